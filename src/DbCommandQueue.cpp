@@ -0,0 +1,159 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * DbCommandQueue.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <boost/bind/bind.hpp>
+
+#include "common/MuxLogger.h"
+#include "DbCommandQueue.h"
+
+namespace mux
+{
+const std::array<const char *, static_cast<size_t> (DbCommand::Count)> DbCommandQueue::mDbCommandName = {
+    "get_mux_state",
+    "set_mux_state",
+    "set_peer_mux_state",
+    "probe_mux_state",
+    "probe_forwarding_state",
+    "set_mux_linkmgr_state",
+    "post_mux_metrics",
+    "post_switch_cause",
+    "post_link_prober_metrics",
+    "post_pck_loss_ratio",
+    "post_probe_interval",
+    "set_mux_mode",
+    "icmp_echo_session",
+    "update_interval",
+    "delete_icmp_echo_session",
+    "flush_state_db"
+};
+
+//
+// ---> DbCommandQueue(boost::asio::io_service::strand &strand);
+//
+// class constructor
+//
+DbCommandQueue::DbCommandQueue(boost::asio::io_service::strand &strand) :
+    mStrand(strand)
+{
+}
+
+//
+// ---> post(DbCommand command, const Handler &handler);
+//
+// queue DB command to run on the DB strand
+//
+void DbCommandQueue::post(DbCommand command, const Handler &handler)
+{
+    uint64_t queueDepth = mQueueDepth.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint64_t maxQueueDepth = mMaxQueueDepth.load(std::memory_order_relaxed);
+    while (queueDepth > maxQueueDepth &&
+           !mMaxQueueDepth.compare_exchange_weak(maxQueueDepth, queueDepth, std::memory_order_relaxed)) {
+    }
+
+    boost::asio::post(mStrand, boost::bind(
+        &DbCommandQueue::handleCommand,
+        this,
+        command,
+        handler,
+        std::chrono::steady_clock::now()
+    ));
+}
+
+//
+// ---> run(DbCommand command, const Handler &handler);
+//
+// run DB command in place and record its latency
+//
+void DbCommandQueue::run(DbCommand command, const Handler &handler)
+{
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    handler();
+    uint64_t latency_usec = getElapsed_usec(startTime);
+
+    mCommandLatency[static_cast<size_t> (command)].record(latency_usec);
+    if (latency_usec > MUX_DB_COMMAND_SLOW_USEC) {
+        MUXLOGWARNING(boost::format("Slow DB command %s took %dus, queue depth: %d") %
+            mDbCommandName[static_cast<size_t> (command)] %
+            latency_usec %
+            getQueueDepth()
+        );
+    }
+}
+
+//
+// ---> dumpStats();
+//
+// log queue depth and latency of every DB command that ran
+//
+void DbCommandQueue::dumpStats()
+{
+    MUXLOGWARNING(boost::format("DB command queue depth: %d, max: %d, queue latency p50: %dus, p99: %dus, max: %dus") %
+        getQueueDepth() %
+        getMaxQueueDepth() %
+        mQueueLatency.getPercentile(50) %
+        mQueueLatency.getPercentile(99) %
+        mQueueLatency.getMax()
+    );
+
+    for (size_t i = 0; i < mCommandLatency.size(); i++) {
+        const common::LatencyHistogram &latency = mCommandLatency[i];
+        if (latency.getCount() == 0) {
+            continue;
+        }
+
+        MUXLOGWARNING(boost::format("DB command %s: count: %d, latency p50: %dus, p99: %dus, p999: %dus, max: %dus") %
+            mDbCommandName[i] %
+            latency.getCount() %
+            latency.getPercentile(50) %
+            latency.getPercentile(99) %
+            latency.getPercentile(99.9) %
+            latency.getMax()
+        );
+    }
+}
+
+//
+// ---> handleCommand(DbCommand command, const Handler &handler, std::chrono::steady_clock::time_point postTime);
+//
+// run queued DB command on the DB strand
+//
+void DbCommandQueue::handleCommand(DbCommand command, const Handler &handler, std::chrono::steady_clock::time_point postTime)
+{
+    mQueueDepth.fetch_sub(1, std::memory_order_relaxed);
+    mQueueLatency.record(getElapsed_usec(postTime));
+
+    run(command, handler);
+}
+
+//
+// ---> getElapsed_usec(std::chrono::steady_clock::time_point startTime);
+//
+// getter for usec elapsed since start time
+//
+uint64_t DbCommandQueue::getElapsed_usec(std::chrono::steady_clock::time_point startTime)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds> (
+        std::chrono::steady_clock::now() - startTime
+    ).count();
+}
+
+} /* namespace mux */
@@ -0,0 +1,224 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * DbCommandQueue.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef DBCOMMANDQUEUE_H_
+#define DBCOMMANDQUEUE_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <boost/asio.hpp>
+#include <boost/function.hpp>
+
+#include "common/LatencyHistogram.h"
+
+namespace test {
+class DbCommandQueueTest;
+}
+
+namespace mux
+{
+#define MUX_DB_COMMAND_SLOW_USEC    100000
+
+/**
+ *@enum DbCommand
+ *
+ *@brief DB commands run on DbInterface strand
+ */
+enum class DbCommand: uint8_t {
+    GetMuxState,
+    SetMuxState,
+    SetPeerMuxState,
+    ProbeMuxState,
+    ProbeForwardingState,
+    SetMuxLinkmgrState,
+    PostMuxMetrics,
+    PostSwitchCause,
+    PostLinkProberMetrics,
+    PostPckLossRatio,
+    PostProbeInterval,
+    SetMuxMode,
+    IcmpEchoSession,
+    UpdateInterval,
+    DeleteIcmpEchoSession,
+    FlushStateDb,
+
+    Count
+};
+
+/**
+ *@class DbCommandQueue
+ *
+ *@brief posts DB commands to the DB strand and measures them. Queue depth is the number
+ *       of commands posted and not yet started. Time a command waited in the queue and
+ *       time it took to run, i.e. how long Redis kept the DB thread busy, are recorded
+ *       in latency histograms. The strand is expected to run on its own DB I/O thread
+ *       so slow Redis replies never hold up link prober and state machine handlers.
+ */
+class DbCommandQueue
+{
+public:
+    using Handler = boost::function<void ()>;
+
+    /**
+    *@method DbCommandQueue
+    *
+    *@brief class constructor
+    *
+    *@param strand (in)     strand DB commands run on
+    */
+    DbCommandQueue(boost::asio::io_service::strand &strand);
+
+    /**
+    *@method DbCommandQueue
+    *
+    *@brief class copy constructor
+    *
+    *@param DbCommandQueue (in)  reference to DbCommandQueue object to be copied
+    */
+    DbCommandQueue(const DbCommandQueue &) = delete;
+
+    /**
+    *@method ~DbCommandQueue
+    *
+    *@brief class destructor
+    */
+    virtual ~DbCommandQueue() = default;
+
+    /**
+    *@method post
+    *
+    *@brief queue DB command to run on the DB strand
+    *
+    *@param command (in)    DB command, used for accounting
+    *@param handler (in)    handler issuing the DB command
+    *
+    *@return none
+    */
+    void post(DbCommand command, const Handler &handler);
+
+    /**
+    *@method run
+    *
+    *@brief run DB command in place and record its latency, called on the DB strand
+    *
+    *@param command (in)    DB command, used for accounting
+    *@param handler (in)    handler issuing the DB command
+    *
+    *@return none
+    */
+    void run(DbCommand command, const Handler &handler);
+
+    /**
+    *@method getQueueDepth
+    *
+    *@brief getter for number of commands posted and not yet started
+    *
+    *@return queue depth
+    */
+    inline uint64_t getQueueDepth() const {return mQueueDepth.load(std::memory_order_relaxed);};
+
+    /**
+    *@method getMaxQueueDepth
+    *
+    *@brief getter for largest queue depth seen
+    *
+    *@return max queue depth
+    */
+    inline uint64_t getMaxQueueDepth() const {return mMaxQueueDepth.load(std::memory_order_relaxed);};
+
+    /**
+    *@method getCommandLatency
+    *
+    *@brief getter for run time histogram of a DB command in usec
+    *
+    *@param command (in)    DB command
+    *
+    *@return reference to latency histogram
+    */
+    inline const common::LatencyHistogram& getCommandLatency(DbCommand command) const {
+        return mCommandLatency[static_cast<size_t> (command)];
+    };
+
+    /**
+    *@method getQueueLatency
+    *
+    *@brief getter for histogram of time commands waited in the queue in usec
+    *
+    *@return reference to latency histogram
+    */
+    inline const common::LatencyHistogram& getQueueLatency() const {return mQueueLatency;};
+
+    /**
+    *@method dumpStats
+    *
+    *@brief log queue depth and latency of every DB command that ran
+    *
+    *@return none
+    */
+    void dumpStats();
+
+private:
+    friend class test::DbCommandQueueTest;
+
+    /**
+    *@method handleCommand
+    *
+    *@brief run queued DB command on the DB strand
+    *
+    *@param command (in)    DB command
+    *@param handler (in)    handler issuing the DB command
+    *@param postTime (in)   time command was posted
+    *
+    *@return none
+    */
+    void handleCommand(DbCommand command, const Handler &handler, std::chrono::steady_clock::time_point postTime);
+
+    /**
+    *@method getElapsed_usec
+    *
+    *@brief getter for usec elapsed since start time
+    *
+    *@param startTime (in)  start time
+    *
+    *@return elapsed usec
+    */
+    static uint64_t getElapsed_usec(std::chrono::steady_clock::time_point startTime);
+
+private:
+    static const std::array<const char *, static_cast<size_t> (DbCommand::Count)> mDbCommandName;
+
+    boost::asio::io_service::strand &mStrand;
+
+    std::atomic<uint64_t> mQueueDepth {0};
+    std::atomic<uint64_t> mMaxQueueDepth {0};
+
+    common::LatencyHistogram mQueueLatency;
+    std::array<common::LatencyHistogram, static_cast<size_t> (DbCommand::Count)> mCommandLatency;
+};
+
+} /* namespace mux */
+
+#endif /* DBCOMMANDQUEUE_H_ */
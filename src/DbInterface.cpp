@@ -52,6 +52,15 @@ std::vector<std::string> DbInterface::mMuxMetrics = {"start", "end"};
 std::vector<std::string> DbInterface::mLinkProbeMetrics = {"link_prober_unknown_start", "link_prober_unknown_end", "link_prober_wait_start", "link_prober_active_start", "link_prober_standby_start"};
 std::vector<std::string> DbInterface::mActiveStandbySwitchCause = {"Peer_Heartbeat_Missing" , "Peer_Link_Down" , "Tlv_Switch_Active_Command" , "Link_Down" , "Transceiver_Daemon_Timeout" , "Matching_Hardware_State" , "Config_Mux_Mode", "Hardware_State_Unknown", "Timed_Oscillation"};
 
+
+// shadow cache tables, table names repeat across DBs so DB name is part of the cache table
+static const std::string SHADOW_APP_MUX_CABLE_TABLE = std::string("APPL_DB|") + APP_MUX_CABLE_TABLE_NAME;
+static const std::string SHADOW_APP_PEER_HW_FORWARDING_STATE_TABLE = std::string("APPL_DB|") + APP_PEER_HW_FORWARDING_STATE_TABLE_NAME;
+static const std::string SHADOW_CFG_MUX_CABLE_TABLE = std::string("CONFIG_DB|") + CFG_MUX_CABLE_TABLE_NAME;
+static const std::string SHADOW_STATE_MUX_CABLE_TABLE = std::string("STATE_DB|") + STATE_MUX_CABLE_TABLE_NAME;
+static const std::string SHADOW_STATE_PEER_HW_FORWARDING_STATE_TABLE = std::string("STATE_DB|") + STATE_PEER_HW_FORWARDING_STATE_TABLE_NAME;
+static const std::string SHADOW_STATE_MUX_LINKMGR_TABLE = std::string("STATE_DB|") + STATE_MUX_LINKMGR_TABLE_NAME;
+
 //
 // ---> DbInterface(mux::MuxManager *muxManager);
 //
@@ -60,7 +69,10 @@ std::vector<std::string> DbInterface::mActiveStandbySwitchCause = {"Peer_Heartbe
 DbInterface::DbInterface(mux::MuxManager *muxManager, boost::asio::io_service *ioService) :
     mMuxManagerPtr(muxManager),
     mBarrier(2),
-    mStrand(*ioService)
+    mStrand(*ioService),
+    mDbCommandQueue(mStrand),
+    mStateDbFlushTimer(*ioService),
+    mMetricsFlushTimer(*ioService)
 {
 }
 
@@ -75,7 +87,7 @@ void DbInterface::getMuxState(const std::string &portName)
 {
     MUXLOGDEBUG(portName);
 
-    boost::asio::post(mStrand, boost::bind(
+    mDbCommandQueue.post(DbCommand::GetMuxState, boost::bind(
         &DbInterface::handleGetMuxState,
         this,
         portName
@@ -83,19 +95,20 @@ void DbInterface::getMuxState(const std::string &portName)
 }
 
 //
-// ---> setMuxState(const std::string &portName, mux_state::MuxState::Label label);
+// ---> setMuxState(const std::string &portName, mux_state::MuxState::Label label, bool forceSwitch);
 //
 // set MUX state in APP DB for orchagent processing
 //
-void DbInterface::setMuxState(const std::string &portName, mux_state::MuxState::Label label)
+void DbInterface::setMuxState(const std::string &portName, mux_state::MuxState::Label label, bool forceSwitch)
 {
     MUXLOGDEBUG(boost::format("%s: setting mux to %s") % portName % mMuxState[label]);
 
-    boost::asio::post(mStrand, boost::bind(
+    mDbCommandQueue.post(DbCommand::SetMuxState, boost::bind(
         &DbInterface::handleSetMuxState,
         this,
         portName,
-        label
+        label,
+        forceSwitch
     ));
 }
 
@@ -108,7 +121,7 @@ void DbInterface::setPeerMuxState(const std::string &portName, mux_state::MuxSta
 {
     MUXLOGDEBUG(boost::format("%s: setting peer mux to %s") % portName % mMuxState[label]);
 
-    boost::asio::post(mStrand, boost::bind(
+    mDbCommandQueue.post(DbCommand::SetPeerMuxState, boost::bind(
         &DbInterface::handleSetPeerMuxState,
         this,
         portName,
@@ -126,7 +139,7 @@ void DbInterface::probeMuxState(const std::string &portName)
 {
     MUXLOGDEBUG(portName);
 
-    boost::asio::post(mStrand, boost::bind(
+    mDbCommandQueue.post(DbCommand::ProbeMuxState, boost::bind(
         &DbInterface::handleProbeMuxState,
         this,
         portName
@@ -142,7 +155,7 @@ void DbInterface::probeForwardingState(const std::string &portName)
 {
     MUXLOGDEBUG(portName);
 
-    boost::asio::post(mStrand, boost::bind(
+    mDbCommandQueue.post(DbCommand::ProbeForwardingState, boost::bind(
         &DbInterface::handleProbeForwardingState,
         this,
         portName
@@ -158,7 +171,11 @@ void DbInterface::setMuxLinkmgrState(const std::string &portName, link_manager::
 {
     MUXLOGDEBUG(boost::format("%s: setting mux linkmgr to %s") % portName % mMuxLinkmgrState[static_cast<int> (label)]);
 
-    boost::asio::post(mStrand, boost::bind(
+    if (storeMetricsSlot(portName, MetricsSlot::MuxLinkmgrState, {static_cast<uint64_t> (label)})) {
+        return;
+    }
+
+    mDbCommandQueue.post(DbCommand::SetMuxLinkmgrState, boost::bind(
         &DbInterface::handleSetMuxLinkmgrState,
         this,
         portName,
@@ -186,7 +203,7 @@ void DbInterface::postMetricsEvent(
         mMuxMetrics[static_cast<int> (metrics)]
     );
 
-    boost::asio::post(mStrand, boost::bind(
+    mDbCommandQueue.post(DbCommand::PostMuxMetrics, boost::bind(
         &DbInterface::handlePostMuxMetrics,
         this,
         portName,
@@ -214,7 +231,7 @@ void DbInterface::postSwitchCause(
         mActiveStandbySwitchCause[static_cast<int>(cause)]
     );
 
-    boost::asio::post(mStrand, boost::bind(
+    mDbCommandQueue.post(DbCommand::PostSwitchCause, boost::bind(
         &DbInterface::handlePostSwitchCause,
         this,
         portName,
@@ -245,6 +262,7 @@ void DbInterface::handlePostSwitchCause(
 
     mStateDbSwitchCauseTablePtr->hset(portName, "cause", mActiveStandbySwitchCause[static_cast<int>(cause)]);
     mStateDbSwitchCauseTablePtr->hset(portName, "time", boost::posix_time::to_simple_string(time));
+    scheduleStateDbFlush();
 }
 
 
@@ -265,12 +283,21 @@ void DbInterface::postLinkProberMetricsEvent(
         mLinkProbeMetrics[static_cast<int> (metrics)]
     );
 
-    boost::asio::post(mStrand, boost::bind(
+    boost::posix_time::ptime time = boost::posix_time::microsec_clock::universal_time();
+    boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+    if (storeMetricsSlot(portName, MetricsSlot::LinkProberMetrics, {
+            static_cast<uint64_t> (metrics),
+            static_cast<uint64_t> ((time - epoch).total_microseconds())
+        })) {
+        return;
+    }
+
+    mDbCommandQueue.post(DbCommand::PostLinkProberMetrics, boost::bind(
         &DbInterface::handlePostLinkProberMetrics,
         this,
         portName,
         metrics,
-        boost::posix_time::microsec_clock::universal_time()
+        time
     ));
 }
 
@@ -278,13 +305,17 @@ void DbInterface::postLinkProberMetricsEvent(
 // ---> postPckLossRatio(
 //        const std::string &portName,
 //        const uint64_t unknownEventCount, 
-//        const uint64_t expectedPacketCount
+//        const uint64_t expectedPacketCount,
+//        const link_prober::HeartbeatLossWindowStats &selfLossStats,
+//        const link_prober::HeartbeatLossWindowStats &peerLossStats
 //    );
 //  post pck loss ratio update to state db 
 void DbInterface::postPckLossRatio(
         const std::string &portName,
         const uint64_t unknownEventCount, 
-        const uint64_t expectedPacketCount
+        const uint64_t expectedPacketCount,
+        const link_prober::HeartbeatLossWindowStats &selfLossStats,
+        const link_prober::HeartbeatLossWindowStats &peerLossStats
 )
 {
     MUXLOGDEBUG(boost::format("%s: posting pck loss ratio, pck_loss_count / pck_expected_count : %d / %d") %
@@ -293,12 +324,48 @@ void DbInterface::postPckLossRatio(
         expectedPacketCount
     );
 
-    boost::asio::post(mStrand,boost::bind(
+    if (storeMetricsSlot(portName, MetricsSlot::PckLossRatio, {
+            unknownEventCount,
+            expectedPacketCount,
+            selfLossStats.lossCount,
+            selfLossStats.burstCount,
+            selfLossStats.longestBurst,
+            peerLossStats.lossCount,
+            peerLossStats.burstCount,
+            peerLossStats.longestBurst
+        })) {
+        return;
+    }
+
+    mDbCommandQueue.post(DbCommand::PostPckLossRatio, boost::bind(
         &DbInterface::handlePostPckLossRatio,
         this,
         portName,
         unknownEventCount,
-        expectedPacketCount
+        expectedPacketCount,
+        selfLossStats,
+        peerLossStats
+    ));
+}
+
+//
+// ---> postProbeInterval(const std::string &portName, const uint32_t probeInterval_msec);
+//
+// post current link prober probing interval to state db
+//
+void DbInterface::postProbeInterval(const std::string &portName, const uint32_t probeInterval_msec)
+{
+    MUXLOGDEBUG(boost::format("%s: posting probe interval: %d msec") % portName % probeInterval_msec);
+
+    if (storeMetricsSlot(portName, MetricsSlot::ProbeInterval, {probeInterval_msec})) {
+        return;
+    }
+
+    mDbCommandQueue.post(DbCommand::PostProbeInterval, boost::bind(
+        &DbInterface::handlePostProbeInterval,
+        this,
+        portName,
+        probeInterval_msec
     ));
 }
 
@@ -328,17 +395,18 @@ void DbInterface::initialize()
         mAppDbIcmpEchoSessionTablePtr = std::make_shared<swss::ProducerStateTable> (
             mAppDbPtr.get(), APP_ICMP_ECHO_SESSION_TABLE_NAME
         );
+        mStateDbPipelinePtr = std::make_shared<swss::RedisPipeline> (mStateDbPtr.get(), MUX_DB_PIPELINE_SIZE);
         mStateDbMuxLinkmgrTablePtr = std::make_shared<swss::Table> (
-            mStateDbPtr.get(), STATE_MUX_LINKMGR_TABLE_NAME
+            mStateDbPipelinePtr.get(), STATE_MUX_LINKMGR_TABLE_NAME, true
         );
         mStateDbMuxMetricsTablePtr = std::make_shared<swss::Table> (
-            mStateDbPtr.get(), STATE_MUX_METRICS_TABLE_NAME
+            mStateDbPipelinePtr.get(), STATE_MUX_METRICS_TABLE_NAME, true
         );
         mStateDbLinkProbeStatsTablePtr = std::make_shared<swss::Table> (
-            mStateDbPtr.get(), LINK_PROBE_STATS_TABLE_NAME
+            mStateDbPipelinePtr.get(), LINK_PROBE_STATS_TABLE_NAME, true
         );
         mStateDbSwitchCauseTablePtr = std::make_shared<swss::Table> (
-            mStateDbPtr.get(),  STATE_MUX_SWITCH_CAUSE_TABLE_NAME
+            mStateDbPipelinePtr.get(), STATE_MUX_SWITCH_CAUSE_TABLE_NAME, true
         );
         mStateDbIcmpEchoSessionTablePtr = std::make_shared<swss::Table> (
             mStateDbPtr.get(),  STATE_ICMP_ECHO_SESSION_TABLE_NAME
@@ -346,6 +414,8 @@ void DbInterface::initialize()
         mMuxStateTablePtr = std::make_shared<swss::Table> (mStateDbPtr.get(), STATE_MUX_CABLE_TABLE_NAME);
         mSwitchCapTablePtr = std::make_shared<swss::Table> (mStateDbPtr.get(), STATE_SWITCH_CAPABILITY_TABLE_NAME);
 
+        seedDbShadowCache();
+
         mSwssThreadPtr = std::make_shared<boost::thread> (&DbInterface::handleSwssNotification, this);
     }
     catch (const std::bad_alloc &ex) {
@@ -364,6 +434,22 @@ void DbInterface::initialize()
 void DbInterface::deinitialize()
 {
     mSwssThreadPtr->join();
+
+    // writes still queued on STATE_DB pipeline
+    boost::asio::post(mStrand, boost::bind(&DbInterface::flushStateDb, this));
+
+    dumpStats();
+}
+
+//
+// ---> dumpStats();
+//
+// log DB command queue depth and latency and shadow cache counters
+//
+void DbInterface::dumpStats()
+{
+    mDbCommandQueue.dumpStats();
+    mDbShadowCache.dumpStats();
 }
 
 //
@@ -388,30 +474,41 @@ void DbInterface::updateServerMacAddress(boost::asio::ip::address serverIp, cons
 //
 // ---> handleGetMuxState(const std::string portName);
 //
-// get state db MUX state
+// get state db MUX state from local cache or from state db
 //
 void DbInterface::handleGetMuxState(const std::string portName)
 {
     MUXLOGDEBUG(portName);
 
+    // cache is kept current by STATE_DB MUX_CABLE subscription, Redis is read only when it is cold
     std::string state;
-    if (mMuxStateTablePtr->hget(portName, "state", state)) {
+    if (mDbShadowCache.read(SHADOW_STATE_MUX_CABLE_TABLE, portName, "state", state)) {
+        mMuxManagerPtr->processGetMuxState(portName, state);
+    } else if (mMuxStateTablePtr->hget(portName, "state", state)) {
+        mDbShadowCache.seed(SHADOW_STATE_MUX_CABLE_TABLE, portName, "state", state);
         mMuxManagerPtr->processGetMuxState(portName, state);
     }
 }
 
 //
-// ---> handleSetMuxState(const std::string portName, mux_state::MuxState::Label label);
+// ---> handleSetMuxState(const std::string portName, mux_state::MuxState::Label label, bool forceSwitch);
 //
 // set MUX state in APP DB for orchagent processing
 //
-void DbInterface::handleSetMuxState(const std::string portName, mux_state::MuxState::Label label)
+void DbInterface::handleSetMuxState(const std::string portName, mux_state::MuxState::Label label, bool forceSwitch)
 {
     MUXLOGDEBUG(boost::format("%s: setting mux state to %s") % portName % mMuxState[label]);
 
     if (label <= mux_state::MuxState::Label::Unknown) {
+        const std::string &state = mMuxState[label];
+        if (!shadowMuxStateWrite(portName, state, forceSwitch)) {
+            MUXLOGDEBUG(boost::format("%s: mux state is already %s, skipping APP DB write") % portName % state);
+            mMuxManagerPtr->addOrUpdateMuxPortMuxState(portName, state);
+            return;
+        }
+
         std::vector<swss::FieldValueTuple> values = {
-            {"state", mMuxState[label]},
+            {"state", state},
         };
         mAppDbMuxTablePtr->set(portName, values);
     }
@@ -427,7 +524,12 @@ void DbInterface::handleSetPeerMuxState(const std::string portName, mux_state::M
     MUXLOGDEBUG(boost::format("%s: setting peer mux state to %s") % portName % mMuxState[label]);
 
     if (label <= mux_state::MuxState::Label::Unknown) {
-        mAppDbPeerMuxTablePtr->hset(portName, "state", mMuxState[label]);
+        // peer is toggled only when its heartbeats are lost, our STATE DB view of peer forwarding
+        // state may be stale then, so the toggle is always written
+        const std::string &state = mMuxState[label];
+        mDbShadowCache.write(SHADOW_APP_PEER_HW_FORWARDING_STATE_TABLE, portName, "state", state, false);
+
+        mAppDbPeerMuxTablePtr->hset(portName, "state", state);
     }
 }
 
@@ -467,8 +569,10 @@ void DbInterface::handleSetMuxLinkmgrState(
 {
     MUXLOGDEBUG(boost::format("%s: setting mux linkmgr state to %s") % portName % mMuxLinkmgrState[static_cast<int> (label)]);
 
-    if (label < link_manager::ActiveStandbyStateMachine::Label::Count) {
+    if (label < link_manager::ActiveStandbyStateMachine::Label::Count &&
+        mDbShadowCache.write(SHADOW_STATE_MUX_LINKMGR_TABLE, portName, "state", mMuxLinkmgrState[static_cast<int> (label)])) {
         mStateDbMuxLinkmgrTablePtr->hset(portName, "state", mMuxLinkmgrState[static_cast<int> (label)]);
+        scheduleStateDbFlush();
     }
 }
 
@@ -503,6 +607,7 @@ void DbInterface::handlePostMuxMetrics(
         "linkmgrd_switch_" + mMuxState[label] + "_" + mMuxMetrics[static_cast<int> (metrics)],
         boost::posix_time::to_simple_string(time)
     );
+    scheduleStateDbFlush();
 }
 
 // 
@@ -529,20 +634,25 @@ void DbInterface::handlePostLinkProberMetrics(
     }
 
     mStateDbLinkProbeStatsTablePtr->hset(portName, mLinkProbeMetrics[static_cast<int> (metrics)], boost::posix_time::to_simple_string(time));
+    scheduleStateDbFlush();
 }
 
 // 
 // ---> handlePostPckLossRatio(
 //        const std::string portName,
 //        const uint64_t unknownEventCount, 
-//        const uint64_t expectedPacketCount
+//        const uint64_t expectedPacketCount,
+//        const link_prober::HeartbeatLossWindowStats &selfLossStats,
+//        const link_prober::HeartbeatLossWindowStats &peerLossStats
 //    );
 //
 // handle post pck loss ratio 
 void DbInterface::handlePostPckLossRatio(
         const std::string portName,
         const uint64_t unknownEventCount, 
-        const uint64_t expectedPacketCount
+        const uint64_t expectedPacketCount,
+        const link_prober::HeartbeatLossWindowStats &selfLossStats,
+        const link_prober::HeartbeatLossWindowStats &peerLossStats
 )
 {
     MUXLOGDEBUG(boost::format("%s: posting pck loss ratio, pck_loss_count / pck_expected_count : %d / %d") %
@@ -555,7 +665,228 @@ void DbInterface::handlePostPckLossRatio(
     std::vector<swss::FieldValueTuple> fieldValues;
     fieldValues.push_back(std::make_pair("pck_loss_count", std::to_string(unknownEventCount)));
     fieldValues.push_back(std::make_pair("pck_expected_count", std::to_string(expectedPacketCount)));
+    fieldValues.push_back(std::make_pair("pck_loss_window_size", std::to_string(MUX_HEARTBEAT_LOSS_WINDOW_SIZE)));
+    fieldValues.push_back(std::make_pair("self_pck_loss_window_count", std::to_string(selfLossStats.lossCount)));
+    fieldValues.push_back(std::make_pair("self_loss_burst_count", std::to_string(selfLossStats.burstCount)));
+    fieldValues.push_back(std::make_pair("self_longest_loss_burst", std::to_string(selfLossStats.longestBurst)));
+    fieldValues.push_back(std::make_pair("peer_pck_loss_window_count", std::to_string(peerLossStats.lossCount)));
+    fieldValues.push_back(std::make_pair("peer_loss_burst_count", std::to_string(peerLossStats.burstCount)));
+    fieldValues.push_back(std::make_pair("peer_longest_loss_burst", std::to_string(peerLossStats.longestBurst)));
     mStateDbLinkProbeStatsTablePtr->set(portName, fieldValues);
+    scheduleStateDbFlush();
+}
+
+//
+// ---> handlePostProbeInterval(const std::string portName, const uint32_t probeInterval_msec);
+//
+// handle post current link prober probing interval
+//
+void DbInterface::handlePostProbeInterval(const std::string portName, const uint32_t probeInterval_msec)
+{
+    MUXLOGDEBUG(boost::format("%s: posting probe interval: %d msec") % portName % probeInterval_msec);
+
+    mStateDbLinkProbeStatsTablePtr->hset(portName, "probe_interval", std::to_string(probeInterval_msec));
+    scheduleStateDbFlush();
+}
+
+//
+// ---> scheduleStateDbFlush();
+//
+// account a write queued on STATE_DB pipeline and arm flush timer if it is not running
+//
+void DbInterface::scheduleStateDbFlush()
+{
+    mStateDbWriteCount++;
+    if (mStateDbFlushScheduled) {
+        return;
+    }
+
+    mStateDbFlushScheduled = true;
+    mStateDbFlushTimer.expires_from_now(boost::posix_time::milliseconds(MUX_DB_FLUSH_INTERVAL_MSEC));
+    mStateDbFlushTimer.async_wait(mStrand.wrap(boost::bind(
+        &DbInterface::handleStateDbFlushTimeout,
+        this,
+        boost::asio::placeholders::error
+    )));
+}
+
+//
+// ---> handleStateDbFlushTimeout(const boost::system::error_code &errorCode);
+//
+// handle expiry of STATE_DB pipeline flush timer
+//
+void DbInterface::handleStateDbFlushTimeout(const boost::system::error_code &errorCode)
+{
+    if (errorCode != boost::asio::error::operation_aborted) {
+        flushStateDb();
+    }
+}
+
+//
+// ---> flushStateDb();
+//
+// send writes queued on STATE_DB pipeline in one round trip
+//
+void DbInterface::flushStateDb()
+{
+    mStateDbFlushScheduled = false;
+    if (!mStateDbPipelinePtr) {
+        return;
+    }
+
+    mStateDbFlushCount++;
+    MUXLOGDEBUG(boost::format("Flushing STATE_DB pipeline, writes: %d, flushes: %d") %
+        mStateDbWriteCount %
+        mStateDbFlushCount
+    );
+    mDbCommandQueue.run(DbCommand::FlushStateDb, boost::bind(&swss::RedisPipeline::flush, mStateDbPipelinePtr.get()));
+}
+
+//
+// ---> storeMetricsSlot(const std::string &portName, MetricsSlot slot, const MetricsSlotValues &values);
+//
+// overwrite latest value slot of a port and schedule metrics flush
+//
+bool DbInterface::storeMetricsSlot(const std::string &portName, MetricsSlot slot, const MetricsSlotValues &values)
+{
+    if (!mMetricsSlotTable.store(portName, slot, values)) {
+        MUXLOGWARNING(boost::format("%s: metrics slot table is full, posting update in order") % portName);
+        return false;
+    }
+
+    if (!mMetricsFlushScheduled.exchange(true)) {
+        boost::asio::post(mStrand, boost::bind(&DbInterface::startMetricsFlushTimer, this));
+    }
+
+    return true;
+}
+
+//
+// ---> startMetricsFlushTimer();
+//
+// arm metrics flush timer with configured interval
+//
+void DbInterface::startMetricsFlushTimer()
+{
+    mMetricsFlushTimer.expires_from_now(boost::posix_time::milliseconds(mMetricsFlushInterval_msec.load()));
+    mMetricsFlushTimer.async_wait(mStrand.wrap(boost::bind(
+        &DbInterface::handleMetricsFlushTimeout,
+        this,
+        boost::asio::placeholders::error
+    )));
+}
+
+//
+// ---> handleMetricsFlushTimeout(const boost::system::error_code &errorCode);
+//
+// write dirty latest value slots of all ports to STATE_DB
+//
+void DbInterface::handleMetricsFlushTimeout(const boost::system::error_code &errorCode)
+{
+    if (errorCode == boost::asio::error::operation_aborted) {
+        return;
+    }
+
+    // slots stored from here on schedule the next flush
+    mMetricsFlushScheduled = false;
+    size_t slotCount = mMetricsSlotTable.collect(boost::bind(
+        &DbInterface::handleMetricsSlot,
+        this,
+        boost::placeholders::_1,
+        boost::placeholders::_2,
+        boost::placeholders::_3
+    ));
+
+    MUXLOGDEBUG(boost::format("Flushed %d metrics slots, stored: %d, written: %d") %
+        slotCount %
+        mMetricsSlotTable.getStoreCount() %
+        mMetricsSlotTable.getCollectCount()
+    );
+}
+
+//
+// ---> handleMetricsSlot(const std::string &portName, MetricsSlot slot, const MetricsSlotValues &values);
+//
+// write latest values of a slot to STATE_DB
+//
+void DbInterface::handleMetricsSlot(const std::string &portName, MetricsSlot slot, const MetricsSlotValues &values)
+{
+    switch (slot) {
+        case MetricsSlot::PckLossRatio: {
+            link_prober::HeartbeatLossWindowStats selfLossStats;
+            selfLossStats.lossCount = values[2];
+            selfLossStats.burstCount = values[3];
+            selfLossStats.longestBurst = values[4];
+            link_prober::HeartbeatLossWindowStats peerLossStats;
+            peerLossStats.lossCount = values[5];
+            peerLossStats.burstCount = values[6];
+            peerLossStats.longestBurst = values[7];
+            handlePostPckLossRatio(portName, values[0], values[1], selfLossStats, peerLossStats);
+            break;
+        }
+        case MetricsSlot::LinkProberMetrics: {
+            boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+            handlePostLinkProberMetrics(
+                portName,
+                static_cast<link_manager::ActiveStandbyStateMachine::LinkProberMetrics> (values[0]),
+                epoch + boost::posix_time::microseconds(values[1])
+            );
+            break;
+        }
+        case MetricsSlot::ProbeInterval:
+            handlePostProbeInterval(portName, values[0]);
+            break;
+        case MetricsSlot::MuxLinkmgrState:
+            handleSetMuxLinkmgrState(portName, static_cast<link_manager::ActiveStandbyStateMachine::Label> (values[0]));
+            break;
+        default:
+            break;
+    }
+}
+
+//
+// ---> seedDbShadowCache();
+//
+// seed shadow cache with DB content of tables linkmgrd writes
+//
+void DbInterface::seedDbShadowCache()
+{
+    auto seedTable = [this] (swss::Table &table, const std::string &shadowTable) {
+        std::vector<swss::KeyOpFieldsValuesTuple> entries;
+        table.getContent(entries);
+
+        for (auto &entry: entries) {
+            for (auto &fieldValue: kfvFieldsValues(entry)) {
+                mDbShadowCache.seed(shadowTable, kfvKey(entry), fvField(fieldValue), fvValue(fieldValue));
+            }
+        }
+    };
+
+    swss::Table appDbMuxTable(mAppDbPtr.get(), APP_MUX_CABLE_TABLE_NAME);
+    swss::Table appDbPeerMuxTable(mAppDbPtr.get(), APP_PEER_HW_FORWARDING_STATE_TABLE_NAME);
+    swss::Table stateDbMuxTable(mStateDbPtr.get(), STATE_MUX_CABLE_TABLE_NAME);
+    swss::Table stateDbPeerMuxTable(mStateDbPtr.get(), STATE_PEER_HW_FORWARDING_STATE_TABLE_NAME);
+    swss::Table stateDbMuxLinkmgrTable(mStateDbPtr.get(), STATE_MUX_LINKMGR_TABLE_NAME);
+
+    seedTable(appDbMuxTable, SHADOW_APP_MUX_CABLE_TABLE);
+    seedTable(appDbPeerMuxTable, SHADOW_APP_PEER_HW_FORWARDING_STATE_TABLE);
+    seedTable(stateDbMuxTable, SHADOW_STATE_MUX_CABLE_TABLE);
+    seedTable(stateDbPeerMuxTable, SHADOW_STATE_PEER_HW_FORWARDING_STATE_TABLE);
+    seedTable(stateDbMuxLinkmgrTable, SHADOW_STATE_MUX_LINKMGR_TABLE);
+}
+
+//
+// ---> shadowMuxStateWrite(const std::string &portName, const std::string &state, bool forceSwitch);
+//
+// record APP DB mux state write in shadow cache
+//
+bool DbInterface::shadowMuxStateWrite(const std::string &portName, const std::string &state, bool forceSwitch)
+{
+    // orchagent answers every write with STATE_DB mux state, a write is redundant only when
+    // orchagent already reports the state. Forced switches correct drift of the hardware from
+    // that state and always go to APP DB
+    bool programmed = mDbShadowCache.isStored(SHADOW_STATE_MUX_CABLE_TABLE, portName, "state", state);
+    return mDbShadowCache.write(SHADOW_APP_MUX_CABLE_TABLE, portName, "state", state, programmed && !forceSwitch);
 }
 
 //
@@ -992,6 +1323,7 @@ std::map<std::string, std::string> DbInterface::getMuxModeConfig()
             MUXLOGDEBUG(boost::format("port: %s, mode mux %s = %s") % portName % f % muxMode);
 
             PortToMuxModeConfigMapping[portName] = muxMode;
+            mDbShadowCache.seed(SHADOW_CFG_MUX_CABLE_TABLE, portName, "state", muxMode);
         } else {
             MUXLOGERROR(boost::format("port: %s, mode mux is not found in %s table") % portName % CFG_MUX_CABLE_TABLE_NAME);
         }
@@ -1023,7 +1355,7 @@ void DbInterface::setMuxMode(const std::string &portName, const std::string stat
 {
     MUXLOGDEBUG(portName);
 
-    boost::asio::post(mStrand,boost::bind(
+    mDbCommandQueue.post(DbCommand::SetMuxMode, boost::bind(
         &DbInterface::handleSetMuxMode,
         this,
         portName,
@@ -1038,6 +1370,11 @@ void DbInterface::setMuxMode(const std::string &portName, const std::string stat
 //
 void DbInterface::handleSetMuxMode(const std::string &portName, const std::string state)
 {
+    if (!mDbShadowCache.write(SHADOW_CFG_MUX_CABLE_TABLE, portName, "state", state)) {
+        MUXLOGWARNING(boost::format("%s: mux mode is already %s after warm restart") % portName % state);
+        return;
+    }
+
     MUXLOGWARNING(boost::format("%s: configuring mux mode to %s after warm restart") % portName % state);
 
     std::shared_ptr<swss::DBConnector> configDbPtr = std::make_shared<swss::DBConnector> ("CONFIG_DB", 0);
@@ -1075,7 +1412,10 @@ void DbInterface::processMuxPortConfigNotifiction(std::deque<swss::KeyOpFieldsVa
                 v
             );
             
+            mDbShadowCache.seed(SHADOW_CFG_MUX_CABLE_TABLE, port, f, v);
             mMuxManagerPtr->updateMuxPortConfig(port, v);
+        } else if (operation == DEL_COMMAND) {
+            mDbShadowCache.erase(SHADOW_CFG_MUX_CABLE_TABLE, port);
         }
 
         std::vector<swss::FieldValueTuple>::const_iterator c_it = std::find_if(
@@ -1096,6 +1436,25 @@ void DbInterface::processMuxPortConfigNotifiction(std::deque<swss::KeyOpFieldsVa
             
             mMuxManagerPtr->resetPckLossCount(port);
         }
+
+        for (auto &fieldValue: fieldValues) {
+            const std::string f = fvField(fieldValue);
+            const std::string v = fvValue(fieldValue);
+            try {
+                if (f == "probe_interval_min_v4") {
+                    mMuxManagerPtr->setMinProbeInterval_msec(port, boost::lexical_cast<uint32_t> (v));
+                } else if (f == "probe_interval_max_v4") {
+                    mMuxManagerPtr->setMaxProbeInterval_msec(port, boost::lexical_cast<uint32_t> (v));
+                } else if (f == "probe_priority") {
+                    mMuxManagerPtr->setProbePriority(port, boost::lexical_cast<uint32_t> (v));
+                } else if (f == "low_latency_rx") {
+                    mMuxManagerPtr->setLowLatencyRx(port, v == "enable");
+                }
+            }
+            catch (boost::bad_lexical_cast const &badLexicalCast) {
+                MUXLOGWARNING(boost::format("%s: bad lexical cast of %s: %s") % port % f % badLexicalCast.what());
+            }
+        }
     }
 }
 
@@ -1131,6 +1490,16 @@ void DbInterface::processMuxLinkmgrConfigNotifiction(std::deque<swss::KeyOpField
                     std::string v = fvValue(fieldValue);
                     if (f == "interval_v4") {
                         mMuxManagerPtr->setTimeoutIpv4_msec(boost::lexical_cast<uint32_t> (v));
+                    } else if (f == "detection_timeout_v4") {
+                        mMuxManagerPtr->setDetectionTimeoutIpv4_msec(boost::lexical_cast<uint32_t> (v));
+                    } else if (f == "max_interval_v4") {
+                        mMuxManagerPtr->setMaxTimeoutIpv4_msec(boost::lexical_cast<uint32_t> (v));
+                    } else if (f == "stable_heartbeat_count") {
+                        mMuxManagerPtr->setStableHeartbeatCount(boost::lexical_cast<uint32_t> (v));
+                    } else if (f == "max_probe_rate") {
+                        mMuxManagerPtr->setMaxProbeRate(boost::lexical_cast<uint32_t> (v));
+                    } else if (f == "metrics_flush_interval") {
+                        mMuxManagerPtr->setMetricsFlushInterval_msec(boost::lexical_cast<uint32_t> (v));
                     } else if (f == "interval_v6") {
                         mMuxManagerPtr->setTimeoutIpv6_msec(boost::lexical_cast<uint32_t> (v));
                     } else if (f == "positive_signal_count") {
@@ -1455,7 +1824,10 @@ void DbInterface::processPeerMuxNotification(std::deque<swss::KeyOpFieldsValuesT
                 f %
                 v
             );
+            mDbShadowCache.seed(SHADOW_STATE_PEER_HW_FORWARDING_STATE_TABLE, port, f, v);
             mMuxManagerPtr->processPeerMuxState(port, v);
+        } else if (oprtation == DEL_COMMAND) {
+            mDbShadowCache.erase(SHADOW_STATE_PEER_HW_FORWARDING_STATE_TABLE, port);
         }
     }
 }
@@ -1500,7 +1872,10 @@ void DbInterface::processMuxStateNotifiction(std::deque<swss::KeyOpFieldsValuesT
                 f %
                 v
             );
+            mDbShadowCache.seed(SHADOW_STATE_MUX_CABLE_TABLE, port, f, v);
             mMuxManagerPtr->addOrUpdateMuxPortMuxState(port, v);
+        } else if (oprtation == DEL_COMMAND) {
+            mDbShadowCache.erase(SHADOW_STATE_MUX_CABLE_TABLE, port);
         }
     }
 }
@@ -1626,7 +2001,7 @@ void DbInterface::processTsaEnableNotification(std::deque<swss::KeyOpFieldsValue
 void DbInterface::createIcmpEchoSession(std::string key, IcmpHwOffloadEntriesPtr entries)
 {
     MUXLOGDEBUG(boost::format(" %s : ICMP session Being created ") % key);
-    boost::asio::post(mStrand, boost::bind(
+    mDbCommandQueue.post(DbCommand::IcmpEchoSession, boost::bind(
         &DbInterface::handleIcmpEchoSession,
         this,
         key,
@@ -1665,7 +2040,7 @@ void DbInterface::updateIntervalv4(uint32_t tx_interval, uint32_t rx_interval)
 {
     MUXLOGDEBUG(boost::format("Updating Interval v4 tx(%u) rx(%u)") %
             tx_interval % rx_interval);
-    boost::asio::post(mStrand, boost::bind(
+    mDbCommandQueue.post(DbCommand::UpdateInterval, boost::bind(
         &DbInterface::handleUpdateInterval,
         this,
         tx_interval,
@@ -1682,7 +2057,7 @@ void DbInterface::updateIntervalv6(uint32_t tx_interval, uint32_t rx_interval)
 {
     MUXLOGDEBUG(boost::format("Updating Interval v6 tx(%u) rx(%u)") %
             tx_interval % rx_interval);
-    boost::asio::post(mStrand, boost::bind(
+    mDbCommandQueue.post(DbCommand::UpdateInterval, boost::bind(
         &DbInterface::handleUpdateInterval,
         this,
         tx_interval,
@@ -1718,7 +2093,7 @@ void DbInterface::handleUpdateInterval(uint32_t tx_interval, uint32_t rx_interva
 void DbInterface::deleteIcmpEchoSession(std::string key)
 {
     MUXLOGDEBUG(boost::format("%s : ICMP session Being deleted") % key);
-    boost::asio::post(mStrand, boost::bind(
+    mDbCommandQueue.post(DbCommand::DeleteIcmpEchoSession, boost::bind(
         &DbInterface::handleDeleteIcmpEchoSession,
         this,
         key
@@ -34,8 +34,12 @@
 
 #include "swss/dbconnector.h"
 #include "swss/producerstatetable.h"
+#include "swss/redispipeline.h"
 #include "swss/subscriberstatetable.h"
 #include "swss/warm_restart.h"
+#include "DbCommandQueue.h"
+#include "DbShadowCache.h"
+#include "MetricsSlotTable.h"
 #include "link_prober/LinkProberBase.h"
 #include "link_manager/LinkManagerStateMachineActiveStandby.h"
 #include "mux_state/MuxState.h"
@@ -62,6 +66,9 @@ namespace mux
 
 #define STATE_MUX_SWITCH_CAUSE_TABLE_NAME "MUX_SWITCH_CAUSE"
 
+#define MUX_DB_PIPELINE_SIZE        128
+#define MUX_DB_FLUSH_INTERVAL_MSEC  10
+
 class MuxManager;
 using ServerIpPortMap = std::map<boost::asio::ip::address, std::string>;
 using IcmpHwOffloadEntries = std::vector<std::pair<std::string, std::string>>;
@@ -127,6 +134,15 @@ public:
     */
     inline boost::asio::io_service::strand& getStrand() {return mStrand;};
 
+    /**
+    *@method dumpStats
+    *
+    *@brief log DB command queue depth and latency and shadow cache counters
+    *
+    *@return none
+    */
+    void dumpStats();
+
     /**
     *@method getMuxState
     *
@@ -143,24 +159,26 @@ public:
     *
     *@brief set MUX state in APP DB for orchagent processing
     *
-    *@param portName (in)   MUX/port name
-    *@param label (in)      label of target state
+    *@param portName (in)       MUX/port name
+    *@param label (in)          label of target state
+    *@param forceSwitch (in)    force switch mux state, write is never skipped as redundant
     *
     *@return none
     */
-    void setMuxState(const std::string &portName, mux_state::MuxState::Label label);
+    void setMuxState(const std::string &portName, mux_state::MuxState::Label label, bool forceSwitch = false);
 
     /**
     *@method handleSetMuxState
     *
     *@brief set MUX state in APP DB for orchagent processing
     *
-    *@param portName (in)   MUX/port name
-    *@param label (in)      label of target state
+    *@param portName (in)       MUX/port name
+    *@param label (in)          label of target state
+    *@param forceSwitch (in)    force switch mux state, write is never skipped as redundant
     *
     *@return none
     */
-    virtual void handleSetMuxState(const std::string portName, mux_state::MuxState::Label label);
+    virtual void handleSetMuxState(const std::string portName, mux_state::MuxState::Label label, bool forceSwitch);
 
     /**
     *@method setPeerMuxState
@@ -298,15 +316,42 @@ public:
      * @param portName (in) port name 
      * @param unknownEventCount (in) count of missing icmp packets
      * @param expectedPacketCount (in) count of expected icmp packets 
+     * @param selfLossStats (in) loss statistics of recent self heartbeats
+     * @param peerLossStats (in) loss statistics of recent peer heartbeats
      * 
      * @return none
     */
     virtual void postPckLossRatio(
         const std::string &portName,
         const uint64_t unknownEventCount, 
-        const uint64_t expectedPacketCount
+        const uint64_t expectedPacketCount,
+        const link_prober::HeartbeatLossWindowStats &selfLossStats,
+        const link_prober::HeartbeatLossWindowStats &peerLossStats
     );
 
+    /**
+     * @method postProbeInterval
+     *
+     * @brief post current link prober probing interval to state db
+     *
+     * @param portName (in) port name
+     * @param probeInterval_msec (in) current probing interval in msec
+     *
+     * @return none
+    */
+    virtual void postProbeInterval(const std::string &portName, const uint32_t probeInterval_msec);
+
+    /**
+     * @method setMetricsFlushInterval_msec
+     *
+     * @brief setter for interval at which latest STATE_DB metrics of all ports are written
+     *
+     * @param interval_msec (in) flush interval in msec
+     *
+     * @return none
+    */
+    inline void setMetricsFlushInterval_msec(uint32_t interval_msec) {mMetricsFlushInterval_msec = interval_msec;};
+
     /**
     *@method initialize
     *
@@ -447,7 +492,7 @@ private:
     /**
     *@method handleGetMuxState
     *
-    *@brief get state db MUX state
+    *@brief get state db MUX state from local cache or from state db
     *
     *@param portName (in)   MUX/port name
     *
@@ -526,15 +571,31 @@ private:
      * @param portName (in) port name 
      * @param unknownEventCount (in) count of missing icmp packets
      * @param expectedPacketCount (in) count of expected icmp packets 
+     * @param selfLossStats (in) loss statistics of recent self heartbeats
+     * @param peerLossStats (in) loss statistics of recent peer heartbeats
      * 
      * @return none
     */
     void handlePostPckLossRatio(
         const std::string portName,
         const uint64_t unknownEventCount, 
-        const uint64_t expectedPacketCount
+        const uint64_t expectedPacketCount,
+        const link_prober::HeartbeatLossWindowStats &selfLossStats,
+        const link_prober::HeartbeatLossWindowStats &peerLossStats
     );
 
+    /**
+     * @method handlePostProbeInterval
+     *
+     * @brief handle post current link prober probing interval
+     *
+     * @param portName (in) port name
+     * @param probeInterval_msec (in) current probing interval in msec
+     *
+     * @return none
+    */
+    void handlePostProbeInterval(const std::string portName, const uint32_t probeInterval_msec);
+
     /**
      * @method handleSetMuxMode
      * 
@@ -990,6 +1051,104 @@ private:
      */
     void extractIfnameAndSessionType(const std::string &key, std::string &ifname, std::string &sessionType);
 
+    /**
+     * @method scheduleStateDbFlush
+     * 
+     * @brief account a write queued on STATE_DB pipeline and arm flush timer if it is not running,
+     *        pipeline is also flushed when MUX_DB_PIPELINE_SIZE commands are queued
+     * 
+     * @return none
+     */
+    void scheduleStateDbFlush();
+
+    /**
+     * @method handleStateDbFlushTimeout
+     * 
+     * @brief handle expiry of STATE_DB pipeline flush timer
+     * 
+     * @param errorCode (in) timer error code
+     * 
+     * @return none
+     */
+    void handleStateDbFlushTimeout(const boost::system::error_code &errorCode);
+
+    /**
+     * @method flushStateDb
+     * 
+     * @brief send writes queued on STATE_DB pipeline in one round trip
+     * 
+     * @return none
+     */
+    void flushStateDb();
+
+    /**
+     * @method storeMetricsSlot
+     * 
+     * @brief overwrite latest value slot of a port and schedule metrics flush
+     * 
+     * @param portName (in) port name
+     * @param slot (in) slot to overwrite
+     * @param values (in) latest values
+     * 
+     * @return false if slot table is full and update has to be posted to strand
+     */
+    bool storeMetricsSlot(const std::string &portName, MetricsSlot slot, const MetricsSlotValues &values);
+
+    /**
+     * @method startMetricsFlushTimer
+     * 
+     * @brief arm metrics flush timer with configured interval
+     * 
+     * @return none
+     */
+    void startMetricsFlushTimer();
+
+    /**
+     * @method handleMetricsFlushTimeout
+     * 
+     * @brief write dirty latest value slots of all ports to STATE_DB
+     * 
+     * @param errorCode (in) timer error code
+     * 
+     * @return none
+     */
+    void handleMetricsFlushTimeout(const boost::system::error_code &errorCode);
+
+    /**
+     * @method handleMetricsSlot
+     * 
+     * @brief write latest values of a slot to STATE_DB
+     * 
+     * @param portName (in) port name
+     * @param slot (in) collected slot
+     * @param values (in) latest values
+     * 
+     * @return none
+     */
+    void handleMetricsSlot(const std::string &portName, MetricsSlot slot, const MetricsSlotValues &values);
+
+    /**
+     * @method seedDbShadowCache
+     * 
+     * @brief seed shadow cache with DB content of tables linkmgrd writes
+     * 
+     * @return none
+     */
+    void seedDbShadowCache();
+
+    /**
+     * @method shadowMuxStateWrite
+     * 
+     * @brief record APP DB mux state write in shadow cache
+     * 
+     * @param portName (in) port name
+     * @param state (in) mux state to write
+     * @param forceSwitch (in) forced switch, e.g. correcting hardware drift, is never redundant
+     * 
+     * @return false if write is redundant and is answered from STATE DB instead
+     */
+    bool shadowMuxStateWrite(const std::string &portName, const std::string &state, bool forceSwitch);
+
 private:
     static std::vector<std::string> mMuxState;
     static std::vector<std::string> mMuxLinkmgrState;
@@ -1032,6 +1191,27 @@ private:
     boost::barrier mBarrier;
 
     boost::asio::io_service::strand mStrand;
+    // DB commands posted to strand, measures queue depth and per command latency
+    DbCommandQueue mDbCommandQueue;
+
+    // STATE_DB linkmgr state, metrics, link probe stats and switch cause writes share one pipeline,
+    // commands of all four tables are sent in queue order so updates to a key are never reordered
+    std::shared_ptr<swss::RedisPipeline> mStateDbPipelinePtr;
+    boost::asio::deadline_timer mStateDbFlushTimer;
+    bool mStateDbFlushScheduled = false;
+    uint64_t mStateDbWriteCount = 0;
+    uint64_t mStateDbFlushCount = 0;
+
+    // pck loss ratio, link prober metrics, probe interval and linkmgr state keep only the latest value,
+    // switch cause and mux metrics sequences go through the ordered strand path
+    MetricsSlotTable mMetricsSlotTable;
+    boost::asio::deadline_timer mMetricsFlushTimer;
+    std::atomic<bool> mMetricsFlushScheduled {false};
+    std::atomic<uint32_t> mMetricsFlushInterval_msec {MUX_METRICS_FLUSH_INTERVAL_MSEC};
+
+    // last known values of mux state, peer mux state, linkmgr state and mux mode entries,
+    // writes that would not change them are skipped
+    DbShadowCache mDbShadowCache;
 
     ServerIpPortMap mServerIpPortMap;
 };
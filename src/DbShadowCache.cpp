@@ -0,0 +1,211 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * DbShadowCache.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "common/MuxLogger.h"
+#include "DbShadowCache.h"
+
+namespace mux
+{
+
+//
+// ---> seed(const std::string &table, const std::string &key, const std::string &field, const std::string &value);
+//
+// record value stored in DB without accounting a write
+//
+void DbShadowCache::seed(const std::string &table, const std::string &key, const std::string &field, const std::string &value)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mTables[table].entries[key][field] = value;
+}
+
+//
+// ---> erase(const std::string &table, const std::string &key);
+//
+// forget all fields of a table entry
+//
+void DbShadowCache::erase(const std::string &table, const std::string &key)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto iter = mTables.find(table);
+    if (iter != mTables.end()) {
+        iter->second.entries.erase(key);
+    }
+}
+
+//
+// ---> isStored(const std::string &table, const std::string &key, const std::string &field, const std::string &value);
+//
+// check if value is known to be stored in DB
+//
+bool DbShadowCache::isStored(const std::string &table, const std::string &key, const std::string &field, const std::string &value)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto tableIter = mTables.find(table);
+    if (tableIter == mTables.end()) {
+        return false;
+    }
+    auto entryIter = tableIter->second.entries.find(key);
+    if (entryIter == tableIter->second.entries.end()) {
+        return false;
+    }
+    auto fieldIter = entryIter->second.find(field);
+
+    return fieldIter != entryIter->second.end() && fieldIter->second == value;
+}
+
+//
+// ---> read(const std::string &table, const std::string &key, const std::string &field, std::string &value);
+//
+// read cached value of a field in place of a DB round trip
+//
+bool DbShadowCache::read(const std::string &table, const std::string &key, const std::string &field, std::string &value)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    TableShadow &tableShadow = mTables[table];
+    auto entryIter = tableShadow.entries.find(key);
+    if (entryIter != tableShadow.entries.end()) {
+        auto fieldIter = entryIter->second.find(field);
+        if (fieldIter != entryIter->second.end()) {
+            tableShadow.readHitCount++;
+            value = fieldIter->second;
+            return true;
+        }
+    }
+    tableShadow.readMissCount++;
+
+    return false;
+}
+
+//
+// ---> write(
+//          const std::string &table,
+//          const std::string &key,
+//          const std::string &field,
+//          const std::string &value,
+//          bool suppressible
+//      );
+//
+// account a write of value to DB and record it as stored value
+//
+bool DbShadowCache::write(
+    const std::string &table,
+    const std::string &key,
+    const std::string &field,
+    const std::string &value,
+    bool suppressible
+)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    TableShadow &tableShadow = mTables[table];
+    FieldValues &fieldValues = tableShadow.entries[key];
+    auto iter = fieldValues.find(field);
+    if (suppressible && iter != fieldValues.end() && iter->second == value) {
+        tableShadow.suppressedWriteCount++;
+        return false;
+    }
+
+    fieldValues[field] = value;
+    tableShadow.writeCount++;
+
+    return true;
+}
+
+//
+// ---> getWriteCount(const std::string &table);
+//
+// getter for number of writes of a table that reached DB
+//
+uint64_t DbShadowCache::getWriteCount(const std::string &table)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto iter = mTables.find(table);
+    return iter == mTables.end() ? 0 : iter->second.writeCount;
+}
+
+//
+// ---> getSuppressedWriteCount(const std::string &table);
+//
+// getter for number of redundant writes of a table that were skipped
+//
+uint64_t DbShadowCache::getSuppressedWriteCount(const std::string &table)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto iter = mTables.find(table);
+    return iter == mTables.end() ? 0 : iter->second.suppressedWriteCount;
+}
+
+//
+// ---> getReadHitCount(const std::string &table);
+//
+// getter for number of reads of a table answered from cache
+//
+uint64_t DbShadowCache::getReadHitCount(const std::string &table)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto iter = mTables.find(table);
+    return iter == mTables.end() ? 0 : iter->second.readHitCount;
+}
+
+//
+// ---> getReadMissCount(const std::string &table);
+//
+// getter for number of reads of a table that had to go to DB
+//
+uint64_t DbShadowCache::getReadMissCount(const std::string &table)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto iter = mTables.find(table);
+    return iter == mTables.end() ? 0 : iter->second.readMissCount;
+}
+
+//
+// ---> dumpStats();
+//
+// log write, suppressed write and read counts of every table
+//
+void DbShadowCache::dumpStats()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    for (const auto &entry: mTables) {
+        MUXLOGWARNING(boost::format("DB shadow cache %s: entries: %d, writes: %d, suppressed writes: %d, "
+            "read hits: %d, read misses: %d") %
+            entry.first %
+            entry.second.entries.size() %
+            entry.second.writeCount %
+            entry.second.suppressedWriteCount %
+            entry.second.readHitCount %
+            entry.second.readMissCount
+        );
+    }
+}
+
+} /* namespace mux */
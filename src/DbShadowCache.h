@@ -0,0 +1,225 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * DbShadowCache.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef DBSHADOWCACHE_H_
+#define DBSHADOWCACHE_H_
+
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+
+namespace test {
+class DbShadowCacheTest;
+}
+
+namespace mux
+{
+
+/**
+ *@class DbShadowCache
+ *
+ *@brief last known value of every table/key/field linkmgrd writes. The cache is seeded
+ *       from DB content at startup, updated by our own writes and by subscribed
+ *       notifications. It is used to skip writes that would not change the stored value
+ *       and to answer reads of subscribed tables without a DB round trip. Writes,
+ *       suppressed writes and read hits and misses are counted per table.
+ */
+class DbShadowCache
+{
+public:
+    /**
+    *@method DbShadowCache
+    *
+    *@brief class default constructor
+    */
+    DbShadowCache() = default;
+
+    /**
+    *@method DbShadowCache
+    *
+    *@brief class copy constructor
+    *
+    *@param DbShadowCache (in)  reference to DbShadowCache object to be copied
+    */
+    DbShadowCache(const DbShadowCache &) = delete;
+
+    /**
+    *@method ~DbShadowCache
+    *
+    *@brief class destructor
+    */
+    virtual ~DbShadowCache() = default;
+
+    /**
+    *@method seed
+    *
+    *@brief record value stored in DB without accounting a write
+    *
+    *@param table (in)  table name
+    *@param key (in)    key of table entry
+    *@param field (in)  field of table entry
+    *@param value (in)  value stored in DB
+    *
+    *@return none
+    */
+    void seed(const std::string &table, const std::string &key, const std::string &field, const std::string &value);
+
+    /**
+    *@method erase
+    *
+    *@brief forget all fields of a table entry, e.g. after entry is deleted
+    *
+    *@param table (in)  table name
+    *@param key (in)    key of table entry
+    *
+    *@return none
+    */
+    void erase(const std::string &table, const std::string &key);
+
+    /**
+    *@method isStored
+    *
+    *@brief check if value is known to be stored in DB
+    *
+    *@param table (in)  table name
+    *@param key (in)    key of table entry
+    *@param field (in)  field of table entry
+    *@param value (in)  value to look for
+    *
+    *@return true if cached value of the field equals value
+    */
+    bool isStored(const std::string &table, const std::string &key, const std::string &field, const std::string &value);
+
+    /**
+    *@method read
+    *
+    *@brief read cached value of a field in place of a DB round trip
+    *
+    *@param table (in)  table name
+    *@param key (in)    key of table entry
+    *@param field (in)  field of table entry
+    *@param value (out) cached value
+    *
+    *@return false on cache miss, value has to be read from DB
+    */
+    bool read(const std::string &table, const std::string &key, const std::string &field, std::string &value);
+
+    /**
+    *@method write
+    *
+    *@brief account a write of value to DB and record it as stored value
+    *
+    *@param table (in)          table name
+    *@param key (in)            key of table entry
+    *@param field (in)          field of table entry
+    *@param value (in)          value to be written
+    *@param suppressible (in)   false if write has to reach DB even if value is unchanged
+    *
+    *@return false if write is redundant and should be skipped
+    */
+    bool write(
+        const std::string &table,
+        const std::string &key,
+        const std::string &field,
+        const std::string &value,
+        bool suppressible = true
+    );
+
+    /**
+    *@method getWriteCount
+    *
+    *@brief getter for number of writes of a table that reached DB
+    *
+    *@param table (in)  table name
+    *
+    *@return write count
+    */
+    uint64_t getWriteCount(const std::string &table);
+
+    /**
+    *@method getSuppressedWriteCount
+    *
+    *@brief getter for number of redundant writes of a table that were skipped
+    *
+    *@param table (in)  table name
+    *
+    *@return suppressed write count
+    */
+    uint64_t getSuppressedWriteCount(const std::string &table);
+
+    /**
+    *@method getReadHitCount
+    *
+    *@brief getter for number of reads of a table answered from cache
+    *
+    *@param table (in)  table name
+    *
+    *@return read hit count
+    */
+    uint64_t getReadHitCount(const std::string &table);
+
+    /**
+    *@method getReadMissCount
+    *
+    *@brief getter for number of reads of a table that had to go to DB
+    *
+    *@param table (in)  table name
+    *
+    *@return read miss count
+    */
+    uint64_t getReadMissCount(const std::string &table);
+
+    /**
+    *@method dumpStats
+    *
+    *@brief log write, suppressed write and read counts of every table
+    *
+    *@return none
+    */
+    void dumpStats();
+
+private:
+    friend class test::DbShadowCacheTest;
+
+    using FieldValues = std::unordered_map<std::string, std::string>;
+
+    /**
+    *@struct TableShadow
+    *
+    *@brief cached entries and write counters of a table
+    */
+    struct TableShadow {
+        std::unordered_map<std::string, FieldValues> entries;
+        uint64_t writeCount = 0;
+        uint64_t suppressedWriteCount = 0;
+        uint64_t readHitCount = 0;
+        uint64_t readMissCount = 0;
+    };
+
+    std::mutex mMutex;
+    std::unordered_map<std::string, TableShadow> mTables;
+};
+
+} /* namespace mux */
+
+#endif /* DBSHADOWCACHE_H_ */
@@ -71,6 +71,12 @@ int main(int argc, const char* argv[])
     bool measureSwitchover = false;
     bool defaultRoute = false;
     bool linkToSwssLogger = false;
+    bool packetRxRing = false;
+    bool packetTxBatch = false;
+    bool timerWheel = false;
+    bool probePhaseSpread = false;
+    uint32_t packetRxFanout = 0;
+    std::string packetRxFanoutMode;
 
     program_options::options_description description("linkmgrd options");
     description.add_options()
@@ -95,6 +101,30 @@ int main(int argc, const char* argv[])
          "Link to swss logger instead of using native boost syslog support, this will"
          "set the boost logging level to TRACE and option verbosity is ignored"
          )
+        ("packet_rx_ring,r",
+         program_options::bool_switch(&packetRxRing)->default_value(false),
+         "Receive heartbeat replies of all ports through a shared memory-mapped RX ring"
+         )
+        ("packet_tx_batch,b",
+         program_options::bool_switch(&packetTxBatch)->default_value(false),
+         "Send heartbeats of all ports in batches with a single system call per tick"
+         )
+        ("timer_wheel,w",
+         program_options::bool_switch(&timerWheel)->default_value(false),
+         "Schedule link prober and link manager timers of all ports on a shared timing wheel"
+         )
+        ("probe_phase_spread,s",
+         program_options::bool_switch(&probePhaseSpread)->default_value(false),
+         "Spread heartbeats of ports across the probing interval instead of sending them in lockstep"
+         )
+        ("packet_rx_fanout,f",
+         program_options::value<uint32_t>(&packetRxFanout)->value_name("<workers>")->default_value(0),
+         "Spread heartbeat replies across worker threads with a PACKET_FANOUT group, each worker owns a fixed set of ports"
+         )
+        ("packet_rx_fanout_mode",
+         program_options::value<std::string>(&packetRxFanoutMode)->value_name("<mode>")->default_value("ifindex"),
+         "PACKET_FANOUT mode: ifindex steers frames to the worker owning their port, hash and cpu forward frames landing on other workers"
+         )
     ;
 
     //
@@ -136,7 +166,9 @@ int main(int argc, const char* argv[])
         }
 
         std::shared_ptr<mux::MuxManager> muxManagerPtr = std::make_shared<mux::MuxManager> ();
-        muxManagerPtr->initialize(measureSwitchover, defaultRoute);
+        muxManagerPtr->initialize(
+            measureSwitchover, defaultRoute, packetRxRing, packetTxBatch, timerWheel, probePhaseSpread, packetRxFanout, packetRxFanoutMode
+        );
         muxManagerPtr->run();
         muxManagerPtr->deinitialize();
     }
@@ -0,0 +1,145 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * MetricsSlotTable.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <functional>
+
+#include "MetricsSlotTable.h"
+
+namespace mux
+{
+
+//
+// ---> MetricsSlotTable();
+//
+// class default constructor
+//
+MetricsSlotTable::MetricsSlotTable() :
+    mEntries(new PortEntry[MUX_METRICS_SLOT_PORT_COUNT])
+{
+}
+
+//
+// ---> store(const std::string &portName, MetricsSlot slot, const MetricsSlotValues &values);
+//
+// overwrite slot of a port with latest values and mark it dirty
+//
+bool MetricsSlotTable::store(const std::string &portName, MetricsSlot slot, const MetricsSlotValues &values)
+{
+    PortEntry *entryPtr = findOrClaimEntry(portName);
+    if (entryPtr == nullptr) {
+        return false;
+    }
+
+    // producers of the same slot take turns, the flusher never waits on them
+    Slot &portSlot = entryPtr->slots[static_cast<size_t> (slot)];
+    uint32_t sequence = portSlot.sequence.load(std::memory_order_relaxed);
+    while ((sequence & 1) ||
+           !portSlot.sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_relaxed)) {
+        sequence = portSlot.sequence.load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i < values.size(); i++) {
+        portSlot.values[i].store(values[i], std::memory_order_relaxed);
+    }
+    portSlot.sequence.store(sequence + 2, std::memory_order_release);
+
+    entryPtr->dirtyMask.fetch_or(1U << static_cast<uint32_t> (slot), std::memory_order_release);
+    mStoreCount.fetch_add(1, std::memory_order_relaxed);
+
+    return true;
+}
+
+//
+// ---> collect(const CollectHandler &handler);
+//
+// call handler with latest values of every dirty slot and clear its dirty bit
+//
+size_t MetricsSlotTable::collect(const CollectHandler &handler)
+{
+    size_t count = 0;
+    for (size_t index = 0; index < MUX_METRICS_SLOT_PORT_COUNT; index++) {
+        PortEntry &entry = mEntries[index];
+        if (entry.state.load(std::memory_order_acquire) != EntryState::Ready) {
+            continue;
+        }
+
+        // a slot stored again after this point is dirty again and picked up by next collect
+        uint32_t dirtyMask = entry.dirtyMask.exchange(0, std::memory_order_acquire);
+        for (uint32_t slot = 0; dirtyMask != 0; slot++, dirtyMask >>= 1) {
+            if ((dirtyMask & 1) == 0) {
+                continue;
+            }
+
+            Slot &portSlot = entry.slots[slot];
+            MetricsSlotValues values;
+            uint32_t sequence;
+            do {
+                sequence = portSlot.sequence.load(std::memory_order_acquire);
+                for (size_t i = 0; i < values.size(); i++) {
+                    values[i] = portSlot.values[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+            } while ((sequence & 1) || sequence != portSlot.sequence.load(std::memory_order_relaxed));
+
+            handler(entry.portName, static_cast<MetricsSlot> (slot), values);
+            count++;
+        }
+    }
+    mCollectCount.fetch_add(count, std::memory_order_relaxed);
+
+    return count;
+}
+
+//
+// ---> findOrClaimEntry(const std::string &portName);
+//
+// find entry of a port, claim the first empty entry of its probe sequence if none
+//
+MetricsSlotTable::PortEntry *MetricsSlotTable::findOrClaimEntry(const std::string &portName)
+{
+    size_t start = std::hash<std::string> {} (portName) % MUX_METRICS_SLOT_PORT_COUNT;
+    for (size_t probe = 0; probe < MUX_METRICS_SLOT_PORT_COUNT; probe++) {
+        PortEntry &entry = mEntries[(start + probe) % MUX_METRICS_SLOT_PORT_COUNT];
+
+        EntryState state = entry.state.load(std::memory_order_acquire);
+        if (state == EntryState::Empty) {
+            if (entry.state.compare_exchange_strong(state, EntryState::Claiming, std::memory_order_acquire)) {
+                entry.portName = portName;
+                entry.state.store(EntryState::Ready, std::memory_order_release);
+                return &entry;
+            }
+        }
+
+        // the same port claimed concurrently lands on this entry, wait for its name
+        while (state != EntryState::Ready) {
+            state = entry.state.load(std::memory_order_acquire);
+        }
+        if (entry.portName == portName) {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+} /* namespace mux */
@@ -0,0 +1,188 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * MetricsSlotTable.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef METRICSSLOTTABLE_H_
+#define METRICSSLOTTABLE_H_
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+#include <boost/function.hpp>
+
+namespace mux
+{
+#define MUX_METRICS_SLOT_PORT_COUNT         512
+#define MUX_METRICS_SLOT_VALUE_COUNT        8
+#define MUX_METRICS_FLUSH_INTERVAL_MSEC     100
+
+/**
+ *@enum MetricsSlot
+ *
+ *@brief STATE_DB updates of a port where only the latest value matters
+ */
+enum class MetricsSlot: uint8_t {
+    PckLossRatio,
+    LinkProberMetrics,
+    ProbeInterval,
+    MuxLinkmgrState,
+
+    Count
+};
+
+using MetricsSlotValues = std::array<uint64_t, MUX_METRICS_SLOT_VALUE_COUNT>;
+
+/**
+ *@class MetricsSlotTable
+ *
+ *@brief latest value slots of every port, producers overwrite a slot without taking a lock
+ *       and mark it dirty, the flusher collects a consistent copy of dirty slots only. Each
+ *       slot is a sequence lock, port entries are claimed once with open addressing and
+ *       never removed.
+ */
+class MetricsSlotTable
+{
+public:
+    using CollectHandler = boost::function<void (const std::string &portName, MetricsSlot slot, const MetricsSlotValues &values)>;
+
+    /**
+    *@method MetricsSlotTable
+    *
+    *@brief class default constructor
+    */
+    MetricsSlotTable();
+
+    /**
+    *@method MetricsSlotTable
+    *
+    *@brief class copy constructor
+    *
+    *@param MetricsSlotTable (in)  reference to MetricsSlotTable object to be copied
+    */
+    MetricsSlotTable(const MetricsSlotTable &) = delete;
+
+    /**
+    *@method ~MetricsSlotTable
+    *
+    *@brief class destructor
+    */
+    virtual ~MetricsSlotTable() = default;
+
+    /**
+    *@method store
+    *
+    *@brief overwrite slot of a port with latest values and mark it dirty
+    *
+    *@param portName (in)   port name
+    *@param slot (in)       slot to overwrite
+    *@param values (in)     latest values
+    *
+    *@return false if no port entry is left for a new port
+    */
+    bool store(const std::string &portName, MetricsSlot slot, const MetricsSlotValues &values);
+
+    /**
+    *@method collect
+    *
+    *@brief call handler with latest values of every dirty slot and clear its dirty bit
+    *
+    *@param handler (in)    handler called for each dirty slot
+    *
+    *@return number of collected slots
+    */
+    size_t collect(const CollectHandler &handler);
+
+    /**
+    *@method getStoreCount
+    *
+    *@brief getter for number of slot updates stored by producers
+    *
+    *@return store count
+    */
+    inline uint64_t getStoreCount() const {return mStoreCount.load(std::memory_order_relaxed);};
+
+    /**
+    *@method getCollectCount
+    *
+    *@brief getter for number of slot updates handed to the flusher
+    *
+    *@return collect count
+    */
+    inline uint64_t getCollectCount() const {return mCollectCount.load(std::memory_order_relaxed);};
+
+private:
+    /**
+    *@struct Slot
+    *
+    *@brief latest values guarded by a sequence lock, sequence is odd while a producer writes
+    */
+    struct Slot {
+        std::atomic<uint32_t> sequence {0};
+        std::array<std::atomic<uint64_t>, MUX_METRICS_SLOT_VALUE_COUNT> values {};
+    };
+
+    /**
+    *@enum EntryState
+    *
+    *@brief port entry life cycle, port name is written only while claiming
+    */
+    enum class EntryState: uint8_t {
+        Empty,
+        Claiming,
+        Ready
+    };
+
+    /**
+    *@struct PortEntry
+    *
+    *@brief slots of a port
+    */
+    struct PortEntry {
+        std::atomic<EntryState> state {EntryState::Empty};
+        std::string portName;
+        std::atomic<uint32_t> dirtyMask {0};
+        std::array<Slot, static_cast<size_t> (MetricsSlot::Count)> slots;
+    };
+
+    /**
+    *@method findOrClaimEntry
+    *
+    *@brief find entry of a port, claim the first empty entry of its probe sequence if none
+    *
+    *@param portName (in)   port name
+    *
+    *@return pointer to port entry, nullptr if table is full
+    */
+    PortEntry *findOrClaimEntry(const std::string &portName);
+
+    std::unique_ptr<PortEntry[]> mEntries;
+
+    std::atomic<uint64_t> mStoreCount {0};
+    std::atomic<uint64_t> mCollectCount {0};
+};
+
+} /* namespace mux */
+
+#endif /* METRICSSLOTTABLE_H_ */
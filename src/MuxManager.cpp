@@ -30,7 +30,13 @@
 
 #include "common/MuxException.h"
 #include "common/MuxLogger.h"
+#include "common/TimerWheel.h"
 #include "MuxManager.h"
+#include "link_prober/LinkProberBudget.h"
+#include "link_prober/LinkProberBusyPoll.h"
+#include "link_prober/LinkProberRxFanout.h"
+#include "link_prober/LinkProberRxRing.h"
+#include "link_prober/LinkProberTxBatcher.h"
 
 namespace mux
 {
@@ -45,7 +51,8 @@ MuxManager::MuxManager() :
     mSignalSet(boost::asio::signal_set(mIoService, SIGINT, SIGTERM)),
     mStrand(mIoService),
     mReconciliationTimer(mIoService),
-    mDbInterfacePtr(std::make_shared<mux::DbInterface> (this, &mIoService))
+    mDbWorkPtr(std::make_shared<boost::asio::io_service::work> (mDbIoService)),
+    mDbInterfacePtr(std::make_shared<mux::DbInterface> (this, &mDbIoService))
 {
     mSignalSet.add(SIGUSR1);
     mSignalSet.add(SIGUSR2);
@@ -101,7 +108,7 @@ void MuxManager::setTimeoutIpv6_msec(uint32_t timeout_msec)
 //
 // initialize MuxManager class and creates DbInterface instance that reads/listen from/to Redis db
 //
-void MuxManager::initialize(bool enable_feature_measurement, bool enable_feature_default_route)
+void MuxManager::initialize(bool enable_feature_measurement, bool enable_feature_default_route, bool enable_packet_rx_ring, bool enable_packet_tx_batch, bool enable_timer_wheel, bool enable_probe_phase_spread, uint32_t packet_rx_fanout_workers, const std::string &packet_rx_fanout_mode)
 {
     for (uint8_t i = 0; (mMuxConfig.getNumberOfThreads() > 2) &&
                         (i < mMuxConfig.getNumberOfThreads() - 2); i++) {
@@ -110,6 +117,48 @@ void MuxManager::initialize(bool enable_feature_measurement, bool enable_feature
         );
     }
 
+    if (enable_packet_rx_ring) {
+        try {
+            link_prober::LinkProberRxRing::getInstance()->initialize(mIoService);
+        }
+        catch (const common::SocketErrorException &ex) {
+            MUXLOGWARNING(boost::format("Shared RX ring is not available, falling back to per port sockets: %s") % ex.what());
+        }
+    }
+
+    link_prober::LinkProberRxFanout::Mode fanoutMode = link_prober::LinkProberRxFanout::Mode::IfIndex;
+    if (packet_rx_fanout_workers > 0 && !link_prober::LinkProberRxFanout::parseMode(packet_rx_fanout_mode, fanoutMode)) {
+        MUXLOGWARNING(boost::format("Unknown RX fanout mode '%s', falling back to per port sockets") % packet_rx_fanout_mode);
+    } else if (packet_rx_fanout_workers > 0) {
+        try {
+            link_prober::LinkProberRxFanout::getInstance()->initialize(packet_rx_fanout_workers, fanoutMode);
+        }
+        catch (const common::SocketErrorException &ex) {
+            MUXLOGWARNING(boost::format("RX fanout is not available, falling back to per port sockets: %s") % ex.what());
+        }
+    }
+
+    if (enable_packet_tx_batch) {
+        try {
+            link_prober::LinkProberTxBatcher::getInstance()->initialize(mIoService);
+        }
+        catch (const common::SocketErrorException &ex) {
+            MUXLOGWARNING(boost::format("TX batching is not available, falling back to per port sends: %s") % ex.what());
+        }
+    }
+
+    if (enable_timer_wheel) {
+        try {
+            common::TimerWheel::getInstance()->initialize(mIoService);
+        }
+        catch (const common::SocketErrorException &ex) {
+            MUXLOGWARNING(boost::format("Timer wheel is not available, falling back to per port timers: %s") % ex.what());
+        }
+    }
+
+    mDbThreadPtr = std::make_shared<boost::thread> (
+        boost::bind(&boost::asio::io_service::run, &mDbIoService)
+    );
     mDbInterfacePtr->initialize();
 
     if (mDbInterfacePtr->isWarmStart()) {
@@ -119,6 +168,7 @@ void MuxManager::initialize(bool enable_feature_measurement, bool enable_feature
 
     mMuxConfig.enableSwitchoverMeasurement(enable_feature_measurement);
     mMuxConfig.enableDefaultRouteFeature(enable_feature_default_route);
+    mMuxConfig.enableProbePhaseSpread(enable_probe_phase_spread);
 }
 
 //
@@ -129,6 +179,18 @@ void MuxManager::initialize(bool enable_feature_measurement, bool enable_feature
 void MuxManager::deinitialize()
 {
     mDbInterfacePtr->deinitialize();
+
+    // DB I/O thread exits once DB commands still queued, including the final STATE_DB flush, are done
+    mDbWorkPtr.reset();
+    if (mDbThreadPtr) {
+        mDbThreadPtr->join();
+    }
+
+    link_prober::LinkProberRxRing::getInstance()->deinitialize();
+    link_prober::LinkProberTxBatcher::getInstance()->deinitialize();
+    link_prober::LinkProberBusyPoll::getInstance()->deinitialize();
+    link_prober::LinkProberRxFanout::getInstance()->deinitialize();
+    common::TimerWheel::getInstance()->deinitialize();
 }
 
 //
@@ -313,6 +375,88 @@ void MuxManager::resetPckLossCount(const std::string &portName)
     }
 }
 
+//
+// ---> setMaxProbeRate(uint32_t maxProbeRate);
+//
+// setter for heartbeats per second all link probers of the ToR may send
+//
+void MuxManager::setMaxProbeRate(uint32_t maxProbeRate)
+{
+    mMuxConfig.setMaxProbeRate(maxProbeRate);
+    link_prober::LinkProberBudget::getInstance()->setMaxProbeRate(maxProbeRate);
+}
+
+//
+// ---> setMetricsFlushInterval_msec(uint32_t interval_msec);
+//
+// setter for interval at which latest STATE_DB metrics of all ports are written
+//
+void MuxManager::setMetricsFlushInterval_msec(uint32_t interval_msec)
+{
+    mMuxConfig.setMetricsFlushInterval_msec(interval_msec);
+    mDbInterfacePtr->setMetricsFlushInterval_msec(interval_msec);
+}
+
+//
+// ---> setMinProbeInterval_msec(const std::string &portName, uint32_t interval_msec);
+//
+// setter for fastest heartbeat interval granted to port by heartbeat budget
+//
+void MuxManager::setMinProbeInterval_msec(const std::string &portName, uint32_t interval_msec)
+{
+    MUXLOGINFO(boost::format("%s: min probe interval: %d msec") % portName % interval_msec);
+
+    PortMapIterator portMapIterator = mPortMap.find(portName);
+    if (portMapIterator != mPortMap.end()) {
+        portMapIterator->second->setMinProbeInterval_msec(interval_msec);
+    }
+}
+
+//
+// ---> setMaxProbeInterval_msec(const std::string &portName, uint32_t interval_msec);
+//
+// setter for slowest heartbeat interval heartbeat budget may throttle port to
+//
+void MuxManager::setMaxProbeInterval_msec(const std::string &portName, uint32_t interval_msec)
+{
+    MUXLOGINFO(boost::format("%s: max probe interval: %d msec") % portName % interval_msec);
+
+    PortMapIterator portMapIterator = mPortMap.find(portName);
+    if (portMapIterator != mPortMap.end()) {
+        portMapIterator->second->setMaxProbeInterval_msec(interval_msec);
+    }
+}
+
+//
+// ---> setProbePriority(const std::string &portName, uint32_t priority);
+//
+// setter for weight of port in sharing heartbeat budget
+//
+void MuxManager::setProbePriority(const std::string &portName, uint32_t priority)
+{
+    MUXLOGINFO(boost::format("%s: probe priority: %d") % portName % priority);
+
+    PortMapIterator portMapIterator = mPortMap.find(portName);
+    if (portMapIterator != mPortMap.end()) {
+        portMapIterator->second->setProbePriority(priority);
+    }
+}
+
+//
+// ---> setLowLatencyRx(const std::string &portName, bool enable);
+//
+// setter for receiving heartbeat replies of port on the busy poll thread
+//
+void MuxManager::setLowLatencyRx(const std::string &portName, bool enable)
+{
+    MUXLOGINFO(boost::format("%s: low latency receive: %d") % portName % enable);
+
+    PortMapIterator portMapIterator = mPortMap.find(portName);
+    if (portMapIterator != mPortMap.end()) {
+        portMapIterator->second->setLowLatencyRx(enable);
+    }
+}
+
 //
 // ---> addOrUpdateMuxPortLinkState(const std::string &portName, const std::string &linkState);
 //
@@ -535,6 +679,24 @@ void MuxManager::handleSignal(const boost::system::error_code errorCode, int sig
         mSignalSet.clear();
         handleProcessTerminate();
     } else {
+        if (signalNumber == SIGUSR1) {
+            // on demand dump of heartbeat RTT, timer burst histograms, heartbeat budget, RX fanout workers and DB commands,
+            // they are safe to read outside strands
+            for (auto &port: mPortMap) {
+                port.second->dumpHeartbeatRtt();
+            }
+            if (common::TimerWheel::getInstance()->isEnabled()) {
+                common::TimerWheel::getInstance()->dumpBurstStats();
+            }
+            if (mMuxConfig.getMaxProbeRate() != 0) {
+                link_prober::LinkProberBudget::getInstance()->dumpStats();
+            }
+            if (link_prober::LinkProberRxFanout::getInstance()->isEnabled()) {
+                link_prober::LinkProberRxFanout::getInstance()->dumpStats();
+            }
+            mDbInterfacePtr->dumpStats();
+        }
+
         mSignalSet.async_wait(boost::bind(&MuxManager::handleSignal,
             this,
             boost::asio::placeholders::error,
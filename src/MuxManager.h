@@ -123,6 +123,62 @@ public:
     */
     void setTimeoutIpv6_msec(uint32_t timeout_msec);
 
+    /**
+    *@method setDetectionTimeoutIpv4_msec
+    *
+    *@brief setter for IPv4 heartbeat reply detection timeout in msec
+    *
+    *@param timeout_msec (in)  timeout in msec
+    *
+    *@return none
+    */
+    inline void setDetectionTimeoutIpv4_msec(uint32_t timeout_msec) {mMuxConfig.setDetectionTimeoutIpv4_msec(timeout_msec);};
+
+    /**
+    *@method setMaxTimeoutIpv4_msec
+    *
+    *@brief setter for upper bound of adaptive IPv4 probing interval in msec
+    *
+    *@param timeout_msec (in)  timeout in msec
+    *
+    *@return none
+    */
+    inline void setMaxTimeoutIpv4_msec(uint32_t timeout_msec) {mMuxConfig.setMaxTimeoutIpv4_msec(timeout_msec);};
+
+    /**
+    *@method setStableHeartbeatCount
+    *
+    *@brief setter for number of consecutive heartbeats received before probing interval is relaxed
+    *
+    *@param count (in)  heartbeat count
+    *
+    *@return none
+    */
+    inline void setStableHeartbeatCount(uint32_t count) {mMuxConfig.setStableHeartbeatCount(count);};
+
+    /**
+    *@method setMaxProbeRate
+    *
+    *@brief setter for heartbeats per second all link probers of the ToR may send, ports watched
+    *       by the peer ToR are not throttled below the rate the peer tolerates
+    *
+    *@param maxProbeRate (in)  heartbeats per second, 0 does not limit link probers
+    *
+    *@return none
+    */
+    void setMaxProbeRate(uint32_t maxProbeRate);
+
+    /**
+    *@method setMetricsFlushInterval_msec
+    *
+    *@brief setter for interval at which latest STATE_DB metrics of all ports are written
+    *
+    *@param interval_msec (in)  flush interval in msec
+    *
+    *@return none
+    */
+    void setMetricsFlushInterval_msec(uint32_t interval_msec);
+
     /**
     *@method setOscillationEnabled
     *
@@ -296,10 +352,16 @@ public:
     *
     * @param enable_feature_measurement (in) whether the feature that decreases link prober interval is enabled or not 
     * @param enable_feature_default_route (in) whether the feature that shutdowns link prober & avoid switching active when defaul route is missing, is enable or not
+    * @param enable_packet_rx_ring (in) whether link probers receive heartbeat replies through a shared memory-mapped RX ring
+    * @param enable_packet_tx_batch (in) whether link probers send heartbeats of all ports in sendmmsg batches
+    * @param enable_timer_wheel (in) whether port timers are scheduled on the shared timing wheel
+    * @param enable_probe_phase_spread (in) whether heartbeat phases of ports are spread across the probing interval
+    * @param packet_rx_fanout_workers (in) number of worker threads heartbeat replies are spread across with PACKET_FANOUT, 0 disables fanout
+    * @param packet_rx_fanout_mode (in) fanout group mode, one of ifindex, hash or cpu
     * 
     * @return none
     */
-    void initialize(bool enable_feature_measurement, bool enable_feature_default_route);
+    void initialize(bool enable_feature_measurement, bool enable_feature_default_route, bool enable_packet_rx_ring = false, bool enable_packet_tx_batch = false, bool enable_timer_wheel = false, bool enable_probe_phase_spread = false, uint32_t packet_rx_fanout_workers = 0, const std::string &packet_rx_fanout_mode = "ifindex");
 
     /**
     *@method deinitialize
@@ -398,6 +460,54 @@ public:
     */
     void resetPckLossCount(const std::string &portName);
 
+    /**
+    *@method setMinProbeInterval_msec
+    *
+    *@brief setter for fastest heartbeat interval granted to port by heartbeat budget
+    *
+    *@param portName (in)       Mux port name
+    *@param interval_msec (in)  interval in msec
+    *
+    *@return none
+    */
+    void setMinProbeInterval_msec(const std::string &portName, uint32_t interval_msec);
+
+    /**
+    *@method setMaxProbeInterval_msec
+    *
+    *@brief setter for slowest heartbeat interval heartbeat budget may throttle port to
+    *
+    *@param portName (in)       Mux port name
+    *@param interval_msec (in)  interval in msec
+    *
+    *@return none
+    */
+    void setMaxProbeInterval_msec(const std::string &portName, uint32_t interval_msec);
+
+    /**
+    *@method setProbePriority
+    *
+    *@brief setter for weight of port in sharing heartbeat budget
+    *
+    *@param portName (in)   Mux port name
+    *@param priority (in)   port priority
+    *
+    *@return none
+    */
+    void setProbePriority(const std::string &portName, uint32_t priority);
+
+    /**
+    *@method setLowLatencyRx
+    *
+    *@brief setter for receiving heartbeat replies of port on the busy poll thread
+    *
+    *@param portName (in)   Mux port name
+    *@param enable (in)     true to busy poll port socket
+    *
+    *@return none
+    */
+    void setLowLatencyRx(const std::string &portName, bool enable);
+
     /**
     *@method addOrUpdateMuxPortLinkState
     *
@@ -653,6 +763,12 @@ private:
     boost::asio::deadline_timer mReconciliationTimer;
     uint16_t mPortReconciliationCount = 0;
 
+    // DbInterface strand runs on its own DB I/O thread so a slow Redis reply never
+    // parks a worker that link prober and state machine handlers need
+    boost::asio::io_service mDbIoService;
+    std::shared_ptr<boost::asio::io_service::work> mDbWorkPtr;
+    std::shared_ptr<boost::thread> mDbThreadPtr;
+
     std::shared_ptr<mux::DbInterface> mDbInterfacePtr;
 
     PortMap mPortMap;
@@ -30,7 +30,7 @@
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <stdlib.h>
-#include <netpacket/packet.h>
+#include <linux/if_packet.h>
 #include <boost/bind/bind.hpp>
 #include "MuxPort.h"
 #include "common/MuxException.h"
@@ -161,6 +161,7 @@ void MuxPort::handleLinkState(const std::string &linkState)
     if (linkState == "up") {
         label = link_state::LinkState::Label::Up;
     }
+    mMuxPortConfig.setLinkUp(label == link_state::LinkState::Label::Up);
 
     boost::asio::post(mStrand, boost::bind(
         &link_manager::LinkManagerStateMachineBase::handleSwssLinkStateNotification,
@@ -436,6 +437,19 @@ void MuxPort::resetPckLossCount()
     )));
 }
 
+//
+// ---> dumpHeartbeatRtt();
+//
+// log heartbeat RTT percentiles of this port
+//
+void MuxPort::dumpHeartbeatRtt()
+{
+    std::shared_ptr<link_prober::LinkProberBase> linkProberPtr = mLinkManagerStateMachinePtr->getLinkProberPtr();
+    if (linkProberPtr) {
+        linkProberPtr->dumpRttStats();
+    }
+}
+
 //
 // ---> probeMuxState()
 //
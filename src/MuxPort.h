@@ -105,11 +105,14 @@ public:
     *
     *@brief set MUX state in APP DB for orchagent processing
     *
-    *@param label (in)      label of target state
+    *@param label (in)          label of target state
+    *@param forceSwitch (in)    force switch mux state, write is never skipped as redundant
     *
     *@return none
     */
-    virtual inline void setMuxState(mux_state::MuxState::Label label) {mDbInterfacePtr->setMuxState(mMuxPortConfig.getPortName(), label);};
+    virtual inline void setMuxState(mux_state::MuxState::Label label, bool forceSwitch = false) {
+        mDbInterfacePtr->setMuxState(mMuxPortConfig.getPortName(), label, forceSwitch);
+    };
 
     /**
     *@method setPeerMuxState
@@ -209,11 +212,27 @@ public:
      * 
      * @param unknownEventCount (in) count of missing icmp packets
      * @param expectedPacketCount (in) count of expected icmp packets 
+     * @param selfLossStats (in) loss statistics of recent self heartbeats
+     * @param peerLossStats (in) loss statistics of recent peer heartbeats
      * 
      * @return none
     */
-    inline void postPckLossRatio(const uint64_t unknownEventCount, const uint64_t expectedPacketCount) {
-        mDbInterfacePtr->postPckLossRatio(mMuxPortConfig.getPortName(), unknownEventCount, expectedPacketCount);
+    inline void postPckLossRatio(const uint64_t unknownEventCount, const uint64_t expectedPacketCount,
+        const link_prober::HeartbeatLossWindowStats &selfLossStats, const link_prober::HeartbeatLossWindowStats &peerLossStats) {
+        mDbInterfacePtr->postPckLossRatio(mMuxPortConfig.getPortName(), unknownEventCount, expectedPacketCount, selfLossStats, peerLossStats);
+    };
+
+    /**
+     * @method postProbeInterval
+     *
+     * @brief post current link prober probing interval to state db
+     *
+     * @param probeInterval_msec (in) current probing interval in msec
+     *
+     * @return none
+    */
+    inline void postProbeInterval(const uint32_t probeInterval_msec) {
+        mDbInterfacePtr->postProbeInterval(mMuxPortConfig.getPortName(), probeInterval_msec);
     };
 
     /**
@@ -249,6 +268,51 @@ public:
     */
     inline void setWellKnownMacAddress(const std::array<uint8_t, ETHER_ADDR_LEN> &address) {mMuxPortConfig.setWellKnownMacAddress(address);};
 
+    /**
+    *@method setMinProbeInterval_msec
+    *
+    *@brief setter for fastest heartbeat interval granted to port by heartbeat budget
+    *
+    *@param interval_msec (in)  interval in msec
+    *
+    *@return none
+    */
+    inline void setMinProbeInterval_msec(uint32_t interval_msec) {mMuxPortConfig.setMinProbeInterval_msec(interval_msec);};
+
+    /**
+    *@method setMaxProbeInterval_msec
+    *
+    *@brief setter for slowest heartbeat interval heartbeat budget may throttle port to
+    *
+    *@param interval_msec (in)  interval in msec
+    *
+    *@return none
+    */
+    inline void setMaxProbeInterval_msec(uint32_t interval_msec) {mMuxPortConfig.setMaxProbeInterval_msec(interval_msec);};
+
+    /**
+    *@method setProbePriority
+    *
+    *@brief setter for weight of port in sharing heartbeat budget
+    *
+    *@param priority (in)   port priority
+    *
+    *@return none
+    */
+    inline void setProbePriority(uint32_t priority) {mMuxPortConfig.setProbePriority(priority);};
+
+    /**
+    *@method setLowLatencyRx
+    *
+    *@brief setter for receiving heartbeat replies on the busy poll thread, applied by
+    *       link prober at its next heartbeat
+    *
+    *@param enable (in)     true to busy poll port socket
+    *
+    *@return none
+    */
+    inline void setLowLatencyRx(bool enable) {mMuxPortConfig.setLowLatencyRx(enable);};
+
     /**
     *@method handleBladeIpv4AddressUpdate
     *
@@ -398,6 +462,15 @@ public:
     */
     void resetPckLossCount();
 
+    /**
+    * @method dumpHeartbeatRtt
+    * 
+    * @brief log heartbeat RTT percentiles of this port
+    * 
+    * @return none
+    */
+    void dumpHeartbeatRtt();
+
     /**
     * @method warmRestartReconciliation
     * 
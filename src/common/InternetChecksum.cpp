@@ -0,0 +1,292 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * InternetChecksum.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <algorithm>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MUX_CHECKSUM_X86
+#endif
+
+#include "InternetChecksum.h"
+
+namespace common
+{
+//
+// kernels sum native order words, ones' complement sum is byte order independent so
+// the folded result only needs swapping to host order of network words at the end
+//
+using ChecksumKernel = uint64_t (*) (const uint8_t *data, size_t size);
+
+//
+// ---> sumTail(const uint8_t *data, size_t size);
+//
+// sum bytes left over by vector kernels, odd trailing byte is padded with zero
+//
+static inline uint64_t sumTail(const uint8_t *data, size_t size)
+{
+    uint64_t sum = 0;
+
+    while (size >= sizeof(uint32_t)) {
+        uint32_t word;
+        memcpy(&word, data, sizeof(word));
+        sum += word;
+        data += sizeof(word);
+        size -= sizeof(word);
+    }
+    if (size >= sizeof(uint16_t)) {
+        uint16_t word;
+        memcpy(&word, data, sizeof(word));
+        sum += word;
+        data += sizeof(word);
+        size -= sizeof(word);
+    }
+    if (size) {
+        uint8_t word[sizeof(uint16_t)] = {*data, 0};
+        uint16_t value;
+        memcpy(&value, word, sizeof(value));
+        sum += value;
+    }
+
+    return sum;
+}
+
+//
+// ---> sumScalar(const uint8_t *data, size_t size);
+//
+// scalar kernel, 32-bit words are accumulated into 64 bits
+//
+static uint64_t sumScalar(const uint8_t *data, size_t size)
+{
+    // two independent accumulators of 32-bit halves of each 64-bit load
+    uint64_t sumLow = 0;
+    uint64_t sumHigh = 0;
+
+    while (size >= sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        sumLow += word & 0xffffffff;
+        sumHigh += word >> 32;
+        data += sizeof(word);
+        size -= sizeof(word);
+    }
+
+    return sumLow + sumHigh + sumTail(data, size);
+}
+
+#ifdef MUX_CHECKSUM_X86
+//
+// ---> sumSse2(const uint8_t *data, size_t size);
+//
+// SSE2 kernel, 16-bit words are zero extended and accumulated into 32-bit lanes
+//
+__attribute__((target("sse2")))
+static uint64_t sumSse2(const uint8_t *data, size_t size)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sum = zero;
+
+    while (size >= 2 * sizeof(__m128i)) {
+        // each 32-bit lane takes two words per iteration, flush before lanes may overflow
+        size_t iterations = std::min<size_t> (size / (2 * sizeof(__m128i)), 0x7fff);
+        __m128i accLow = zero;
+        __m128i accHigh = zero;
+        for (size_t i = 0; i < iterations; i++) {
+            __m128i block0 = _mm_loadu_si128(reinterpret_cast<const __m128i *> (data));
+            __m128i block1 = _mm_loadu_si128(reinterpret_cast<const __m128i *> (data) + 1);
+            accLow = _mm_add_epi32(accLow, _mm_add_epi32(_mm_unpacklo_epi16(block0, zero), _mm_unpacklo_epi16(block1, zero)));
+            accHigh = _mm_add_epi32(accHigh, _mm_add_epi32(_mm_unpackhi_epi16(block0, zero), _mm_unpackhi_epi16(block1, zero)));
+            data += 2 * sizeof(__m128i);
+        }
+        size -= iterations * 2 * sizeof(__m128i);
+
+        // widen lanes to 64 bits before they are combined
+        sum = _mm_add_epi64(sum, _mm_add_epi64(_mm_unpacklo_epi32(accLow, zero), _mm_unpackhi_epi32(accLow, zero)));
+        sum = _mm_add_epi64(sum, _mm_add_epi64(_mm_unpacklo_epi32(accHigh, zero), _mm_unpackhi_epi32(accHigh, zero)));
+    }
+
+    uint64_t lanes[sizeof(__m128i) / sizeof(uint64_t)];
+    _mm_storeu_si128(reinterpret_cast<__m128i *> (lanes), sum);
+
+    return lanes[0] + lanes[1] + sumTail(data, size);
+}
+
+//
+// ---> sumAvx2(const uint8_t *data, size_t size);
+//
+// AVX2 kernel, 16-bit words are zero extended and accumulated into 32-bit lanes
+//
+__attribute__((target("avx2")))
+static uint64_t sumAvx2(const uint8_t *data, size_t size)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i sum = zero;
+
+    while (size >= 2 * sizeof(__m256i)) {
+        size_t iterations = std::min<size_t> (size / (2 * sizeof(__m256i)), 0x7fff);
+        __m256i accLow = zero;
+        __m256i accHigh = zero;
+        for (size_t i = 0; i < iterations; i++) {
+            __m256i block0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *> (data));
+            __m256i block1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *> (data) + 1);
+            accLow = _mm256_add_epi32(accLow, _mm256_add_epi32(_mm256_unpacklo_epi16(block0, zero), _mm256_unpacklo_epi16(block1, zero)));
+            accHigh = _mm256_add_epi32(accHigh, _mm256_add_epi32(_mm256_unpackhi_epi16(block0, zero), _mm256_unpackhi_epi16(block1, zero)));
+            data += 2 * sizeof(__m256i);
+        }
+        size -= iterations * 2 * sizeof(__m256i);
+
+        sum = _mm256_add_epi64(sum, _mm256_add_epi64(_mm256_unpacklo_epi32(accLow, zero), _mm256_unpackhi_epi32(accLow, zero)));
+        sum = _mm256_add_epi64(sum, _mm256_add_epi64(_mm256_unpacklo_epi32(accHigh, zero), _mm256_unpackhi_epi32(accHigh, zero)));
+    }
+
+    // bytes short of a full iteration go through SSE2 kernel
+    uint64_t lanes[sizeof(__m256i) / sizeof(uint64_t)];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *> (lanes), sum);
+
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sumSse2(data, size);
+}
+#endif
+
+//
+// kernels indexed by InternetChecksum::Kernel, unsupported kernels fall back to scalar
+//
+static const ChecksumKernel Kernels[static_cast<size_t> (InternetChecksum::Kernel::Count)] = {
+    sumScalar,
+#ifdef MUX_CHECKSUM_X86
+    sumSse2,
+    sumAvx2,
+#else
+    sumScalar,
+    sumScalar,
+#endif
+};
+
+//
+// ---> selectKernel();
+//
+// pick fastest kernel supported by the CPU
+//
+static InternetChecksum::Kernel selectKernel()
+{
+    if (InternetChecksum::isSupported(InternetChecksum::Kernel::Avx2)) {
+        return InternetChecksum::Kernel::Avx2;
+    }
+    if (InternetChecksum::isSupported(InternetChecksum::Kernel::Sse2)) {
+        return InternetChecksum::Kernel::Sse2;
+    }
+
+    return InternetChecksum::Kernel::Scalar;
+}
+
+static const InternetChecksum::Kernel SelectedKernel = selectKernel();
+static const ChecksumKernel SelectedKernelFunc = Kernels[static_cast<size_t> (SelectedKernel)];
+
+//
+// ---> finish(uint64_t sum);
+//
+// fold native order sum to 16 bits in host order of network words
+//
+static inline uint32_t finish(uint64_t sum)
+{
+    sum = (sum >> 32) + (sum & 0xffffffff);
+    sum = (sum >> 32) + (sum & 0xffffffff);
+
+    return ntohs(InternetChecksum::fold(static_cast<uint32_t> (sum)));
+}
+
+//
+// ---> sum(const void *data, size_t size);
+//
+// ones' complement sum of buffer with selected kernel
+//
+uint32_t InternetChecksum::sum(const void *data, size_t size)
+{
+    // kernel may be used by static initializers of other translation units
+    ChecksumKernel kernel = SelectedKernelFunc ? SelectedKernelFunc : sumScalar;
+
+    return finish(kernel(reinterpret_cast<const uint8_t *> (data), size));
+}
+
+//
+// ---> sum(Kernel kernel, const void *data, size_t size);
+//
+// ones' complement sum of buffer with a given kernel
+//
+uint32_t InternetChecksum::sum(Kernel kernel, const void *data, size_t size)
+{
+    return finish(Kernels[static_cast<size_t> (kernel)](reinterpret_cast<const uint8_t *> (data), size));
+}
+
+//
+// ---> isSupported(Kernel kernel);
+//
+// check if kernel is supported by the CPU
+//
+bool InternetChecksum::isSupported(Kernel kernel)
+{
+    __builtin_cpu_init();
+
+    switch (kernel) {
+    case Kernel::Scalar:
+        return true;
+#ifdef MUX_CHECKSUM_X86
+    case Kernel::Sse2:
+        return __builtin_cpu_supports("sse2");
+    case Kernel::Avx2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+//
+// ---> getKernel();
+//
+// getter for kernel selected at startup
+//
+InternetChecksum::Kernel InternetChecksum::getKernel()
+{
+    return SelectedKernel;
+}
+
+//
+// ---> getKernelName(Kernel kernel);
+//
+// getter for kernel name
+//
+const char* InternetChecksum::getKernelName(Kernel kernel)
+{
+    switch (kernel) {
+    case Kernel::Scalar:
+        return "scalar";
+    case Kernel::Sse2:
+        return "sse2";
+    case Kernel::Avx2:
+        return "avx2";
+    default:
+        return "unknown";
+    }
+}
+
+} /* namespace common */
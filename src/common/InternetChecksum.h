@@ -0,0 +1,141 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * InternetChecksum.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef COMMON_INTERNETCHECKSUM_H_
+#define COMMON_INTERNETCHECKSUM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <arpa/inet.h>
+
+namespace common
+{
+
+/**
+ *@class InternetChecksum
+ *
+ *@brief RFC 1071 ones' complement sum of 16-bit words. Scalar, SSE2 and AVX2
+ *       kernels produce identical results, the fastest one supported by the CPU
+ *       is selected once at startup.
+ */
+class InternetChecksum
+{
+public:
+    /**
+    *@enum Kernel
+    *
+    *@brief checksum kernel implementations
+    */
+    enum class Kernel: uint8_t {
+        Scalar,
+        Sse2,
+        Avx2,
+
+        Count
+    };
+
+    /**
+    *@method sum
+    *
+    *@brief ones' complement sum of buffer with selected kernel
+    *
+    *@param data (in)   pointer to data buffer, no alignment is required
+    *@param size (in)   size of data buffer, odd trailing byte is padded with zero
+    *
+    *@return sum of network order 16-bit words in host order, folded to 16 bits
+    */
+    static uint32_t sum(const void *data, size_t size);
+
+    /**
+    *@method sum
+    *
+    *@brief ones' complement sum of buffer with a given kernel
+    *
+    *@param kernel (in) kernel to use, must be supported by the CPU
+    *@param data (in)   pointer to data buffer, no alignment is required
+    *@param size (in)   size of data buffer, odd trailing byte is padded with zero
+    *
+    *@return sum of network order 16-bit words in host order, folded to 16 bits
+    */
+    static uint32_t sum(Kernel kernel, const void *data, size_t size);
+
+    /**
+    *@method fold
+    *
+    *@brief fold carries of a 32-bit sum back into its low 16 bits
+    *
+    *@param sum (in)    sum of 16-bit words
+    *
+    *@return ones' complement sum in 16 bits
+    */
+    static inline uint16_t fold(uint32_t sum) {
+        sum = (sum >> 16) + (sum & 0xffff);
+        return (sum >> 16) + (sum & 0xffff);
+    };
+
+    /**
+    *@method finalize
+    *
+    *@brief fold sum and complement it into checksum field value
+    *
+    *@param sum (in)    sum of 16-bit words in host order
+    *
+    *@return checksum in network order
+    */
+    static inline uint16_t finalize(uint32_t sum) {return htons(~fold(sum));};
+
+    /**
+    *@method isSupported
+    *
+    *@brief check if kernel is supported by the CPU
+    *
+    *@param kernel (in) checksum kernel
+    *
+    *@return true if kernel may be used
+    */
+    static bool isSupported(Kernel kernel);
+
+    /**
+    *@method getKernel
+    *
+    *@brief getter for kernel selected at startup
+    *
+    *@return selected kernel
+    */
+    static Kernel getKernel();
+
+    /**
+    *@method getKernelName
+    *
+    *@brief getter for kernel name
+    *
+    *@param kernel (in) checksum kernel
+    *
+    *@return kernel name
+    */
+    static const char* getKernelName(Kernel kernel);
+};
+
+} /* namespace common */
+
+#endif /* COMMON_INTERNETCHECKSUM_H_ */
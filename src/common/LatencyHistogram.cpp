@@ -0,0 +1,139 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LatencyHistogram.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "LatencyHistogram.h"
+
+namespace common
+{
+
+constexpr size_t LatencyHistogram::SUB_BUCKET_COUNT;
+constexpr size_t LatencyHistogram::BUCKET_COUNT;
+
+//
+// ---> LatencyHistogram();
+//
+// class default constructor
+//
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+//
+// ---> record(uint64_t value);
+//
+// record a sample, values beyond histogram range land in the last bucket
+//
+void LatencyHistogram::record(uint64_t value)
+{
+    mBuckets[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    mCount.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t max = mMax.load(std::memory_order_relaxed);
+    while (value > max && !mMax.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+//
+// ---> reset();
+//
+// clear all recorded samples
+//
+void LatencyHistogram::reset()
+{
+    for (std::atomic<uint64_t> &bucket: mBuckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    mCount.store(0, std::memory_order_relaxed);
+    mMax.store(0, std::memory_order_relaxed);
+}
+
+//
+// ---> getPercentile(double percentile);
+//
+// getter for sample value at given percentile
+//
+uint64_t LatencyHistogram::getPercentile(double percentile) const
+{
+    uint64_t count = getCount();
+    if (count == 0) {
+        return 0;
+    }
+
+    uint64_t rank = static_cast<uint64_t> (std::ceil(percentile * count / 100.0));
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    // buckets are read one by one while the writer may still be recording, stop at the last bucket
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += mBuckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(getBucketUpperBound(i), getMax());
+        }
+    }
+
+    return getMax();
+}
+
+//
+// ---> getBucketIndex(uint64_t value);
+//
+// map sample value to its bucket
+//
+size_t LatencyHistogram::getBucketIndex(uint64_t value)
+{
+    if (value < SUB_BUCKET_COUNT) {
+        return value;
+    }
+
+    size_t msb = 63 - __builtin_clzll(value);
+    if (msb >= MUX_LATENCY_HISTOGRAM_MAX_VALUE_BITS) {
+        return BUCKET_COUNT - 1;
+    }
+
+    size_t shift = msb - MUX_LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKET_COUNT + ((value >> shift) & (SUB_BUCKET_COUNT - 1));
+}
+
+//
+// ---> getBucketUpperBound(size_t index);
+//
+// getter for largest value mapped to a bucket
+//
+uint64_t LatencyHistogram::getBucketUpperBound(size_t index)
+{
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+
+    size_t shift = index / SUB_BUCKET_COUNT - 1;
+    uint64_t subBucket = SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT;
+
+    return ((subBucket + 1) << shift) - 1;
+}
+
+} /* namespace common */
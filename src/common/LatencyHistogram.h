@@ -0,0 +1,155 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LatencyHistogram.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef COMMON_LATENCYHISTOGRAM_H_
+#define COMMON_LATENCYHISTOGRAM_H_
+
+#include <array>
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MUX_LATENCY_HISTOGRAM_SUB_BUCKET_BITS   4
+#define MUX_LATENCY_HISTOGRAM_MAX_VALUE_BITS    32
+
+namespace common
+{
+
+/**
+ *@class LatencyHistogram
+ *
+ *@brief log-linear histogram of latency samples. Each power of two range is split
+ *       into 2^MUX_LATENCY_HISTOGRAM_SUB_BUCKET_BITS linear buckets, which bounds the
+ *       relative error of reported percentiles to 1/16. Buckets are atomic counters,
+ *       one writer may record while other threads read percentiles without locking.
+ */
+class LatencyHistogram
+{
+public:
+    /**
+    *@method LatencyHistogram
+    *
+    *@brief class default constructor
+    */
+    LatencyHistogram();
+
+    /**
+    *@method LatencyHistogram
+    *
+    *@brief class copy constructor
+    *
+    *@param LatencyHistogram (in)  reference to LatencyHistogram object to be copied
+    */
+    LatencyHistogram(const LatencyHistogram &) = delete;
+
+    /**
+    *@method ~LatencyHistogram
+    *
+    *@brief class destructor
+    */
+    virtual ~LatencyHistogram() = default;
+
+    /**
+    *@method record
+    *
+    *@brief record a sample, values beyond histogram range land in the last bucket
+    *
+    *@param value (in)  sample value
+    *
+    *@return none
+    */
+    void record(uint64_t value);
+
+    /**
+    *@method reset
+    *
+    *@brief clear all recorded samples
+    *
+    *@return none
+    */
+    void reset();
+
+    /**
+    *@method getCount
+    *
+    *@brief getter for number of recorded samples
+    *
+    *@return sample count
+    */
+    inline uint64_t getCount() const {return mCount.load(std::memory_order_relaxed);};
+
+    /**
+    *@method getMax
+    *
+    *@brief getter for largest recorded sample
+    *
+    *@return max sample value
+    */
+    inline uint64_t getMax() const {return mMax.load(std::memory_order_relaxed);};
+
+    /**
+    *@method getPercentile
+    *
+    *@brief getter for sample value at given percentile, reported as the upper
+    *       bound of the bucket holding it
+    *
+    *@param percentile (in)     percentile in range (0, 100]
+    *
+    *@return sample value at percentile, 0 if histogram is empty
+    */
+    uint64_t getPercentile(double percentile) const;
+
+private:
+    static constexpr size_t SUB_BUCKET_COUNT = 1 << MUX_LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT =
+        (MUX_LATENCY_HISTOGRAM_MAX_VALUE_BITS - MUX_LATENCY_HISTOGRAM_SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    /**
+    *@method getBucketIndex
+    *
+    *@brief map sample value to its bucket
+    *
+    *@param value (in)  sample value
+    *
+    *@return bucket index
+    */
+    static size_t getBucketIndex(uint64_t value);
+
+    /**
+    *@method getBucketUpperBound
+    *
+    *@brief getter for largest value mapped to a bucket
+    *
+    *@param index (in)  bucket index
+    *
+    *@return bucket upper bound
+    */
+    static uint64_t getBucketUpperBound(size_t index);
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> mBuckets;
+    std::atomic<uint64_t> mCount;
+    std::atomic<uint64_t> mMax;
+};
+
+} /* namespace common */
+
+#endif /* COMMON_LATENCYHISTOGRAM_H_ */
@@ -86,6 +86,66 @@ public:
     */
     inline void setTimeoutIpv4_msec(uint32_t timeout_msec) {mTimeoutIpv4_msec = timeout_msec;};
 
+    /**
+    *@method setDetectionTimeoutIpv4_msec
+    *
+    *@brief setter for IPv4 heartbeat reply detection timeout in msec, heartbeats are pipelined
+    *       when it is longer than the probing interval
+    *
+    *@param timeout_msec (in)  timeout in msec, 0 times out heartbeats at the next probe
+    *
+    *@return none
+    */
+    inline void setDetectionTimeoutIpv4_msec(uint32_t timeout_msec) {mDetectionTimeoutIpv4_msec = timeout_msec;};
+
+    /**
+    *@method setMaxTimeoutIpv4_msec
+    *
+    *@brief setter for upper bound of adaptive IPv4 probing interval in msec. Interval is only
+    *       relaxed on ports whose heartbeats the peer ToR does not watch
+    *
+    *@param timeout_msec (in)  timeout in msec, 0 keeps probing interval fixed
+    *
+    *@return none
+    */
+    inline void setMaxTimeoutIpv4_msec(uint32_t timeout_msec) {mMaxTimeoutIpv4_msec = timeout_msec;};
+
+    /**
+    *@method setStableHeartbeatCount
+    *
+    *@brief setter for number of consecutive heartbeats received before probing interval is relaxed
+    *
+    *@param count (in)  heartbeat count
+    *
+    *@return none
+    */
+    inline void setStableHeartbeatCount(uint32_t count) {mStableHeartbeatCount = count;};
+
+    /**
+    *@method setMaxProbeRate
+    *
+    *@brief setter for heartbeats per second all link probers of the ToR may send. Ports whose
+    *       heartbeats are watched by the peer ToR are never throttled beyond
+    *       interval_v4 x (negative_signal_count - 1), so the budget should cover that rate for
+    *       every such port or those ports stay over budget
+    *
+    *@param maxProbeRate (in)  heartbeats per second, 0 does not limit link probers
+    *
+    *@return none
+    */
+    inline void setMaxProbeRate(uint32_t maxProbeRate) {mMaxProbeRate = maxProbeRate;};
+
+    /**
+    *@method setMetricsFlushInterval_msec
+    *
+    *@brief setter for interval at which latest STATE_DB metrics of all ports are written
+    *
+    *@param interval_msec (in)  flush interval in msec
+    *
+    *@return none
+    */
+    inline void setMetricsFlushInterval_msec(uint32_t interval_msec) {mMetricsFlushInterval_msec = interval_msec;};
+
      /**
     *@method setRxTimeoutIpv4_msec
     *
@@ -262,6 +322,51 @@ public:
     */
     inline uint32_t getTimeoutIpv4_msec() const {return mTimeoutIpv4_msec;};
 
+    /**
+    *@method getDetectionTimeoutIpv4_msec
+    *
+    *@brief getter for IPv4 heartbeat reply detection timeout in msec
+    *
+    *@return timeout in msec
+    */
+    inline uint32_t getDetectionTimeoutIpv4_msec() const {return mDetectionTimeoutIpv4_msec;};
+
+    /**
+    *@method getMaxTimeoutIpv4_msec
+    *
+    *@brief getter for upper bound of adaptive IPv4 probing interval in msec
+    *
+    *@return timeout in msec
+    */
+    inline uint32_t getMaxTimeoutIpv4_msec() const {return mMaxTimeoutIpv4_msec;};
+
+    /**
+    *@method getStableHeartbeatCount
+    *
+    *@brief getter for number of consecutive heartbeats received before probing interval is relaxed
+    *
+    *@return heartbeat count
+    */
+    inline uint32_t getStableHeartbeatCount() const {return mStableHeartbeatCount;};
+
+    /**
+    *@method getMaxProbeRate
+    *
+    *@brief getter for heartbeats per second all link probers of the ToR may send
+    *
+    *@return heartbeats per second
+    */
+    inline uint32_t getMaxProbeRate() const {return mMaxProbeRate;};
+
+    /**
+    *@method getMetricsFlushInterval_msec
+    *
+    *@brief getter for interval at which latest STATE_DB metrics of all ports are written
+    *
+    *@return flush interval in msec
+    */
+    inline uint32_t getMetricsFlushInterval_msec() const {return mMetricsFlushInterval_msec;};
+
     /**
     *@method getTimeoutIpv6_msec
     *
@@ -446,6 +551,26 @@ public:
      */
     inline bool getIfEnableDefaultRouteFeature() {return mEnableDefaultRouteFeature;};
 
+    /**
+     * @method enableProbePhaseSpread
+     * 
+     * @brief enable or disable spreading heartbeat phases of ports across the probing interval
+     * 
+     * @param enable_feature (in) enable feature
+     * 
+     * @return none 
+     */
+    inline void enableProbePhaseSpread(bool enable_feature) {mEnableProbePhaseSpread = enable_feature;};
+
+    /**
+     * @method getIfEnableProbePhaseSpread
+     * 
+     * @brief check if heartbeat phases of ports are spread across the probing interval
+     * 
+     * @return if probe phase spread is enabled or not
+     */
+    inline bool getIfEnableProbePhaseSpread() {return mEnableProbePhaseSpread;};
+
     /**
      * @method getIfUseWellKnownMacActiveActive
      * 
@@ -485,6 +610,11 @@ public:
 private:
     uint8_t mNumberOfThreads = 5;
     uint32_t mTimeoutIpv4_msec = 100;
+    uint32_t mDetectionTimeoutIpv4_msec = 0;
+    uint32_t mMaxTimeoutIpv4_msec = 0;
+    uint32_t mStableHeartbeatCount = 100;
+    uint32_t mMaxProbeRate = 0;
+    uint32_t mMetricsFlushInterval_msec = 100;
     uint32_t mTimeoutIpv6_msec = 1000;
     uint32_t mRxTimeoutIpv4_msec = 300;
     uint32_t mPositiveStateChangeRetryCount = 1;
@@ -503,6 +633,7 @@ private:
     uint32_t mMuxReconciliationTimeout_sec = 10;
 
     bool mEnableDefaultRouteFeature = false;
+    bool mEnableProbePhaseSpread = false;
     bool mUseWellKnownMacActiveActive = true;
 
     bool mEnableUseTorMac = false;
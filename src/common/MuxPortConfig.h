@@ -152,6 +152,62 @@ public:
     */
     inline void setMode(const Mode mode) {mMode = mode;};
 
+    /**
+    *@method setLinkUp
+    *
+    *@brief setter for port link state
+    *
+    *@param linkUp (in)   true if port link is up
+    *
+    *@return none
+    */
+    inline void setLinkUp(bool linkUp) {mLinkUp = linkUp;};
+
+    /**
+    *@method setMinProbeInterval_msec
+    *
+    *@brief setter for fastest heartbeat interval granted to port by heartbeat budget
+    *
+    *@param interval_msec (in)   interval in msec, 0 does not bound port interval
+    *
+    *@return none
+    */
+    inline void setMinProbeInterval_msec(uint32_t interval_msec) {mMinProbeInterval_msec = interval_msec;};
+
+    /**
+    *@method setMaxProbeInterval_msec
+    *
+    *@brief setter for slowest heartbeat interval heartbeat budget may throttle port to, capped
+    *       at interval_v4 x (negative_signal_count - 1) while the peer ToR watches our heartbeats
+    *
+    *@param interval_msec (in)   interval in msec, 0 falls back to max_interval_v4
+    *
+    *@return none
+    */
+    inline void setMaxProbeInterval_msec(uint32_t interval_msec) {mMaxProbeInterval_msec = interval_msec;};
+
+    /**
+    *@method setProbePriority
+    *
+    *@brief setter for weight of port in sharing heartbeat budget
+    *
+    *@param priority (in)   port priority, 0 grants port its slowest interval only
+    *
+    *@return none
+    */
+    inline void setProbePriority(uint32_t priority) {mProbePriority = priority;};
+
+    /**
+    *@method setLowLatencyRx
+    *
+    *@brief setter for receiving heartbeat replies of the port on the busy poll thread
+    *
+    *@param enable (in)     true to busy poll port socket
+    *
+    *@return none
+    */
+    inline void setLowLatencyRx(bool enable) {mLowLatencyRx = enable;};
+
     /**
     *@method getTimeoutIpv4_msec
     *
@@ -161,6 +217,33 @@ public:
     */
     inline uint32_t getTimeoutIpv4_msec() const {return mMuxConfig.getTimeoutIpv4_msec();};
 
+    /**
+    *@method getDetectionTimeoutIpv4_msec
+    *
+    *@brief getter for IPv4 heartbeat reply detection timeout in msec
+    *
+    *@return timeout in msec
+    */
+    inline uint32_t getDetectionTimeoutIpv4_msec() const {return mMuxConfig.getDetectionTimeoutIpv4_msec();};
+
+    /**
+    *@method getMaxTimeoutIpv4_msec
+    *
+    *@brief getter for upper bound of adaptive IPv4 probing interval in msec
+    *
+    *@return timeout in msec
+    */
+    inline uint32_t getMaxTimeoutIpv4_msec() const {return mMuxConfig.getMaxTimeoutIpv4_msec();};
+
+    /**
+    *@method getStableHeartbeatCount
+    *
+    *@brief getter for number of consecutive heartbeats received before probing interval is relaxed
+    *
+    *@return heartbeat count
+    */
+    inline uint32_t getStableHeartbeatCount() const {return mMuxConfig.getStableHeartbeatCount();};
+
     /**
     *@method getTimeoutIpv6_msec
     *
@@ -323,6 +406,44 @@ public:
     */
     inline Mode getMode() const {return mMode;};
 
+    /**
+    *@method isLinkUp
+    *
+    *@brief getter for port link state
+    *
+    *@return true if port link is up
+    */
+    inline bool isLinkUp() const {return mLinkUp;};
+
+    /**
+    *@method getMinProbeInterval_msec
+    *
+    *@brief getter for fastest heartbeat interval granted to port by heartbeat budget
+    *
+    *@return interval in msec
+    */
+    inline uint32_t getMinProbeInterval_msec() const {return mMinProbeInterval_msec;};
+
+    /**
+    *@method getMaxProbeInterval_msec
+    *
+    *@brief getter for slowest heartbeat interval heartbeat budget may throttle port to
+    *
+    *@return interval in msec
+    */
+    inline uint32_t getMaxProbeInterval_msec() const {
+        return mMaxProbeInterval_msec ? mMaxProbeInterval_msec : mMuxConfig.getMaxTimeoutIpv4_msec();
+    };
+
+    /**
+    *@method getProbePriority
+    *
+    *@brief getter for weight of port in sharing heartbeat budget
+    *
+    *@return port priority
+    */
+    inline uint32_t getProbePriority() const {return mProbePriority;};
+
     /**
     *@method getPortCableType
     *
@@ -390,6 +511,40 @@ public:
      */
     inline bool ifEnableDefaultRouteFeature() {return mMuxConfig.getIfEnableDefaultRouteFeature();};
 
+    /**
+     * @method ifEnableProbePhaseSpread
+     * 
+     * @brief check if heartbeat phases of ports are spread across the probing interval
+     * 
+     * @return if probe phase spread is enabled or not
+     */
+    inline bool ifEnableProbePhaseSpread() {return mMuxConfig.getIfEnableProbePhaseSpread();};
+
+    /**
+     * @method ifEnableLowLatencyRx
+     * 
+     * @brief check if heartbeat replies of the port are received on the busy poll thread
+     * 
+     * @return if low latency receive is enabled or not
+     */
+    inline bool ifEnableLowLatencyRx() const {return mLowLatencyRx;};
+
+    /**
+     * @method getProbePhase_msec
+     * 
+     * @brief getter for heartbeat phase of the port within the probing interval. Phase is the
+     *        fractional part of server id times the golden ratio, so consecutive ports are spread
+     *        evenly and each port keeps the same relative phase when the interval changes
+     * 
+     * @param interval_msec (in) probing interval
+     * 
+     * @return phase offset in msec, less than interval_msec
+     */
+    inline uint32_t getProbePhase_msec(uint32_t interval_msec) const {
+        uint32_t phaseFraction = static_cast<uint32_t> (mServerId) * 0x9e3779b9u;
+        return static_cast<uint32_t> ((static_cast<uint64_t> (phaseFraction) * interval_msec) >> 32);
+    };
+
     /**
      * @method getIfUseWellKnownMacActiveActive
      * 
@@ -466,6 +621,11 @@ private:
     std::array<uint8_t, ETHER_ADDR_LEN> mLastUpdatedMacAddress = {0, 0, 0, 0, 0, 0};
     uint16_t mServerId;
     Mode mMode = Manual;
+    bool mLinkUp = true;
+    uint32_t mMinProbeInterval_msec = 0;
+    uint32_t mMaxProbeInterval_msec = 0;
+    uint32_t mProbePriority = 1;
+    bool mLowLatencyRx = false;
     PortCableType mPortCableType;
     LinkProberType mLinkProberType;
     uint32_t mAdminForwardingStateSyncUpInterval_msec = 10000;
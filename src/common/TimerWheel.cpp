@@ -0,0 +1,515 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * TimerWheel.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <boost/bind/bind.hpp>
+
+#include "MuxException.h"
+#include "MuxLogger.h"
+#include "TimerWheel.h"
+
+namespace common
+{
+
+constexpr uint64_t TimerWheel::NO_TICK;
+constexpr size_t TimerWheel::ROOT_SIZE;
+constexpr size_t TimerWheel::LEVEL_SIZE;
+
+//
+// ---> getInstance();
+//
+// constructs TimerWheel singleton instance
+//
+TimerWheelPtr TimerWheel::getInstance()
+{
+    static std::shared_ptr<TimerWheel> TimerWheelPtr = nullptr;
+
+    if (TimerWheelPtr == nullptr) {
+        TimerWheelPtr = std::shared_ptr<TimerWheel> (new TimerWheel);
+    }
+
+    return TimerWheelPtr;
+}
+
+//
+// ---> initialize(boost::asio::io_service &ioService);
+//
+// open timerfd and start driving the wheel, timers created afterwards use the wheel
+//
+void TimerWheel::initialize(boost::asio::io_service &ioService)
+{
+    mTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (mTimerFd < 0) {
+        std::ostringstream errMsg;
+        errMsg << "Failed to create timer wheel timerfd with '" << strerror(errno) << "'" << std::endl;
+        throw MUX_ERROR(SocketError, errMsg.str());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStartTime = std::chrono::steady_clock::now();
+        mCurrentTick = 0;
+        mArmedTick = NO_TICK;
+    }
+    mBurstHistogram.reset();
+
+    mStreamPtr = std::make_shared<boost::asio::posix::stream_descriptor> (ioService);
+    mStreamPtr->assign(mTimerFd);
+    mEnabled = true;
+
+    MUXLOGWARNING(boost::format("Timer wheel initialized with %d usec tick") % MUX_TIMER_WHEEL_TICK_USEC);
+
+    startWait();
+}
+
+//
+// ---> deinitialize();
+//
+// stop driving the wheel and close timerfd
+//
+void TimerWheel::deinitialize()
+{
+    if (mEnabled) {
+        mEnabled = false;
+
+        boost::system::error_code errorCode;
+        mStreamPtr->close(errorCode);
+        mTimerFd = -1;
+    }
+}
+
+//
+// ---> getTimerCount();
+//
+// getter for number of timers currently on the wheel
+//
+size_t TimerWheel::getTimerCount()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mTimerCount;
+}
+
+//
+// ---> dumpBurstStats();
+//
+// log p50/p99/max of timers expiring on the same tick
+//
+void TimerWheel::dumpBurstStats()
+{
+    MUXLOGINFO(boost::format("Timer wheel burst size: ticks %d, p50 %d, p99 %d, max %d") %
+        mBurstHistogram.getCount() %
+        mBurstHistogram.getPercentile(50) %
+        mBurstHistogram.getPercentile(99) %
+        mBurstHistogram.getMax()
+    );
+}
+
+//
+// ---> getExpiryTick(const boost::posix_time::time_duration &expiryTime);
+//
+// convert timeout relative to now into wheel tick, rounded up
+//
+uint64_t TimerWheel::getExpiryTick(const boost::posix_time::time_duration &expiryTime)
+{
+    int64_t nowUsec = std::chrono::duration_cast<std::chrono::microseconds> (
+        std::chrono::steady_clock::now() - mStartTime
+    ).count();
+    int64_t expiryUsec = nowUsec + std::max<int64_t> (expiryTime.total_microseconds(), 0);
+
+    return (expiryUsec + MUX_TIMER_WHEEL_TICK_USEC - 1) / MUX_TIMER_WHEEL_TICK_USEC;
+}
+
+//
+// ---> getNowTick();
+//
+// getter for tick that has fully elapsed
+//
+uint64_t TimerWheel::getNowTick()
+{
+    int64_t nowUsec = std::chrono::duration_cast<std::chrono::microseconds> (
+        std::chrono::steady_clock::now() - mStartTime
+    ).count();
+
+    return nowUsec / MUX_TIMER_WHEEL_TICK_USEC;
+}
+
+//
+// ---> schedule(WheelTimer *timerPtr, Handler &&handler);
+//
+// add wait handler to timer and put timer on the wheel
+//
+void TimerWheel::schedule(WheelTimer *timerPtr, Handler &&handler)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    timerPtr->mHandlers.push_back(std::move(handler));
+    if (!timerPtr->mLinked) {
+        if (mTimerCount == 0) {
+            // idle wheel has not been advanced, catch up so the new timer is placed relative to now
+            mCurrentTick = std::max(mCurrentTick, getNowTick());
+        }
+
+        uint64_t wakeupTick = link(timerPtr, mCurrentTick + 1);
+        if (wakeupTick < mArmedTick) {
+            arm(wakeupTick);
+        }
+    }
+}
+
+//
+// ---> cancel(WheelTimer *timerPtr, std::vector<Handler> &handlers);
+//
+// take timer off the wheel
+//
+size_t TimerWheel::cancel(WheelTimer *timerPtr, std::vector<Handler> &handlers)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (timerPtr->mLinked) {
+        unlink(timerPtr);
+    }
+    handlers.swap(timerPtr->mHandlers);
+
+    return handlers.size();
+}
+
+//
+// ---> link(WheelTimer *timerPtr, uint64_t baseTick);
+//
+// insert timer into the slot list matching its expiry, caller holds mMutex
+//
+uint64_t TimerWheel::link(WheelTimer *timerPtr, uint64_t baseTick)
+{
+    uint64_t expiryTick = std::max(timerPtr->mExpiryTick, baseTick);
+    uint64_t delta = expiryTick - mCurrentTick;
+    uint64_t wakeupTick = (mCurrentTick | (ROOT_SIZE - 1)) + 1;
+    size_t level = 0;
+    size_t slot = 0;
+
+    if (delta < ROOT_SIZE) {
+        slot = expiryTick & (ROOT_SIZE - 1);
+        wakeupTick = expiryTick;
+    } else {
+        size_t shift = MUX_TIMER_WHEEL_ROOT_BITS;
+        for (level = 1; level < MUX_TIMER_WHEEL_LEVELS; level++) {
+            if (delta < (1ULL << (shift + MUX_TIMER_WHEEL_LEVEL_BITS)) || level == MUX_TIMER_WHEEL_LEVELS - 1) {
+                break;
+            }
+            shift += MUX_TIMER_WHEEL_LEVEL_BITS;
+        }
+        if (delta >= (1ULL << (shift + MUX_TIMER_WHEEL_LEVEL_BITS))) {
+            // beyond wheel span, park in the last slot reachable and re-check on expiry
+            expiryTick = mCurrentTick + (1ULL << (shift + MUX_TIMER_WHEEL_LEVEL_BITS)) - 1;
+        }
+        slot = (expiryTick >> shift) & (LEVEL_SIZE - 1);
+    }
+
+    WheelTimer *&head = mSlots[level][slot];
+    timerPtr->mPrev = nullptr;
+    timerPtr->mNext = head;
+    if (head != nullptr) {
+        head->mPrev = timerPtr;
+    }
+    head = timerPtr;
+
+    timerPtr->mLevel = level;
+    timerPtr->mSlot = slot;
+    timerPtr->mLinked = true;
+    mLevelCount[level]++;
+    mTimerCount++;
+
+    return wakeupTick;
+}
+
+//
+// ---> unlink(WheelTimer *timerPtr);
+//
+// remove timer from its slot list, caller holds mMutex
+//
+void TimerWheel::unlink(WheelTimer *timerPtr)
+{
+    if (timerPtr->mPrev != nullptr) {
+        timerPtr->mPrev->mNext = timerPtr->mNext;
+    } else {
+        mSlots[timerPtr->mLevel][timerPtr->mSlot] = timerPtr->mNext;
+    }
+    if (timerPtr->mNext != nullptr) {
+        timerPtr->mNext->mPrev = timerPtr->mPrev;
+    }
+
+    timerPtr->mPrev = nullptr;
+    timerPtr->mNext = nullptr;
+    timerPtr->mLinked = false;
+    mLevelCount[timerPtr->mLevel]--;
+    mTimerCount--;
+}
+
+//
+// ---> cascade(size_t level, size_t index);
+//
+// move timers of an upper level slot to lower levels, caller holds mMutex
+//
+void TimerWheel::cascade(size_t level, size_t index)
+{
+    WheelTimer *timerPtr = mSlots[level][index];
+    while (timerPtr != nullptr) {
+        WheelTimer *nextPtr = timerPtr->mNext;
+        unlink(timerPtr);
+        link(timerPtr, mCurrentTick);
+        timerPtr = nextPtr;
+    }
+}
+
+//
+// ---> advance(uint64_t tick, std::vector<Handler> &handlers);
+//
+// move wheel forward to tick and collect handlers of expired timers, caller holds mMutex
+//
+void TimerWheel::advance(uint64_t tick, std::vector<Handler> &handlers)
+{
+    while (mCurrentTick < tick) {
+        if (mTimerCount == 0) {
+            mCurrentTick = tick;
+            break;
+        }
+
+        mCurrentTick++;
+        size_t index = mCurrentTick & (ROOT_SIZE - 1);
+        if (index == 0) {
+            size_t shift = MUX_TIMER_WHEEL_ROOT_BITS;
+            for (size_t level = 1; level < MUX_TIMER_WHEEL_LEVELS; level++) {
+                size_t levelIndex = (mCurrentTick >> shift) & (LEVEL_SIZE - 1);
+                cascade(level, levelIndex);
+                if (levelIndex != 0) {
+                    break;
+                }
+                shift += MUX_TIMER_WHEEL_LEVEL_BITS;
+            }
+        }
+
+        size_t burstSize = 0;
+        WheelTimer *timerPtr = mSlots[0][index];
+        while (timerPtr != nullptr) {
+            WheelTimer *nextPtr = timerPtr->mNext;
+            unlink(timerPtr);
+            if (timerPtr->mExpiryTick > mCurrentTick) {
+                link(timerPtr, mCurrentTick + 1);
+            } else {
+                mExpiredCount++;
+                burstSize++;
+                for (auto &handler: timerPtr->mHandlers) {
+                    handlers.push_back(std::move(handler));
+                }
+                timerPtr->mHandlers.clear();
+            }
+            timerPtr = nextPtr;
+        }
+        if (burstSize > 0) {
+            mBurstHistogram.record(burstSize);
+        }
+    }
+}
+
+//
+// ---> getNextWakeupTick();
+//
+// find next tick the wheel has work at, caller holds mMutex
+//
+uint64_t TimerWheel::getNextWakeupTick()
+{
+    uint64_t wakeupTick = NO_TICK;
+
+    if (mLevelCount[0] > 0) {
+        for (uint64_t tick = mCurrentTick + 1; tick <= mCurrentTick + ROOT_SIZE; tick++) {
+            if (mSlots[0][tick & (ROOT_SIZE - 1)] != nullptr) {
+                wakeupTick = tick;
+                break;
+            }
+        }
+    }
+    if (mTimerCount > mLevelCount[0]) {
+        wakeupTick = std::min(wakeupTick, (mCurrentTick | (ROOT_SIZE - 1)) + 1);
+    }
+
+    return wakeupTick;
+}
+
+//
+// ---> arm(uint64_t tick);
+//
+// arm timerfd for the given tick, caller holds mMutex
+//
+void TimerWheel::arm(uint64_t tick)
+{
+    if (mTimerFd < 0) {
+        return;
+    }
+
+    struct itimerspec timerSpec;
+    memset(&timerSpec, 0, sizeof(timerSpec));
+
+    if (tick != NO_TICK) {
+        std::chrono::nanoseconds wakeupTime = mStartTime.time_since_epoch() +
+            std::chrono::microseconds(tick * MUX_TIMER_WHEEL_TICK_USEC);
+        timerSpec.it_value.tv_sec = wakeupTime.count() / 1000000000;
+        timerSpec.it_value.tv_nsec = wakeupTime.count() % 1000000000;
+    }
+
+    if (timerfd_settime(mTimerFd, TFD_TIMER_ABSTIME, &timerSpec, nullptr) != 0) {
+        MUXLOGERROR(boost::format("Failed to arm timer wheel timerfd with '%s'") % strerror(errno));
+        return;
+    }
+    mArmedTick = tick;
+}
+
+//
+// ---> startWait();
+//
+// wait for timerfd to become readable
+//
+void TimerWheel::startWait()
+{
+    mStreamPtr->async_wait(
+        boost::asio::posix::stream_descriptor::wait_read,
+        boost::bind(&TimerWheel::handleWait, this, boost::asio::placeholders::error)
+    );
+}
+
+//
+// ---> handleWait(const boost::system::error_code &errorCode);
+//
+// handle timerfd expiry
+//
+void TimerWheel::handleWait(const boost::system::error_code &errorCode)
+{
+    if (errorCode == boost::asio::error::operation_aborted || !mEnabled) {
+        return;
+    }
+
+    uint64_t expirations;
+    if (read(mTimerFd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN) {
+        MUXLOGERROR(boost::format("Failed to read timer wheel timerfd with '%s'") % strerror(errno));
+    }
+
+    std::vector<Handler> handlers;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mWakeupCount++;
+        advance(getNowTick(), handlers);
+        arm(getNextWakeupTick());
+    }
+
+    for (auto &handler: handlers) {
+        handler(boost::system::error_code());
+    }
+
+    startWait();
+}
+
+//
+// ---> WheelTimer(boost::asio::io_service &ioService);
+//
+// class constructor
+//
+WheelTimer::WheelTimer(boost::asio::io_service &ioService) :
+    mIoService(ioService)
+{
+    TimerWheelPtr timerWheelPtr = TimerWheel::getInstance();
+    if (timerWheelPtr->isEnabled()) {
+        mTimerWheelPtr = timerWheelPtr;
+    } else {
+        mDeadlineTimerPtr = std::make_shared<boost::asio::deadline_timer> (ioService);
+    }
+}
+
+//
+// ---> ~WheelTimer();
+//
+// class destructor, pending waits are canceled
+//
+WheelTimer::~WheelTimer()
+{
+    if (mTimerWheelPtr) {
+        cancel();
+    }
+}
+
+//
+// ---> expires_from_now(const boost::posix_time::time_duration &expiryTime);
+//
+// set expiry time relative to now, pending waits are canceled
+//
+size_t WheelTimer::expires_from_now(const boost::posix_time::time_duration &expiryTime)
+{
+    if (!mTimerWheelPtr) {
+        return mDeadlineTimerPtr->expires_from_now(expiryTime);
+    }
+
+    size_t count = cancel();
+    mExpiresAt = boost::posix_time::microsec_clock::universal_time() + expiryTime;
+    mExpiryTick = mTimerWheelPtr->getExpiryTick(expiryTime);
+
+    return count;
+}
+
+//
+// ---> expires_at();
+//
+// getter for absolute expiry time
+//
+boost::posix_time::ptime WheelTimer::expires_at() const
+{
+    if (!mTimerWheelPtr) {
+        return mDeadlineTimerPtr->expires_at();
+    }
+
+    return mExpiresAt;
+}
+
+//
+// ---> cancel();
+//
+// cancel pending waits
+//
+size_t WheelTimer::cancel()
+{
+    if (!mTimerWheelPtr) {
+        return mDeadlineTimerPtr->cancel();
+    }
+
+    std::vector<TimerWheel::Handler> handlers;
+    size_t count = mTimerWheelPtr->cancel(this, handlers);
+    for (auto &handler: handlers) {
+        handler(boost::asio::error::operation_aborted);
+    }
+
+    return count;
+}
+
+} /* namespace common */
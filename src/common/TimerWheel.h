@@ -0,0 +1,439 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * TimerWheel.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef COMMON_TIMERWHEEL_H_
+#define COMMON_TIMERWHEEL_H_
+
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <common/BoostAsioBehavior.h>
+#include <boost/asio.hpp>
+#include <boost/function.hpp>
+
+#include "LatencyHistogram.h"
+
+#define MUX_TIMER_WHEEL_TICK_USEC       1000
+#define MUX_TIMER_WHEEL_LEVELS          4
+#define MUX_TIMER_WHEEL_ROOT_BITS       8
+#define MUX_TIMER_WHEEL_LEVEL_BITS      6
+
+namespace common
+{
+class TimerWheel;
+class WheelTimer;
+
+using TimerWheelPtr = std::shared_ptr<TimerWheel>;
+
+/**
+ *@class TimerWheel
+ *
+ *@brief hierarchical timing wheel shared by all WheelTimer objects of the process.
+ *       Timers are kept in per tick slot lists so arming and canceling a timer is
+ *       O(1); expiry is driven by a single timerfd that is armed for the next
+ *       non-empty tick, timers expiring on the same tick are handled together.
+ */
+class TimerWheel
+{
+public:
+    /**
+    *@method TimerWheel
+    *
+    *@brief class copy constructor
+    *
+    *@param TimerWheel (in)  reference to TimerWheel object to be copied
+    */
+    TimerWheel(const TimerWheel &) = delete;
+
+    /**
+    *@method ~TimerWheel
+    *
+    *@brief class destructor
+    */
+    virtual ~TimerWheel() = default;
+
+    /**
+    *@method getInstance
+    *
+    *@brief constructs TimerWheel singleton instance
+    *
+    *@return shared pointer to TimerWheel singleton instance
+    */
+    static TimerWheelPtr getInstance();
+
+    /**
+    *@method initialize
+    *
+    *@brief open timerfd and start driving the wheel, timers created afterwards use the wheel
+    *
+    *@param ioService (in)  reference to boost io_service object
+    *
+    *@return none
+    */
+    void initialize(boost::asio::io_service &ioService);
+
+    /**
+    *@method deinitialize
+    *
+    *@brief stop driving the wheel and close timerfd
+    *
+    *@return none
+    */
+    void deinitialize();
+
+    /**
+    *@method isEnabled
+    *
+    *@brief check if new timers should be scheduled on the wheel
+    *
+    *@return true if timer wheel is in use
+    */
+    inline bool isEnabled() const {return mEnabled;};
+
+    /**
+    *@method getTimerCount
+    *
+    *@brief getter for number of timers currently on the wheel
+    *
+    *@return timer count
+    */
+    size_t getTimerCount();
+
+    /**
+    *@method getWakeupCount
+    *
+    *@brief getter for number of timerfd wakeups
+    *
+    *@return wakeup count
+    */
+    inline uint64_t getWakeupCount() const {return mWakeupCount;};
+
+    /**
+    *@method getExpiredCount
+    *
+    *@brief getter for number of timers expired by the wheel
+    *
+    *@return expired timer count
+    */
+    inline uint64_t getExpiredCount() const {return mExpiredCount;};
+
+    /**
+    *@method getBurstHistogram
+    *
+    *@brief getter for histogram of number of timers expiring on the same tick
+    *
+    *@return reference to burst size histogram
+    */
+    inline const LatencyHistogram& getBurstHistogram() const {return mBurstHistogram;};
+
+    /**
+    *@method dumpBurstStats
+    *
+    *@brief log p50/p99/max of timers expiring on the same tick
+    *
+    *@return none
+    */
+    void dumpBurstStats();
+
+private:
+    friend class WheelTimer;
+
+    using Handler = boost::function<void (const boost::system::error_code &)>;
+
+    static constexpr uint64_t NO_TICK = std::numeric_limits<uint64_t>::max();
+    static constexpr size_t ROOT_SIZE = 1 << MUX_TIMER_WHEEL_ROOT_BITS;
+    static constexpr size_t LEVEL_SIZE = 1 << MUX_TIMER_WHEEL_LEVEL_BITS;
+
+    /**
+    *@method TimerWheel
+    *
+    *@brief class default constructor
+    */
+    TimerWheel() = default;
+
+    /**
+    *@method getExpiryTick
+    *
+    *@brief convert timeout relative to now into wheel tick, rounded up
+    *
+    *@param expiryTime (in)     timeout relative to now
+    *
+    *@return expiry tick
+    */
+    uint64_t getExpiryTick(const boost::posix_time::time_duration &expiryTime);
+
+    /**
+    *@method getNowTick
+    *
+    *@brief getter for tick that has fully elapsed
+    *
+    *@return current tick
+    */
+    uint64_t getNowTick();
+
+    /**
+    *@method schedule
+    *
+    *@brief add wait handler to timer and put timer on the wheel
+    *
+    *@param timerPtr (in)       pointer to timer
+    *@param handler (in)        handler to call on expiry or cancellation
+    *
+    *@return none
+    */
+    void schedule(WheelTimer *timerPtr, Handler &&handler);
+
+    /**
+    *@method cancel
+    *
+    *@brief take timer off the wheel
+    *
+    *@param timerPtr (in)       pointer to timer
+    *@param handlers (out)      wait handlers of the canceled timer
+    *
+    *@return number of canceled wait handlers
+    */
+    size_t cancel(WheelTimer *timerPtr, std::vector<Handler> &handlers);
+
+    /**
+    *@method link
+    *
+    *@brief insert timer into the slot list matching its expiry, caller holds mMutex
+    *
+    *@param timerPtr (in)       pointer to timer
+    *@param baseTick (in)       earliest tick the timer may be placed at
+    *
+    *@return tick at which the wheel has to look at the timer next
+    */
+    uint64_t link(WheelTimer *timerPtr, uint64_t baseTick);
+
+    /**
+    *@method unlink
+    *
+    *@brief remove timer from its slot list, caller holds mMutex
+    *
+    *@param timerPtr (in)       pointer to timer
+    *
+    *@return none
+    */
+    void unlink(WheelTimer *timerPtr);
+
+    /**
+    *@method cascade
+    *
+    *@brief move timers of an upper level slot to lower levels, caller holds mMutex
+    *
+    *@param level (in)          wheel level
+    *@param index (in)          slot index within level
+    *
+    *@return none
+    */
+    void cascade(size_t level, size_t index);
+
+    /**
+    *@method advance
+    *
+    *@brief move wheel forward to tick and collect handlers of expired timers, caller holds mMutex
+    *
+    *@param tick (in)           tick to advance to
+    *@param handlers (out)      wait handlers of expired timers
+    *
+    *@return none
+    */
+    void advance(uint64_t tick, std::vector<Handler> &handlers);
+
+    /**
+    *@method getNextWakeupTick
+    *
+    *@brief find next tick the wheel has work at, caller holds mMutex
+    *
+    *@return next wakeup tick, NO_TICK if the wheel is empty
+    */
+    uint64_t getNextWakeupTick();
+
+    /**
+    *@method arm
+    *
+    *@brief arm timerfd for the given tick, caller holds mMutex
+    *
+    *@param tick (in)           wakeup tick, NO_TICK disarms timerfd
+    *
+    *@return none
+    */
+    void arm(uint64_t tick);
+
+    /**
+    *@method startWait
+    *
+    *@brief wait for timerfd to become readable
+    *
+    *@return none
+    */
+    void startWait();
+
+    /**
+    *@method handleWait
+    *
+    *@brief handle timerfd expiry
+    *
+    *@param errorCode (in)  socket error code
+    *
+    *@return none
+    */
+    void handleWait(const boost::system::error_code &errorCode);
+
+    std::shared_ptr<boost::asio::posix::stream_descriptor> mStreamPtr;
+    int mTimerFd = -1;
+    bool mEnabled = false;
+
+    std::mutex mMutex;
+    std::chrono::steady_clock::time_point mStartTime;
+    uint64_t mCurrentTick = 0;
+    uint64_t mArmedTick = NO_TICK;
+    WheelTimer *mSlots[MUX_TIMER_WHEEL_LEVELS][ROOT_SIZE] = {};
+    size_t mLevelCount[MUX_TIMER_WHEEL_LEVELS] = {};
+    size_t mTimerCount = 0;
+
+    uint64_t mWakeupCount = 0;
+    uint64_t mExpiredCount = 0;
+    LatencyHistogram mBurstHistogram;
+};
+
+/**
+ *@class WheelTimer
+ *
+ *@brief drop-in replacement for boost::asio::deadline_timer that is scheduled on the
+ *       shared TimerWheel. Timers constructed while the wheel is not initialized
+ *       fall back to a regular deadline_timer.
+ */
+class WheelTimer
+{
+public:
+    /**
+    *@method WheelTimer
+    *
+    *@brief class default constructor
+    */
+    WheelTimer() = delete;
+
+    /**
+    *@method WheelTimer
+    *
+    *@brief class constructor
+    *
+    *@param ioService (in)  reference to boost io_service object handlers are posted to
+    */
+    WheelTimer(boost::asio::io_service &ioService);
+
+    /**
+    *@method WheelTimer
+    *
+    *@brief class copy constructor
+    *
+    *@param WheelTimer (in)  reference to WheelTimer object to be copied
+    */
+    WheelTimer(const WheelTimer &) = delete;
+
+    /**
+    *@method ~WheelTimer
+    *
+    *@brief class destructor, pending waits are canceled
+    */
+    virtual ~WheelTimer();
+
+    /**
+    *@method expires_from_now
+    *
+    *@brief set expiry time relative to now, pending waits are canceled
+    *
+    *@param expiryTime (in)     timeout relative to now
+    *
+    *@return number of canceled waits
+    */
+    size_t expires_from_now(const boost::posix_time::time_duration &expiryTime);
+
+    /**
+    *@method expires_at
+    *
+    *@brief getter for absolute expiry time
+    *
+    *@return expiry time in UTC
+    */
+    boost::posix_time::ptime expires_at() const;
+
+    /**
+    *@method async_wait
+    *
+    *@brief start asynchronous wait, handler is called with operation_aborted when the timer is canceled
+    *
+    *@param handler (in)        wait handler
+    *
+    *@return none
+    */
+    template <typename WaitHandler>
+    void async_wait(WaitHandler handler)
+    {
+        if (!mTimerWheelPtr) {
+            mDeadlineTimerPtr->async_wait(handler);
+            return;
+        }
+
+        auto executor = boost::asio::get_associated_executor(handler, mIoService.get_executor());
+        mTimerWheelPtr->schedule(this, [handler, executor] (const boost::system::error_code &errorCode) {
+            boost::asio::post(executor, [handler, errorCode] () mutable {handler(errorCode);});
+        });
+    }
+
+    /**
+    *@method cancel
+    *
+    *@brief cancel pending waits
+    *
+    *@return number of canceled waits
+    */
+    size_t cancel();
+
+private:
+    friend class TimerWheel;
+
+    boost::asio::io_service &mIoService;
+    TimerWheelPtr mTimerWheelPtr;
+    std::shared_ptr<boost::asio::deadline_timer> mDeadlineTimerPtr;
+
+    boost::posix_time::ptime mExpiresAt;
+    uint64_t mExpiryTick = 0;
+
+    // wheel bookkeeping, guarded by TimerWheel::mMutex
+    std::vector<TimerWheel::Handler> mHandlers;
+    WheelTimer *mPrev = nullptr;
+    WheelTimer *mNext = nullptr;
+    size_t mLevel = 0;
+    size_t mSlot = 0;
+    bool mLinked = false;
+};
+
+} /* namespace common */
+
+#endif /* COMMON_TIMERWHEEL_H_ */
@@ -1,24 +1,33 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+    ./src/common/InternetChecksum.cpp \
+    ./src/common/LatencyHistogram.cpp \
     ./src/common/MuxLogger.cpp \
     ./src/common/MuxPortConfig.cpp \
     ./src/common/State.cpp \
     ./src/common/StateMachine.cpp \
-    ./src/common/SwssLogBackend.cpp
+    ./src/common/SwssLogBackend.cpp \
+    ./src/common/TimerWheel.cpp
 
 OBJS += \
+    ./src/common/InternetChecksum.o \
+    ./src/common/LatencyHistogram.o \
     ./src/common/MuxLogger.o \
     ./src/common/MuxPortConfig.o \
     ./src/common/State.o \
     ./src/common/StateMachine.o \
-    ./src/common/SwssLogBackend.o
+    ./src/common/SwssLogBackend.o \
+    ./src/common/TimerWheel.o
 
 CPP_DEPS += \
+    ./src/common/InternetChecksum.d \
+    ./src/common/LatencyHistogram.d \
     ./src/common/MuxLogger.d \
     ./src/common/MuxPortConfig.d \
     ./src/common/State.d \
     ./src/common/StateMachine.d \
-    ./src/common/SwssLogBackend.d
+    ./src/common/SwssLogBackend.d \
+    ./src/common/TimerWheel.d
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -20,6 +20,7 @@
 #include "common/MuxLogger.h"
 #include "common/MuxException.h"
 #include "MuxPort.h"
+#include "link_prober/LinkProberRxFanout.h"
 #include <chrono>
 
 std::chrono::time_point<std::chrono::high_resolution_clock> global_start;
@@ -126,18 +127,22 @@ void ActiveActiveStateMachine::handleSwssSoCIpv4AddressUpdate(boost::asio::ip::a
             MUXLOGINFO( boost::format("%s: detected Prober type HW(%b) ") % mMuxPortConfig.getPortName() %
             isHwProber);
 
+            // probers run on the RX fanout worker owning their port when fanout is in use
+            boost::asio::io_service &ioService = link_prober::LinkProberRxFanout::getInstance()->getIoService(
+                mMuxPortConfig.getPortName(), getStrand().context()
+            );
             if (isHwProber)
             {
                 mLinkProberPtr = std::make_shared<link_prober::LinkProberHw>(
                 mMuxPortConfig,
-                getStrand().context(),
+                ioService,
                 mLinkProberStateMachinePtr.get(),
                 mMuxPortPtr
                 );
             } else {
                 mLinkProberPtr = std::make_shared<link_prober::LinkProberSw>(
                 mMuxPortConfig,
-                getStrand().context(),
+                ioService,
                 mLinkProberStateMachinePtr.get()
                 );
             }
@@ -169,6 +174,9 @@ void ActiveActiveStateMachine::handleSwssSoCIpv4AddressUpdate(boost::asio::ip::a
             mResetIcmpPacketCountsFnPtr = boost::bind(
                 &link_prober::LinkProberBase::resetIcmpPacketCounts, mLinkProberPtr.get()
             );
+            mResetProbeIntervalFnPtr = boost::bind(
+                &link_prober::LinkProberBase::resetProbeInterval, mLinkProberPtr.get()
+            );
             mSendPeerProbeCommandFnPtr = boost::bind(
                 &link_prober::LinkProberBase::sendPeerProbeCommand, mLinkProberPtr.get()
             );
@@ -269,6 +277,9 @@ void ActiveActiveStateMachine::handleMuxConfigNotification(const common::MuxPort
     MUXLOGWARNING(boost::format("%s: mux config mode: %s") % mMuxPortConfig.getPortName() % mode);
 
     mMuxPortConfig.setMode(mode);
+    if (mResetProbeIntervalFnPtr) {
+        mResetProbeIntervalFnPtr();
+    }
     if (mComponentInitState.all()) {
         CompositeState nextState = mCompositeState;
         if (mode == common::MuxPortConfig::Mode::Active && ms(mCompositeState) != mux_state::MuxState::Label::Active) {
@@ -590,6 +601,9 @@ void ActiveActiveStateMachine::handleStateChange(
 
         CompositeState nextState = mCompositeState;
         ls(nextState) = state;
+        if (mResetProbeIntervalFnPtr) {
+            mResetProbeIntervalFnPtr();
+        }
         if (ls(mCompositeState) == link_state::LinkState::Down && ls(nextState) == link_state::LinkState::Up) {
             if (ps(mCompositeState) == link_prober::LinkProberState::Label::Active) {
                 // The link prober already holds a definitive Active state before the
@@ -1109,7 +1123,7 @@ void ActiveActiveStateMachine::switchMuxState(
         enterMuxState(nextState, label);
         mMuxStateMachine.setWaitStateCause(mux_state::WaitState::WaitStateCause::SwssUpdate);
         mMuxPortPtr->postMetricsEvent(Metrics::SwitchingStart, label);
-        mMuxPortPtr->setMuxState(label);
+        mMuxPortPtr->setMuxState(label, forceSwitch);
         mDeadlineTimer.cancel();
         startMuxWaitTimer();
     } else {
@@ -1425,11 +1439,12 @@ void ActiveActiveStateMachine::shutdownOrRestartLinkProberOnDefaultRoute()
 }
 
 //
-// ---> handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount);
+// ---> handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount, const link_prober::HeartbeatLossWindowStats &selfLossStats, const link_prober::HeartbeatLossWindowStats &peerLossStats);
 // 
 // handle post pck loss ratio 
 //
-void ActiveActiveStateMachine::handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount)
+void ActiveActiveStateMachine::handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount,
+        const link_prober::HeartbeatLossWindowStats &selfLossStats, const link_prober::HeartbeatLossWindowStats &peerLossStats)
 {
     MUXLOGDEBUG(boost::format("%s: posting pck loss ratio, pck_loss_count / pck_expected_count : %d / %d") %
         mMuxPortConfig.getPortName() %
@@ -1437,7 +1452,7 @@ void ActiveActiveStateMachine::handlePostPckLossRatioNotification(const uint64_t
         expectedPacketCount
     );
     
-    mMuxPortPtr->postPckLossRatio(unknownEventCount, expectedPacketCount);
+    mMuxPortPtr->postPckLossRatio(unknownEventCount, expectedPacketCount, selfLossStats, peerLossStats);
 }
 
 // ---> handleResetLinkProberPckLossCount();
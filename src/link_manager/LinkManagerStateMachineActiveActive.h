@@ -25,6 +25,7 @@
 #include <boost/function.hpp>
 
 #include "common/AsyncEvent.h"
+#include "common/TimerWheel.h"
 #include "link_manager/LinkManagerStateMachineBase.h"
 #include "link_prober/LinkProberState.h"
 #include "link_state/LinkState.h"
@@ -195,10 +196,13 @@ public: // db event handlers
      * 
      * @param unknownEventCount (in) count of missing icmp packets
      * @param expectedPacketCount (in) count of expected icmp packets
+     * @param selfLossStats (in) loss statistics of recent self heartbeats
+     * @param peerLossStats (in) loss statistics of recent peer heartbeats
      * 
      * @return none
     */
-    void handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount) override;
+    void handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount,
+        const link_prober::HeartbeatLossWindowStats &selfLossStats, const link_prober::HeartbeatLossWindowStats &peerLossStats) override;
 
     /**
      * @method handleResetLinkProberPckLossCount
@@ -688,6 +692,17 @@ private: // testing only
      */
     void setResetIcmpPacketCountsFnPtr(boost::function<void()> resetIcmpPacketCountsFnPtr) { mResetIcmpPacketCountsFnPtr = resetIcmpPacketCountsFnPtr; }
 
+    /**
+     * @method setResetProbeIntervalFnPtr
+     *
+     * @brief set ResetProbeIntervalFnPtr. This method is used for testing
+     *
+     * @param resetProbeIntervalFnPtr (in)           pointer to new resetProbeIntervalFnPtr
+     *
+     * @return none
+     */
+    void setResetProbeIntervalFnPtr(boost::function<void()> resetProbeIntervalFnPtr) { mResetProbeIntervalFnPtr = resetProbeIntervalFnPtr; }
+
     /**
      * @method set
      *
@@ -730,10 +745,10 @@ private:
     uint32_t mMuxProbeBackoffFactor = 1;
 
     bool mWaitMux = false;
-    boost::asio::deadline_timer mDeadlineTimer;
-    boost::asio::deadline_timer mWaitTimer;
-    boost::asio::deadline_timer mPeerWaitTimer;
-    boost::asio::deadline_timer mResyncTimer;
+    common::WheelTimer mDeadlineTimer;
+    common::WheelTimer mWaitTimer;
+    common::WheelTimer mPeerWaitTimer;
+    common::WheelTimer mResyncTimer;
 
     common::AsyncEvent mWaitStateMachineInit;
 
@@ -745,6 +760,7 @@ private:
     boost::function<void()> mShutdownTxFnPtr;
     boost::function<void()> mRestartTxFnPtr;
     boost::function<void ()> mResetIcmpPacketCountsFnPtr;
+    boost::function<void ()> mResetProbeIntervalFnPtr;
     boost::function<void ()> mSendPeerProbeCommandFnPtr;
     boost::function<void (const std::string& linkFailureDetectionState,
             const std::string session_type)> mHandleStateDbUpdateFnPtr;
@@ -23,6 +23,7 @@
 
 #include <boost/bind/bind.hpp>
 
+#include "link_prober/LinkProberRxFanout.h"
 #include "link_prober/LinkProberSw.h"
 #include "link_manager/LinkManagerStateMachineActiveStandby.h"
 #include "common/MuxLogger.h"
@@ -325,7 +326,7 @@ void ActiveStandbyStateMachine::switchMuxState(
         mMuxStateMachine.setWaitStateCause(mux_state::WaitState::WaitStateCause::SwssUpdate);
         mMuxPortPtr->postMetricsEvent(Metrics::SwitchingStart, label);
         mMuxPortPtr->postSwitchCause(cause);
-        mMuxPortPtr->setMuxState(label);
+        mMuxPortPtr->setMuxState(label, forceSwitch);
         if(mMuxPortConfig.ifEnableSwitchoverMeasurement()) {
             mDecreaseIntervalFnPtr(mMuxPortConfig.getLinkWaitTimeout_msec()); 
         }
@@ -348,9 +349,10 @@ void ActiveStandbyStateMachine::handleSwssBladeIpv4AddressUpdate(boost::asio::ip
         mMuxPortConfig.setBladeIpv4Address(address);
 
         try {
+            // prober runs on the RX fanout worker owning the port when fanout is in use
             mLinkProberPtr = std::make_shared<link_prober::LinkProberSw> (
                 mMuxPortConfig,
-                getStrand().context(),
+                link_prober::LinkProberRxFanout::getInstance()->getIoService(mMuxPortConfig.getPortName(), getStrand().context()),
                 mLinkProberStateMachinePtr.get()
             );
             mInitializeProberFnPtr = boost::bind(
@@ -380,6 +382,9 @@ void ActiveStandbyStateMachine::handleSwssBladeIpv4AddressUpdate(boost::asio::ip
             mResetIcmpPacketCountsFnPtr = boost::bind(
                 &link_prober::LinkProberBase::resetIcmpPacketCounts, mLinkProberPtr.get()
             );
+            mResetProbeIntervalFnPtr = boost::bind(
+                &link_prober::LinkProberBase::resetProbeInterval, mLinkProberPtr.get()
+            );
             mShutdownTxFnPtr = boost::bind(
                 &link_prober::LinkProberBase::shutdownTxProbes, mLinkProberPtr.get()
             );
@@ -571,6 +576,9 @@ void ActiveStandbyStateMachine::handleStateChange(LinkStateEvent &event, link_st
 
         CompositeState nextState = mCompositeState;
         ls(nextState) = state;
+        if (mResetProbeIntervalFnPtr) {
+            mResetProbeIntervalFnPtr();
+        }
         if (ls(mCompositeState) == link_state::LinkState::Down &&
             ls(nextState) == link_state::LinkState::Up) {
             // start fresh when the link transition from Down to UP state
@@ -787,6 +795,10 @@ void ActiveStandbyStateMachine::handlePeerLinkStateNotification(const link_state
 //
 void ActiveStandbyStateMachine::handleMuxConfigNotification(const common::MuxPortConfig::Mode mode)
 {
+    if (mResetProbeIntervalFnPtr) {
+        mResetProbeIntervalFnPtr();
+    }
+
     if (mComponentInitState.test(MuxStateComponent) &&
         mode != common::MuxPortConfig::Mode::Auto && 
         mode != common::MuxPortConfig::Mode::Manual &&
@@ -939,11 +951,12 @@ void ActiveStandbyStateMachine::shutdownOrRestartLinkProberOnDefaultRoute()
 }
 
 //
-// ---> handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount);
+// ---> handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount, const link_prober::HeartbeatLossWindowStats &selfLossStats, const link_prober::HeartbeatLossWindowStats &peerLossStats);
 // 
 // handle post pck loss ratio 
 //
-void ActiveStandbyStateMachine::handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount)
+void ActiveStandbyStateMachine::handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount,
+        const link_prober::HeartbeatLossWindowStats &selfLossStats, const link_prober::HeartbeatLossWindowStats &peerLossStats)
 {
     MUXLOGDEBUG(boost::format("%s: posting pck loss ratio, pck_loss_count / pck_expected_count : %d / %d") %
         mMuxPortConfig.getPortName() %
@@ -951,7 +964,7 @@ void ActiveStandbyStateMachine::handlePostPckLossRatioNotification(const uint64_
         expectedPacketCount
     );
     
-    mMuxPortPtr->postPckLossRatio(unknownEventCount, expectedPacketCount);
+    mMuxPortPtr->postPckLossRatio(unknownEventCount, expectedPacketCount, selfLossStats, peerLossStats);
 }
 
 // ---> handleResetLinkProberPckLossCount();
@@ -31,6 +31,7 @@
 #include <vector>
 #include <boost/function.hpp>
 
+#include "common/TimerWheel.h"
 #include "link_manager/LinkManagerStateMachineBase.h"
 #include "link_prober/LinkProberState.h"
 #include "link_state/LinkState.h"
@@ -386,10 +387,13 @@ public:
      * 
      * @param unknownEventCount (in) count of missing icmp packets
      * @param expectedPacketCount (in) count of expected icmp packets
+     * @param selfLossStats (in) loss statistics of recent self heartbeats
+     * @param peerLossStats (in) loss statistics of recent peer heartbeats
      * 
      * @return none
     */
-    void handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount);
+    void handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount,
+        const link_prober::HeartbeatLossWindowStats &selfLossStats, const link_prober::HeartbeatLossWindowStats &peerLossStats);
 
     /**
      * @method handleResetLinkProberPckLossCount
@@ -870,12 +874,25 @@ private:
         mRevertIntervalFnPtr = RevertIntervalFnPtr;
     };
 
+    /**
+     * @method setResetProbeIntervalFnPtr
+     * 
+     * @brief set new ResetProbeIntervalFnPtr for the state machine. This method is used for testing
+     * 
+     * @param  ResetProbeIntervalFnPtr (in) pointer to new ResetProbeIntervalFnPtr
+     * 
+     * @return none
+     */
+    void setResetProbeIntervalFnPtr(boost::function<void ()> ResetProbeIntervalFnPtr) {
+        mResetProbeIntervalFnPtr = ResetProbeIntervalFnPtr;
+    };
+
 private:
     link_state::LinkState::Label mPeerLinkState = link_state::LinkState::Label::Down;
 
-    boost::asio::deadline_timer mDeadlineTimer;
-    boost::asio::deadline_timer mWaitTimer;
-    boost::asio::deadline_timer mOscillationTimer;
+    common::WheelTimer mDeadlineTimer;
+    common::WheelTimer mWaitTimer;
+    common::WheelTimer mOscillationTimer;
     bool mOscillationTimerAlive = false;
 
     boost::function<void ()> mInitializeProberFnPtr;
@@ -886,6 +903,7 @@ private:
     boost::function<void ()> mResumeTxFnPtr;
     boost::function<void ()> mSendPeerSwitchCommandFnPtr;
     boost::function<void ()> mResetIcmpPacketCountsFnPtr;
+    boost::function<void ()> mResetProbeIntervalFnPtr;
     boost::function<void ()> mShutdownTxFnPtr;
     boost::function<void ()> mRestartTxFnPtr;
     boost::function<void (uint32_t switchTime_msec)> mDecreaseIntervalFnPtr;
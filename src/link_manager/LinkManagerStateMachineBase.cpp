@@ -318,15 +318,31 @@ void LinkManagerStateMachineBase::shutdownOrRestartLinkProberOnDefaultRoute()
 }
 
 //
-// ---> handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount);
+// ---> handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount, const link_prober::HeartbeatLossWindowStats &selfLossStats, const link_prober::HeartbeatLossWindowStats &peerLossStats);
 //
 // handle post pck loss ratio
 //
-void LinkManagerStateMachineBase::handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount)
+void LinkManagerStateMachineBase::handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount,
+        const link_prober::HeartbeatLossWindowStats &selfLossStats, const link_prober::HeartbeatLossWindowStats &peerLossStats)
 {
     MUXLOGINFO(mMuxPortConfig.getPortName());
 }
 
+//
+// ---> handlePostProbeIntervalNotification(const uint32_t probeInterval_msec);
+//
+// handle current probing interval of adaptive link prober
+//
+void LinkManagerStateMachineBase::handlePostProbeIntervalNotification(const uint32_t probeInterval_msec)
+{
+    MUXLOGDEBUG(boost::format("%s: posting probe interval: %d msec") %
+        mMuxPortConfig.getPortName() %
+        probeInterval_msec
+    );
+
+    mMuxPortPtr->postProbeInterval(probeInterval_msec);
+}
+
 // ---> handleResetLinkProberPckLossCount();
 //
 // reset link prober heartbeat packet loss count
@@ -496,10 +496,24 @@ public:
      *
      * @param unknownEventCount (in) count of missing icmp packets
      * @param expectedPacketCount (in) count of expected icmp packets
+     * @param selfLossStats (in) loss statistics of recent self heartbeats
+     * @param peerLossStats (in) loss statistics of recent peer heartbeats
      *
      * @return none
      */
-    virtual void handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount);
+    virtual void handlePostPckLossRatioNotification(const uint64_t unknownEventCount, const uint64_t expectedPacketCount,
+        const link_prober::HeartbeatLossWindowStats &selfLossStats, const link_prober::HeartbeatLossWindowStats &peerLossStats);
+
+    /**
+     * @method handlePostProbeIntervalNotification
+     *
+     * @brief handle current probing interval of adaptive link prober
+     *
+     * @param probeInterval_msec (in) current probing interval in msec
+     *
+     * @return none
+     */
+    void handlePostProbeIntervalNotification(const uint32_t probeInterval_msec);
 
     /**
      * @method handleResetLinkProberPckLossCount
@@ -540,6 +554,15 @@ public:
     */
     std::shared_ptr<link_prober::LinkProberStateMachineBase> getLinkProberStateMachinePtr() {return mLinkProberStateMachinePtr;};
 
+    /**
+    *@method getLinkProberPtr
+    *
+    *@brief getter for LinkProberBase pointer
+    *
+    *@return LinkProberBase pointer, nullptr before link prober is initialized
+    */
+    std::shared_ptr<link_prober::LinkProberBase> getLinkProberPtr() {return mLinkProberPtr;};
+
     /**
     *@method getMuxStateMachine
     *
@@ -0,0 +1,120 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * HeartbeatLossWindow.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "HeartbeatLossWindow.h"
+
+namespace link_prober
+{
+
+constexpr size_t HeartbeatLossWindow::WINDOW_SIZE;
+constexpr size_t HeartbeatLossWindow::WORD_BITS;
+constexpr size_t HeartbeatLossWindow::BURST_QUEUE_SIZE;
+
+//
+// ---> HeartbeatLossWindow();
+//
+// class default constructor
+//
+HeartbeatLossWindow::HeartbeatLossWindow()
+{
+    reset();
+}
+
+//
+// ---> record(bool lost);
+//
+// record outcome of a heartbeat
+//
+void HeartbeatLossWindow::record(bool lost)
+{
+    uint64_t position = mPosition++;
+
+    // evict the oldest outcome, a burst has left the window once its last heartbeat is evicted
+    if (position >= WINDOW_SIZE && isLost(position - WINDOW_SIZE)) {
+        mLossCount--;
+        if (!isLost(position - WINDOW_SIZE + 1)) {
+            mBurstCount--;
+        }
+    }
+
+    size_t slot = position % WINDOW_SIZE;
+    uint64_t mask = 1ULL << (slot % WORD_BITS);
+    if (lost) {
+        mBitmap[slot / WORD_BITS] |= mask;
+        mLossCount++;
+        if (mCurrentBurst++ == 0) {
+            mBurstCount++;
+        } else {
+            // the ongoing burst is at the back of the queue, it is pushed again with its new length
+            mBurstQueueSize--;
+        }
+
+        while (mBurstQueueSize > 0 &&
+               mBurstQueue[(mBurstQueueHead + mBurstQueueSize - 1) % BURST_QUEUE_SIZE].length <= mCurrentBurst) {
+            mBurstQueueSize--;
+        }
+        mBurstQueue[(mBurstQueueHead + mBurstQueueSize) % BURST_QUEUE_SIZE] = {position, mCurrentBurst};
+        mBurstQueueSize++;
+    } else {
+        mBitmap[slot / WORD_BITS] &= ~mask;
+        mCurrentBurst = 0;
+    }
+
+    while (mBurstQueueSize > 0 && mBurstQueue[mBurstQueueHead].end + WINDOW_SIZE <= position) {
+        mBurstQueueHead = (mBurstQueueHead + 1) % BURST_QUEUE_SIZE;
+        mBurstQueueSize--;
+    }
+}
+
+//
+// ---> reset();
+//
+// clear all recorded outcomes
+//
+void HeartbeatLossWindow::reset()
+{
+    mBitmap.fill(0);
+    mPosition = 0;
+    mLossCount = 0;
+    mBurstCount = 0;
+    mCurrentBurst = 0;
+    mBurstQueueHead = 0;
+    mBurstQueueSize = 0;
+}
+
+//
+// ---> getStats();
+//
+// getter for loss statistics of current window
+//
+HeartbeatLossWindowStats HeartbeatLossWindow::getStats() const
+{
+    HeartbeatLossWindowStats stats;
+    stats.sampleCount = mPosition < WINDOW_SIZE ? mPosition : WINDOW_SIZE;
+    stats.lossCount = mLossCount;
+    stats.burstCount = mBurstCount;
+    stats.longestBurst = mBurstQueueSize > 0 ? mBurstQueue[mBurstQueueHead].length : 0;
+
+    return stats;
+}
+
+} /* namespace link_prober */
@@ -0,0 +1,142 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * HeartbeatLossWindow.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef LINK_PROBER_HEARTBEATLOSSWINDOW_H_
+#define LINK_PROBER_HEARTBEATLOSSWINDOW_H_
+
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MUX_HEARTBEAT_LOSS_WINDOW_SIZE  1024
+
+namespace link_prober
+{
+
+/**
+ *@struct HeartbeatLossWindowStats
+ *
+ *@brief loss statistics over the last heartbeats kept by HeartbeatLossWindow
+ */
+struct HeartbeatLossWindowStats {
+    uint32_t sampleCount = 0;
+    uint32_t lossCount = 0;
+    uint32_t burstCount = 0;
+    uint32_t longestBurst = 0;
+};
+
+/**
+ *@class HeartbeatLossWindow
+ *
+ *@brief bitmap ring of the last MUX_HEARTBEAT_LOSS_WINDOW_SIZE heartbeat outcomes.
+ *       Loss count and burst count are updated in O(1) as outcomes enter and leave
+ *       the window; longest burst is kept by a monotonic queue of bursts ordered by
+ *       length, which is amortized O(1). A burst counts with its full length as long
+ *       as its last lost heartbeat is within the window.
+ */
+class HeartbeatLossWindow
+{
+public:
+    /**
+    *@method HeartbeatLossWindow
+    *
+    *@brief class default constructor
+    */
+    HeartbeatLossWindow();
+
+    /**
+    *@method ~HeartbeatLossWindow
+    *
+    *@brief class destructor
+    */
+    virtual ~HeartbeatLossWindow() = default;
+
+    /**
+    *@method record
+    *
+    *@brief record outcome of a heartbeat
+    *
+    *@param lost (in)   true if heartbeat reply was not received
+    *
+    *@return none
+    */
+    void record(bool lost);
+
+    /**
+    *@method reset
+    *
+    *@brief clear all recorded outcomes
+    *
+    *@return none
+    */
+    void reset();
+
+    /**
+    *@method getStats
+    *
+    *@brief getter for loss statistics of current window
+    *
+    *@return window loss statistics
+    */
+    HeartbeatLossWindowStats getStats() const;
+
+private:
+    static constexpr size_t WINDOW_SIZE = MUX_HEARTBEAT_LOSS_WINDOW_SIZE;
+    static constexpr size_t WORD_BITS = 64;
+    static constexpr size_t BURST_QUEUE_SIZE = WINDOW_SIZE / 2 + 2;
+
+    static_assert(WINDOW_SIZE >= 2 && WINDOW_SIZE % WORD_BITS == 0,
+        "loss window must hold whole bitmap words");
+
+    /**
+    *@method isLost
+    *
+    *@brief test outcome of heartbeat at absolute position
+    *
+    *@param position (in)   heartbeat position since reset
+    *
+    *@return true if heartbeat was lost
+    */
+    inline bool isLost(uint64_t position) const {
+        size_t slot = position % WINDOW_SIZE;
+        return (mBitmap[slot / WORD_BITS] >> (slot % WORD_BITS)) & 1;
+    };
+
+    struct Burst {
+        uint64_t end;
+        uint32_t length;
+    };
+
+    std::array<uint64_t, WINDOW_SIZE / WORD_BITS> mBitmap;
+    uint64_t mPosition = 0;
+    uint32_t mLossCount = 0;
+    uint32_t mBurstCount = 0;
+    uint32_t mCurrentBurst = 0;
+
+    std::array<Burst, BURST_QUEUE_SIZE> mBurstQueue;
+    size_t mBurstQueueHead = 0;
+    size_t mBurstQueueSize = 0;
+};
+
+} /* namespace link_prober */
+
+#endif /* LINK_PROBER_HEARTBEATLOSSWINDOW_H_ */
@@ -94,7 +94,7 @@ struct IcmpPayload {
     uint32_t cookie;
     uint32_t version;
     uint8_t uuid[8];
-    uint64_t seq;
+    uint64_t seq;   // TX time of software heartbeat in nanoseconds, network byte order
 
     /**
     *@method IcmpPayload
@@ -1,12 +1,19 @@
 #include <memory>
 #include <stdint.h>
 #include <linux/filter.h>
+#include <linux/sockios.h>
 #include "LinkProberBase.h"
+#include "LinkProberBudget.h"
+#include "LinkProberBusyPoll.h"
 #include "LinkProberHw.h"
 #include "LinkProberSw.h"
+#include "LinkProberRxFanout.h"
+#include "LinkProberRxRing.h"
+#include "LinkProberTxBatcher.h"
 #include <boost/bind/bind.hpp>
 #include <sstream>
 #include "common/MuxLogger.h"
+#include "common/InternetChecksum.h"
 #include "common/MuxException.h"
 #include "LinkProberStateMachineActiveActive.h"
 #include "LinkProberStateMachineActiveStandby.h"
@@ -14,23 +21,17 @@
 namespace link_prober
 {
 //
-// Berkeley Packet Filter program that captures incoming ICMP traffic
-//
-SockFilter LinkProberBase::mIcmpFilter[] = {
-    [0]  = {.code = 0x28, .jt = 0, .jf = 0,  .k = 0x0000000c},
-    [1]  = {.code = 0x15, .jt = 0, .jf = 10, .k = 0x00000800},
-    [2]  = {.code = 0x20, .jt = 0, .jf = 0,  .k = 0x0000001a},
-    [3]  = {.code = 0x15, .jt = 0, .jf = 8,  .k = 0x00000000},
-    [4]  = {.code = 0x30, .jt = 0, .jf = 0,  .k = 0x00000017},
-    [5]  = {.code = 0x15, .jt = 0, .jf = 6,  .k = 0x00000001},
-    [6]  = {.code = 0x28, .jt = 0, .jf = 0,  .k = 0x00000014},
-    [7]  = {.code = 0x45, .jt = 4, .jf = 0,  .k = 0x00001fff},
-    [8]  = {.code = 0xb1, .jt = 0, .jf = 0,  .k = 0x0000000e},
-    [9]  = {.code = 0x50, .jt = 0, .jf = 0,  .k = 0x0000000e},
-    [10] = {.code = 0x15, .jt = 0, .jf = 1,  .k = 0x00000000},
-    [11] = {.code = 0x6,  .jt = 0, .jf = 0,  .k = 0x00040000},
-    [12] = {.code = 0x6,  .jt = 0, .jf = 0,  .k = 0x00000000},
-};
+// ---> getRealTime();
+//
+// current CLOCK_REALTIME in nanoseconds, the clock kernel RX timestamps are taken from
+//
+static uint64_t getRealTime()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    return now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
 
 LinkProberBase::LinkProberBase(common::MuxPortConfig &muxPortConfig, boost::asio::io_service &ioService,
             LinkProberStateMachineBase *linkProberStateMachinePtr) :
@@ -43,24 +44,33 @@ LinkProberBase::LinkProberBase(common::MuxPortConfig &muxPortConfig, boost::asio
     mSuspendTimer(mIoService),
     mSwitchoverTimer(mIoService)
 {
-    try {
-        mSockFilterPtr = std::shared_ptr<SockFilter> (
-            new SockFilter[sizeof(mIcmpFilter) / sizeof(*mIcmpFilter)],
-            std::default_delete<SockFilter[]>()
-        );
-        memcpy(mSockFilterPtr.get(), mIcmpFilter, sizeof(mIcmpFilter));
+    setSelfGuidData(generateGuid());
 
-        mSockFilterProg.len = sizeof(mIcmpFilter) / sizeof(*mIcmpFilter);
-        mSockFilterProg.filter = mSockFilterPtr.get();
+    memset(mRxBatchMsgHdrs.data(), 0, sizeof(mRxBatchMsgHdrs));
+    for (size_t i = 0; i < mRxBatchSize; i++) {
+        mRxBatchMsgHdrs[i].msg_hdr.msg_iov = &mRxBatchIovecs[i];
+        mRxBatchMsgHdrs[i].msg_hdr.msg_iovlen = 1;
+        mRxBatchMsgHdrs[i].msg_hdr.msg_control = mRxBatchControls[i].data();
     }
-    catch (const std::bad_alloc& ex) {
-        std::ostringstream errMsg;
-        errMsg << "Failed allocate memory. Exception details: " << ex.what();
+}
 
-        throw MUX_ERROR(BadAlloc, errMsg.str());
+//
+// ---> ~LinkProberBase();
+//
+// class destructor
+//
+LinkProberBase::~LinkProberBase()
+{
+    LinkProberBudget::getInstance()->unregisterLinkProber(this);
+    if (mLowLatencyRxEnabled) {
+        LinkProberBusyPoll::getInstance()->unregisterLinkProber(this);
+    }
+    if (mRxRingEnabled) {
+        LinkProberRxRing::getInstance()->unregisterLinkProber(mIfIndex, this);
+    }
+    if (mRxFanoutEnabled) {
+        LinkProberRxFanout::getInstance()->unregisterLinkProber(mIfIndex, this);
     }
-
-    setSelfGuidData(generateGuid());
 }
 
 //
@@ -69,8 +79,15 @@ LinkProberBase::LinkProberBase(common::MuxPortConfig &muxPortConfig, boost::asio
 // creation of socket to recieve icmp packets only and setup recieve stream
 //
 void LinkProberBase::setupSocket() {
+    LinkProberRxRingPtr rxRingPtr = LinkProberRxRing::getInstance();
+    LinkProberRxFanoutPtr rxFanoutPtr = LinkProberRxFanout::getInstance();
+    mRxFanoutEnabled = rxFanoutPtr->isEnabled();
+    mRxRingEnabled = !mRxFanoutEnabled && rxRingPtr->isEnabled();
+    mTxBatchEnabled = LinkProberTxBatcher::getInstance()->isEnabled();
+    mIfIndex = if_nametoindex(mMuxPortConfig.getPortName().c_str());
+
 	SockAddrLinkLayer addr = {0};
-    addr.sll_ifindex = if_nametoindex(mMuxPortConfig.getPortName().c_str());
+    addr.sll_ifindex = mIfIndex;
     addr.sll_family = AF_PACKET;
     addr.sll_protocol = htons(ETH_P_ALL);
 
@@ -89,20 +106,153 @@ void LinkProberBase::setupSocket() {
         throw MUX_ERROR(SocketError, errMsg.str());
     }
 
-    mSockFilterPtr.get()[3].k = mMuxPortConfig.getBladeIpv4Address().to_v4().to_uint();
-    if (setsockopt(mSocket, SOL_SOCKET, SO_ATTACH_FILTER, &mSockFilterProg, sizeof(mSockFilterProg)) != 0) {
+    if (mRxRingEnabled || mRxFanoutEnabled) {
+        // replies are received through the shared RX ring or fanout workers, keep this socket for TX only
+        mSockFilter.compileDropAll();
+    } else {
+        mSockFilter.compile(getIcmpFilterIdentity());
+    }
+    if (!attachSocketFilter()) {
         std::ostringstream errMsg;
         errMsg << "Failed to attach filter with '" << strerror(errno) << "'"
                << std::endl;
         throw MUX_ERROR(SocketError, errMsg.str());
     }
 
+    // kernel RX timestamps are used for heartbeat RTT, fall back to user space time without them
+    int timestampingFlags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    if (!mRxRingEnabled && !mRxFanoutEnabled &&
+        setsockopt(mSocket, SOL_SOCKET, SO_TIMESTAMPING, &timestampingFlags, sizeof(timestampingFlags))) {
+        MUXLOGWARNING(boost::format("%s: Failed to enable RX timestamps with '%s'") %
+            mMuxPortConfig.getPortName() %
+            strerror(errno)
+        );
+    }
+
     mStream.assign(mSocket);
 
     initializeSendBuffer();
+    if (mRxRingEnabled) {
+        rxRingPtr->registerLinkProber(mIfIndex, this);
+    } else if (mRxFanoutEnabled) {
+        rxFanoutPtr->registerLinkProber(mIfIndex, this, mIoService);
+    } else if (mMuxPortConfig.ifEnableLowLatencyRx()) {
+        enableLowLatencyRx();
+    }
     startInitRecv();
 }
 
+//
+// ---> updateRxMode();
+//
+// switch between io_service and busy poll reception when low latency config of the port changes
+//
+void LinkProberBase::updateRxMode()
+{
+    if (mRxRingEnabled || mRxFanoutEnabled || !mStream.is_open() || mMuxPortConfig.ifEnableLowLatencyRx() == mLowLatencyRxEnabled) {
+        return;
+    }
+
+    if (mMuxPortConfig.ifEnableLowLatencyRx()) {
+        // abort pending readiness wait, handleRecv does not re-arm on error
+        boost::system::error_code errorCode;
+        mStream.cancel(errorCode);
+        enableLowLatencyRx();
+    } else {
+        LinkProberBusyPoll::getInstance()->unregisterLinkProber(this);
+        LinkProberBusyPoll::disableBusyPoll(mSocket);
+        mRxLatencyHistogram.reset();
+        mLowLatencyRxEnabled = false;
+
+        MUXLOGWARNING(boost::format("%s: Low latency receive disabled") % mMuxPortConfig.getPortName());
+
+        startRecv();
+    }
+}
+
+//
+// ---> enableLowLatencyRx();
+//
+// busy poll socket and receive its frames on the busy poll thread
+//
+void LinkProberBase::enableLowLatencyRx()
+{
+    if (!LinkProberBusyPoll::enableBusyPoll(mSocket)) {
+        // frames are still received on the busy poll thread, only without kernel busy polling
+        MUXLOGWARNING(boost::format("%s: Failed to enable socket busy poll with '%s'") %
+            mMuxPortConfig.getPortName() %
+            strerror(errno)
+        );
+    }
+
+    // samples of the previous receive mode are not mixed with the new ones
+    mRxLatencyHistogram.reset();
+    mLowLatencyRxEnabled = true;
+    LinkProberBusyPoll::getInstance()->registerLinkProber(mSocket, this);
+
+    MUXLOGWARNING(boost::format("%s: Low latency receive enabled") % mMuxPortConfig.getPortName());
+}
+
+//
+// ---> getIcmpFilterIdentity();
+//
+// build prober identity matched by socket filter from port config
+//
+IcmpFilterIdentity LinkProberBase::getIcmpFilterIdentity()
+{
+    IcmpFilterIdentity identity;
+    identity.bladeIpv4 = mMuxPortConfig.getBladeIpv4Address().to_v4().to_uint();
+    identity.matchServerId = true;
+    identity.serverId = mMuxPortConfig.getServerId();
+    // software prober accepts hardware cookie with any echo id
+    identity.matchHwEchoId = mMuxPortConfig.getLinkProberType() == common::MuxPortConfig::LinkProberType::Hardware;
+    identity.softwareCookie = IcmpPayload::getSoftwareCookie();
+    identity.hardwareCookie = IcmpPayload::getHardwareCookie();
+    identity.version = IcmpPayload::getVersion();
+
+    return identity;
+}
+
+//
+// ---> attachSocketFilter();
+//
+// attach compiled socket filter, replacing the one already attached
+//
+bool LinkProberBase::attachSocketFilter()
+{
+    SockFilterProg sockFilterProg = mSockFilter.getSockFilterProg();
+
+    return setsockopt(mSocket, SOL_SOCKET, SO_ATTACH_FILTER, &sockFilterProg, sizeof(sockFilterProg)) == 0;
+}
+
+//
+// ---> updateSocketFilter();
+//
+// recompile and re-attach socket filter when prober identity changed
+//
+void LinkProberBase::updateSocketFilter()
+{
+    if (mRxRingEnabled || mRxFanoutEnabled || mSocket <= 0) {
+        return;
+    }
+
+    IcmpFilterIdentity identity = getIcmpFilterIdentity();
+    if (identity != mSockFilter.getIdentity()) {
+        mSockFilter.compile(identity);
+        if (attachSocketFilter()) {
+            MUXLOGINFO(boost::format("%s: Re-attached socket filter for server %s") %
+                mMuxPortConfig.getPortName() %
+                mMuxPortConfig.getBladeIpv4Address().to_string()
+            );
+        } else {
+            MUXLOGERROR(boost::format("%s: Failed to re-attach socket filter with '%s'") %
+                mMuxPortConfig.getPortName() %
+                strerror(errno)
+            );
+        }
+    }
+}
+
 //
 // ---> startInitRecv();
 //
@@ -112,8 +262,14 @@ void LinkProberBase::startInitRecv()
 {
     MUXLOGTRACE(mMuxPortConfig.getPortName());
 
+    if (mRxRingEnabled || mRxFanoutEnabled || mLowLatencyRxEnabled) {
+        // first frame delivered by the shared RX ring, fanout worker or busy poll thread completes initial reception
+        mInitRecvPending = true;
+        return;
+    }
+
     mStream.async_read_some(
-        boost::asio::buffer(mRxBuffer, MUX_MAX_ICMP_BUFFER_SIZE),
+        boost::asio::buffer(mRxBuffer.data(), mRxBuffer.size()),
         mStrand.wrap(boost::bind(
             &LinkProberBase::handleInitRecv,
             this,
@@ -157,73 +313,461 @@ void LinkProberBase::handleInitRecv(
 }
 
 //
-// ---> handleRecv(const boost::system::error_code& errorCode, size_t bytesTransferred);
+// ---> handleRecv(const boost::system::error_code& errorCode);
 //
-// handle packet reception
+// handle socket readiness, process all queued frames and re-arm reception
 //
-void LinkProberBase::handleRecv(
-    const boost::system::error_code& errorCode,
-    size_t bytesTransferred
-)
+void LinkProberBase::handleRecv(const boost::system::error_code& errorCode)
 {
     MUXLOGDEBUG(mMuxPortConfig.getPortName());
-    bool isProberHw  = mMuxPortConfig.getLinkProberType() == common::MuxPortConfig::LinkProberType::Hardware;
-    if(isProberHw)
+
+    if (!errorCode && !mLowLatencyRxEnabled)
     {
-        MUXLOGWARNING(boost::format("Raw GUID PORT: {%s}") % mMuxPortConfig.getPortName());
+        size_t frameCount = drainRecv();
+        if (frameCount > 0) {
+            mRxWakeupCount++;
+            mRxFrameCount += frameCount;
+            if (frameCount > mRxMaxFramesPerWakeup) {
+                mRxMaxFramesPerWakeup = frameCount;
+            }
+            if (frameCount > 1) {
+                MUXLOGTRACE(boost::format("%s: Processed %d frames in one wakeup") %
+                    mMuxPortConfig.getPortName() %
+                    frameCount
+                );
+            }
+        }
+
+        startRecv();
+    } else {
+        MUXLOGDEBUG(boost::format("Recv System Error {%s} for PORT: {%s}") %  errorCode.message() % mMuxPortConfig.getPortName());
     }
+}
 
-    if (!errorCode)
-    {
-        iphdr *ipHeader = reinterpret_cast<iphdr *> (mRxBuffer.data() + sizeof(ether_header));
-        icmphdr *icmpHeader = reinterpret_cast<icmphdr *> (
-            mRxBuffer.data() + sizeof(ether_header) + sizeof(iphdr)
-        );
+//
+// ---> drainRecv();
+//
+// receive and process frames already queued on socket with non-blocking recvmmsg
+//
+size_t LinkProberBase::drainRecv()
+{
+    size_t frameCount = 0;
+    size_t recvCount = 0;
+
+    // batch buffers are held from the shared pool only while the socket is drained
+    LinkProberBufferPoolPtr bufferPoolPtr = LinkProberBufferPool::getInstance();
+    size_t bufferSize = 0;
+
+    while (mStream.is_open() && recvCount < mRxDrainLimit) {
+        if (!mRxJumboEnabled) {
+            // size of the frame at the head of the queue, a jumbo heartbeat must not be truncated by a pool buffer
+            int nextFrameSize = 0;
+            if (ioctl(mSocket, SIOCINQ, &nextFrameSize) == 0 && nextFrameSize > MUX_POOL_BUFFER_SIZE) {
+                enableRxJumbo(nextFrameSize);
+            }
+        }
+        size_t batchBufferSize = mRxJumboEnabled ? MUX_MAX_ICMP_BUFFER_SIZE : MUX_POOL_BUFFER_SIZE;
+        if (bufferSize != batchBufferSize) {
+            bufferSize = batchBufferSize;
+            for (size_t i = 0; i < mRxBatchSize; i++) {
+                mRxBatchBuffers[i] = bufferPoolPtr->acquire(bufferSize);
+                mRxBatchIovecs[i].iov_base = mRxBatchBuffers[i].data();
+                mRxBatchIovecs[i].iov_len = mRxBatchBuffers[i].size();
+            }
+        }
+
+        for (struct mmsghdr &msgHdr: mRxBatchMsgHdrs) {
+            msgHdr.msg_hdr.msg_controllen = sizeof(mRxBatchControls[0]);
+            msgHdr.msg_hdr.msg_flags = 0;
+        }
+        int rc = recvmmsg(mSocket, mRxBatchMsgHdrs.data(), mRxBatchSize, MSG_DONTWAIT, nullptr);
+        if (rc <= 0) {
+            if (rc < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                MUXLOGDEBUG(boost::format("%s: recvmmsg failed with '%s'") %
+                    mMuxPortConfig.getPortName() %
+                    strerror(errno)
+                );
+            }
+            break;
+        }
 
-        MUXLOGTRACE(boost::format("%s: Got data from: %s, size: %d") %
+        for (int i = 0; i < rc; i++) {
+            if (mRxBatchMsgHdrs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                // only the head of the queue is sized before receiving, a jumbo frame behind it is lost
+                mRxTruncatedFrameCount++;
+                enableRxJumbo(mRxBatchMsgHdrs[i].msg_len);
+                continue;
+            }
+            mRxFramePtr = mRxBatchBuffers[i].data();
+            mRxTimestamp = getRxTimestamp(mRxBatchMsgHdrs[i].msg_hdr);
+            processRxFrame(mRxBatchMsgHdrs[i].msg_len);
+            frameCount++;
+        }
+        mRxFramePtr = mRxBuffer.data();
+        mRxTimestamp = 0;
+        recvCount += rc;
+
+        if (static_cast<size_t> (rc) < mRxBatchSize) {
+            // socket queue is empty
+            break;
+        }
+    }
+
+    for (PacketBuffer &packetBuffer: mRxBatchBuffers) {
+        packetBuffer.reset();
+    }
+
+    return frameCount;
+}
+
+//
+// ---> enableRxJumbo(size_t frameSize);
+//
+// switch frame reception to jumbo buffers once a heartbeat outgrows the pool buffer size
+//
+void LinkProberBase::enableRxJumbo(size_t frameSize)
+{
+    if (!mRxJumboEnabled) {
+        mRxJumboEnabled = true;
+        MUXLOGWARNING(boost::format("%s: received %d bytes heartbeat, switching to jumbo RX buffers") %
             mMuxPortConfig.getPortName() %
-            boost::asio::ip::address_v4(ntohl(ipHeader->saddr)).to_string() %
-            (bytesTransferred - sizeof(iphdr) - sizeof(ether_header))
+            frameSize
         );
+    }
+}
 
-        IcmpPayload *icmpPayload = reinterpret_cast<IcmpPayload *> (
-            mRxBuffer.data() + mPacketHeaderSize
-        );
+//
+// ---> getRxTimestamp(const struct msghdr &msgHdr);
+//
+// extract kernel receive timestamp from SO_TIMESTAMPING control message
+//
+uint64_t LinkProberBase::getRxTimestamp(const struct msghdr &msgHdr)
+{
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msgHdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(const_cast<struct msghdr *> (&msgHdr), cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPING) {
+            struct scm_timestamping *timestamping = reinterpret_cast<struct scm_timestamping *> (CMSG_DATA(cmsg));
+            if (timestamping->ts[0].tv_sec != 0 || timestamping->ts[0].tv_nsec != 0) {
+                return timestamping->ts[0].tv_sec * 1000000000ULL + timestamping->ts[0].tv_nsec;
+            }
+        }
+    }
 
+    return getRealTime();
+}
 
-        // Handling of cookie and guids:
-        // - reception of peer hw cookie is considered as hw prober in peer
-        //   and will trigger creation of RX session in hw recording the peer guid.
-        // - reception of new peer guid with hardware cookie will trigger deletion of old
-        //   hardware RX session and creation of new session.
-        // - TLV probe will always use software.
-        // - software peer guid may not be unique across mux ports fo backward compatibilty,
-        //   however we will record it in the global set to avoid collisions.
-        if (isProberHw)
-        {
-            (static_cast<LinkProberHw *>(this))->handleIcmpPayload(bytesTransferred, icmpHeader, icmpPayload);
-        } else {
-            (static_cast<LinkProberSw *>(this))->handleIcmpPayload(bytesTransferred, icmpHeader, icmpPayload);
+//
+// ---> recordHeartbeatRtt(IcmpPayload *icmpPayload);
+//
+// record RTT of a self heartbeat reply from TX timestamp carried in its payload
+//
+void LinkProberBase::recordHeartbeatRtt(IcmpPayload *icmpPayload)
+{
+    uint64_t txTimestamp;
+    memcpy(&txTimestamp, reinterpret_cast<uint8_t *> (icmpPayload) + offsetof(IcmpPayload, seq), sizeof(txTimestamp));
+    txTimestamp = be64toh(txTimestamp);
+
+    // older ToRs leave seq at 0, a realtime clock step may put TX time ahead of RX time
+    if (mRxTimestamp == 0 || txTimestamp == 0 || txTimestamp > mRxTimestamp) {
+        return;
+    }
+
+    mRttHistogram.record((mRxTimestamp - txTimestamp) / 1000);
+}
+
+//
+// ---> getProbeTimerDelay_msec(uint64_t now_msec);
+//
+// get delay of next heartbeat timeout, aligned to the port phase when probe phase spread is enabled
+//
+uint32_t LinkProberBase::getProbeTimerDelay_msec(uint64_t now_msec)
+{
+    uint32_t interval_msec = getProbingInterval();
+    if (!mMuxPortConfig.ifEnableProbePhaseSpread() || interval_msec == 0) {
+        return interval_msec;
+    }
+
+    uint32_t phase_msec = mMuxPortConfig.getProbePhase_msec(interval_msec);
+    uint32_t delay_msec = (phase_msec + interval_msec - now_msec % interval_msec) % interval_msec;
+    if (delay_msec < (interval_msec + 1) / 2) {
+        delay_msec += interval_msec;
+    }
+
+    return delay_msec;
+}
+
+//
+// ---> resetProbeInterval();
+//
+// snap adaptive probing interval back to the configured fast interval
+//
+void LinkProberBase::resetProbeInterval()
+{
+    MUXLOGDEBUG(mMuxPortConfig.getPortName());
+
+    mStableProbeCount = 0;
+    setAdaptiveProbeInterval(0);
+}
+
+//
+// ---> updateAdaptiveProbeInterval(bool heartbeatReceived);
+//
+// relax probing interval on port unwatched by peer when stable or in manual mode, snap back on
+// missed heartbeat
+//
+void LinkProberBase::updateAdaptiveProbeInterval(bool heartbeatReceived)
+{
+    uint32_t interval_msec = mMuxPortConfig.getTimeoutIpv4_msec();
+    uint32_t maxInterval_msec = mMuxPortConfig.getMaxTimeoutIpv4_msec();
+
+    if (maxInterval_msec <= interval_msec || mDecreaseProbingInterval) {
+        resetProbeInterval();
+    } else if (isHeartbeatWatchedByPeer()) {
+        // peer ToR declares our heartbeats missing after interval_v4 x negative_signal_count,
+        // whatever our own mux mode is
+        resetProbeInterval();
+    } else if (mMuxPortConfig.getMode() == common::MuxPortConfig::Mode::Manual ||
+               mMuxPortConfig.getMode() == common::MuxPortConfig::Mode::Detached) {
+        // link prober state cannot trigger a switchover, slow probing only feeds metrics
+        setAdaptiveProbeInterval(maxInterval_msec);
+    } else if (!heartbeatReceived) {
+        resetProbeInterval();
+    } else if (++mStableProbeCount >= mMuxPortConfig.getStableHeartbeatCount()) {
+        mStableProbeCount = 0;
+        uint64_t nextInterval_msec = 2ULL * std::max(mAdaptiveInterval_msec, interval_msec);
+        setAdaptiveProbeInterval(std::min<uint64_t> (nextInterval_msec, maxInterval_msec));
+    }
+}
+
+//
+// ---> isHeartbeatWatchedByPeer();
+//
+// check if peer ToR judges our heartbeats at the configured interval
+//
+bool LinkProberBase::isHeartbeatWatchedByPeer() const
+{
+    // standby ToR of active-standby port watches heartbeats of active ToR even though the mux
+    // drops its own heartbeats, active-active ToRs see each other's heartbeats once peer is up
+    return mMuxPortConfig.getPortCableType() == common::MuxPortConfig::PortCableType::ActiveStandby ||
+        mPeerGuid != 0;
+}
+
+//
+// ---> setAdaptiveProbeInterval(uint32_t interval_msec);
+//
+// set adaptive probing interval and post it to link manager when it changes
+//
+void LinkProberBase::setAdaptiveProbeInterval(uint32_t interval_msec)
+{
+    if (interval_msec == mAdaptiveInterval_msec) {
+        return;
+    }
+
+    uint32_t prevInterval_msec = getAdaptiveProbingInterval();
+    mAdaptiveInterval_msec = interval_msec;
+    uint32_t probeInterval_msec = getAdaptiveProbingInterval();
+    if (probeInterval_msec == prevInterval_msec) {
+        return;
+    }
+
+    MUXLOGINFO(boost::format("%s: probing interval changed from %d to %d msec") %
+        mMuxPortConfig.getPortName() %
+        prevInterval_msec %
+        probeInterval_msec
+    );
+
+    boost::asio::io_service::strand &strand = mLinkProberStateMachinePtr->getStrand();
+    boost::asio::io_service &ioService = strand.context();
+    ioService.post(strand.wrap(boost::bind(
+        &LinkProberStateMachineBase::handleProbeIntervalUpdate,
+        mLinkProberStateMachinePtr,
+        probeInterval_msec
+    )));
+}
+
+//
+// ---> updateProbeBudget();
+//
+// report heartbeat demand of the port to heartbeat budget and apply allocated interval
+//
+void LinkProberBase::updateProbeBudget()
+{
+    ProbeDemand demand;
+    demand.interval_msec = std::max(
+        mDecreaseProbingInterval? mMuxPortConfig.getDecreasedTimeoutIpv4_msec():getAdaptiveProbingInterval(),
+        mMuxPortConfig.getMinProbeInterval_msec()
+    );
+    demand.maxInterval_msec = mMuxPortConfig.getMaxProbeInterval_msec();
+    demand.priority = mMuxPortConfig.getProbePriority();
+    demand.active = !mShutdownTx && !mSuspendTx;
+    if (mMuxPortConfig.isLinkUp() && isHeartbeatWatchedByPeer()) {
+        // peer ToR declares our heartbeats missing after interval_v4 x negative_signal_count,
+        // whatever our own mux mode is, keep one interval of margin for timer jitter
+        uint32_t negativeCount = mMuxPortConfig.getNegativeStateChangeRetryCount();
+        uint64_t peerMaxInterval_msec = negativeCount > 1 ?
+            static_cast<uint64_t> (mMuxPortConfig.getTimeoutIpv4_msec()) * (negativeCount - 1) : 0;
+        demand.maxInterval_msec = std::min<uint64_t> (demand.maxInterval_msec, peerMaxInterval_msec);
+    }
+    if ((!mMuxPortConfig.isLinkUp() ||
+         mMuxPortConfig.getMode() == common::MuxPortConfig::Mode::Manual ||
+         mMuxPortConfig.getMode() == common::MuxPortConfig::Mode::Detached) &&
+        demand.maxInterval_msec > demand.interval_msec) {
+        demand.interval_msec = demand.maxInterval_msec;
+    }
+
+    mBudgetInterval_msec = LinkProberBudget::getInstance()->allocate(this, demand);
+}
+
+//
+// ---> dumpRttStats();
+//
+// log p50/p99/p999 of self heartbeat RTT and RX latency
+//
+void LinkProberBase::dumpRttStats()
+{
+    const common::LatencyHistogram &selfRtt = getRttHistogram();
+
+    MUXLOGINFO(boost::format("%s: self RTT count: %d, p50: %dus, p99: %dus, p999: %dus, max: %dus; "
+        "RX latency (low latency: %d) count: %d, p50: %dus, p99: %dus, p999: %dus, max: %dus") %
+        mMuxPortConfig.getPortName() %
+        selfRtt.getCount() %
+        selfRtt.getPercentile(50) %
+        selfRtt.getPercentile(99) %
+        selfRtt.getPercentile(99.9) %
+        selfRtt.getMax() %
+        mLowLatencyRxEnabled %
+        mRxLatencyHistogram.getCount() %
+        mRxLatencyHistogram.getPercentile(50) %
+        mRxLatencyHistogram.getPercentile(99) %
+        mRxLatencyHistogram.getPercentile(99.9) %
+        mRxLatencyHistogram.getMax()
+    );
+}
+
+//
+// ---> handleRxRingFrame(uint8_t *frame, size_t size, uint64_t rxTimestamp, std::shared_ptr<void> blockRef);
+//
+// hand a frame received on the shared RX ring or busy poll thread to this link prober
+//
+void LinkProberBase::handleRxRingFrame(uint8_t *frame, size_t size, uint64_t rxTimestamp, std::shared_ptr<void> blockRef)
+{
+    boost::asio::post(mStrand, boost::bind(
+        &LinkProberBase::processRxRingFrame,
+        this,
+        frame,
+        size,
+        rxTimestamp,
+        blockRef
+    ));
+}
+
+//
+// ---> handleRxFanoutFrame(uint8_t *frame, size_t size, uint64_t rxTimestamp);
+//
+// process a frame received by the fanout worker this link prober runs on
+//
+void LinkProberBase::handleRxFanoutFrame(uint8_t *frame, size_t size, uint64_t rxTimestamp)
+{
+    processRxRingFrame(frame, size, rxTimestamp, nullptr);
+}
+
+//
+// ---> processRxRingFrame(uint8_t *frame, size_t size, uint64_t rxTimestamp, std::shared_ptr<void> blockRef);
+//
+// process a frame received on the shared RX ring, fanout worker or busy poll thread
+//
+void LinkProberBase::processRxRingFrame(uint8_t *frame, size_t size, uint64_t rxTimestamp, std::shared_ptr<void> blockRef)
+{
+    MUXLOGDEBUG(mMuxPortConfig.getPortName());
+
+    if (mInitRecvPending) {
+        mInitRecvPending = false;
+        handleInitRecv(boost::system::error_code(), size);
+    }
+
+    // shared RX ring and fanout filters do not match server IP, drop replies of other hosts here
+    iphdr *ipHeader = reinterpret_cast<iphdr *> (frame + sizeof(ether_header));
+    if (size < mTlvStartOffset ||
+        ipHeader->saddr != htonl(mMuxPortConfig.getBladeIpv4Address().to_v4().to_uint())) {
+        return;
+    }
+
+    mRxFramePtr = frame;
+    mRxTimestamp = rxTimestamp;
+    processRxFrame(size);
+    mRxFramePtr = mRxBuffer.data();
+    mRxTimestamp = 0;
+}
+
+//
+// ---> processRxFrame(size_t bytesTransferred);
+//
+// process ICMP ECHOREPLY frame pointed to by mRxFramePtr
+//
+void LinkProberBase::processRxFrame(size_t bytesTransferred)
+{
+    // delay from kernel RX timestamp to processing on this strand
+    if (mRxTimestamp != 0) {
+        uint64_t now = getRealTime();
+        if (now > mRxTimestamp) {
+            mRxLatencyHistogram.record((now - mRxTimestamp) / 1000);
         }
+    }
+
+    bool isProberHw  = mMuxPortConfig.getLinkProberType() == common::MuxPortConfig::LinkProberType::Hardware;
+    if(isProberHw)
+    {
+        MUXLOGTRACE(boost::format("Raw GUID PORT: {%s}") % mMuxPortConfig.getPortName());
+    }
+
+    iphdr *ipHeader = reinterpret_cast<iphdr *> (mRxFramePtr + sizeof(ether_header));
+    icmphdr *icmpHeader = reinterpret_cast<icmphdr *> (
+        mRxFramePtr + sizeof(ether_header) + sizeof(iphdr)
+    );
+
+    MUXLOGTRACE(boost::format("%s: Got data from: %s, size: %d") %
+        mMuxPortConfig.getPortName() %
+        boost::asio::ip::address_v4(ntohl(ipHeader->saddr)).to_string() %
+        (bytesTransferred - sizeof(iphdr) - sizeof(ether_header))
+    );
+
+    IcmpPayload *icmpPayload = reinterpret_cast<IcmpPayload *> (
+        mRxFramePtr + mPacketHeaderSize
+    );
+
+
+    // Handling of cookie and guids:
+    // - reception of peer hw cookie is considered as hw prober in peer
+    //   and will trigger creation of RX session in hw recording the peer guid.
+    // - reception of new peer guid with hardware cookie will trigger deletion of old
+    //   hardware RX session and creation of new session.
+    // - TLV probe will always use software.
+    // - software peer guid may not be unique across mux ports fo backward compatibilty,
+    //   however we will record it in the global set to avoid collisions.
+    if (isProberHw)
+    {
+        (static_cast<LinkProberHw *>(this))->handleIcmpPayload(bytesTransferred, icmpHeader, icmpPayload);
     } else {
-        MUXLOGDEBUG(boost::format("Recv System Error {%s} for PORT: {%s}") %  errorCode.message() % mMuxPortConfig.getPortName());
+        (static_cast<LinkProberSw *>(this))->handleIcmpPayload(bytesTransferred, icmpHeader, icmpPayload);
     }
 }
 
 //
-// ---> handleTlvCommandRecv(Tlv *tlvPtr, bool isPeer);
+// ---> handleTlvCommandRecv(const TlvView &tlv, bool isPeer);
 //
 // process icmp Tlv 
 //
 void LinkProberBase::handleTlvCommandRecv(
-    Tlv *tlvPtr,
+    const TlvView &tlv,
     bool isPeer
 )
 {
-    if (isPeer) {
+    if (isPeer && tlv.length() >= sizeof(Command)) {
+        // peer command may precede a switchover, probe at the fast interval again
+        resetProbeInterval();
+
         boost::asio::io_service::strand &strand = mLinkProberStateMachinePtr->getStrand();
 
-        switch (static_cast<Command>(tlvPtr->command)) {
+        switch (static_cast<Command>(*tlv.value())) {
             case Command::COMMAND_SWITCH_ACTIVE: {
                 MUXLOGWARNING(boost::format("SwitchActiveRequestEvent"));
                 boost::asio::post(strand, boost::bind(
@@ -256,42 +800,24 @@ void LinkProberBase::handleTlvCommandRecv(
 //
 size_t LinkProberBase::findNextTlv(size_t readOffset, size_t bytesTransferred)
 {
-    size_t tlvSize = 0;
-    if (readOffset + sizeof(TlvHead) <= bytesTransferred) {
-        Tlv *tlvPtr = reinterpret_cast<Tlv *> (mRxBuffer.data() + readOffset);
-        tlvSize = (sizeof(TlvHead) + ntohs(tlvPtr->tlvhead.length));
-        if (readOffset + tlvSize > bytesTransferred) {
-            tlvSize = 0;
-        }
-    }
-    return tlvSize;
+    return TlvReader::getTlvSize(mRxFramePtr, bytesTransferred, readOffset);
 }
 
+//
+// ---> handleTlvRecv(size_t bytesTransferred, bool isSelfGuid);
+//
+// walk TLVs of received frame and dispatch them to their handlers
+//
 void LinkProberBase::handleTlvRecv(size_t bytesTransferred, bool isSelfGuid)
 {
-    size_t nextTlvOffset = mTlvStartOffset;
-    size_t nextTlvSize = 0;
-    bool stopProcessTlv = false;
-    Tlv *nextTlvPtr = nullptr;
-    while ((nextTlvPtr = getNextTLVPtr(nextTlvOffset, bytesTransferred, nextTlvSize)) && !stopProcessTlv) {
-        switch (nextTlvPtr->tlvhead.type) {
-            case TlvType::TLV_COMMAND: {
-                handleTlvCommandRecv(nextTlvPtr, !isSelfGuid);
-                break;
-            }
-            case TlvType::TLV_SENTINEL: {
-                // sentinel TLV, stop processing
-                stopProcessTlv = true;
-                break;
-            }
-            default: {
-                // try to skip unknown TLV with valid length(>0)
-                stopProcessTlv = (nextTlvSize == sizeof(Tlv));
-                break;
-            }
-        }
-        nextTlvOffset += nextTlvSize;
-    }
+    TlvRecvContext context {this, !isSelfGuid};
+    size_t nextTlvOffset = dispatchTlvs(
+        mTlvRecvDispatchTable,
+        context,
+        TlvReader(mRxFramePtr, bytesTransferred, mTlvStartOffset)
+    );
+    nextTlvOffset = std::max(nextTlvOffset, mTlvStartOffset);
+
     if (nextTlvOffset < bytesTransferred) {
         size_t BytesNotProcessed = bytesTransferred - nextTlvOffset;
         MUXLOGTRACE(boost::format("%s: %d bytes in RxBuffer not processed") %
@@ -301,6 +827,44 @@ void LinkProberBase::handleTlvRecv(size_t bytesTransferred, bool isSelfGuid)
     }
 }
 
+//
+// ---> handleTlvCommand(TlvRecvContext &context, const TlvView &tlv);
+//
+// TLV_COMMAND handler of receive dispatch table
+//
+TlvAction LinkProberBase::handleTlvCommand(TlvRecvContext &context, const TlvView &tlv)
+{
+    context.linkProberPtr->handleTlvCommandRecv(tlv, context.isPeer);
+    return TlvAction::Continue;
+}
+
+//
+// ---> handleTlvSentinel(TlvRecvContext &context, const TlvView &tlv);
+//
+// TLV_SENTINEL handler of receive dispatch table, stop processing
+//
+TlvAction LinkProberBase::handleTlvSentinel(TlvRecvContext &context, const TlvView &tlv)
+{
+    return TlvAction::Stop;
+}
+
+//
+// ---> handleTlvUnknown(TlvRecvContext &context, const TlvView &tlv);
+//
+// handler of unknown TLV types in receive dispatch table
+//
+TlvAction LinkProberBase::handleTlvUnknown(TlvRecvContext &context, const TlvView &tlv)
+{
+    // try to skip unknown TLV with valid length(>0)
+    return tlv.size() == sizeof(Tlv) ? TlvAction::Stop : TlvAction::Continue;
+}
+
+const TlvDispatchTable<LinkProberBase::TlvRecvContext> LinkProberBase::mTlvRecvDispatchTable =
+    makeTlvDispatchTable<TlvRecvContext> ({
+        {TlvType::TLV_COMMAND, &LinkProberBase::handleTlvCommand},
+        {TlvType::TLV_SENTINEL, &LinkProberBase::handleTlvSentinel},
+    }, &LinkProberBase::handleTlvUnknown);
+
 //
 // ---> startRecv();
 //
@@ -310,13 +874,19 @@ void LinkProberBase::startRecv()
 {
     MUXLOGTRACE(mMuxPortConfig.getPortName());
 
-    mStream.async_read_some(
-        boost::asio::buffer(mRxBuffer, MUX_MAX_ICMP_BUFFER_SIZE),
+    if (mRxRingEnabled || mRxFanoutEnabled || mLowLatencyRxEnabled) {
+        // frames are pushed by the shared RX ring, fanout workers or busy poll thread
+        return;
+    }
+
+    // frames are read with recvmmsg once the socket is readable to get their RX timestamps
+    mRxWaitCount++;
+    mStream.async_wait(
+        boost::asio::posix::stream_descriptor::wait_read,
         mStrand.wrap(boost::bind(
             &LinkProberBase::handleRecv,
             this,
-            boost::asio::placeholders::error,
-            boost::asio::placeholders::bytes_transferred
+            boost::asio::placeholders::error
         ))
     );
 }
@@ -343,8 +913,7 @@ void LinkProberBase::initializeSendBuffer()
 
     IcmpPayload *payloadPtr  = new (mTxBuffer.data() + mPacketHeaderSize) IcmpPayload();
     memcpy(payloadPtr->uuid, (mSelfUUID.data + 8), sizeof(payloadPtr->uuid));
-    resetTxBufferTlv();
-    appendTlvSentinel();
+    buildTxTlvTemplates();
     size_t totalPayloadSize = mTxPacketSize - mPacketHeaderSize;
 
     ipHeader->ihl = sizeof(iphdr) >> 2;
@@ -366,6 +935,9 @@ void LinkProberBase::initializeSendBuffer()
     icmpHeader->un.echo.sequence = htons(mTxSeqNo);
 
     computeChecksum(icmpHeader, sizeof(icmphdr) + totalPayloadSize);
+
+    mTxTlvTemplate = Command::COMMAND_NONE;
+    mTxFrameBuilt = true;
 }
 
 //
@@ -375,12 +947,10 @@ void LinkProberBase::initializeSendBuffer()
 //
 size_t LinkProberBase::appendTlvSentinel()
 {
-    size_t tlvSize = sizeof(TlvHead);
-    assert(mTxPacketSize + tlvSize <= MUX_MAX_ICMP_BUFFER_SIZE);
-    Tlv *tlvPtr = reinterpret_cast<Tlv *> (mTxBuffer.data() + mTxPacketSize);
-    tlvPtr->tlvhead.type = TlvType::TLV_SENTINEL;
-    tlvPtr->tlvhead.length = 0;
-    mTxPacketSize += tlvSize;
+    reserveTxBuffer(sizeof(TlvHead));
+    TlvWriter tlvWriter(mTxBuffer.data(), mTxBuffer.size(), mTxPacketSize);
+    size_t tlvSize = tlvWriter.appendSentinel();
+    mTxPacketSize = tlvWriter.getOffset();
     return tlvSize;
 }
 
@@ -456,6 +1026,31 @@ void LinkProberBase::sendPeerSwitchCommand()
     ioService.post(mStrand.wrap(boost::bind(&LinkProberBase::handleSendSwitchCommand, this)));
 }
 
+//
+// ---> handleTxBatchError(const boost::system::error_code &errorCode);
+//
+// report failure to send a heartbeat queued to the TX batcher
+//
+void LinkProberBase::handleTxBatchError(const boost::system::error_code &errorCode)
+{
+    boost::asio::post(mStrand, boost::bind(
+        &LinkProberBase::processTxBatchError,
+        this,
+        errorCode
+    ));
+}
+
+//
+// ---> processTxBatchError(const boost::system::error_code &errorCode);
+//
+// process failure to send a heartbeat queued to the TX batcher
+//
+void LinkProberBase::processTxBatchError(const boost::system::error_code &errorCode)
+{
+    mTxErrorCount++;
+    MUXLOGTRACE(mMuxPortConfig.getPortName() + ": Failed to send heartbeat! Error code: " + errorCode.message());
+}
+
 //
 // ---> sendHeartbeat(bool forceSend)
 //
@@ -468,6 +1063,15 @@ void LinkProberBase::sendHeartbeat(bool forceSend)
     updateIcmpSequenceNo();
     // check if suspend timer is running
     if (forceSend || ((!mSuspendTx) && (!mShutdownTx))) {
+        // TX batcher stamps the heartbeat when the batch is sent
+        if (mTxBatchEnabled &&
+            LinkProberTxBatcher::getInstance()->enqueue(mIfIndex, mTxBuffer.data(), mTxPacketSize, this)) {
+            MUXLOGTRACE(mMuxPortConfig.getPortName() + ": Queued heartbeat to TX batcher");
+            return;
+        }
+
+        updateIcmpTxTimestamp();
+
         boost::system::error_code errorCode;
         mStream.write_some(boost::asio::buffer(mTxBuffer.data(), mTxPacketSize), errorCode);
 
@@ -486,30 +1090,7 @@ void LinkProberBase::sendHeartbeat(bool forceSend)
 //
 uint32_t LinkProberBase::calculateChecksum(uint16_t *data, size_t size)
 {
-    uint32_t sum = 0;
-
-    while (size > 1) {
-        sum += ntohs(*data++);
-        size -= sizeof(uint16_t);
-    }
-
-    if (size) {
-        sum += ntohs(static_cast<uint16_t> ((*reinterpret_cast<uint8_t *> (data))));
-    }
-
-    return sum;
-}
-
-//
-// ---> addChecksumCarryover(uint16_t *checksum, uint32_t sum);
-//
-// add checksum carryover
-//
-void LinkProberBase::addChecksumCarryover(uint16_t *checksum, uint32_t sum)
-{
-    sum = (sum >> 16) + (sum & 0xFFFF);
-    sum += (sum >> 16);
-    *checksum = htons(~sum);
+    return common::InternetChecksum::sum(data, size);
 }
 
 //
@@ -523,7 +1104,7 @@ void LinkProberBase::computeChecksum(icmphdr *icmpHeader, size_t size)
     mIcmpChecksum = calculateChecksum(
         reinterpret_cast<uint16_t *> (icmpHeader), size
     );
-    addChecksumCarryover(&icmpHeader->checksum, mIcmpChecksum);
+    icmpHeader->checksum = common::InternetChecksum::finalize(mIcmpChecksum);
 }
 
 //
@@ -537,7 +1118,7 @@ void LinkProberBase::computeChecksum(iphdr *ipHeader, size_t size)
     mIpChecksum = calculateChecksum(
         reinterpret_cast<uint16_t *> (ipHeader), size
     );
-    addChecksumCarryover(&ipHeader->check, mIpChecksum);
+    ipHeader->check = common::InternetChecksum::finalize(mIpChecksum);
 }
 
 
@@ -556,7 +1137,25 @@ void LinkProberBase::updateIcmpSequenceNo()
     icmphdr *icmpHeader = reinterpret_cast<icmphdr *> (mTxBuffer.data() + sizeof(ether_header) + sizeof(iphdr));
     icmpHeader->un.echo.sequence = htons(++mTxSeqNo);
     mIcmpChecksum += mTxSeqNo ? 1 : 0;
-    addChecksumCarryover(&icmpHeader->checksum, mIcmpChecksum);
+    icmpHeader->checksum = common::InternetChecksum::finalize(mIcmpChecksum);
+}
+
+//
+// ---> updateIcmpTxTimestamp();
+//
+// stamp TX time into heartbeat payload seq field, ICMP checksum is updated incrementally
+//
+void LinkProberBase::updateIcmpTxTimestamp()
+{
+    icmphdr *icmpHeader = reinterpret_cast<icmphdr *> (mTxBuffer.data() + sizeof(ether_header) + sizeof(iphdr));
+    uint8_t *seqPtr = mTxBuffer.data() + mPacketHeaderSize + offsetof(IcmpPayload, seq);
+
+    uint32_t oldSum = calculateChecksum(reinterpret_cast<uint16_t *> (seqPtr), sizeof(uint64_t));
+    uint64_t txTimestamp = htobe64(getRealTime());
+    memcpy(seqPtr, &txTimestamp, sizeof(txTimestamp));
+    uint32_t newSum = calculateChecksum(reinterpret_cast<uint16_t *> (seqPtr), sizeof(uint64_t));
+
+    updateChecksum(&icmpHeader->checksum, mIcmpChecksum, oldSum, newSum);
 }
 
 //
@@ -566,13 +1165,10 @@ void LinkProberBase::updateIcmpSequenceNo()
 //
 size_t LinkProberBase::appendTlvCommand(Command commandType)
 {
-    size_t tlvSize = sizeof(TlvHead) + sizeof(Command);
-    assert(mTxPacketSize + tlvSize <= MUX_MAX_ICMP_BUFFER_SIZE);
-    Tlv *tlvPtr = reinterpret_cast<Tlv *> (mTxBuffer.data() + mTxPacketSize);
-    tlvPtr->tlvhead.type = TlvType::TLV_COMMAND;
-    tlvPtr->tlvhead.length = htons(sizeof(Command));
-    tlvPtr->command = static_cast<uint8_t> (commandType);
-    mTxPacketSize += tlvSize;
+    reserveTxBuffer(sizeof(TlvHead) + sizeof(Command));
+    TlvWriter tlvWriter(mTxBuffer.data(), mTxBuffer.size(), mTxPacketSize);
+    size_t tlvSize = tlvWriter.appendCommand(commandType);
+    mTxPacketSize = tlvWriter.getOffset();
     return tlvSize;
 }
 
@@ -583,11 +1179,7 @@ size_t LinkProberBase::appendTlvCommand(Command commandType)
 //
 void LinkProberBase::initTxBufferTlvSendProbe()
 {
-    resetTxBufferTlv();
-    appendTlvCommand(Command::COMMAND_MUX_PROBE);
-    appendTlvSentinel();
-
-    calculateTxPacketChecksum();
+    applyTxTlvTemplate(Command::COMMAND_MUX_PROBE);
 }
 
 //
@@ -597,10 +1189,7 @@ void LinkProberBase::initTxBufferTlvSendProbe()
 //
 void LinkProberBase::initTxBufferTlvSentinel()
 {
-    resetTxBufferTlv();
-    appendTlvSentinel();
-
-    calculateTxPacketChecksum();
+    applyTxTlvTemplate(Command::COMMAND_NONE);
 }
 
 //
@@ -610,11 +1199,7 @@ void LinkProberBase::initTxBufferTlvSentinel()
 //
 void LinkProberBase::initTxBufferTlvSendSwitch()
 {
-    resetTxBufferTlv();
-    appendTlvCommand(Command::COMMAND_SWITCH_ACTIVE);
-    appendTlvSentinel();
-
-    calculateTxPacketChecksum();
+    applyTxTlvTemplate(Command::COMMAND_SWITCH_ACTIVE);
 }
 
 //
@@ -632,6 +1217,115 @@ void LinkProberBase::calculateTxPacketChecksum()
     computeChecksum(ipHeader, ipHeader->ihl << 2);
 }
 
+//
+// ---> buildTxTlvTemplates();
+//
+// build TLV templates of sentinel, MUX_PROBE and SWITCH_ACTIVE frames, TX buffer is left with sentinel
+//
+void LinkProberBase::buildTxTlvTemplates()
+{
+    // sentinel only frame goes last so it stays in the TX buffer
+    for (Command command: {Command::COMMAND_MUX_PROBE, Command::COMMAND_SWITCH_ACTIVE, Command::COMMAND_NONE}) {
+        TxTlvTemplate &txTlvTemplate = mTxTlvTemplates[static_cast<size_t> (command)];
+
+        resetTxBufferTlv();
+        if (command != Command::COMMAND_NONE) {
+            appendTlvCommand(command);
+        }
+        appendTlvSentinel();
+
+        txTlvTemplate.size = mTxPacketSize - mTlvStartOffset;
+        memcpy(txTlvTemplate.tlv.data(), mTxBuffer.data() + mTlvStartOffset, txTlvTemplate.size);
+        txTlvTemplate.checksum = calculateChecksum(
+            reinterpret_cast<uint16_t *> (mTxBuffer.data() + mTlvStartOffset), txTlvTemplate.size
+        );
+    }
+}
+
+//
+// ---> applyTxTlvTemplate(Command command);
+//
+// switch TX frame to another TLV template, checksums are updated incrementally
+//
+void LinkProberBase::applyTxTlvTemplate(Command command)
+{
+    const TxTlvTemplate &currentTemplate = mTxTlvTemplates[static_cast<size_t> (mTxTlvTemplate)];
+    const TxTlvTemplate &nextTemplate = mTxTlvTemplates[static_cast<size_t> (command)];
+    iphdr *ipHeader = reinterpret_cast<iphdr *> (mTxBuffer.data() + sizeof(ether_header));
+    icmphdr *icmpHeader = reinterpret_cast<icmphdr *> (mTxBuffer.data() + sizeof(ether_header) + sizeof(iphdr));
+
+    memcpy(mTxBuffer.data() + mTlvStartOffset, nextTemplate.tlv.data(), nextTemplate.size);
+    mTxPacketSize = mTlvStartOffset + nextTemplate.size;
+    updateChecksum(&icmpHeader->checksum, mIcmpChecksum, currentTemplate.checksum, nextTemplate.checksum);
+
+    uint16_t totalLength = ntohs(ipHeader->tot_len);
+    ipHeader->tot_len = htons(totalLength - currentTemplate.size + nextTemplate.size);
+    updateChecksum(&ipHeader->check, mIpChecksum, totalLength, ntohs(ipHeader->tot_len));
+
+    mTxTlvTemplate = command;
+}
+
+//
+// ---> updateTxFrameAddresses();
+//
+// patch MAC and IP addresses of the TX frame, IP checksum is updated incrementally
+//
+void LinkProberBase::updateTxFrameAddresses()
+{
+    ether_header *ethHeader = reinterpret_cast<ether_header *> (mTxBuffer.data());
+    memcpy(ethHeader->ether_dhost, mMuxPortConfig.getBladeMacAddress().data(), sizeof(ethHeader->ether_dhost));
+    if (mMuxPortConfig.ifEnableUseTorMac()) {
+        memcpy(ethHeader->ether_shost, mMuxPortConfig.getTorMacAddress().data(), sizeof(ethHeader->ether_shost));
+    } else {
+        memcpy(ethHeader->ether_shost, mMuxPortConfig.getVlanMacAddress().data(), sizeof(ethHeader->ether_shost));
+    }
+
+    iphdr *ipHeader = reinterpret_cast<iphdr *> (mTxBuffer.data() + sizeof(ether_header));
+    uint32_t saddr = mMuxPortConfig.getLoopbackIpv4Address().to_v4().to_uint();
+    uint32_t daddr = mMuxPortConfig.getBladeIpv4Address().to_v4().to_uint();
+    uint32_t oldSaddr = ntohl(ipHeader->saddr);
+    uint32_t oldDaddr = ntohl(ipHeader->daddr);
+    if (saddr != oldSaddr || daddr != oldDaddr) {
+        ipHeader->saddr = htonl(saddr);
+        ipHeader->daddr = htonl(daddr);
+        updateChecksum(
+            &ipHeader->check,
+            mIpChecksum,
+            (oldSaddr >> 16) + (oldSaddr & 0xffff) + (oldDaddr >> 16) + (oldDaddr & 0xffff),
+            (saddr >> 16) + (saddr & 0xffff) + (daddr >> 16) + (daddr & 0xffff)
+        );
+    }
+}
+
+//
+// ---> updateChecksum(uint16_t *checksum, uint32_t &sum, uint32_t oldSum, uint32_t newSum);
+//
+// update checksum for replaced data as per RFC 1624, HC' = ~(~HC + ~m + m')
+//
+void LinkProberBase::updateChecksum(uint16_t *checksum, uint32_t &sum, uint32_t oldSum, uint32_t newSum)
+{
+    sum = common::InternetChecksum::fold(sum) +
+          (~common::InternetChecksum::fold(oldSum) & 0xffff) +
+          common::InternetChecksum::fold(newSum);
+    *checksum = common::InternetChecksum::finalize(sum);
+}
+
+//
+// ---> reserveTxBuffer(size_t size);
+//
+// make room for more bytes at the end of TX frame
+//
+void LinkProberBase::reserveTxBuffer(size_t size)
+{
+    assert(mTxPacketSize + size <= MUX_MAX_ICMP_BUFFER_SIZE);
+
+    if (mTxPacketSize + size > mTxBuffer.size()) {
+        PacketBuffer txBuffer = LinkProberBufferPool::getInstance()->acquire(mTxPacketSize + size);
+        memcpy(txBuffer.data(), mTxBuffer.data(), mTxPacketSize);
+        mTxBuffer = std::move(txBuffer);
+    }
+}
+
 //
 // ---> appendTlvDummy
 //
@@ -639,14 +1333,10 @@ void LinkProberBase::calculateTxPacketChecksum()
 //
 size_t LinkProberBase::appendTlvDummy(size_t paddingSize, int seqNo)
 {
-    size_t tlvSize = sizeof(TlvHead) + paddingSize + sizeof(uint32_t);
-    assert(mTxPacketSize + tlvSize <= MUX_MAX_ICMP_BUFFER_SIZE);
-    Tlv *tlvPtr = reinterpret_cast<Tlv *> (mTxBuffer.data() + mTxPacketSize);
-    tlvPtr->tlvhead.type = TlvType::TLV_DUMMY;
-    tlvPtr->tlvhead.length = htons(paddingSize + sizeof(uint32_t));
-    memset(tlvPtr->data, 0, paddingSize);
-    *(reinterpret_cast<uint32_t *> (tlvPtr->data + paddingSize)) = htonl(seqNo);
-    mTxPacketSize += tlvSize;
+    reserveTxBuffer(sizeof(TlvHead) + paddingSize + sizeof(uint32_t));
+    TlvWriter tlvWriter(mTxBuffer.data(), mTxBuffer.size(), mTxPacketSize);
+    size_t tlvSize = tlvWriter.appendDummy(paddingSize, seqNo);
+    mTxPacketSize = tlvWriter.getOffset();
     return tlvSize;
 }
 
@@ -657,7 +1347,12 @@ size_t LinkProberBase::appendTlvDummy(size_t paddingSize, int seqNo)
 //
 void LinkProberBase::handleUpdateEthernetFrame()
 {
-    initializeSendBuffer();
+    if (mTxFrameBuilt) {
+        updateTxFrameAddresses();
+    } else {
+        initializeSendBuffer();
+    }
+    updateSocketFilter();
 }
 
 //
@@ -677,23 +1372,30 @@ std::string LinkProberBase::uuidToHexString(const boost::uuids::uuid& uuid)
     return oss.str();
 }
 
-void LinkProberBase::getGuidStr(const IcmpPayload *icmpPayload, std::string& guidDataStr)
+//
+// ---> getGuid(const IcmpPayload *icmpPayload);
+//
+// read GUID carried by ICMP payload
+//
+uint32_t LinkProberBase::getGuid(const IcmpPayload *icmpPayload)
 {
-    uint64_t network_guid;
-    std::memcpy(&network_guid, icmpPayload->uuid, sizeof(network_guid));
-    if (network_guid == 0)
-    {
-        MUXLOGWARNING(boost::format("Received invalid Raw GUID: {%d}") % network_guid);
-        guidDataStr = "0";
-    } else {
-        uint64_t host_guid = ntohll(network_guid);
-        host_guid = static_cast<uint32_t>(host_guid);
-        std::stringstream os;
-        os << std::hex << std::setw(8) << std::setfill('0') << host_guid;
-        guidDataStr = os.str();
-        MUXLOGDEBUG(boost::format("Link Prober recieved GUID: {%s}") % guidDataStr);
-    }
-    guidDataStr = "0x" + guidDataStr;
+    uint64_t networkGuid;
+    memcpy(&networkGuid, icmpPayload->uuid, sizeof(networkGuid));
+
+    return static_cast<uint32_t> (ntohll(networkGuid));
+}
+
+//
+// ---> guidToString(uint32_t guid);
+//
+// convert GUID to its string form used in DB keys and logs
+//
+std::string LinkProberBase::guidToString(uint32_t guid)
+{
+    char guidStr[16];
+    snprintf(guidStr, sizeof(guidStr), "0x%08x", guid);
+
+    return std::string(guidStr);
 }
 
 //
@@ -701,7 +1403,7 @@ void LinkProberBase::getGuidStr(const IcmpPayload *icmpPayload, std::string& gui
 //
 // generate unique GUID based on Loopback3 and SoC IP addresses for LinkProber session
 //
-std::string LinkProberBase::generateGuid()
+uint32_t LinkProberBase::generateGuid()
 {
     // Get the last 16 bits from Loopback3 IP address
     boost::asio::ip::address loopback3Ip = mMuxPortConfig.getLoopback3Ipv4Address();
@@ -717,19 +1419,15 @@ std::string LinkProberBase::generateGuid()
     uint32_t deterministicGuid = (static_cast<uint32_t>(loopback3Last16Bits) << 16) | socLast16Bits;
     uint32_t reverseGuid =  htonl(deterministicGuid);
 
-    char guidStr[16];
-    snprintf(guidStr, sizeof(guidStr), "0x%08x", deterministicGuid);
-    std::string generatedGuidStr(guidStr);
-
     boost::uuids::uuid generatedGuid;
     std::fill(generatedGuid.begin(), generatedGuid.end(), 0);
     memcpy(generatedGuid.begin()+12, &reverseGuid, sizeof(reverseGuid));
     mSelfUUID = generatedGuid;
 
     MUXLOGWARNING(boost::format("Link Prober generated GUID: {%s} from Loopback3 IP: %s, SoC IP: %s")
-                  % generatedGuidStr % loopback3Ip.to_string() % socIp.to_string());
+                  % guidToString(deterministicGuid) % loopback3Ip.to_string() % socIp.to_string());
 
-    return generatedGuidStr;
+    return deterministicGuid;
 }
 
 }
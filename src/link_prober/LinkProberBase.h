@@ -1,6 +1,7 @@
 #ifndef LINK_PROBER_LINKPROBERBASE_H_
 #define LINK_PROBER_LINKPROBERBASE_H_
 
+#include <algorithm>
 #include <memory>
 #include <stdint.h>
 #include <vector>
@@ -9,7 +10,9 @@
 #include <iomanip>
 #include <mutex>
 
-#include <netpacket/packet.h>
+#include <linux/errqueue.h>
+#include <linux/if_packet.h>
+#include <linux/net_tstamp.h>
 #include <sys/socket.h>
 #include <sys/ioctl.h>
 #include <malloc.h>
@@ -22,8 +25,13 @@
 #include "LinkProberStateMachineBase.h"
 
 #include "IcmpPayload.h"
+#include "LinkProberBufferPool.h"
+#include "LinkProberFilter.h"
+#include "TlvCodec.h"
+#include "common/LatencyHistogram.h"
 #include "common/MuxPortConfig.h"
 #include "common/MuxLogger.h"
+#include "common/TimerWheel.h"
 
 namespace std {
     template <>
@@ -60,6 +68,17 @@ using SockFilter = struct sock_filter;
 using SockFilterProg = struct sock_fprog;
 using SockAddrLinkLayer = struct sockaddr_ll;
 
+/**
+ *@struct TxTlvTemplate
+ *
+ *@brief prebuilt TLV area of a TX frame variant with its partial ICMP checksum
+ */
+struct TxTlvTemplate {
+    std::array<uint8_t, sizeof(TlvHead) + sizeof(Command) + sizeof(TlvHead)> tlv;
+    size_t size;
+    uint32_t checksum;
+};
+
 
 /**
  *@class LinkProberBase
@@ -103,7 +122,7 @@ public:
     *
     *@brief class destructor
     */
-    ~LinkProberBase() = default;
+    ~LinkProberBase();
 
     /**
     *@method LinkProberBase
@@ -243,6 +262,16 @@ public:
         MUXLOGWARNING(boost::format("Link Prober revertProbeIntervalAfterSwitchComplete not implemented"));
     }
 
+    /**
+    * @method resetProbeInterval
+    *
+    * @brief snap adaptive probing interval back to the configured fast interval, used on
+    *        link events and mux config changes. Takes effect from the next heartbeat.
+    *
+    * @return none
+    */
+    virtual void resetProbeInterval();
+
     virtual void handleIcmpPayload(size_t bytesTransferred, icmphdr *icmpHeader, IcmpPayload *icmpPayload) {
         MUXLOGWARNING(boost::format("Link Prober handleIcmpPayload not implemented"));
     }
@@ -252,9 +281,9 @@ public:
     *
     *@brief getter for self GUID data
     *
-    *@return pointer to current self GUID data
+    *@return current self GUID
     */
-    inline std::string getSelfGuidData() {
+    inline uint32_t getSelfGuidData() {
         return mSelfGuid;
     }
 
@@ -263,9 +292,9 @@ public:
     *
     *@brief getter for PEER GUID data
     *
-    *@return pointer to current PEER GUID data
+    *@return current PEER GUID, 0 if no peer is learned
     */
-    inline std::string getPeerGuidData() {
+    inline uint32_t getPeerGuidData() {
         return mPeerGuid;
     }
 
@@ -276,21 +305,32 @@ public:
     *
     *@return none
     */
-   inline void setSelfGuidData(std::string l_guid) {
-       mSelfGuid = l_guid;
-   }
+    inline void setSelfGuidData(uint32_t guid) {
+        mSelfGuid = guid;
+    }
 
-   /**
+    /**
     *@method setPeerGuidData
     *
     *@brief setter for PEER GUID data
     *
     *@return none
     */
-    inline void setPeerGuidData(std::string l_guid) {
-        mPeerGuid = l_guid;
+    inline void setPeerGuidData(uint32_t guid) {
+        mPeerGuid = guid;
     }
 
+    /**
+    *@method guidToString
+    *
+    *@brief convert GUID to its string form used in DB keys and logs
+    *
+    *@param guid (in)   GUID to convert
+    *
+    *@return GUID string in 0x%08x form
+    */
+    static std::string guidToString(uint32_t guid);
+
     /**
     * @method getPeerSessionType
     *
@@ -305,31 +345,47 @@ public:
     /**
     * @method getProbingInterval
     *
-    * @brief get link prober interval
+    * @brief get link prober interval, no shorter than the interval allocated by heartbeat budget
     *
     * @return link prober interval
     */
     inline uint32_t getProbingInterval() {
         MUXLOGDEBUG(mMuxPortConfig.getPortName());
-        return mDecreaseProbingInterval? mMuxPortConfig.getDecreasedTimeoutIpv4_msec():mMuxPortConfig.getTimeoutIpv4_msec();
+        uint32_t interval_msec = mDecreaseProbingInterval? mMuxPortConfig.getDecreasedTimeoutIpv4_msec():getAdaptiveProbingInterval();
+        return std::max(interval_msec, mBudgetInterval_msec);
     }
 
     /**
-    * @method getNextTlvPtr
+    * @method getAdaptiveProbingInterval
     *
-    * @brief get the next TLV pointer
+    * @brief get link prober interval outside of switchover, relaxed by the adaptive controller
+    *        within the configured maximum interval
     *
-    * @return next Tlv pointer from the offset
+    * @return link prober interval
     */
-    inline Tlv* getNextTLVPtr(size_t offset, size_t bytesTransferred, size_t &nextTlvSize) {
-        nextTlvSize = findNextTlv(offset, bytesTransferred);
-        if (nextTlvSize == 0)
-            return nullptr;
+    inline uint32_t getAdaptiveProbingInterval() const {
+        uint32_t interval_msec = mMuxPortConfig.getTimeoutIpv4_msec();
+        uint32_t maxInterval_msec = mMuxPortConfig.getMaxTimeoutIpv4_msec();
+        if (maxInterval_msec > interval_msec && mAdaptiveInterval_msec > interval_msec) {
+            interval_msec = std::min(mAdaptiveInterval_msec, maxInterval_msec);
+        }
 
-        Tlv *nextTlvPtr = reinterpret_cast<Tlv *> (mRxBuffer.data() + offset);
-        return nextTlvPtr;
+        return interval_msec;
     }
 
+    /**
+    * @method getProbeTimerDelay_msec
+    *
+    * @brief get delay of next heartbeat timeout. When probe phase spread is enabled the timeout
+    *        is aligned to the port phase within the probing interval, at least half an interval
+    *        away so replies have time to arrive
+    *
+    * @param now_msec (in) current monotonic time in msec
+    *
+    * @return timer delay in msec
+    */
+    uint32_t getProbeTimerDelay_msec(uint64_t now_msec);
+
     /**
     *@method updateEthernetFrame
     *
@@ -397,21 +453,219 @@ public:
 
     void resetTxBufferTlv() {mTxPacketSize = mTlvStartOffset;};
 
+    /**
+    *@method getRxTimestamp
+    *
+    *@brief extract kernel receive timestamp from SO_TIMESTAMPING control message
+    *
+    *@param msgHdr (in)     received message header
+    *
+    *@return receive timestamp in nanoseconds, current time if kernel did not stamp the frame
+    */
+    static uint64_t getRxTimestamp(const struct msghdr &msgHdr);
+
+    /**
+    *@method handleRxRingFrame
+    *
+    *@brief hand a frame received on the shared RX ring or busy poll thread to this link prober
+    *
+    *@param frame (in)          pointer to Ethernet frame within RX ring block or busy poll buffer
+    *@param size (in)           size of Ethernet frame
+    *@param rxTimestamp (in)    kernel receive timestamp in nanoseconds
+    *@param blockRef (in)       reference that keeps frame memory valid until it is processed
+    *
+    *@return none
+    */
+    void handleRxRingFrame(uint8_t *frame, size_t size, uint64_t rxTimestamp, std::shared_ptr<void> blockRef);
+
+    /**
+    *@method handleRxFanoutFrame
+    *
+    *@brief process a frame received by the fanout worker this link prober runs on, called
+    *       on the worker thread which is the only thread running link prober handlers
+    *
+    *@param frame (in)          pointer to Ethernet frame within worker buffer
+    *@param size (in)           size of Ethernet frame
+    *@param rxTimestamp (in)    kernel receive timestamp in nanoseconds
+    *
+    *@return none
+    */
+    void handleRxFanoutFrame(uint8_t *frame, size_t size, uint64_t rxTimestamp);
+
+    /**
+    *@method handleTxBatchError
+    *
+    *@brief report failure to send a heartbeat queued to the TX batcher
+    *
+    *@param errorCode (in)      send error code
+    *
+    *@return none
+    */
+    void handleTxBatchError(const boost::system::error_code &errorCode);
+
+    /**
+    *@method getRxWakeupCount
+    *
+    *@brief getter for number of socket read completions that delivered frames
+    *
+    *@return RX wakeup count
+    */
+    inline uint64_t getRxWakeupCount() const {return mRxWakeupCount;};
+
+    /**
+    *@method getRxFrameCount
+    *
+    *@brief getter for number of frames received on socket
+    *
+    *@return RX frame count
+    */
+    inline uint64_t getRxFrameCount() const {return mRxFrameCount;};
+
+    /**
+    *@method getRxMaxFramesPerWakeup
+    *
+    *@brief getter for largest number of frames processed by a single wakeup
+    *
+    *@return max frames per wakeup
+    */
+    inline uint64_t getRxMaxFramesPerWakeup() const {return mRxMaxFramesPerWakeup;};
+
+    /**
+    *@method getTimerWaitCount
+    *
+    *@brief getter for number of heartbeat timeout timer waits armed on io_service
+    *
+    *@return timer wait count
+    */
+    inline uint64_t getTimerWaitCount() const {return mTimerWaitCount;};
+
+    /**
+    *@method getRxWaitCount
+    *
+    *@brief getter for number of socket readiness waits armed on io_service
+    *
+    *@return RX wait count
+    */
+    inline uint64_t getRxWaitCount() const {return mRxWaitCount;};
+
+    /**
+    *@method getRttHistogram
+    *
+    *@brief getter for self heartbeat round trip time histogram, samples are in microseconds.
+    *       Peer heartbeats carry TX time of the peer ToR clock and are not sampled
+    *
+    *@return reference to RTT histogram
+    */
+    inline const common::LatencyHistogram& getRttHistogram() const {return mRttHistogram;};
+
+    /**
+    *@method getRxLatencyHistogram
+    *
+    *@brief getter for histogram of delay from kernel RX timestamp to frame processing,
+    *       samples are in microseconds and restart when receive mode changes
+    *
+    *@return reference to RX latency histogram
+    */
+    inline const common::LatencyHistogram& getRxLatencyHistogram() const {return mRxLatencyHistogram;};
+
+    /**
+    *@method isLowLatencyRxEnabled
+    *
+    *@brief check if frames are received on the busy poll thread
+    *
+    *@return true if low latency receive is in use
+    */
+    inline bool isLowLatencyRxEnabled() const {return mLowLatencyRxEnabled;};
+
+    /**
+    *@method dumpRttStats
+    *
+    *@brief log p50/p99/p999 of self heartbeat RTT and RX latency, safe to call from any thread
+    *
+    *@return none
+    */
+    void dumpRttStats();
+
+    /**
+    *@method getStableProbeCount
+    *
+    *@brief getter for number of consecutive heartbeats received since probing interval last changed
+    *
+    *@return stable heartbeat count
+    */
+    inline uint32_t getStableProbeCount() const {return mStableProbeCount;};
+
+    /**
+    *@method getLossWindow
+    *
+    *@brief getter for sliding window of recent heartbeat outcomes
+    *
+    *@param heartbeatType (in)  self or peer heartbeat
+    *
+    *@return reference to heartbeat loss window
+    */
+    inline const HeartbeatLossWindow& getLossWindow(HeartbeatType heartbeatType) const {
+        return mLossWindows[static_cast<size_t> (heartbeatType)];
+    };
+
     boost::uuids::uuid mSelfUUID;
 
 protected:
+    /**
+    *@method updateAdaptiveProbeInterval
+    *
+    *@brief relax probing interval, doubling it up to the configured maximum, after a run of
+    *       received heartbeats or at once when mux mode is manual or detached. Snap back to the
+    *       fast interval on a missed heartbeat. Ports whose heartbeats are watched by the peer
+    *       ToR keep the fast interval in every mux mode, peer ToR expects them every interval_v4
+    *
+    *@param heartbeatReceived (in)  whether reply of last heartbeat was received
+    *
+    *@return none
+    */
+    void updateAdaptiveProbeInterval(bool heartbeatReceived);
 
     /**
-    *@method addChecksumCarryover
+    *@method isHeartbeatWatchedByPeer
     *
-    *@brief add checksum carryover
+    *@brief check if peer ToR judges our heartbeats, i.e. port is active-standby or a peer
+    *       heartbeat was received on active-active port
     *
-    *@param checksum (out)  pointer to checksum field
-    *@param sum (in)        current sum of the buffer payload
+    *@return true if peer ToR watches our heartbeats
+    */
+    bool isHeartbeatWatchedByPeer() const;
+
+    /**
+    *@method setAdaptiveProbeInterval
     *
-    *@return CRC checksum
+    *@brief set adaptive probing interval and post it to link manager when it changes
+    *
+    *@param interval_msec (in)  new adaptive interval, 0 for the configured fast interval
+    *
+    *@return none
     */
-   void addChecksumCarryover(uint16_t *checksum, uint32_t sum);
+    void setAdaptiveProbeInterval(uint32_t interval_msec);
+
+    /**
+    *@method updateProbeBudget
+    *
+    *@brief report heartbeat demand of the port to heartbeat budget and apply allocated interval.
+    *       Ports that are down or in manual or detached mode ask for their slowest interval only.
+    *       Ports that are up and whose heartbeats are watched by the peer ToR are not throttled
+    *       beyond interval_v4 x (negative_signal_count - 1) in any mux mode
+    *
+    *@return none
+    */
+    void updateProbeBudget();
+
+    /**
+    *@method updateRxMode
+    *
+    *@brief switch between io_service and busy poll reception when low latency config of the port changes
+    *
+    *@return none
+    */
+    void updateRxMode();
 
     /**
     * @method startInitRecv
@@ -440,39 +694,197 @@ protected:
    */
    void setupSocket();
 
+   /**
+   * @method enableLowLatencyRx
+   *
+   * @brief busy poll socket and receive its frames on the busy poll thread
+   *
+   * @return none
+   */
+   void enableLowLatencyRx();
+
+   /**
+   * @method getIcmpFilterIdentity
+   *
+   * @brief build prober identity matched by socket filter from port config
+   *
+   * @return prober identity
+   */
+   IcmpFilterIdentity getIcmpFilterIdentity();
+
+   /**
+   * @method attachSocketFilter
+   *
+   * @brief attach compiled socket filter, replacing the one already attached
+   *
+   * @return true if filter is attached
+   */
+   bool attachSocketFilter();
+
+   /**
+   * @method updateSocketFilter
+   *
+   * @brief recompile and re-attach socket filter when prober identity changed
+   *
+   * @return none
+   */
+   void updateSocketFilter();
+
    /**
    *@method handleTlvCommandRecv
    *
    *@brief handle TLV command
    *
-   *@param tlvPtr (in)     Tlv ptr points to the start of TlvCommand in mRxBuffer
+   *@param tlv (in)        view of TlvCommand in received frame
    *@param isPeer (in)     True if the reply received is from the peer ToR
    *
    *@return none
    */
    void handleTlvCommandRecv(
-       Tlv *tlvPtr,
+       const TlvView &tlv,
        bool isPeer
    );
 
+   /**
+   *@method handleTlvRecv
+   *
+   *@brief walk TLVs of received frame and dispatch them to their handlers
+   *
+   *@param bytesTransferred (in)   size of received frame
+   *@param isSelfGuid (in)         True if the reply carries own GUID
+   *
+   *@return none
+   */
    void handleTlvRecv(
         size_t bytesTransferred,
         bool isSelfGuid
    );
-       /**
+
+   /**
+   *@struct TlvRecvContext
+   *
+   *@brief context handed to TLV handlers of a received frame
+   */
+   struct TlvRecvContext {
+       LinkProberBase *linkProberPtr;
+       bool isPeer;
+   };
+
+   /**
+   *@method handleTlvCommand
+   *
+   *@brief TLV_COMMAND handler of receive dispatch table
+   *
+   *@param context (in)    receive context
+   *@param tlv (in)        view of TLV in received frame
+   *
+   *@return TlvAction::Continue
+   */
+   static TlvAction handleTlvCommand(TlvRecvContext &context, const TlvView &tlv);
+
+   /**
+   *@method handleTlvSentinel
+   *
+   *@brief TLV_SENTINEL handler of receive dispatch table
+   *
+   *@param context (in)    receive context
+   *@param tlv (in)        view of TLV in received frame
+   *
+   *@return TlvAction::Stop
+   */
+   static TlvAction handleTlvSentinel(TlvRecvContext &context, const TlvView &tlv);
+
+   /**
+   *@method handleTlvUnknown
+   *
+   *@brief handler of unknown TLV types in receive dispatch table, TLVs are skipped
+   *
+   *@param context (in)    receive context
+   *@param tlv (in)        view of TLV in received frame
+   *
+   *@return TlvAction::Stop for TLVs of single byte value, TlvAction::Continue otherwise
+   */
+   static TlvAction handleTlvUnknown(TlvRecvContext &context, const TlvView &tlv);
+
+   static const TlvDispatchTable<TlvRecvContext> mTlvRecvDispatchTable;
+   /**
    *@method handleRecv
    *
-   *@brief handle packet reception
+   *@brief handle socket readiness, process all queued frames and re-arm reception
    *
    *@param errorCode (in)          socket error code
-   *@param bytesTransferred (in)   number of bytes received
    *
    *@return none
    */
-   void handleRecv(
-       const boost::system::error_code &errorCode,
-       size_t bytesTransferred
-   );
+   void handleRecv(const boost::system::error_code &errorCode);
+
+   /**
+   *@method drainRecv
+   *
+   *@brief receive and process frames already queued on socket with non-blocking recvmmsg
+   *
+   *@return number of frames processed
+   */
+   size_t drainRecv();
+
+   /**
+   *@method enableRxJumbo
+   *
+   *@brief switch frame reception to jumbo buffers once a heartbeat outgrows the pool buffer size
+   *
+   *@param frameSize (in)          size of received heartbeat
+   *
+   *@return none
+   */
+   void enableRxJumbo(size_t frameSize);
+
+
+   /**
+   *@method recordHeartbeatRtt
+   *
+   *@brief record RTT of a self heartbeat reply from TX timestamp carried in its payload
+   *
+   *@param icmpPayload (in)    pointer to received ICMP payload
+   *
+   *@return none
+   */
+   void recordHeartbeatRtt(IcmpPayload *icmpPayload);
+
+   /**
+   *@method processRxRingFrame
+   *
+   *@brief process a frame received on the shared RX ring
+   *
+   *@param frame (in)          pointer to Ethernet frame within RX ring block
+   *@param size (in)           size of Ethernet frame
+   *@param rxTimestamp (in)    kernel receive timestamp in nanoseconds
+   *@param blockRef (in)       reference that keeps RX ring block owned by user space
+   *
+   *@return none
+   */
+   void processRxRingFrame(uint8_t *frame, size_t size, uint64_t rxTimestamp, std::shared_ptr<void> blockRef);
+
+   /**
+   *@method processRxFrame
+   *
+   *@brief process ICMP ECHOREPLY frame pointed to by mRxFramePtr
+   *
+   *@param bytesTransferred (in)   size of received frame
+   *
+   *@return none
+   */
+   void processRxFrame(size_t bytesTransferred);
+
+   /**
+   *@method processTxBatchError
+   *
+   *@brief process failure to send a heartbeat queued to the TX batcher
+   *
+   *@param errorCode (in)      send error code
+   *
+   *@return none
+   */
+   void processTxBatchError(const boost::system::error_code &errorCode);
 
    /**
    *@method handleInitRecv
@@ -540,6 +952,15 @@ protected:
     */
     void updateIcmpSequenceNo();
 
+    /**
+    *@method updateIcmpTxTimestamp
+    *
+    *@brief stamp TX time into heartbeat payload seq field, ICMP checksum is updated incrementally
+    *
+    *@return none
+    */
+    void updateIcmpTxTimestamp();
+
     /**
     *@method getTxBuffer
     *
@@ -547,7 +968,7 @@ protected:
     *
     *@return reference to tx buffer
     */
-    std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE>& getTxBuffer() {return mTxBuffer;};
+    PacketBuffer& getTxBuffer() {return mTxBuffer;};
 
     /**
     *@method findNextTlv
@@ -590,7 +1011,7 @@ protected:
     *@param data (in)   pointer to data buffer
     *@param size (in)   size of data buffer
     *
-    *@return CRC checksum
+    *@return ones' complement sum folded to 16 bits
     */
     uint32_t calculateChecksum(uint16_t *data, size_t size);
 
@@ -623,7 +1044,16 @@ protected:
      */
     std::string uuidToHexString(const boost::uuids::uuid& uuid);
 
-    void getGuidStr(const IcmpPayload *icmpPayload, std::string& guidDataStr);
+    /**
+     *@method getGuid
+     *
+     *@brief read GUID carried by ICMP payload
+     *
+     *@param icmpPayload (in)   pointer to received ICMP payload
+     *
+     *@return GUID, 0 if payload GUID is invalid
+     */
+    uint32_t getGuid(const IcmpPayload *icmpPayload);
 
     /**
      *@method generateGuid
@@ -632,7 +1062,9 @@ protected:
      *
      *@return generated guid
      */
-    std::string generateGuid();    /**
+    uint32_t generateGuid();
+
+    /**
     *@method appendTlvSentinel
     *
     *@brief append TlvSentinel to txBuffer
@@ -641,6 +1073,18 @@ protected:
     */
     size_t appendTlvSentinel();
 
+    /**
+    *@method reserveTxBuffer
+    *
+    *@brief make room for more bytes at the end of TX frame, TX buffer is swapped for
+    *       a jumbo buffer once the frame outgrows the pool buffer
+    *
+    *@param size (in)  bytes to be appended
+    *
+    *@return none
+    */
+    void reserveTxBuffer(size_t size);
+
     /**
     *@method appendTlvDummy
     *
@@ -659,8 +1103,48 @@ protected:
     */
     void calculateTxPacketChecksum();
 
+    /**
+    * @method buildTxTlvTemplates
+    *
+    * @brief build TLV templates of sentinel, MUX_PROBE and SWITCH_ACTIVE frames, TX buffer is left with sentinel
+    *
+    * @return none
+    */
+    void buildTxTlvTemplates();
 
-    static SockFilter mIcmpFilter[];
+    /**
+    * @method applyTxTlvTemplate
+    *
+    * @brief switch TX frame to another TLV template, checksums are updated incrementally
+    *
+    * @param command (in)   command of the template, COMMAND_NONE selects the sentinel only frame
+    *
+    * @return none
+    */
+    void applyTxTlvTemplate(Command command);
+
+    /**
+    * @method updateTxFrameAddresses
+    *
+    * @brief patch MAC and IP addresses of the TX frame, IP checksum is updated incrementally
+    *
+    * @return none
+    */
+    void updateTxFrameAddresses();
+
+    /**
+    * @method updateChecksum
+    *
+    * @brief update checksum for replaced data as per RFC 1624, HC' = ~(~HC + ~m + m')
+    *
+    * @param checksum (out)     pointer to checksum field
+    * @param sum (in, out)      running sum of checksummed data
+    * @param oldSum (in)        sum of replaced data
+    * @param newSum (in)        sum of new data
+    *
+    * @return none
+    */
+    void updateChecksum(uint16_t *checksum, uint32_t &sum, uint32_t oldSum, uint32_t newSum);
 
     common::MuxPortConfig &mMuxPortConfig;
     boost::asio::io_service &mIoService;
@@ -673,36 +1157,71 @@ protected:
     uint32_t mIcmpChecksum = 0;
     uint32_t mIpChecksum = 0;
 
+    std::array<TxTlvTemplate, static_cast<size_t> (Command::Count)> mTxTlvTemplates;
+    Command mTxTlvTemplate = Command::COMMAND_NONE;
+    bool mTxFrameBuilt = false;
+
     static const size_t mPacketHeaderSize = sizeof(ether_header) + sizeof(iphdr) + sizeof(icmphdr);
     static const size_t mTlvStartOffset = sizeof(ether_header) + sizeof(iphdr) + sizeof(icmphdr) + sizeof(IcmpPayload);
 
     boost::asio::io_service::strand mStrand;
     boost::asio::posix::stream_descriptor mStream;
-    boost::asio::deadline_timer mDeadlineTimer;
-    boost::asio::deadline_timer mSuspendTimer;
-    boost::asio::deadline_timer mSwitchoverTimer;
-    std::shared_ptr<SockFilter> mSockFilterPtr;
-    SockFilterProg mSockFilterProg;
-
-    std::string mSelfGuid;
-    std::string mPeerGuid;
+    common::WheelTimer mDeadlineTimer;
+    common::WheelTimer mSuspendTimer;
+    common::WheelTimer mSwitchoverTimer;
+    LinkProberFilter mSockFilter;
+
+    uint32_t mSelfGuid = 0;
+    uint32_t mPeerGuid = 0;
     SessionType mPeerType = SessionType::UNKNOWN;
     boost::function<void (HeartbeatType heartbeatType)> mReportHeartbeatReplyReceivedFuncPtr;
     boost::function<void (HeartbeatType heartbeatType)> mReportHeartbeatReplyNotReceivedFuncPtr;
 
     int mSocket = 0;
+    int mIfIndex = 0;
 
     std::size_t mTxPacketSize;
-    std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE> mTxBuffer;
-    std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE> mRxBuffer;
+    PacketBuffer mTxBuffer = LinkProberBufferPool::getInstance()->acquire();
+    PacketBuffer mRxBuffer = LinkProberBufferPool::getInstance()->acquire();
+    uint8_t *mRxFramePtr = mRxBuffer.data();
+
+    static const size_t mRxBatchSize = 8;
+    static const size_t mRxDrainLimit = 4 * mRxBatchSize;
+    std::array<PacketBuffer, mRxBatchSize> mRxBatchBuffers;
+    std::array<struct iovec, mRxBatchSize> mRxBatchIovecs;
+    std::array<struct mmsghdr, mRxBatchSize> mRxBatchMsgHdrs;
+    std::array<std::array<uint8_t, CMSG_SPACE(sizeof(struct scm_timestamping))>, mRxBatchSize> mRxBatchControls;
+    uint64_t mRxTimestamp = 0;
+    bool mRxJumboEnabled = false;
+    uint64_t mRxTruncatedFrameCount = 0;
+
+    common::LatencyHistogram mRttHistogram;
+    std::array<HeartbeatLossWindow, static_cast<size_t> (HeartbeatType::Count)> mLossWindows;
+    common::LatencyHistogram mRxLatencyHistogram;
+
+    bool mRxRingEnabled = false;
+    bool mRxFanoutEnabled = false;
+    bool mLowLatencyRxEnabled = false;
+    bool mInitRecvPending = false;
+    bool mTxBatchEnabled = false;
 
     bool mCancelSuspend = false;
     bool mSuspendTx = false;
     bool mShutdownTx = false;
     bool mDecreaseProbingInterval = false;
 
+    uint32_t mAdaptiveInterval_msec = 0;
+    uint32_t mStableProbeCount = 0;
+    uint32_t mBudgetInterval_msec = 0;
+
     uint64_t mIcmpUnknownEventCount = 0;
     uint64_t mIcmpPacketCount = 0;
+    uint64_t mTxErrorCount = 0;
+    uint64_t mRxWakeupCount = 0;
+    uint64_t mRxFrameCount = 0;
+    uint64_t mRxMaxFramesPerWakeup = 0;
+    uint64_t mTimerWaitCount = 0;
+    uint64_t mRxWaitCount = 0;
 };
 
 } /* namespace link_prober */
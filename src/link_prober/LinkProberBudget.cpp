@@ -0,0 +1,282 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LinkProberBudget.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "common/MuxLogger.h"
+#include "LinkProberBudget.h"
+
+namespace link_prober
+{
+
+//
+// heartbeats per second sent at interval
+//
+static inline double getProbeRate(uint32_t interval_msec)
+{
+    return 1000.0 / std::max<uint32_t> (interval_msec, 1);
+}
+
+//
+// ---> operator==(const ProbeDemand &demand);
+//
+// compare heartbeat demands
+//
+bool ProbeDemand::operator==(const ProbeDemand &demand) const
+{
+    return interval_msec == demand.interval_msec &&
+           maxInterval_msec == demand.maxInterval_msec &&
+           priority == demand.priority &&
+           active == demand.active;
+}
+
+//
+// ---> getInstance();
+//
+// constructs LinkProberBudget singleton instance
+//
+LinkProberBudgetPtr LinkProberBudget::getInstance()
+{
+    static std::shared_ptr<LinkProberBudget> LinkProberBudgetPtr = nullptr;
+
+    if (LinkProberBudgetPtr == nullptr) {
+        LinkProberBudgetPtr = std::shared_ptr<LinkProberBudget> (new LinkProberBudget);
+    }
+
+    return LinkProberBudgetPtr;
+}
+
+//
+// ---> setMaxProbeRate(uint32_t maxProbeRate);
+//
+// setter for heartbeat budget of the ToR
+//
+void LinkProberBudget::setMaxProbeRate(uint32_t maxProbeRate)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (maxProbeRate != mMaxProbeRate) {
+        MUXLOGWARNING(boost::format("Link Prober heartbeat budget changed from %d to %d pps") % mMaxProbeRate % maxProbeRate);
+
+        mMaxProbeRate = maxProbeRate;
+        rebalance();
+    }
+}
+
+//
+// ---> getMaxProbeRate();
+//
+// getter for heartbeat budget of the ToR
+//
+uint32_t LinkProberBudget::getMaxProbeRate()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mMaxProbeRate;
+}
+
+//
+// ---> allocate(LinkProberBase *linkProberPtr, const ProbeDemand &demand);
+//
+// update demand of a link prober and get its allocated interval
+//
+uint32_t LinkProberBudget::allocate(LinkProberBase *linkProberPtr, const ProbeDemand &demand)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto iter = mAllocations.find(linkProberPtr);
+    if (iter == mAllocations.end()) {
+        iter = mAllocations.emplace(linkProberPtr, Allocation {demand, demand.interval_msec}).first;
+        rebalance();
+    } else if (iter->second.demand != demand) {
+        iter->second.demand = demand;
+        rebalance();
+    }
+
+    return mMaxProbeRate == 0 ? 0 : iter->second.interval_msec;
+}
+
+//
+// ---> unregisterLinkProber(LinkProberBase *linkProberPtr);
+//
+// release budget of a link prober
+//
+void LinkProberBudget::unregisterLinkProber(LinkProberBase *linkProberPtr)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (mAllocations.erase(linkProberPtr) > 0) {
+        rebalance();
+    }
+}
+
+//
+// ---> isOverBudget();
+//
+// check if heartbeat rate asked for by link probers exceeds budget
+//
+bool LinkProberBudget::isOverBudget()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mOverBudget;
+}
+
+//
+// ---> getDemandRate();
+//
+// getter for heartbeats per second asked for by active link probers
+//
+double LinkProberBudget::getDemandRate()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mDemandRate;
+}
+
+//
+// ---> getAllocatedRate();
+//
+// getter for heartbeats per second allocated to active link probers
+//
+double LinkProberBudget::getAllocatedRate()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mAllocatedRate;
+}
+
+//
+// ---> dumpStats();
+//
+// log heartbeat budget, demand and allocation
+//
+void LinkProberBudget::dumpStats()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    MUXLOGWARNING(boost::format("Link Prober heartbeat budget: %d pps, probers: %d, demand: %.1f pps, allocated: %.1f pps, "
+        "over budget: %d, rebalance count: %d, over budget count: %d") %
+        mMaxProbeRate %
+        mAllocations.size() %
+        mDemandRate %
+        mAllocatedRate %
+        mOverBudget %
+        mRebalanceCount %
+        mOverBudgetCount
+    );
+}
+
+//
+// ---> rebalance();
+//
+// recompute allocated interval of every link prober
+//
+void LinkProberBudget::rebalance()
+{
+    struct Share {
+        Allocation *allocationPtr;
+        double floorRate;
+        double extraRate;
+        uint32_t weight;
+    };
+    std::vector<Share> shares;
+    shares.reserve(mAllocations.size());
+
+    double demandRate = 0;
+    double floorRate = 0;
+    for (auto &entry: mAllocations) {
+        Allocation &allocation = entry.second;
+        allocation.interval_msec = allocation.demand.interval_msec;
+        if (!allocation.demand.active) {
+            continue;
+        }
+
+        // probers without a slower bound keep the rate they ask for
+        double rate = getProbeRate(allocation.demand.interval_msec);
+        double minRate = allocation.demand.maxInterval_msec > allocation.demand.interval_msec ?
+            getProbeRate(allocation.demand.maxInterval_msec) : rate;
+        demandRate += rate;
+        floorRate += minRate;
+        shares.push_back({&allocation, minRate, rate - minRate, allocation.demand.priority});
+    }
+
+    mRebalanceCount++;
+    mDemandRate = demandRate;
+    mAllocatedRate = demandRate;
+
+    bool overBudget = mMaxProbeRate != 0 && demandRate > mMaxProbeRate;
+    if (overBudget) {
+        // priority weighted water filling of the budget left above the floor rates, probers
+        // with the least extra rate per weight are served first so every prober either gets
+        // all it asks for or the same weighted share as the probers after it
+        std::sort(shares.begin(), shares.end(), [] (const Share &lhs, const Share &rhs) {
+            double lhsLevel = lhs.weight ? lhs.extraRate / lhs.weight : std::numeric_limits<double>::max();
+            double rhsLevel = rhs.weight ? rhs.extraRate / rhs.weight : std::numeric_limits<double>::max();
+            return lhsLevel < rhsLevel;
+        });
+
+        double remainingRate = std::max(0.0, mMaxProbeRate - floorRate);
+        uint64_t weightSum = 0;
+        for (const Share &share: shares) {
+            weightSum += share.extraRate > 0 ? share.weight : 0;
+        }
+
+        mAllocatedRate = 0;
+        for (Share &share: shares) {
+            double grantRate = 0;
+            if (share.extraRate > 0 && share.weight > 0 && weightSum > 0) {
+                grantRate = std::min(share.extraRate, remainingRate * share.weight / weightSum);
+                remainingRate -= grantRate;
+                weightSum -= share.weight;
+            }
+
+            const ProbeDemand &demand = share.allocationPtr->demand;
+            uint32_t interval_msec = static_cast<uint32_t> (std::ceil(1000.0 / (share.floorRate + grantRate)));
+            interval_msec = std::max(interval_msec, demand.interval_msec);
+            if (demand.maxInterval_msec > demand.interval_msec) {
+                interval_msec = std::min(interval_msec, demand.maxInterval_msec);
+            }
+            share.allocationPtr->interval_msec = interval_msec;
+            mAllocatedRate += getProbeRate(interval_msec);
+        }
+    }
+
+    if (overBudget && !mOverBudget) {
+        mOverBudgetCount++;
+        MUXLOGWARNING(boost::format("Link Prober heartbeat demand %.1f pps of %d probers exceeds budget %d pps, "
+            "throttled to %.1f pps, rate at maximum intervals: %.1f pps") %
+            demandRate %
+            shares.size() %
+            mMaxProbeRate %
+            mAllocatedRate %
+            floorRate
+        );
+    } else if (!overBudget && mOverBudget) {
+        MUXLOGWARNING(boost::format("Link Prober heartbeat demand %.1f pps is within budget %d pps") %
+            demandRate %
+            mMaxProbeRate
+        );
+    }
+    mOverBudget = overBudget;
+}
+
+} /* namespace link_prober */
@@ -0,0 +1,219 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LinkProberBudget.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef LINK_PROBER_LINKPROBERBUDGET_H_
+#define LINK_PROBER_LINKPROBERBUDGET_H_
+
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <unordered_map>
+
+namespace test {
+class LinkProberBudgetTest;
+}
+
+namespace link_prober
+{
+class LinkProberBase;
+class LinkProberBudget;
+
+using LinkProberBudgetPtr = std::shared_ptr<LinkProberBudget>;
+
+/**
+ *@struct ProbeDemand
+ *
+ *@brief heartbeat rate asked for by a link prober
+ */
+struct ProbeDemand {
+    uint32_t interval_msec = 0;
+    uint32_t maxInterval_msec = 0;
+    uint32_t priority = 1;
+    bool active = true;
+
+    bool operator==(const ProbeDemand &demand) const;
+    bool operator!=(const ProbeDemand &demand) const {return !(*this == demand);};
+};
+
+/**
+ *@class LinkProberBudget
+ *
+ *@brief bounds heartbeat packets per second sent by all link probers of the ToR.
+ *       Every active prober is first granted the rate of its maximum interval,
+ *       the rest of the budget is shared by priority weighted max-min fairness
+ *       up to the rate each prober asks for. Allocation is recomputed whenever
+ *       a prober demand or the budget changes. Probers report as maximum interval
+ *       the slowest rate the peer ToR tolerates, budget below the sum of those
+ *       rates leaves the ToR over budget rather than starving peer detection.
+ */
+class LinkProberBudget
+{
+public:
+    /**
+    *@method LinkProberBudget
+    *
+    *@brief class copy constructor
+    *
+    *@param LinkProberBudget (in)  reference to LinkProberBudget object to be copied
+    */
+    LinkProberBudget(const LinkProberBudget &) = delete;
+
+    /**
+    *@method ~LinkProberBudget
+    *
+    *@brief class destructor
+    */
+    virtual ~LinkProberBudget() = default;
+
+    /**
+    *@method getInstance
+    *
+    *@brief constructs LinkProberBudget singleton instance
+    *
+    *@return shared pointer to LinkProberBudget singleton instance
+    */
+    static LinkProberBudgetPtr getInstance();
+
+    /**
+    *@method setMaxProbeRate
+    *
+    *@brief setter for heartbeat budget of the ToR
+    *
+    *@param maxProbeRate (in)   heartbeats per second, 0 does not limit link probers
+    *
+    *@return none
+    */
+    void setMaxProbeRate(uint32_t maxProbeRate);
+
+    /**
+    *@method getMaxProbeRate
+    *
+    *@brief getter for heartbeat budget of the ToR
+    *
+    *@return heartbeats per second
+    */
+    uint32_t getMaxProbeRate();
+
+    /**
+    *@method allocate
+    *
+    *@brief update demand of a link prober and get its allocated interval. Link prober
+    *       is registered on first call
+    *
+    *@param linkProberPtr (in)  link prober asking for heartbeat rate
+    *@param demand (in)         heartbeat rate asked for
+    *
+    *@return allocated interval in msec, 0 when budget does not limit link probers
+    */
+    uint32_t allocate(LinkProberBase *linkProberPtr, const ProbeDemand &demand);
+
+    /**
+    *@method unregisterLinkProber
+    *
+    *@brief release budget of a link prober
+    *
+    *@param linkProberPtr (in)  link prober to remove
+    *
+    *@return none
+    */
+    void unregisterLinkProber(LinkProberBase *linkProberPtr);
+
+    /**
+    *@method isOverBudget
+    *
+    *@brief check if heartbeat rate asked for by link probers exceeds budget
+    *
+    *@return true if link probers are throttled
+    */
+    bool isOverBudget();
+
+    /**
+    *@method getDemandRate
+    *
+    *@brief getter for heartbeats per second asked for by active link probers
+    *
+    *@return heartbeat rate
+    */
+    double getDemandRate();
+
+    /**
+    *@method getAllocatedRate
+    *
+    *@brief getter for heartbeats per second allocated to active link probers
+    *
+    *@return heartbeat rate
+    */
+    double getAllocatedRate();
+
+    /**
+    *@method dumpStats
+    *
+    *@brief log heartbeat budget, demand and allocation
+    *
+    *@return none
+    */
+    void dumpStats();
+
+private:
+    friend class test::LinkProberBudgetTest;
+
+    /**
+    *@struct Allocation
+    *
+    *@brief demand and allocated interval of a link prober
+    */
+    struct Allocation {
+        ProbeDemand demand;
+        uint32_t interval_msec;
+    };
+
+    /**
+    *@method LinkProberBudget
+    *
+    *@brief class default constructor
+    */
+    LinkProberBudget() = default;
+
+    /**
+    *@method rebalance
+    *
+    *@brief recompute allocated interval of every link prober, called with mMutex held
+    *
+    *@return none
+    */
+    void rebalance();
+
+    std::mutex mMutex;
+    std::unordered_map<LinkProberBase *, Allocation> mAllocations;
+
+    uint32_t mMaxProbeRate = 0;
+    double mDemandRate = 0;
+    double mAllocatedRate = 0;
+    bool mOverBudget = false;
+
+    uint64_t mRebalanceCount = 0;
+    uint64_t mOverBudgetCount = 0;
+};
+
+} /* namespace link_prober */
+
+#endif /* LINK_PROBER_LINKPROBERBUDGET_H_ */
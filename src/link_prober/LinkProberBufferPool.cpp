@@ -0,0 +1,221 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LinkProberBufferPool.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <new>
+#include <stdlib.h>
+
+#include "LinkProberBufferPool.h"
+
+namespace link_prober
+{
+//
+// jumbo buffers keep the pool alignment
+//
+static const size_t MUX_POOL_JUMBO_BUFFER_SIZE =
+    (MUX_MAX_ICMP_BUFFER_SIZE + MUX_POOL_BUFFER_ALIGNMENT - 1) & ~static_cast<size_t> (MUX_POOL_BUFFER_ALIGNMENT - 1);
+
+//
+// ---> PacketBuffer(PacketBuffer &&buffer);
+//
+// class move constructor
+//
+PacketBuffer::PacketBuffer(PacketBuffer &&buffer) noexcept :
+    mData(buffer.mData),
+    mSize(buffer.mSize)
+{
+    buffer.mData = nullptr;
+    buffer.mSize = 0;
+}
+
+//
+// ---> operator=(PacketBuffer &&buffer);
+//
+// move assignment, buffer owned so far is returned to pool
+//
+PacketBuffer& PacketBuffer::operator=(PacketBuffer &&buffer) noexcept
+{
+    if (this != &buffer) {
+        reset();
+        mData = buffer.mData;
+        mSize = buffer.mSize;
+        buffer.mData = nullptr;
+        buffer.mSize = 0;
+    }
+
+    return *this;
+}
+
+//
+// ---> reset();
+//
+// return buffer to pool
+//
+void PacketBuffer::reset()
+{
+    if (mData != nullptr) {
+        LinkProberBufferPool::getInstance()->release(mData, mSize);
+        mData = nullptr;
+        mSize = 0;
+    }
+}
+
+//
+// ---> getInstance();
+//
+// constructs LinkProberBufferPool singleton instance
+//
+LinkProberBufferPoolPtr LinkProberBufferPool::getInstance()
+{
+    static std::shared_ptr<LinkProberBufferPool> LinkProberBufferPoolPtr = nullptr;
+
+    if (LinkProberBufferPoolPtr == nullptr) {
+        LinkProberBufferPoolPtr = std::shared_ptr<LinkProberBufferPool> (new LinkProberBufferPool);
+    }
+
+    return LinkProberBufferPoolPtr;
+}
+
+//
+// ---> ~LinkProberBufferPool();
+//
+// class destructor
+//
+LinkProberBufferPool::~LinkProberBufferPool()
+{
+    for (uint8_t *slab: mSlabs) {
+        free(slab);
+    }
+}
+
+//
+// ---> acquire(size_t size);
+//
+// draw a buffer from the pool
+//
+PacketBuffer LinkProberBufferPool::acquire(size_t size)
+{
+    if (size > MUX_POOL_BUFFER_SIZE) {
+        void *data = nullptr;
+        if (posix_memalign(&data, MUX_POOL_BUFFER_ALIGNMENT, MUX_POOL_JUMBO_BUFFER_SIZE) != 0) {
+            throw std::bad_alloc();
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJumboBufferCount++;
+        mInUseBytes += MUX_POOL_JUMBO_BUFFER_SIZE;
+
+        return PacketBuffer(reinterpret_cast<uint8_t *> (data), MUX_POOL_JUMBO_BUFFER_SIZE);
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mFreeBuffers.empty()) {
+        addSlab();
+    }
+    uint8_t *data = mFreeBuffers.back();
+    mFreeBuffers.pop_back();
+    mInUseBytes += MUX_POOL_BUFFER_SIZE;
+
+    return PacketBuffer(data, MUX_POOL_BUFFER_SIZE);
+}
+
+//
+// ---> release(uint8_t *data, size_t size);
+//
+// return a buffer to the pool
+//
+void LinkProberBufferPool::release(uint8_t *data, size_t size)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mInUseBytes -= size;
+    if (size > MUX_POOL_BUFFER_SIZE) {
+        mJumboBufferCount--;
+        free(data);
+    } else {
+        mFreeBuffers.push_back(data);
+    }
+}
+
+//
+// ---> getSlabCount();
+//
+// getter for number of slabs allocated
+//
+size_t LinkProberBufferPool::getSlabCount()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mSlabs.size();
+}
+
+//
+// ---> getFreeBufferCount();
+//
+// getter for number of pool buffers not drawn
+//
+size_t LinkProberBufferPool::getFreeBufferCount()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mFreeBuffers.size();
+}
+
+//
+// ---> getJumboBufferCount();
+//
+// getter for number of jumbo buffers drawn
+//
+size_t LinkProberBufferPool::getJumboBufferCount()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mJumboBufferCount;
+}
+
+//
+// ---> getInUseBytes();
+//
+// getter for bytes of pool and jumbo buffers drawn
+//
+size_t LinkProberBufferPool::getInUseBytes()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mInUseBytes;
+}
+
+//
+// ---> addSlab();
+//
+// allocate a slab and add its buffers to the free list
+//
+void LinkProberBufferPool::addSlab()
+{
+    void *slab = nullptr;
+    if (posix_memalign(&slab, MUX_POOL_BUFFER_ALIGNMENT, MUX_POOL_BUFFER_SIZE * MUX_POOL_SLAB_BUFFER_COUNT) != 0) {
+        throw std::bad_alloc();
+    }
+    mSlabs.push_back(reinterpret_cast<uint8_t *> (slab));
+
+    // free list capacity covers every buffer so release never allocates
+    mFreeBuffers.reserve(mSlabs.size() * MUX_POOL_SLAB_BUFFER_COUNT);
+    for (size_t i = MUX_POOL_SLAB_BUFFER_COUNT; i > 0; i--) {
+        mFreeBuffers.push_back(reinterpret_cast<uint8_t *> (slab) + (i - 1) * MUX_POOL_BUFFER_SIZE);
+    }
+}
+
+} /* namespace link_prober */
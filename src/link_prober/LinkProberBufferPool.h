@@ -0,0 +1,269 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LinkProberBufferPool.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef LINK_PROBER_LINKPROBERBUFFERPOOL_H_
+#define LINK_PROBER_LINKPROBERBUFFERPOOL_H_
+
+#include <memory>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "IcmpPayload.h"
+
+#define MUX_POOL_BUFFER_SIZE        2048
+#define MUX_POOL_BUFFER_ALIGNMENT   64
+#define MUX_POOL_SLAB_BUFFER_COUNT  32
+
+namespace link_prober
+{
+class LinkProberBufferPool;
+
+using LinkProberBufferPoolPtr = std::shared_ptr<LinkProberBufferPool>;
+
+/**
+ *@class PacketBuffer
+ *
+ *@brief owning handle of a packet buffer drawn from LinkProberBufferPool, the
+ *       buffer is returned to the pool when the handle is reset or destroyed
+ */
+class PacketBuffer
+{
+public:
+    /**
+    *@method PacketBuffer
+    *
+    *@brief class default constructor, handle owns no buffer
+    */
+    PacketBuffer() = default;
+
+    /**
+    *@method PacketBuffer
+    *
+    *@brief class constructor
+    *
+    *@param data (in)   pointer to buffer drawn from pool
+    *@param size (in)   buffer size
+    */
+    PacketBuffer(uint8_t *data, size_t size) : mData(data), mSize(size) {};
+
+    /**
+    *@method PacketBuffer
+    *
+    *@brief class copy constructor
+    *
+    *@param PacketBuffer (in)  reference to PacketBuffer object to be copied
+    */
+    PacketBuffer(const PacketBuffer &) = delete;
+
+    /**
+    *@method PacketBuffer
+    *
+    *@brief class move constructor
+    *
+    *@param buffer (in)     handle to take buffer from
+    */
+    PacketBuffer(PacketBuffer &&buffer) noexcept;
+
+    /**
+    *@method operator=
+    *
+    *@brief move assignment, buffer owned so far is returned to pool
+    *
+    *@param buffer (in)     handle to take buffer from
+    *
+    *@return reference to this handle
+    */
+    PacketBuffer& operator=(PacketBuffer &&buffer) noexcept;
+
+    /**
+    *@method ~PacketBuffer
+    *
+    *@brief class destructor
+    */
+    ~PacketBuffer() {reset();};
+
+    /**
+    *@method reset
+    *
+    *@brief return buffer to pool
+    *
+    *@return none
+    */
+    void reset();
+
+    /**
+    *@method data
+    *
+    *@brief getter for buffer data
+    *
+    *@return pointer to buffer
+    */
+    inline uint8_t* data() const {return mData;};
+
+    /**
+    *@method size
+    *
+    *@brief getter for buffer size
+    *
+    *@return buffer size in bytes
+    */
+    inline size_t size() const {return mSize;};
+
+    /**
+    *@method isJumbo
+    *
+    *@brief check if buffer is a jumbo buffer allocated outside of pool slabs
+    *
+    *@return true if buffer is larger than pool buffer size
+    */
+    inline bool isJumbo() const {return mSize > MUX_POOL_BUFFER_SIZE;};
+
+private:
+    uint8_t *mData = nullptr;
+    size_t mSize = 0;
+};
+
+/**
+ *@class LinkProberBufferPool
+ *
+ *@brief shared pool of MTU sized, cache aligned packet buffers carved out of
+ *       slabs. Link probers draw their TX frame and RX buffers from it instead
+ *       of embedding jumbo sized arrays. Jumbo buffers are allocated on demand
+ *       and freed once returned.
+ */
+class LinkProberBufferPool
+{
+public:
+    /**
+    *@method LinkProberBufferPool
+    *
+    *@brief class copy constructor
+    *
+    *@param LinkProberBufferPool (in)  reference to LinkProberBufferPool object to be copied
+    */
+    LinkProberBufferPool(const LinkProberBufferPool &) = delete;
+
+    /**
+    *@method ~LinkProberBufferPool
+    *
+    *@brief class destructor
+    */
+    virtual ~LinkProberBufferPool();
+
+    /**
+    *@method getInstance
+    *
+    *@brief constructs LinkProberBufferPool singleton instance
+    *
+    *@return shared pointer to LinkProberBufferPool singleton instance
+    */
+    static LinkProberBufferPoolPtr getInstance();
+
+    /**
+    *@method acquire
+    *
+    *@brief draw a buffer from the pool
+    *
+    *@param size (in)   bytes needed, sizes above pool buffer size get a jumbo buffer
+    *
+    *@return handle owning the buffer
+    */
+    PacketBuffer acquire(size_t size = MUX_POOL_BUFFER_SIZE);
+
+    /**
+    *@method release
+    *
+    *@brief return a buffer to the pool
+    *
+    *@param data (in)   pointer to buffer
+    *@param size (in)   buffer size
+    *
+    *@return none
+    */
+    void release(uint8_t *data, size_t size);
+
+    /**
+    *@method getSlabCount
+    *
+    *@brief getter for number of slabs allocated
+    *
+    *@return slab count
+    */
+    size_t getSlabCount();
+
+    /**
+    *@method getFreeBufferCount
+    *
+    *@brief getter for number of pool buffers not drawn
+    *
+    *@return free buffer count
+    */
+    size_t getFreeBufferCount();
+
+    /**
+    *@method getJumboBufferCount
+    *
+    *@brief getter for number of jumbo buffers drawn
+    *
+    *@return jumbo buffer count
+    */
+    size_t getJumboBufferCount();
+
+    /**
+    *@method getInUseBytes
+    *
+    *@brief getter for bytes of pool and jumbo buffers drawn
+    *
+    *@return bytes in use
+    */
+    size_t getInUseBytes();
+
+private:
+    /**
+    *@method LinkProberBufferPool
+    *
+    *@brief class default constructor
+    */
+    LinkProberBufferPool() = default;
+
+    /**
+    *@method addSlab
+    *
+    *@brief allocate a slab and add its buffers to the free list, called with mMutex held
+    *
+    *@return none
+    */
+    void addSlab();
+
+    std::mutex mMutex;
+    std::vector<uint8_t *> mSlabs;
+    std::vector<uint8_t *> mFreeBuffers;
+
+    size_t mJumboBufferCount = 0;
+    size_t mInUseBytes = 0;
+};
+
+} /* namespace link_prober */
+
+#endif /* LINK_PROBER_LINKPROBERBUFFERPOOL_H_ */
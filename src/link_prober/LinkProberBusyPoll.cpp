@@ -0,0 +1,269 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LinkProberBusyPoll.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <string.h>
+
+#include <poll.h>
+
+#include "common/MuxLogger.h"
+#include "LinkProberBase.h"
+#include "LinkProberBusyPoll.h"
+
+namespace link_prober
+{
+//
+// ---> getInstance();
+//
+// constructs LinkProberBusyPoll singleton instance
+//
+LinkProberBusyPollPtr LinkProberBusyPoll::getInstance()
+{
+    static std::shared_ptr<LinkProberBusyPoll> LinkProberBusyPollPtr = nullptr;
+
+    if (LinkProberBusyPollPtr == nullptr) {
+        LinkProberBusyPollPtr = std::shared_ptr<LinkProberBusyPoll> (new LinkProberBusyPoll);
+    }
+
+    return LinkProberBusyPollPtr;
+}
+
+//
+// ---> LinkProberBusyPoll();
+//
+// class default constructor
+//
+LinkProberBusyPoll::LinkProberBusyPoll()
+{
+    memset(mRxMsgHdrs.data(), 0, sizeof(mRxMsgHdrs));
+    for (size_t i = 0; i < MUX_BUSY_POLL_BATCH_SIZE; i++) {
+        mRxBuffers[i] = std::make_shared<RxBuffer> ();
+        mRxIovecs[i].iov_base = mRxBuffers[i]->data();
+        mRxIovecs[i].iov_len = mRxBuffers[i]->size();
+        mRxMsgHdrs[i].msg_hdr.msg_iov = &mRxIovecs[i];
+        mRxMsgHdrs[i].msg_hdr.msg_iovlen = 1;
+        mRxMsgHdrs[i].msg_hdr.msg_control = mRxControls[i].data();
+    }
+}
+
+//
+// ---> ~LinkProberBusyPoll();
+//
+// class destructor
+//
+LinkProberBusyPoll::~LinkProberBusyPoll()
+{
+    deinitialize();
+}
+
+//
+// ---> deinitialize();
+//
+// stop receive thread and release registered sockets
+//
+void LinkProberBusyPoll::deinitialize()
+{
+    if (mRunning.exchange(false)) {
+        mThreadPtr->join();
+        mThreadPtr.reset();
+    }
+
+    std::lock_guard<std::mutex> lock(mLinkProberMapMutex);
+    mLinkProberMap.clear();
+    mLinkProberMapVersion++;
+}
+
+//
+// ---> enableBusyPoll(int socket);
+//
+// set SO_BUSY_POLL and SO_PREFER_BUSY_POLL on link prober socket
+//
+bool LinkProberBusyPoll::enableBusyPoll(int socket)
+{
+    // raising busy poll time above net.core.busy_read needs CAP_NET_ADMIN
+    int busyPoll_usec = MUX_BUSY_POLL_USEC;
+    if (setsockopt(socket, SOL_SOCKET, SO_BUSY_POLL, &busyPoll_usec, sizeof(busyPoll_usec)) != 0) {
+        return false;
+    }
+
+#ifdef SO_PREFER_BUSY_POLL
+    // kernels older than 5.11 lack it, busy polling then competes with softirq processing
+    int preferBusyPoll = 1;
+    if (setsockopt(socket, SOL_SOCKET, SO_PREFER_BUSY_POLL, &preferBusyPoll, sizeof(preferBusyPoll)) != 0) {
+        MUXLOGDEBUG(boost::format("Failed to set SO_PREFER_BUSY_POLL with '%s'") % strerror(errno));
+    }
+#endif
+
+    return true;
+}
+
+//
+// ---> disableBusyPoll(int socket);
+//
+// clear SO_BUSY_POLL and SO_PREFER_BUSY_POLL on link prober socket
+//
+void LinkProberBusyPoll::disableBusyPoll(int socket)
+{
+    int disable = 0;
+    setsockopt(socket, SOL_SOCKET, SO_BUSY_POLL, &disable, sizeof(disable));
+#ifdef SO_PREFER_BUSY_POLL
+    setsockopt(socket, SOL_SOCKET, SO_PREFER_BUSY_POLL, &disable, sizeof(disable));
+#endif
+}
+
+//
+// ---> registerLinkProber(int socket, LinkProberBase *linkProberPtr);
+//
+// receive frames of link prober socket on the busy poll thread
+//
+void LinkProberBusyPoll::registerLinkProber(int socket, LinkProberBase *linkProberPtr)
+{
+    {
+        std::lock_guard<std::mutex> lock(mLinkProberMapMutex);
+        mLinkProberMap[socket] = linkProberPtr;
+        mLinkProberMapVersion++;
+    }
+
+    if (!mRunning.exchange(true)) {
+        MUXLOGWARNING("Link Prober busy poll thread started");
+        mThreadPtr = std::make_shared<boost::thread> (&LinkProberBusyPoll::run, this);
+    }
+}
+
+//
+// ---> unregisterLinkProber(LinkProberBase *linkProberPtr);
+//
+// stop receiving frames of link prober
+//
+void LinkProberBusyPoll::unregisterLinkProber(LinkProberBase *linkProberPtr)
+{
+    std::lock_guard<std::mutex> lock(mLinkProberMapMutex);
+    for (auto iter = mLinkProberMap.begin(); iter != mLinkProberMap.end(); iter++) {
+        if (iter->second == linkProberPtr) {
+            mLinkProberMap.erase(iter);
+            mLinkProberMapVersion++;
+            break;
+        }
+    }
+}
+
+//
+// ---> getLinkProberCount();
+//
+// getter for number of registered link probers
+//
+size_t LinkProberBusyPoll::getLinkProberCount()
+{
+    std::lock_guard<std::mutex> lock(mLinkProberMapMutex);
+    return mLinkProberMap.size();
+}
+
+//
+// ---> run();
+//
+// busy poll thread body, poll registered sockets until deinitialized
+//
+void LinkProberBusyPoll::run()
+{
+    std::vector<struct pollfd> pollFds;
+    uint64_t version = UINT64_MAX;
+
+    while (mRunning) {
+        {
+            std::lock_guard<std::mutex> lock(mLinkProberMapMutex);
+            if (version != mLinkProberMapVersion) {
+                version = mLinkProberMapVersion;
+                pollFds.clear();
+                for (auto &entry: mLinkProberMap) {
+                    pollFds.push_back({entry.first, POLLIN, 0});
+                }
+            }
+        }
+
+        // sockets with SO_BUSY_POLL are busy polled by poll() for net.core.busy_poll usec before
+        // sleeping, timeout bounds how long socket registration changes wait to be picked up
+        int rc = poll(pollFds.data(), pollFds.size(), MUX_BUSY_POLL_TIMEOUT_MSEC);
+        if (rc <= 0) {
+            if (rc < 0 && errno != EINTR) {
+                MUXLOGERROR(boost::format("Busy poll failed with '%s'") % strerror(errno));
+            }
+            continue;
+        }
+        mPollCount++;
+
+        std::lock_guard<std::mutex> lock(mLinkProberMapMutex);
+        if (version != mLinkProberMapVersion) {
+            // readable socket may have been closed and reused since poll
+            continue;
+        }
+        for (struct pollfd &pollFd: pollFds) {
+            if (pollFd.revents & POLLIN) {
+                auto iter = mLinkProberMap.find(pollFd.fd);
+                if (iter != mLinkProberMap.end()) {
+                    mFrameCount += drainSocket(pollFd.fd, iter->second);
+                }
+            }
+        }
+    }
+}
+
+//
+// ---> drainSocket(int socket, LinkProberBase *linkProberPtr);
+//
+// receive frames queued on a socket and hand them to its link prober
+//
+size_t LinkProberBusyPoll::drainSocket(int socket, LinkProberBase *linkProberPtr)
+{
+    size_t frameCount = 0;
+
+    while (frameCount < MUX_BUSY_POLL_DRAIN_LIMIT) {
+        for (struct mmsghdr &msgHdr: mRxMsgHdrs) {
+            msgHdr.msg_hdr.msg_controllen = sizeof(mRxControls[0]);
+        }
+        int rc = recvmmsg(socket, mRxMsgHdrs.data(), MUX_BUSY_POLL_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+        if (rc <= 0) {
+            break;
+        }
+
+        for (int i = 0; i < rc; i++) {
+            // buffer is owned by the link prober until it processed the frame on its strand
+            RxBufferPtr rxBufferPtr = mRxBuffers[i];
+            linkProberPtr->handleRxRingFrame(
+                rxBufferPtr->data(),
+                mRxMsgHdrs[i].msg_len,
+                LinkProberBase::getRxTimestamp(mRxMsgHdrs[i].msg_hdr),
+                rxBufferPtr
+            );
+
+            mRxBuffers[i] = std::make_shared<RxBuffer> ();
+            mRxIovecs[i].iov_base = mRxBuffers[i]->data();
+        }
+        frameCount += rc;
+
+        if (rc < MUX_BUSY_POLL_BATCH_SIZE) {
+            break;
+        }
+    }
+
+    return frameCount;
+}
+
+} /* namespace link_prober */
@@ -0,0 +1,230 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LinkProberBusyPoll.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef LINK_PROBER_LINKPROBERBUSYPOLL_H_
+#define LINK_PROBER_LINKPROBERBUSYPOLL_H_
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/socket.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+
+#include <boost/thread.hpp>
+
+#include "IcmpPayload.h"
+
+#define MUX_BUSY_POLL_USEC          50
+#define MUX_BUSY_POLL_TIMEOUT_MSEC  1
+#define MUX_BUSY_POLL_BATCH_SIZE    8
+#define MUX_BUSY_POLL_DRAIN_LIMIT   (4 * MUX_BUSY_POLL_BATCH_SIZE)
+
+namespace test {
+class LinkProberTest;
+}
+
+namespace link_prober
+{
+class LinkProberBase;
+class LinkProberBusyPoll;
+
+using LinkProberBusyPollPtr = std::shared_ptr<LinkProberBusyPoll>;
+
+/**
+ *@class LinkProberBusyPoll
+ *
+ *@brief receives ICMP ECHOREPLY packets of low latency mux ports on a dedicated
+ *       thread instead of the shared io_service. Sockets of these ports are set
+ *       with SO_BUSY_POLL/SO_PREFER_BUSY_POLL so the kernel polls the device queue
+ *       on behalf of the receiving thread. Received frames are handed to the owning
+ *       link prober strand with their kernel RX timestamps.
+ */
+class LinkProberBusyPoll
+{
+public:
+    /**
+    *@method LinkProberBusyPoll
+    *
+    *@brief class copy constructor
+    *
+    *@param LinkProberBusyPoll (in)  reference to LinkProberBusyPoll object to be copied
+    */
+    LinkProberBusyPoll(const LinkProberBusyPoll &) = delete;
+
+    /**
+    *@method ~LinkProberBusyPoll
+    *
+    *@brief class destructor
+    */
+    virtual ~LinkProberBusyPoll();
+
+    /**
+    *@method getInstance
+    *
+    *@brief constructs LinkProberBusyPoll singleton instance
+    *
+    *@return shared pointer to LinkProberBusyPoll singleton instance
+    */
+    static LinkProberBusyPollPtr getInstance();
+
+    /**
+    *@method deinitialize
+    *
+    *@brief stop receive thread and release registered sockets
+    *
+    *@return none
+    */
+    void deinitialize();
+
+    /**
+    *@method enableBusyPoll
+    *
+    *@brief set SO_BUSY_POLL and SO_PREFER_BUSY_POLL on link prober socket
+    *
+    *@param socket (in)     link prober socket
+    *
+    *@return true if busy polling is enabled on socket
+    */
+    static bool enableBusyPoll(int socket);
+
+    /**
+    *@method disableBusyPoll
+    *
+    *@brief clear SO_BUSY_POLL and SO_PREFER_BUSY_POLL on link prober socket
+    *
+    *@param socket (in)     link prober socket
+    *
+    *@return none
+    */
+    static void disableBusyPoll(int socket);
+
+    /**
+    *@method registerLinkProber
+    *
+    *@brief receive frames of link prober socket on the busy poll thread, the thread
+    *       is started by the first registration
+    *
+    *@param socket (in)             link prober socket
+    *@param linkProberPtr (in)      pointer to owning link prober
+    *
+    *@return none
+    */
+    void registerLinkProber(int socket, LinkProberBase *linkProberPtr);
+
+    /**
+    *@method unregisterLinkProber
+    *
+    *@brief stop receiving frames of link prober, no frame is handed to link prober
+    *       once this call returns
+    *
+    *@param linkProberPtr (in)      pointer to owning link prober
+    *
+    *@return none
+    */
+    void unregisterLinkProber(LinkProberBase *linkProberPtr);
+
+    /**
+    *@method getLinkProberCount
+    *
+    *@brief getter for number of registered link probers
+    *
+    *@return link prober count
+    */
+    size_t getLinkProberCount();
+
+    /**
+    *@method getFrameCount
+    *
+    *@brief getter for number of frames handed to link probers
+    *
+    *@return frame count
+    */
+    inline uint64_t getFrameCount() const {return mFrameCount;};
+
+    /**
+    *@method getPollCount
+    *
+    *@brief getter for number of poll calls that found a readable socket
+    *
+    *@return poll count
+    */
+    inline uint64_t getPollCount() const {return mPollCount;};
+
+private:
+    friend class test::LinkProberTest;
+
+    using RxBuffer = std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE>;
+    using RxBufferPtr = std::shared_ptr<RxBuffer>;
+
+    /**
+    *@method LinkProberBusyPoll
+    *
+    *@brief class default constructor
+    */
+    LinkProberBusyPoll();
+
+    /**
+    *@method run
+    *
+    *@brief busy poll thread body, poll registered sockets until deinitialized
+    *
+    *@return none
+    */
+    void run();
+
+    /**
+    *@method drainSocket
+    *
+    *@brief receive frames queued on a socket and hand them to its link prober,
+    *       called with mLinkProberMapMutex held
+    *
+    *@param socket (in)             readable link prober socket
+    *@param linkProberPtr (in)      pointer to owning link prober
+    *
+    *@return number of frames received
+    */
+    size_t drainSocket(int socket, LinkProberBase *linkProberPtr);
+
+    std::shared_ptr<boost::thread> mThreadPtr;
+    std::atomic<bool> mRunning{false};
+
+    std::mutex mLinkProberMapMutex;
+    std::unordered_map<int, LinkProberBase *> mLinkProberMap;
+    uint64_t mLinkProberMapVersion = 0;
+
+    std::array<RxBufferPtr, MUX_BUSY_POLL_BATCH_SIZE> mRxBuffers;
+    std::array<struct iovec, MUX_BUSY_POLL_BATCH_SIZE> mRxIovecs;
+    std::array<struct mmsghdr, MUX_BUSY_POLL_BATCH_SIZE> mRxMsgHdrs;
+    std::array<std::array<uint8_t, CMSG_SPACE(sizeof(struct scm_timestamping))>, MUX_BUSY_POLL_BATCH_SIZE> mRxControls;
+
+    std::atomic<uint64_t> mFrameCount{0};
+    std::atomic<uint64_t> mPollCount{0};
+};
+
+} /* namespace link_prober */
+
+#endif /* LINK_PROBER_LINKPROBERBUSYPOLL_H_ */
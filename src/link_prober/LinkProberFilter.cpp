@@ -0,0 +1,213 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LinkProberFilter.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <assert.h>
+#include <stddef.h>
+
+#include "IcmpPayload.h"
+#include "LinkProberFilter.h"
+
+namespace link_prober
+{
+//
+// offsets of matched fields, ICMP offsets are relative to X register holding IPv4 header length
+//
+static const uint32_t ETHER_TYPE_OFFSET = offsetof(ether_header, ether_type);
+static const uint32_t IP_FRAG_OFFSET = sizeof(ether_header) + offsetof(iphdr, frag_off);
+static const uint32_t IP_PROTOCOL_OFFSET = sizeof(ether_header) + offsetof(iphdr, protocol);
+static const uint32_t IP_SADDR_OFFSET = sizeof(ether_header) + offsetof(iphdr, saddr);
+static const uint32_t ICMP_TYPE_OFFSET = sizeof(ether_header) + offsetof(icmphdr, type);
+static const uint32_t ICMP_ECHO_ID_OFFSET = sizeof(ether_header) + offsetof(icmphdr, un.echo.id);
+static const uint32_t ICMP_COOKIE_OFFSET = sizeof(ether_header) + sizeof(icmphdr) + offsetof(IcmpPayload, cookie);
+static const uint32_t ICMP_VERSION_OFFSET = sizeof(ether_header) + sizeof(icmphdr) + offsetof(IcmpPayload, version);
+static const uint32_t ICMP_FRAME_MIN_SIZE = sizeof(ether_header) + sizeof(iphdr) + sizeof(icmphdr) + sizeof(IcmpPayload);
+static const uint32_t FILTER_ACCEPT = 0x00040000;
+static const uint32_t FILTER_DROP = 0;
+
+//
+// ---> operator==(const IcmpFilterIdentity &identity);
+//
+// compare prober identities
+//
+bool IcmpFilterIdentity::operator==(const IcmpFilterIdentity &identity) const
+{
+    return bladeIpv4 == identity.bladeIpv4 &&
+           matchServerId == identity.matchServerId &&
+           serverId == identity.serverId &&
+           matchHwEchoId == identity.matchHwEchoId &&
+           softwareCookie == identity.softwareCookie &&
+           hardwareCookie == identity.hardwareCookie &&
+           version == identity.version;
+}
+
+//
+// ---> LinkProberFilter();
+//
+// class default constructor, program drops all packets
+//
+LinkProberFilter::LinkProberFilter()
+{
+    compileDropAll();
+}
+
+//
+// ---> compile(const IcmpFilterIdentity &identity);
+//
+// compile filter program for prober identity
+//
+void LinkProberFilter::compile(const IcmpFilterIdentity &identity)
+{
+    mIdentity = identity;
+    mFilter.clear();
+    mJumpFixups.clear();
+    mLabels.fill(0);
+
+    emitStatement(BPF_LD | BPF_W | BPF_LEN, 0);
+    emitJump(BPF_JMP | BPF_JGE | BPF_K, ICMP_FRAME_MIN_SIZE, Label::NEXT, Label::DROP);
+    emitStatement(BPF_LD | BPF_H | BPF_ABS, ETHER_TYPE_OFFSET);
+    emitJump(BPF_JMP | BPF_JEQ | BPF_K, ETHERTYPE_IP, Label::NEXT, Label::DROP);
+    if (identity.bladeIpv4 != 0) {
+        emitStatement(BPF_LD | BPF_W | BPF_ABS, IP_SADDR_OFFSET);
+        emitJump(BPF_JMP | BPF_JEQ | BPF_K, identity.bladeIpv4, Label::NEXT, Label::DROP);
+    }
+    emitStatement(BPF_LD | BPF_B | BPF_ABS, IP_PROTOCOL_OFFSET);
+    emitJump(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_ICMP, Label::NEXT, Label::DROP);
+    emitStatement(BPF_LD | BPF_H | BPF_ABS, IP_FRAG_OFFSET);
+    emitJump(BPF_JMP | BPF_JSET | BPF_K, 0x1fff, Label::DROP, Label::NEXT);
+
+    // X <- IPv4 header length
+    emitStatement(BPF_LDX | BPF_B | BPF_MSH, sizeof(ether_header));
+    emitStatement(BPF_LD | BPF_B | BPF_IND, ICMP_TYPE_OFFSET);
+    emitJump(BPF_JMP | BPF_JEQ | BPF_K, ICMP_ECHOREPLY, Label::NEXT, Label::DROP);
+    emitStatement(BPF_LD | BPF_W | BPF_IND, ICMP_VERSION_OFFSET);
+    emitJump(BPF_JMP | BPF_JGT | BPF_K, identity.version, Label::DROP, Label::NEXT);
+    emitStatement(BPF_LD | BPF_W | BPF_IND, ICMP_COOKIE_OFFSET);
+    emitJump(BPF_JMP | BPF_JEQ | BPF_K, identity.hardwareCookie, Label::HARDWARE_COOKIE, Label::NEXT);
+    emitJump(BPF_JMP | BPF_JEQ | BPF_K, identity.softwareCookie, Label::SOFTWARE_COOKIE, Label::DROP);
+
+    // software heartbeats carry server id as echo id
+    bindLabel(Label::SOFTWARE_COOKIE);
+    if (identity.matchServerId) {
+        emitStatement(BPF_LD | BPF_H | BPF_IND, ICMP_ECHO_ID_OFFSET);
+        emitJump(BPF_JMP | BPF_JEQ | BPF_K, identity.serverId, Label::ACCEPT, Label::DROP);
+    } else {
+        emitStatement(BPF_RET | BPF_K, FILTER_ACCEPT);
+    }
+
+    // hardware sessions do not set echo id
+    bindLabel(Label::HARDWARE_COOKIE);
+    if (identity.matchHwEchoId) {
+        emitStatement(BPF_LD | BPF_H | BPF_IND, ICMP_ECHO_ID_OFFSET);
+        emitJump(BPF_JMP | BPF_JEQ | BPF_K, 0, Label::ACCEPT, Label::DROP);
+    }
+
+    bindLabel(Label::ACCEPT);
+    emitStatement(BPF_RET | BPF_K, FILTER_ACCEPT);
+    bindLabel(Label::DROP);
+    emitStatement(BPF_RET | BPF_K, FILTER_DROP);
+
+    resolveLabels();
+}
+
+//
+// ---> compileDropAll();
+//
+// compile filter program that drops all packets
+//
+void LinkProberFilter::compileDropAll()
+{
+    mIdentity = IcmpFilterIdentity();
+    mFilter.clear();
+    mJumpFixups.clear();
+
+    emitStatement(BPF_RET | BPF_K, FILTER_DROP);
+}
+
+//
+// ---> getSockFilterProg();
+//
+// getter for socket filter program to attach with SO_ATTACH_FILTER
+//
+struct sock_fprog LinkProberFilter::getSockFilterProg()
+{
+    struct sock_fprog sockFilterProg;
+    sockFilterProg.len = mFilter.size();
+    sockFilterProg.filter = mFilter.data();
+
+    return sockFilterProg;
+}
+
+//
+// ---> emitStatement(uint16_t code, uint32_t k);
+//
+// append non-jump instruction to program
+//
+void LinkProberFilter::emitStatement(uint16_t code, uint32_t k)
+{
+    mFilter.push_back(BPF_STMT(code, k));
+}
+
+//
+// ---> emitJump(uint16_t code, uint32_t k, Label jumpTrue, Label jumpFalse);
+//
+// append conditional jump instruction to program
+//
+void LinkProberFilter::emitJump(uint16_t code, uint32_t k, Label jumpTrue, Label jumpFalse)
+{
+    mJumpFixups.push_back({mFilter.size(), jumpTrue, jumpFalse});
+    mFilter.push_back(BPF_JUMP(code, k, 0, 0));
+}
+
+//
+// ---> bindLabel(Label label);
+//
+// bind label to the next instruction to be emitted
+//
+void LinkProberFilter::bindLabel(Label label)
+{
+    mLabels[static_cast<size_t> (label)] = mFilter.size();
+}
+
+//
+// ---> resolveLabels();
+//
+// patch jump offsets of emitted program with bound label positions
+//
+void LinkProberFilter::resolveLabels()
+{
+    auto getOffset = [this] (size_t index, Label label) -> uint8_t {
+        if (label == Label::NEXT) {
+            return 0;
+        }
+        size_t target = mLabels[static_cast<size_t> (label)];
+        assert(target > index && target - index - 1 <= UINT8_MAX);
+        return static_cast<uint8_t> (target - index - 1);
+    };
+
+    for (const JumpFixup &jumpFixup: mJumpFixups) {
+        mFilter[jumpFixup.index].jt = getOffset(jumpFixup.index, jumpFixup.jumpTrue);
+        mFilter[jumpFixup.index].jf = getOffset(jumpFixup.index, jumpFixup.jumpFalse);
+    }
+    mJumpFixups.clear();
+}
+
+} /* namespace link_prober */
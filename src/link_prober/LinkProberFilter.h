@@ -0,0 +1,202 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LinkProberFilter.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef LINK_PROBER_LINKPROBERFILTER_H_
+#define LINK_PROBER_LINKPROBERFILTER_H_
+
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include <linux/filter.h>
+
+namespace link_prober
+{
+
+/**
+ *@struct IcmpFilterIdentity
+ *
+ *@brief prober identity matched by the compiled socket filter
+ */
+struct IcmpFilterIdentity {
+    uint32_t bladeIpv4 = 0;
+    bool matchServerId = false;
+    uint16_t serverId = 0;
+    bool matchHwEchoId = false;
+    uint32_t softwareCookie = 0;
+    uint32_t hardwareCookie = 0;
+    uint32_t version = 0;
+
+    bool operator==(const IcmpFilterIdentity &identity) const;
+    bool operator!=(const IcmpFilterIdentity &identity) const {return !(*this == identity);};
+};
+
+/**
+ *@class LinkProberFilter
+ *
+ *@brief compiles classic BPF program that passes only ICMP ECHOREPLY heartbeats
+ *       of a prober identity to user space. Reply type, cookie, payload version
+ *       and echo id are matched at fixed offsets from the IPv4 header, frames too
+ *       short to carry the ICMP payload are dropped.
+ */
+class LinkProberFilter
+{
+public:
+    /**
+    *@method LinkProberFilter
+    *
+    *@brief class default constructor, program drops all packets
+    */
+    LinkProberFilter();
+
+    /**
+    *@method ~LinkProberFilter
+    *
+    *@brief class destructor
+    */
+    virtual ~LinkProberFilter() = default;
+
+    /**
+    *@method compile
+    *
+    *@brief compile filter program for prober identity
+    *
+    *@param identity (in)   prober identity to match, zero blade IP matches any server
+    *
+    *@return none
+    */
+    void compile(const IcmpFilterIdentity &identity);
+
+    /**
+    *@method compileDropAll
+    *
+    *@brief compile filter program that drops all packets
+    *
+    *@return none
+    */
+    void compileDropAll();
+
+    /**
+    *@method getIdentity
+    *
+    *@brief getter for identity matched by current program
+    *
+    *@return reference to prober identity
+    */
+    inline const IcmpFilterIdentity& getIdentity() const {return mIdentity;};
+
+    /**
+    *@method getSockFilterProg
+    *
+    *@brief getter for socket filter program to attach with SO_ATTACH_FILTER
+    *
+    *@return socket filter program
+    */
+    struct sock_fprog getSockFilterProg();
+
+    /**
+    *@method size
+    *
+    *@brief getter for number of program instructions
+    *
+    *@return program size
+    */
+    inline size_t size() const {return mFilter.size();};
+
+private:
+    /**
+    *@enum Label
+    *
+    *@brief jump targets of filter program, NEXT is the following instruction
+    */
+    enum class Label: uint8_t {
+        NEXT,
+        SOFTWARE_COOKIE,
+        HARDWARE_COOKIE,
+        ACCEPT,
+        DROP,
+
+        Count
+    };
+
+    /**
+    *@method emitStatement
+    *
+    *@brief append non-jump instruction to program
+    *
+    *@param code (in)   instruction code
+    *@param k (in)      instruction operand
+    *
+    *@return none
+    */
+    void emitStatement(uint16_t code, uint32_t k);
+
+    /**
+    *@method emitJump
+    *
+    *@brief append conditional jump instruction to program
+    *
+    *@param code (in)       instruction code
+    *@param k (in)          instruction operand
+    *@param jumpTrue (in)   target if condition holds
+    *@param jumpFalse (in)  target if condition fails
+    *
+    *@return none
+    */
+    void emitJump(uint16_t code, uint32_t k, Label jumpTrue, Label jumpFalse);
+
+    /**
+    *@method bindLabel
+    *
+    *@brief bind label to the next instruction to be emitted
+    *
+    *@param label (in)  label to bind
+    *
+    *@return none
+    */
+    void bindLabel(Label label);
+
+    /**
+    *@method resolveLabels
+    *
+    *@brief patch jump offsets of emitted program with bound label positions
+    *
+    *@return none
+    */
+    void resolveLabels();
+
+    struct JumpFixup {
+        size_t index;
+        Label jumpTrue;
+        Label jumpFalse;
+    };
+
+    IcmpFilterIdentity mIdentity;
+    std::vector<struct sock_filter> mFilter;
+    std::vector<JumpFixup> mJumpFixups;
+    std::array<size_t, static_cast<size_t> (Label::Count)> mLabels;
+};
+
+} /* namespace link_prober */
+
+#endif /* LINK_PROBER_LINKPROBERFILTER_H_ */
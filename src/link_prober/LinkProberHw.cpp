@@ -5,7 +5,8 @@
  *      Author: Harjot Singh
  */
 
-#include <netpacket/packet.h>
+#include <algorithm>
+#include <linux/if_packet.h>
 #include <sys/socket.h>
 #include <sys/ioctl.h>
 #include <malloc.h>
@@ -103,9 +104,13 @@ void LinkProberHw::handleTimeout(boost::system::error_code errorCode)
         mMuxPortConfig.getServerId()
     );
 
+    if (errorCode == boost::asio::error::operation_aborted) {
+        // timer was restarted or stopped, the new wait owns the timeout cycle
+        return;
+    }
+
     switch (mPeerType) {
         case SessionType::UNKNOWN:
-            // start another cycle of recv
             break;
 
         case SessionType::SOFTWARE:
@@ -120,18 +125,63 @@ void LinkProberHw::handleTimeout(boost::system::error_code errorCode)
                     &LinkProberStateMachineBase::handlePckLossRatioUpdate,
                     mLinkProberStateMachinePtr,
                     mIcmpUnknownEventCount,
-                    mIcmpPacketCount
+                    mIcmpPacketCount,
+                    mLossWindows[static_cast<size_t> (HeartbeatType::HEARTBEAT_SELF)].getStats(),
+                    mLossWindows[static_cast<size_t> (HeartbeatType::HEARTBEAT_PEER)].getStats()
                 )));
             }
+            // pending reception is canceled only for software peer, it stays armed otherwise
+            startRecv();
             break;
 
         case SessionType::HARDWARE:
+            if (isIcmpSessionOffloaded()) {
+                MUXLOGWARNING(boost::format("%s: ICMP sessions offloaded, stop ICMP timeout timer, "
+                    "timer waits: %d, RX waits: %d") %
+                    mMuxPortConfig.getPortName() %
+                    mTimerWaitCount %
+                    mRxWaitCount
+                );
+                mTimerFree = true;
+                return;
+            }
             break;
     }
-    startRecv();
     startTimer();
 }
 
+//
+// ---> isIcmpSessionOffloaded();
+//
+// check if self and peer ICMP sessions are both up in hardware
+//
+bool LinkProberHw::isIcmpSessionOffloaded() const
+{
+    return mPeerType == SessionType::HARDWARE && mSelfSessionUp && mPeerSessionUp;
+}
+
+//
+// ---> handleIcmpSessionLost(const std::string &hwSessionType);
+//
+// mark ICMP session as no longer in hardware and restart ICMP timeout timer
+//
+void LinkProberHw::handleIcmpSessionLost(const std::string &hwSessionType)
+{
+    if (hwSessionType == mSessionTypeSelf) {
+        mSelfSessionUp = false;
+    } else {
+        mPeerSessionUp = false;
+    }
+
+    if (mTimerFree) {
+        MUXLOGWARNING(boost::format("%s: ICMP session of type %s left hardware, restart ICMP timeout timer") %
+            mMuxPortConfig.getPortName() %
+            hwSessionType
+        );
+        startTimer();
+    }
+}
+
 //
 // ---> startTimer();
 //
@@ -141,6 +191,8 @@ void LinkProberHw::startTimer()
 {
     MUXLOGDEBUG(mMuxPortConfig.getPortName());
     // time out these heartbeats
+    mTimerFree = false;
+    mTimerWaitCount++;
     mDeadlineTimer.expires_from_now(boost::posix_time::milliseconds(getProbingInterval()));
     mDeadlineTimer.async_wait(mStrand.wrap(boost::bind(
         &LinkProberHw::handleTimeout,
@@ -231,6 +283,18 @@ void LinkProberHw::handleStateDbStateUpdate(const std::string& session_state, co
     MUXLOGWARNING(boost::format("%s: Recieved New state %s for icmp_Echo mSuspendTx = %b and mShutdownTx = %b ") %
             mMuxPortConfig.getPortName() % session_state  % mSuspendTx % mShutdownTx);
 
+    // session state is tracked even when suspended, timer-free steady state needs both sessions up
+    if (session_state == mUpState) {
+        if (hwSessionType == mSessionTypeSelf) {
+            mSelfSessionUp = true;
+        } else if (hwSessionType == mSessionTypePeer) {
+            mPeerSessionUp = true;
+        }
+    } else if (session_state == mDownState &&
+               (hwSessionType == mSessionTypeSelf || hwSessionType == mSessionTypePeer)) {
+        handleIcmpSessionLost(hwSessionType);
+    }
+
     if((!mSuspendTx) && (!mShutdownTx))
     {
         if(hwSessionType == mSessionTypeSelf) {
@@ -263,15 +327,15 @@ void LinkProberHw::handleStateDbStateUpdate(const std::string& session_state, co
 }
 
 //
-// ---> createIcmpEchoSession(std::string hwSessionType, std::string guid);
+// ---> createIcmpEchoSession(std::string hwSessionType, uint32_t guid);
 //
 //  triggers creation of new icmp_echo_session
 //
-void LinkProberHw::createIcmpEchoSession(std::string hwSessionType, std::string guid)
+void LinkProberHw::createIcmpEchoSession(std::string hwSessionType, uint32_t guid)
 {
+    std::string guidStr = guidToString(guid);
     MUXLOGDEBUG(boost::format("%s: Creating the Icmp session of type %s with guid {%s}")
-                % mMuxPortConfig.getPortName() % hwSessionType % guid);
-    auto entries =  std::make_unique<mux::IcmpHwOffloadEntries>();
+                % mMuxPortConfig.getPortName() % hwSessionType % guidStr);
     std::string portName = mMuxPortConfig.getPortName();
     std::string tx_interval = std::to_string(mMuxPortConfig.getTimeoutIpv4_msec());
     std::string rx_interval  = std::to_string(mMuxPortConfig.getTimeoutIpv4_msec() * mMuxPortConfig.getNegativeStateChangeRetryCount());
@@ -288,7 +352,7 @@ void LinkProberHw::createIcmpEchoSession(std::string hwSessionType, std::string
     }
 
     std::string key = mDefaultVrfName +
-        mKeySeparator + portName + mKeySeparator + guid + mKeySeparator;
+        mKeySeparator + portName + mKeySeparator + guidStr + mKeySeparator;
 
     if (hwSessionType == mSessionTypeSelf) {
         key += mSessionTypeSelf;
@@ -296,15 +360,48 @@ void LinkProberHw::createIcmpEchoSession(std::string hwSessionType, std::string
         key += mSessionTypePeer;
     }
 
-    entries->emplace_back("tx_interval", tx_interval);
-    entries->emplace_back("rx_interval", rx_interval);
-    entries->emplace_back("session_guid", guid);
-    entries->emplace_back("session_cookie", mSessionCookie);
-    entries->emplace_back("src_ip", src_ip);
-    entries->emplace_back("dst_ip", dst_ip);
-    entries->emplace_back("src_mac", src_mac);
-    entries->emplace_back("dst_mac", dst_mac);
+    std::pair<std::string, std::string> sessionEntries[] = {
+        {"tx_interval", tx_interval},
+        {"rx_interval", rx_interval},
+        {"session_guid", guidStr},
+        {"session_cookie", mSessionCookie},
+        {"src_ip", src_ip},
+        {"dst_ip", dst_ip},
+        {"src_mac", src_mac},
+        {"dst_mac", dst_mac},
+    };
+
+    // only fields that differ from the last write of this session go to APP_DB
+    IcmpSessionFields &programmedEntries = mIcmpSessionCache[key];
+    mux::IcmpHwOffloadEntriesPtr entries;
+    for (auto &sessionEntry: sessionEntries) {
+        auto iter = std::find_if(programmedEntries.begin(), programmedEntries.end(),
+            [&sessionEntry] (const std::pair<std::string, std::string> &entry) {
+                return entry.first == sessionEntry.first;
+            }
+        );
+        if (iter != programmedEntries.end() && iter->second == sessionEntry.second) {
+            continue;
+        }
+        if (!entries) {
+            entries = std::make_unique<mux::IcmpHwOffloadEntries>();
+        }
+        entries->push_back(sessionEntry);
+        if (iter == programmedEntries.end()) {
+            programmedEntries.push_back(std::move(sessionEntry));
+        } else {
+            iter->second = std::move(sessionEntry.second);
+        }
+    }
+
+    if (!entries) {
+        mIcmpSessionWriteSuppressedCount++;
+        MUXLOGDEBUG(boost::format("%s: Icmp session %s is already programmed, write suppressed") %
+            mMuxPortConfig.getPortName() % key);
+        return;
+    }
 
+    mIcmpSessionWriteCount++;
     mMuxPortPtr->createIcmpEchoSession(key, std::move(entries));
 }
 
@@ -313,19 +410,22 @@ void LinkProberHw::createIcmpEchoSession(std::string hwSessionType, std::string
 //
 // triggers deletion of icmp_echo_session
 //
-void LinkProberHw::deleteIcmpEchoSession(std::string hwSessionType, std::string guid)
+void LinkProberHw::deleteIcmpEchoSession(std::string hwSessionType, uint32_t guid)
 {
+    std::string guidStr = guidToString(guid);
     MUXLOGWARNING(boost::format("%s: Deleting the Icmp session of type %s with guid {%s} ")
-                  % mMuxPortConfig.getPortName() % hwSessionType %guid);
+                  % mMuxPortConfig.getPortName() % hwSessionType % guidStr);
     std::string portName = mMuxPortConfig.getPortName();
     std::string key = mDefaultVrfName +
-        mKeySeparator + portName + mKeySeparator + guid + mKeySeparator;
+        mKeySeparator + portName + mKeySeparator + guidStr + mKeySeparator;
     if (hwSessionType == mSessionTypeSelf) {
         key += mSessionTypeSelf;
     } else {
         key += mSessionTypePeer;
     }
     mMuxPortPtr->deleteIcmpEchoSession(key);
+    mIcmpSessionCache.erase(key);
+    handleIcmpSessionLost(hwSessionType);
 }
 
 //
@@ -467,33 +567,31 @@ void LinkProberHw::handleIcmpPayload(size_t bytesTransferred, icmphdr *icmpHeade
                 mMuxPortConfig.getBladeIpv4Address().to_string()
             );
 
-            std::string guidDataStr;
-            getGuidStr(icmpPayload, guidDataStr);
+            uint32_t guid = getGuid(icmpPayload);
 
-            if (guidDataStr == "0x0") {
+            if (guid == 0) {
                 MUXLOGWARNING(boost::format("%s: Received 0x0 GUID") %
                         mMuxPortConfig.getPortName());
                 //ignore this and get more packets
-                startRecv();
                 return;
             }
-            bool isSelfGuid = getSelfGuidData() == guidDataStr;
+            bool isSelfGuid = mSelfGuid == guid;
             // sequence numbers are not used by hw prober
             if (!isSelfGuid)
             {
                 // Received a peer guid
                 MUXLOGWARNING(boost::format("%s: Peer Guid Detected %s") %
-                        mMuxPortConfig.getPortName() % guidDataStr);
+                        mMuxPortConfig.getPortName() % guidToString(guid));
                 // existing peer guid session needs to be deleted, when we learn a new peer session
-                if ((mPeerType == SessionType::HARDWARE) && (mPeerGuid != "") &&
-                        (mPeerGuid != guidDataStr))
+                if ((mPeerType == SessionType::HARDWARE) && (mPeerGuid != 0) &&
+                        (mPeerGuid != guid))
                 {
                     deleteIcmpEchoSession(mSessionTypePeer, mPeerGuid);
                     mPositiveProbingPeerTimer.cancel();
                     mLinkProberStateMachinePtr->postLinkProberStateEvent(LinkProberStateMachineBase::getIcmpPeerUnknownEvent());
                 }
                 mPeerType = LinkProberBase::HARDWARE;
-                setPeerGuidData(guidDataStr);
+                setPeerGuidData(guid);
                 createIcmpEchoSession(mSessionTypePeer, getPeerGuidData());
             }
         } else {
@@ -510,27 +608,24 @@ void LinkProberHw::handleIcmpPayload(size_t bytesTransferred, icmphdr *icmpHeade
             );
 
             // we can get software cookie from only from peer
-            std::string guidDataStr;
-            getGuidStr(icmpPayload, guidDataStr);
-            if (guidDataStr == "0x0") {
+            uint32_t guid = getGuid(icmpPayload);
+            if (guid == 0) {
                 MUXLOGWARNING(boost::format("%s: Received 0x0 GUID from") %
                         mMuxPortConfig.getPortName());
-                startRecv();
                 return;
             }
 
-            if (guidDataStr == mSelfGuid)
+            if (guid == mSelfGuid)
             {
                 // ignore this, software generated TLV packets are coming back.
-                startRecv();
                 return;
             }
 
             // check peer TLV packets
             bool isTlvPkt = false;
-            size_t nextTlvSize = 0;
-            auto *tlvPtr = getNextTLVPtr(mTlvStartOffset, bytesTransferred, nextTlvSize);
-            if (tlvPtr && tlvPtr->tlvhead.type != TlvType::TLV_SENTINEL)
+            TlvReader tlvReader(mRxFramePtr, bytesTransferred, mTlvStartOffset);
+            TlvReader::const_iterator tlvIter = tlvReader.begin();
+            if (tlvIter != tlvReader.end() && tlvIter->type() != TlvType::TLV_SENTINEL)
                 isTlvPkt = true;
 
             // peer transitioned to software we need to delete peer HW session
@@ -543,13 +638,12 @@ void LinkProberHw::handleIcmpPayload(size_t bytesTransferred, icmphdr *icmpHeade
             }
 
             // new peer guid
-            if (mPeerGuid != guidDataStr)
+            if (mPeerGuid != guid)
             {
-                setPeerGuidData(guidDataStr);
+                setPeerGuidData(guid);
                 mPositiveProbingPeerTimer.cancel();
                 mDeadlineTimer.cancel();
                 mLinkProberStateMachinePtr->postLinkProberStateEvent(LinkProberStateMachineBase::getIcmpPeerUnknownEvent());
-                startRecv();
                 startTimer();
                 return;
             }
@@ -561,7 +655,6 @@ void LinkProberHw::handleIcmpPayload(size_t bytesTransferred, icmphdr *icmpHeade
                     mMuxPortConfig.getPortName());
         }
     }
-    startRecv();
 }
 
 }
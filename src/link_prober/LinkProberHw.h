@@ -1,6 +1,11 @@
 #ifndef LINK_PROBER_LINKPROBERHW_H_
 #define LINK_PROBER_LINKPROBERHW_H_
 
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "LinkProberBase.h"
 
 namespace test {
@@ -147,6 +152,24 @@ public:
     void startTimer();
 
 
+    /**
+    *@method getIcmpSessionWriteCount
+    *
+    *@brief getter for number of ICMP_ECHO_SESSION writes sent to APP_DB
+    *
+    *@return issued write count
+    */
+    inline uint64_t getIcmpSessionWriteCount() const {return mIcmpSessionWriteCount;};
+
+    /**
+    *@method getIcmpSessionWriteSuppressedCount
+    *
+    *@brief getter for number of ICMP_ECHO_SESSION writes skipped because session was already programmed
+    *
+    *@return suppressed write count
+    */
+    inline uint64_t getIcmpSessionWriteSuppressedCount() const {return mIcmpSessionWriteSuppressedCount;};
+
     /**
     *@method ~LinkProber
     *
@@ -171,6 +194,28 @@ private:
     */
     void handleTimeout(boost::system::error_code errorCode);
 
+    /**
+    *@method isIcmpSessionOffloaded
+    *
+    *@brief check if self and peer ICMP sessions are both up in hardware, STATE_DB
+    *       ICMP_ECHO_SESSION notifications then drive the link prober without timer
+    *
+    *@return true if ICMP timeout timer is not needed
+    */
+    bool isIcmpSessionOffloaded() const;
+
+    /**
+    *@method handleIcmpSessionLost
+    *
+    *@brief mark ICMP session as no longer in hardware and restart ICMP timeout timer
+    *       stopped by timer-free steady state
+    *
+    *@param hwSessionType (in)  session type
+    *
+    *@return none
+    */
+    void handleIcmpSessionLost(const std::string &hwSessionType);
+
     /**
      *@method startPositiveProbingTimer
      *
@@ -214,7 +259,7 @@ private:
      *
      *@return none
      */
-    void createIcmpEchoSession(std::string torType, std::string guid);
+    void createIcmpEchoSession(std::string torType, uint32_t guid);
 
     /**
      *@method deleteIcmpEchoSession
@@ -226,7 +271,7 @@ private:
      *
      *@return none
      */
-    void deleteIcmpEchoSession(std::string torType, std::string guid);
+    void deleteIcmpEchoSession(std::string torType, uint32_t guid);
 
     /**
      *@method reportHeartbeatReplyNotReceivedActiveActive
@@ -262,9 +307,19 @@ private:
     std::string etherMacArrayToString(const std::array<uint8_t, 6>& macAddress);
 
     mux::MuxPort *mMuxPortPtr;
-    boost::asio::deadline_timer mSuspendTimer;
-    boost::asio::deadline_timer mPositiveProbingTimer;
-    boost::asio::deadline_timer mPositiveProbingPeerTimer;
+    common::WheelTimer mSuspendTimer;
+    common::WheelTimer mPositiveProbingTimer;
+    common::WheelTimer mPositiveProbingPeerTimer;
+
+    // APP_DB ICMP_ECHO_SESSION fields last written per session key
+    using IcmpSessionFields = std::vector<std::pair<std::string, std::string>>;
+    std::unordered_map<std::string, IcmpSessionFields> mIcmpSessionCache;
+    uint64_t mIcmpSessionWriteCount = 0;
+    uint64_t mIcmpSessionWriteSuppressedCount = 0;
+
+    bool mSelfSessionUp = false;
+    bool mPeerSessionUp = false;
+    bool mTimerFree = false;
 
     static std::string mIcmpTableName;
     static std::string mSessionCookie;
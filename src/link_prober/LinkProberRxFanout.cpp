@@ -0,0 +1,494 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LinkProberRxFanout.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <sstream>
+#include <string.h>
+
+#include <net/ethernet.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <unistd.h>
+
+#include <boost/bind/bind.hpp>
+
+#include "common/MuxException.h"
+#include "common/MuxLogger.h"
+#include "LinkProberBase.h"
+#include "LinkProberRxFanout.h"
+
+namespace link_prober
+{
+//
+// ---> getRealTime();
+//
+// current CLOCK_REALTIME in nanoseconds, the clock kernel RX timestamps are taken from
+//
+static uint64_t getRealTime()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    return now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+//
+// ---> Worker(size_t workerIndex);
+//
+// class constructor
+//
+LinkProberRxFanout::Worker::Worker(size_t workerIndex) :
+    index(workerIndex),
+    stream(ioService)
+{
+    memset(rxMsgHdrs.data(), 0, sizeof(rxMsgHdrs));
+    for (size_t i = 0; i < MUX_RX_FANOUT_BATCH_SIZE; i++) {
+        rxIovecs[i].iov_base = rxBuffers[i].data();
+        rxIovecs[i].iov_len = rxBuffers[i].size();
+        rxMsgHdrs[i].msg_hdr.msg_name = &rxAddrs[i];
+        rxMsgHdrs[i].msg_hdr.msg_iov = &rxIovecs[i];
+        rxMsgHdrs[i].msg_hdr.msg_iovlen = 1;
+        rxMsgHdrs[i].msg_hdr.msg_control = rxControls[i].data();
+    }
+}
+
+//
+// ---> getInstance();
+//
+// constructs LinkProberRxFanout singleton instance
+//
+LinkProberRxFanoutPtr LinkProberRxFanout::getInstance()
+{
+    static std::shared_ptr<LinkProberRxFanout> LinkProberRxFanoutPtr = nullptr;
+
+    if (LinkProberRxFanoutPtr == nullptr) {
+        LinkProberRxFanoutPtr = std::shared_ptr<LinkProberRxFanout> (new LinkProberRxFanout);
+    }
+
+    return LinkProberRxFanoutPtr;
+}
+
+//
+// ---> ~LinkProberRxFanout();
+//
+// class destructor
+//
+LinkProberRxFanout::~LinkProberRxFanout()
+{
+    deinitialize();
+}
+
+//
+// ---> parseMode(const std::string &name, Mode &mode);
+//
+// parse fanout mode name
+//
+bool LinkProberRxFanout::parseMode(const std::string &name, Mode &mode)
+{
+    if (name == "ifindex") {
+        mode = Mode::IfIndex;
+    } else if (name == "hash") {
+        mode = Mode::Hash;
+    } else if (name == "cpu") {
+        mode = Mode::Cpu;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+//
+// ---> initialize(size_t workerCount, Mode mode);
+//
+// open fanout group sockets and start worker threads
+//
+void LinkProberRxFanout::initialize(size_t workerCount, Mode mode)
+{
+    mMode = mode;
+    mFanoutGroupId = getpid() & 0xffff;
+
+    // server IP and echo id are checked by the owning link prober
+    IcmpFilterIdentity identity;
+    identity.softwareCookie = IcmpPayload::getSoftwareCookie();
+    identity.hardwareCookie = IcmpPayload::getHardwareCookie();
+    identity.version = IcmpPayload::getVersion();
+    mSockFilter.compile(identity);
+
+    // steer frames to the worker owning their ingress interface
+    mFanoutProg = {
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t> (SKF_AD_OFF + SKF_AD_IFINDEX)),
+        BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, static_cast<uint32_t> (workerCount)),
+        BPF_STMT(BPF_RET | BPF_A, 0)
+    };
+
+    try {
+        // sockets join fanout group in worker order, so group member index is worker index
+        for (size_t i = 0; i < workerCount; i++) {
+            mWorkers.emplace_back(new Worker(i));
+            setupSocket(*mWorkers.back());
+        }
+    }
+    catch (const common::SocketErrorException &ex) {
+        for (auto &workerPtr: mWorkers) {
+            if (workerPtr->socket >= 0) {
+                close(workerPtr->socket);
+            }
+        }
+        mWorkers.clear();
+        throw;
+    }
+
+    for (auto &workerPtr: mWorkers) {
+        Worker &worker = *workerPtr;
+        worker.stream.assign(worker.socket);
+        worker.workPtr.reset(new boost::asio::io_service::work(worker.ioService));
+        startWait(worker);
+        worker.threadPtr = std::make_shared<boost::thread> (
+            boost::bind(&boost::asio::io_service::run, &worker.ioService)
+        );
+    }
+    mEnabled = true;
+
+    static const char *modeNames[] = {"ifindex", "hash", "cpu"};
+    MUXLOGWARNING(boost::format("Link Prober RX fanout initialized with %d workers in %s mode") %
+        workerCount %
+        modeNames[static_cast<int> (mode)]
+    );
+}
+
+//
+// ---> deinitialize();
+//
+// stop worker threads and close fanout group sockets
+//
+void LinkProberRxFanout::deinitialize()
+{
+    if (mEnabled) {
+        mEnabled = false;
+
+        for (auto &workerPtr: mWorkers) {
+            workerPtr->workPtr.reset();
+            workerPtr->ioService.stop();
+            workerPtr->threadPtr->join();
+
+            boost::system::error_code errorCode;
+            workerPtr->stream.close(errorCode);
+            workerPtr->socket = -1;
+        }
+    }
+}
+
+//
+// ---> setupSocket(Worker &worker);
+//
+// create worker packet socket, attach filter and join fanout group
+//
+void LinkProberRxFanout::setupSocket(Worker &worker)
+{
+    // socket with no protocol will not receive any packet until it is bound
+    worker.socket = socket(AF_PACKET, SOCK_RAW | SOCK_NONBLOCK, 0);
+    if (worker.socket < 0) {
+        std::ostringstream errMsg;
+        errMsg << "Failed to open RX fanout socket with '" << strerror(errno) << "'" << std::endl;
+        throw MUX_ERROR(SocketError, errMsg.str());
+    }
+
+    struct sock_fprog sockFilterProg = mSockFilter.getSockFilterProg();
+    if (setsockopt(worker.socket, SOL_SOCKET, SO_ATTACH_FILTER, &sockFilterProg, sizeof(sockFilterProg)) != 0) {
+        std::ostringstream errMsg;
+        errMsg << "Failed to attach RX fanout filter with '" << strerror(errno) << "'" << std::endl;
+        close(worker.socket);
+        worker.socket = -1;
+        throw MUX_ERROR(SocketError, errMsg.str());
+    }
+
+    int timestampingFlags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    if (setsockopt(worker.socket, SOL_SOCKET, SO_TIMESTAMPING, &timestampingFlags, sizeof(timestampingFlags)) != 0) {
+        MUXLOGWARNING(boost::format("Failed to enable RX timestamps of fanout worker %d with '%s'") %
+            worker.index %
+            strerror(errno)
+        );
+    }
+
+    SockAddrLinkLayer addr = {0};
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_IP);
+    addr.sll_ifindex = 0;
+    if (bind(worker.socket, (struct sockaddr *) &addr, sizeof(addr))) {
+        std::ostringstream errMsg;
+        errMsg << "Failed to bind RX fanout socket with '" << strerror(errno) << "'" << std::endl;
+        close(worker.socket);
+        worker.socket = -1;
+        throw MUX_ERROR(SocketError, errMsg.str());
+    }
+
+    int fanoutType = PACKET_FANOUT_CBPF;
+    if (mMode == Mode::Hash) {
+        fanoutType = PACKET_FANOUT_HASH;
+    } else if (mMode == Mode::Cpu) {
+        fanoutType = PACKET_FANOUT_CPU;
+    }
+    int fanoutArg = mFanoutGroupId | (fanoutType << 16);
+    if (setsockopt(worker.socket, SOL_PACKET, PACKET_FANOUT, &fanoutArg, sizeof(fanoutArg)) != 0) {
+        std::ostringstream errMsg;
+        errMsg << "Failed to join RX fanout group with '" << strerror(errno) << "'" << std::endl;
+        close(worker.socket);
+        worker.socket = -1;
+        throw MUX_ERROR(SocketError, errMsg.str());
+    }
+
+    if (mMode == Mode::IfIndex && worker.index == 0) {
+        // fanout program is shared by the group, setting it on first member is enough
+        struct sock_fprog fanoutProg;
+        fanoutProg.len = mFanoutProg.size();
+        fanoutProg.filter = mFanoutProg.data();
+        if (setsockopt(worker.socket, SOL_PACKET, PACKET_FANOUT_DATA, &fanoutProg, sizeof(fanoutProg)) != 0) {
+            std::ostringstream errMsg;
+            errMsg << "Failed to set RX fanout program with '" << strerror(errno) << "'" << std::endl;
+            close(worker.socket);
+        worker.socket = -1;
+            throw MUX_ERROR(SocketError, errMsg.str());
+        }
+    }
+}
+
+//
+// ---> getIoService(const std::string &portName, boost::asio::io_service &ioService);
+//
+// getter for io_service a link prober of port runs on
+//
+boost::asio::io_service& LinkProberRxFanout::getIoService(const std::string &portName, boost::asio::io_service &ioService)
+{
+    if (!mEnabled) {
+        return ioService;
+    }
+
+    return mWorkers[getOwnerWorkerIndex(if_nametoindex(portName.c_str()))]->ioService;
+}
+
+//
+// ---> registerLinkProber(int ifIndex, LinkProberBase *linkProberPtr, boost::asio::io_service &ioService);
+//
+// register link prober as owner of frames received on interface
+//
+void LinkProberRxFanout::registerLinkProber(int ifIndex, LinkProberBase *linkProberPtr, boost::asio::io_service &ioService)
+{
+    Owner owner = {linkProberPtr, getOwnerWorkerIndex(ifIndex), false};
+    for (auto &workerPtr: mWorkers) {
+        if (&workerPtr->ioService == &ioService) {
+            owner.workerIndex = workerPtr->index;
+            owner.onWorker = true;
+            break;
+        }
+    }
+    if (!owner.onWorker) {
+        // link prober strand is not served by a worker, frames are posted to it instead
+        MUXLOGWARNING(boost::format("Link prober of interface %d does not run on RX fanout worker") % ifIndex);
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mLinkProberMapMutex);
+    mLinkProberMap[ifIndex] = owner;
+}
+
+//
+// ---> unregisterLinkProber(int ifIndex, LinkProberBase *linkProberPtr);
+//
+// remove link prober as owner of frames received on interface
+//
+void LinkProberRxFanout::unregisterLinkProber(int ifIndex, LinkProberBase *linkProberPtr)
+{
+    std::unique_lock<std::shared_mutex> lock(mLinkProberMapMutex);
+    auto iter = mLinkProberMap.find(ifIndex);
+    if (iter != mLinkProberMap.end() && iter->second.linkProberPtr == linkProberPtr) {
+        mLinkProberMap.erase(iter);
+    }
+}
+
+//
+// ---> dumpStats();
+//
+// log packet counters and latency of every worker
+//
+void LinkProberRxFanout::dumpStats()
+{
+    for (auto &workerPtr: mWorkers) {
+        Worker &worker = *workerPtr;
+        MUXLOGWARNING(boost::format("Link Prober RX fanout worker %d: frames: %d, forwarded: %d, unclaimed: %d, "
+            "wakeups: %d, latency p50: %dus, p99: %dus, p999: %dus, max: %dus") %
+            worker.index %
+            worker.frameCount %
+            worker.forwardedFrameCount %
+            worker.unclaimedFrameCount %
+            worker.wakeupCount %
+            worker.latencyHistogram.getPercentile(50) %
+            worker.latencyHistogram.getPercentile(99) %
+            worker.latencyHistogram.getPercentile(99.9) %
+            worker.latencyHistogram.getMax()
+        );
+    }
+}
+
+//
+// ---> startWait(Worker &worker);
+//
+// wait for worker socket to become readable
+//
+void LinkProberRxFanout::startWait(Worker &worker)
+{
+    worker.stream.async_wait(
+        boost::asio::posix::stream_descriptor::wait_read,
+        boost::bind(
+            &LinkProberRxFanout::handleWait,
+            this,
+            boost::ref(worker),
+            boost::asio::placeholders::error
+        )
+    );
+}
+
+//
+// ---> handleWait(Worker &worker, const boost::system::error_code &errorCode);
+//
+// receive queued frames of worker socket and hand them to owning link probers
+//
+void LinkProberRxFanout::handleWait(Worker &worker, const boost::system::error_code &errorCode)
+{
+    if (errorCode == boost::asio::error::operation_aborted) {
+        return;
+    } else if (errorCode) {
+        MUXLOGERROR(boost::format("RX fanout worker %d wait failed with error: %s") % worker.index % errorCode.message());
+        startWait(worker);
+        return;
+    }
+
+    size_t frameCount = 0;
+    while (frameCount < MUX_RX_FANOUT_DRAIN_LIMIT) {
+        for (struct mmsghdr &msgHdr: worker.rxMsgHdrs) {
+            msgHdr.msg_hdr.msg_namelen = sizeof(worker.rxAddrs[0]);
+            msgHdr.msg_hdr.msg_controllen = sizeof(worker.rxControls[0]);
+        }
+        int rc = recvmmsg(worker.socket, worker.rxMsgHdrs.data(), MUX_RX_FANOUT_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+        if (rc <= 0) {
+            break;
+        }
+
+        std::shared_lock<std::shared_mutex> lock(mLinkProberMapMutex);
+        for (int i = 0; i < rc; i++) {
+            dispatchFrame(
+                worker,
+                worker.rxAddrs[i].sll_ifindex,
+                worker.rxBuffers[i].data(),
+                worker.rxMsgHdrs[i].msg_len,
+                LinkProberBase::getRxTimestamp(worker.rxMsgHdrs[i].msg_hdr)
+            );
+        }
+        frameCount += rc;
+
+        if (rc < MUX_RX_FANOUT_BATCH_SIZE) {
+            break;
+        }
+    }
+
+    if (frameCount > 0) {
+        worker.wakeupCount++;
+        worker.frameCount += frameCount;
+    }
+
+    startWait(worker);
+}
+
+//
+// ---> dispatchFrame(Worker &worker, int ifIndex, uint8_t *frame, size_t size, uint64_t rxTimestamp);
+//
+// process frame inline when link prober runs on this worker, forward it otherwise
+//
+void LinkProberRxFanout::dispatchFrame(Worker &worker, int ifIndex, uint8_t *frame, size_t size, uint64_t rxTimestamp)
+{
+    auto iter = mLinkProberMap.find(ifIndex);
+    if (iter == mLinkProberMap.end()) {
+        worker.unclaimedFrameCount++;
+        return;
+    }
+
+    const Owner &owner = iter->second;
+    if (owner.onWorker && owner.workerIndex == worker.index) {
+        // worker thread is the only one running link prober handlers, no strand hop is needed
+        recordLatency(worker, rxTimestamp);
+        owner.linkProberPtr->handleRxFanoutFrame(frame, size, rxTimestamp);
+        return;
+    }
+
+    worker.forwardedFrameCount++;
+    std::shared_ptr<RxBuffer> frameRef = std::make_shared<RxBuffer> ();
+    memcpy(frameRef->data(), frame, size);
+    if (owner.onWorker) {
+        Worker &ownerWorker = *mWorkers[owner.workerIndex];
+        boost::asio::post(ownerWorker.ioService, boost::bind(
+            &LinkProberRxFanout::processForwardedFrame,
+            this,
+            boost::ref(ownerWorker),
+            ifIndex,
+            frameRef,
+            size,
+            rxTimestamp
+        ));
+    } else {
+        owner.linkProberPtr->handleRxRingFrame(frameRef->data(), size, rxTimestamp, frameRef);
+    }
+}
+
+//
+// ---> processForwardedFrame(Worker &worker, int ifIndex, std::shared_ptr<RxBuffer> frameRef, size_t size, uint64_t rxTimestamp);
+//
+// process frame forwarded by another worker on the owning worker
+//
+void LinkProberRxFanout::processForwardedFrame(
+    Worker &worker,
+    int ifIndex,
+    std::shared_ptr<RxBuffer> frameRef,
+    size_t size,
+    uint64_t rxTimestamp
+)
+{
+    // link prober may have gone away while frame was in flight
+    std::shared_lock<std::shared_mutex> lock(mLinkProberMapMutex);
+    auto iter = mLinkProberMap.find(ifIndex);
+    if (iter != mLinkProberMap.end() && iter->second.onWorker && iter->second.workerIndex == worker.index) {
+        recordLatency(worker, rxTimestamp);
+        iter->second.linkProberPtr->handleRxFanoutFrame(frameRef->data(), size, rxTimestamp);
+    }
+}
+
+//
+// ---> recordLatency(Worker &worker, uint64_t rxTimestamp);
+//
+// record delay from kernel RX timestamp to now in worker latency histogram
+//
+void LinkProberRxFanout::recordLatency(Worker &worker, uint64_t rxTimestamp)
+{
+    uint64_t now = getRealTime();
+    if (now > rxTimestamp) {
+        worker.latencyHistogram.record((now - rxTimestamp) / 1000);
+    }
+}
+
+} /* namespace link_prober */
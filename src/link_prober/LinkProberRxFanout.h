@@ -0,0 +1,397 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LinkProberRxFanout.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef LINK_PROBER_LINKPROBERRXFANOUT_H_
+#define LINK_PROBER_LINKPROBERRXFANOUT_H_
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/socket.h>
+#include <linux/if_packet.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+
+#include <common/BoostAsioBehavior.h>
+#include <boost/asio.hpp>
+#include <boost/thread.hpp>
+
+#include "IcmpPayload.h"
+#include "LinkProberFilter.h"
+#include "common/LatencyHistogram.h"
+
+#define MUX_RX_FANOUT_BATCH_SIZE    8
+#define MUX_RX_FANOUT_DRAIN_LIMIT   (4 * MUX_RX_FANOUT_BATCH_SIZE)
+
+namespace test {
+class LinkProberTest;
+}
+
+namespace link_prober
+{
+class LinkProberBase;
+class LinkProberRxFanout;
+
+using LinkProberRxFanoutPtr = std::shared_ptr<LinkProberRxFanout>;
+
+/**
+ *@class LinkProberRxFanout
+ *
+ *@brief spreads ICMP ECHOREPLY packets of all mux ports across worker threads
+ *       with a PACKET_FANOUT group of one packet socket per worker. A port is
+ *       owned by worker (interface index % worker count): its link prober runs
+ *       on the worker io_service and the worker processes its frames inline.
+ *       In ifindex mode a classic BPF fanout program steers every frame to the
+ *       owning worker; in hash and cpu modes frames landing on another worker
+ *       are forwarded to the owner.
+ */
+class LinkProberRxFanout
+{
+public:
+    /**
+    *@enum Mode
+    *
+    *@brief fanout group mode
+    */
+    enum class Mode: uint8_t {
+        IfIndex,
+        Hash,
+        Cpu
+    };
+
+    /**
+    *@method LinkProberRxFanout
+    *
+    *@brief class copy constructor
+    *
+    *@param LinkProberRxFanout (in)  reference to LinkProberRxFanout object to be copied
+    */
+    LinkProberRxFanout(const LinkProberRxFanout &) = delete;
+
+    /**
+    *@method ~LinkProberRxFanout
+    *
+    *@brief class destructor
+    */
+    virtual ~LinkProberRxFanout();
+
+    /**
+    *@method getInstance
+    *
+    *@brief constructs LinkProberRxFanout singleton instance
+    *
+    *@return shared pointer to LinkProberRxFanout singleton instance
+    */
+    static LinkProberRxFanoutPtr getInstance();
+
+    /**
+    *@method parseMode
+    *
+    *@brief parse fanout mode name
+    *
+    *@param name (in)   one of ifindex, hash or cpu
+    *@param mode (out)  parsed fanout mode
+    *
+    *@return true if name is a valid fanout mode
+    */
+    static bool parseMode(const std::string &name, Mode &mode);
+
+    /**
+    *@method initialize
+    *
+    *@brief open fanout group sockets and start worker threads
+    *
+    *@param workerCount (in)    number of worker threads
+    *@param mode (in)           fanout group mode
+    *
+    *@return none
+    */
+    void initialize(size_t workerCount, Mode mode);
+
+    /**
+    *@method deinitialize
+    *
+    *@brief stop worker threads and close fanout group sockets
+    *
+    *@return none
+    */
+    void deinitialize();
+
+    /**
+    *@method isEnabled
+    *
+    *@brief check if fanout workers are up and link probers should use them
+    *
+    *@return true if fanout workers are in use
+    */
+    inline bool isEnabled() const {return mEnabled;};
+
+    /**
+    *@method getIoService
+    *
+    *@brief getter for io_service a link prober of port runs on
+    *
+    *@param portName (in)       mux port name
+    *@param ioService (in)      io_service used when fanout workers are not in use
+    *
+    *@return reference to io_service of owning worker
+    */
+    boost::asio::io_service& getIoService(const std::string &portName, boost::asio::io_service &ioService);
+
+    /**
+    *@method registerLinkProber
+    *
+    *@brief register link prober as owner of frames received on interface
+    *
+    *@param ifIndex (in)            interface index of mux port
+    *@param linkProberPtr (in)      pointer to owning link prober
+    *@param ioService (in)          io_service link prober runs on
+    *
+    *@return none
+    */
+    void registerLinkProber(int ifIndex, LinkProberBase *linkProberPtr, boost::asio::io_service &ioService);
+
+    /**
+    *@method unregisterLinkProber
+    *
+    *@brief remove link prober as owner of frames received on interface, no frame is
+    *       handed to link prober once this call returns
+    *
+    *@param ifIndex (in)            interface index of mux port
+    *@param linkProberPtr (in)      pointer to owning link prober
+    *
+    *@return none
+    */
+    void unregisterLinkProber(int ifIndex, LinkProberBase *linkProberPtr);
+
+    /**
+    *@method getWorkerCount
+    *
+    *@brief getter for number of worker threads
+    *
+    *@return worker count
+    */
+    inline size_t getWorkerCount() const {return mWorkers.size();};
+
+    /**
+    *@method getWorkerFrameCount
+    *
+    *@brief getter for number of frames received by worker
+    *
+    *@param workerIndex (in)    index of worker
+    *
+    *@return frame count
+    */
+    inline uint64_t getWorkerFrameCount(size_t workerIndex) const {return mWorkers[workerIndex]->frameCount;};
+
+    /**
+    *@method getWorkerForwardedFrameCount
+    *
+    *@brief getter for number of frames received by worker and forwarded to the owning worker
+    *
+    *@param workerIndex (in)    index of worker
+    *
+    *@return forwarded frame count
+    */
+    inline uint64_t getWorkerForwardedFrameCount(size_t workerIndex) const {return mWorkers[workerIndex]->forwardedFrameCount;};
+
+    /**
+    *@method getWorkerLatencyHistogram
+    *
+    *@brief getter for histogram of delay from kernel RX timestamp to frame processing on worker,
+    *       samples are in microseconds
+    *
+    *@param workerIndex (in)    index of worker
+    *
+    *@return reference to latency histogram
+    */
+    inline const common::LatencyHistogram& getWorkerLatencyHistogram(size_t workerIndex) const {
+        return mWorkers[workerIndex]->latencyHistogram;
+    };
+
+    /**
+    *@method dumpStats
+    *
+    *@brief log packet counters and latency of every worker
+    *
+    *@return none
+    */
+    void dumpStats();
+
+private:
+    friend class test::LinkProberTest;
+
+    using RxBuffer = std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE>;
+
+    /**
+    *@struct Worker
+    *
+    *@brief fanout group socket and the thread receiving on it
+    */
+    struct Worker {
+        explicit Worker(size_t workerIndex);
+
+        size_t index;
+        boost::asio::io_service ioService;
+        std::unique_ptr<boost::asio::io_service::work> workPtr;
+        boost::asio::posix::stream_descriptor stream;
+        std::shared_ptr<boost::thread> threadPtr;
+        int socket = -1;
+
+        std::array<RxBuffer, MUX_RX_FANOUT_BATCH_SIZE> rxBuffers;
+        std::array<struct iovec, MUX_RX_FANOUT_BATCH_SIZE> rxIovecs;
+        std::array<struct sockaddr_ll, MUX_RX_FANOUT_BATCH_SIZE> rxAddrs;
+        std::array<struct mmsghdr, MUX_RX_FANOUT_BATCH_SIZE> rxMsgHdrs;
+        std::array<std::array<uint8_t, CMSG_SPACE(sizeof(struct scm_timestamping))>, MUX_RX_FANOUT_BATCH_SIZE> rxControls;
+
+        std::atomic<uint64_t> frameCount{0};
+        std::atomic<uint64_t> forwardedFrameCount{0};
+        std::atomic<uint64_t> unclaimedFrameCount{0};
+        std::atomic<uint64_t> wakeupCount{0};
+        common::LatencyHistogram latencyHistogram;
+    };
+
+    /**
+    *@struct Owner
+    *
+    *@brief link prober owning frames of an interface and the worker it runs on
+    */
+    struct Owner {
+        LinkProberBase *linkProberPtr;
+        size_t workerIndex;
+        bool onWorker;
+    };
+
+    /**
+    *@method LinkProberRxFanout
+    *
+    *@brief class default constructor
+    */
+    LinkProberRxFanout() = default;
+
+    /**
+    *@method setupSocket
+    *
+    *@brief create worker packet socket, attach filter and join fanout group
+    *
+    *@param worker (in)     worker owning the socket
+    *
+    *@return none
+    */
+    void setupSocket(Worker &worker);
+
+    /**
+    *@method startWait
+    *
+    *@brief wait for worker socket to become readable
+    *
+    *@param worker (in)     worker to wait on
+    *
+    *@return none
+    */
+    void startWait(Worker &worker);
+
+    /**
+    *@method handleWait
+    *
+    *@brief receive queued frames of worker socket and hand them to owning link probers
+    *
+    *@param worker (in)     worker whose socket is readable
+    *@param errorCode (in)  socket error code
+    *
+    *@return none
+    */
+    void handleWait(Worker &worker, const boost::system::error_code &errorCode);
+
+    /**
+    *@method dispatchFrame
+    *
+    *@brief process frame inline when link prober runs on this worker, forward it otherwise
+    *
+    *@param worker (in)         worker that received the frame
+    *@param ifIndex (in)        ingress interface index
+    *@param frame (in)          pointer to Ethernet frame
+    *@param size (in)           size of Ethernet frame
+    *@param rxTimestamp (in)    kernel receive timestamp in nanoseconds
+    *
+    *@return none
+    */
+    void dispatchFrame(Worker &worker, int ifIndex, uint8_t *frame, size_t size, uint64_t rxTimestamp);
+
+    /**
+    *@method processForwardedFrame
+    *
+    *@brief process frame forwarded by another worker on the owning worker
+    *
+    *@param worker (in)         owning worker
+    *@param ifIndex (in)        ingress interface index
+    *@param frameRef (in)       frame copy
+    *@param size (in)           size of Ethernet frame
+    *@param rxTimestamp (in)    kernel receive timestamp in nanoseconds
+    *
+    *@return none
+    */
+    void processForwardedFrame(Worker &worker, int ifIndex, std::shared_ptr<RxBuffer> frameRef, size_t size, uint64_t rxTimestamp);
+
+    /**
+    *@method recordLatency
+    *
+    *@brief record delay from kernel RX timestamp to now in worker latency histogram
+    *
+    *@param worker (in)         worker processing the frame
+    *@param rxTimestamp (in)    kernel receive timestamp in nanoseconds
+    *
+    *@return none
+    */
+    void recordLatency(Worker &worker, uint64_t rxTimestamp);
+
+    /**
+    *@method getOwnerWorkerIndex
+    *
+    *@brief getter for index of worker owning an interface
+    *
+    *@param ifIndex (in)    interface index
+    *
+    *@return worker index
+    */
+    inline size_t getOwnerWorkerIndex(int ifIndex) const {return static_cast<size_t> (ifIndex) % mWorkers.size();};
+
+    LinkProberFilter mSockFilter;
+    std::vector<struct sock_filter> mFanoutProg;
+
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    Mode mMode = Mode::IfIndex;
+    uint16_t mFanoutGroupId = 0;
+    bool mEnabled = false;
+
+    std::shared_mutex mLinkProberMapMutex;
+    std::unordered_map<int, Owner> mLinkProberMap;
+};
+
+} /* namespace link_prober */
+
+#endif /* LINK_PROBER_LINKPROBERRXFANOUT_H_ */
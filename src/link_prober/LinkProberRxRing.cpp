@@ -0,0 +1,332 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LinkProberRxRing.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <sstream>
+
+#include <net/ethernet.h>
+#include <netinet/in.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <boost/bind/bind.hpp>
+
+#include "common/MuxException.h"
+#include "common/MuxLogger.h"
+#include "IcmpPayload.h"
+#include "LinkProberBase.h"
+#include "LinkProberRxRing.h"
+
+namespace link_prober
+{
+//
+// ---> getInstance();
+//
+// constructs LinkProberRxRing singleton instance
+//
+LinkProberRxRingPtr LinkProberRxRing::getInstance()
+{
+    static std::shared_ptr<LinkProberRxRing> LinkProberRxRingPtr = nullptr;
+
+    if (LinkProberRxRingPtr == nullptr) {
+        LinkProberRxRingPtr = std::shared_ptr<LinkProberRxRing> (new LinkProberRxRing);
+    }
+
+    return LinkProberRxRingPtr;
+}
+
+//
+// ---> initialize(boost::asio::io_service &ioService);
+//
+// open packet socket, map its RX ring and start receiving
+//
+void LinkProberRxRing::initialize(boost::asio::io_service &ioService)
+{
+    mStrandPtr = std::make_shared<boost::asio::io_service::strand> (ioService);
+    mStreamPtr = std::make_shared<boost::asio::posix::stream_descriptor> (ioService);
+
+    setupRing();
+
+    mStreamPtr->assign(mSocket);
+    mEnabled = true;
+
+    MUXLOGWARNING(boost::format("Link Prober RX ring initialized with %d blocks of %d bytes") %
+        MUX_RX_RING_BLOCK_COUNT %
+        MUX_RX_RING_BLOCK_SIZE
+    );
+
+    boost::asio::post(*mStrandPtr, boost::bind(&LinkProberRxRing::startWait, this));
+}
+
+//
+// ---> deinitialize();
+//
+// stop receiving, unmap RX ring and close packet socket
+//
+void LinkProberRxRing::deinitialize()
+{
+    if (mEnabled) {
+        mEnabled = false;
+
+        boost::system::error_code errorCode;
+        mStreamPtr->close(errorCode);
+        mSocket = -1;
+
+        munmap(mRingPtr, mRingSize);
+        mRingPtr = nullptr;
+    }
+}
+
+//
+// ---> setupRing();
+//
+// create packet socket, attach filter and map TPACKET_V3 RX ring
+//
+void LinkProberRxRing::setupRing()
+{
+    // socket with no protocol will not receive any packet until it is bound
+    mSocket = socket(AF_PACKET, SOCK_RAW | SOCK_NONBLOCK, 0);
+    if (mSocket < 0) {
+        std::ostringstream errMsg;
+        errMsg << "Failed to open RX ring socket with '" << strerror(errno) << "'" << std::endl;
+        throw MUX_ERROR(SocketError, errMsg.str());
+    }
+
+    int version = TPACKET_V3;
+    if (setsockopt(mSocket, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) != 0) {
+        std::ostringstream errMsg;
+        errMsg << "Failed to set TPACKET_V3 with '" << strerror(errno) << "'" << std::endl;
+        close(mSocket);
+        throw MUX_ERROR(SocketError, errMsg.str());
+    }
+
+    // server IP and echo id are checked by the owning link prober
+    IcmpFilterIdentity identity;
+    identity.softwareCookie = IcmpPayload::getSoftwareCookie();
+    identity.hardwareCookie = IcmpPayload::getHardwareCookie();
+    identity.version = IcmpPayload::getVersion();
+    mSockFilter.compile(identity);
+
+    struct sock_fprog sockFilterProg = mSockFilter.getSockFilterProg();
+    if (setsockopt(mSocket, SOL_SOCKET, SO_ATTACH_FILTER, &sockFilterProg, sizeof(sockFilterProg)) != 0) {
+        std::ostringstream errMsg;
+        errMsg << "Failed to attach RX ring filter with '" << strerror(errno) << "'" << std::endl;
+        close(mSocket);
+        throw MUX_ERROR(SocketError, errMsg.str());
+    }
+
+    struct tpacket_req3 req = {0};
+    req.tp_block_size = MUX_RX_RING_BLOCK_SIZE;
+    req.tp_block_nr = MUX_RX_RING_BLOCK_COUNT;
+    req.tp_frame_size = MUX_RX_RING_FRAME_SIZE;
+    req.tp_frame_nr = (MUX_RX_RING_BLOCK_SIZE / MUX_RX_RING_FRAME_SIZE) * MUX_RX_RING_BLOCK_COUNT;
+    req.tp_retire_blk_tov = MUX_RX_RING_BLOCK_TIMEOUT_MSEC;
+    if (setsockopt(mSocket, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) != 0) {
+        std::ostringstream errMsg;
+        errMsg << "Failed to setup RX ring with '" << strerror(errno) << "'" << std::endl;
+        close(mSocket);
+        throw MUX_ERROR(SocketError, errMsg.str());
+    }
+
+    mRingSize = static_cast<size_t> (req.tp_block_size) * req.tp_block_nr;
+    void *ringPtr = mmap(nullptr, mRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, mSocket, 0);
+    if (ringPtr == MAP_FAILED) {
+        std::ostringstream errMsg;
+        errMsg << "Failed to map RX ring with '" << strerror(errno) << "'" << std::endl;
+        close(mSocket);
+        throw MUX_ERROR(SocketError, errMsg.str());
+    }
+    mRingPtr = reinterpret_cast<uint8_t *> (ringPtr);
+
+    mBlockInFlight.reset(new std::atomic<bool>[MUX_RX_RING_BLOCK_COUNT]);
+    for (size_t i = 0; i < MUX_RX_RING_BLOCK_COUNT; i++) {
+        mBlockInFlight[i] = false;
+    }
+    mBlockIndex = 0;
+
+    SockAddrLinkLayer addr = {0};
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_IP);
+    addr.sll_ifindex = 0;
+    if (bind(mSocket, (struct sockaddr *) &addr, sizeof(addr))) {
+        std::ostringstream errMsg;
+        errMsg << "Failed to bind RX ring socket with '" << strerror(errno) << "'" << std::endl;
+        munmap(mRingPtr, mRingSize);
+        mRingPtr = nullptr;
+        close(mSocket);
+        throw MUX_ERROR(SocketError, errMsg.str());
+    }
+}
+
+//
+// ---> registerLinkProber(int ifIndex, LinkProberBase *linkProberPtr);
+//
+// register link prober as owner of frames received on interface
+//
+void LinkProberRxRing::registerLinkProber(int ifIndex, LinkProberBase *linkProberPtr)
+{
+    std::lock_guard<std::mutex> lock(mLinkProberMapMutex);
+    mLinkProberMap[ifIndex] = linkProberPtr;
+}
+
+//
+// ---> unregisterLinkProber(int ifIndex, LinkProberBase *linkProberPtr);
+//
+// remove link prober as owner of frames received on interface
+//
+void LinkProberRxRing::unregisterLinkProber(int ifIndex, LinkProberBase *linkProberPtr)
+{
+    std::lock_guard<std::mutex> lock(mLinkProberMapMutex);
+    auto iter = mLinkProberMap.find(ifIndex);
+    if (iter != mLinkProberMap.end() && iter->second == linkProberPtr) {
+        mLinkProberMap.erase(iter);
+    }
+}
+
+//
+// ---> startWait();
+//
+// wait for ring socket to become readable
+//
+void LinkProberRxRing::startWait()
+{
+    if (mEnabled) {
+        mStreamPtr->async_wait(
+            boost::asio::posix::stream_descriptor::wait_read,
+            mStrandPtr->wrap(boost::bind(
+                &LinkProberRxRing::handleWait,
+                this,
+                boost::asio::placeholders::error
+            ))
+        );
+    }
+}
+
+//
+// ---> handleWait(const boost::system::error_code &errorCode);
+//
+// handle ring socket readable notification
+//
+void LinkProberRxRing::handleWait(const boost::system::error_code &errorCode)
+{
+    if (!errorCode) {
+        processRing();
+    } else if (errorCode != boost::asio::error::operation_aborted) {
+        MUXLOGERROR(boost::format("RX ring wait failed with error: %s") % errorCode.message());
+        startWait();
+    }
+}
+
+//
+// ---> processRing();
+//
+// walk user owned ring blocks in order and dispatch their frames
+//
+void LinkProberRxRing::processRing()
+{
+    while (mEnabled) {
+        size_t blockIndex = mBlockIndex;
+
+        if (mBlockInFlight[blockIndex].load(std::memory_order_acquire)) {
+            // link probers still hold this block, releaseBlock() will resume processing
+            mStalled.store(true, std::memory_order_release);
+            if (mBlockInFlight[blockIndex].load(std::memory_order_acquire) ||
+                !mStalled.exchange(false, std::memory_order_acq_rel)) {
+                return;
+            }
+            continue;
+        }
+
+        tpacket_block_desc *blockDesc = getBlockDesc(blockIndex);
+        if ((__atomic_load_n(&blockDesc->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0) {
+            break;
+        }
+
+        mBlockInFlight[blockIndex].store(true, std::memory_order_release);
+        std::shared_ptr<void> blockRef(
+            nullptr,
+            [this, blockIndex] (void *) {releaseBlock(blockIndex);}
+        );
+        dispatchBlock(blockDesc, blockRef);
+
+        mBlockIndex = (blockIndex + 1) % MUX_RX_RING_BLOCK_COUNT;
+    }
+
+    startWait();
+}
+
+//
+// ---> dispatchBlock(tpacket_block_desc *blockDesc, std::shared_ptr<void> blockRef);
+//
+// hand every frame of a ring block to the link prober owning its interface
+//
+void LinkProberRxRing::dispatchBlock(tpacket_block_desc *blockDesc, std::shared_ptr<void> blockRef)
+{
+    uint8_t *blockPtr = reinterpret_cast<uint8_t *> (blockDesc);
+    uint32_t packetCount = blockDesc->hdr.bh1.num_pkts;
+    tpacket3_hdr *frameHeader = reinterpret_cast<tpacket3_hdr *> (blockPtr + blockDesc->hdr.bh1.offset_to_first_pkt);
+
+    mBlockCount++;
+
+    std::lock_guard<std::mutex> lock(mLinkProberMapMutex);
+    for (uint32_t i = 0; i < packetCount; i++) {
+        SockAddrLinkLayer *addr = reinterpret_cast<SockAddrLinkLayer *> (
+            reinterpret_cast<uint8_t *> (frameHeader) + TPACKET_ALIGN(sizeof(tpacket3_hdr))
+        );
+
+        auto iter = mLinkProberMap.find(addr->sll_ifindex);
+        if (iter != mLinkProberMap.end()) {
+            iter->second->handleRxRingFrame(
+                reinterpret_cast<uint8_t *> (frameHeader) + frameHeader->tp_mac,
+                frameHeader->tp_snaplen,
+                frameHeader->tp_sec * 1000000000ULL + frameHeader->tp_nsec,
+                blockRef
+            );
+            mFrameCount++;
+        } else {
+            mUnclaimedFrameCount++;
+        }
+
+        frameHeader = reinterpret_cast<tpacket3_hdr *> (
+            reinterpret_cast<uint8_t *> (frameHeader) + frameHeader->tp_next_offset
+        );
+    }
+}
+
+//
+// ---> releaseBlock(size_t blockIndex);
+//
+// return ring block to the kernel
+//
+void LinkProberRxRing::releaseBlock(size_t blockIndex)
+{
+    if (mRingPtr != nullptr) {
+        __atomic_store_n(&getBlockDesc(blockIndex)->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+    }
+    mBlockInFlight[blockIndex].store(false, std::memory_order_release);
+
+    if (mStalled.exchange(false, std::memory_order_acq_rel)) {
+        boost::asio::post(*mStrandPtr, boost::bind(&LinkProberRxRing::processRing, this));
+    }
+}
+
+} /* namespace link_prober */
@@ -0,0 +1,279 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LinkProberRxRing.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef LINK_PROBER_LINKPROBERRXRING_H_
+#define LINK_PROBER_LINKPROBERRXRING_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <linux/filter.h>
+#include <linux/if_packet.h>
+
+#include <common/BoostAsioBehavior.h>
+#include <boost/asio.hpp>
+
+#include "LinkProberFilter.h"
+
+#define MUX_RX_RING_BLOCK_SIZE          (1 << 16)
+#define MUX_RX_RING_BLOCK_COUNT         16
+#define MUX_RX_RING_FRAME_SIZE          (1 << 11)
+#define MUX_RX_RING_BLOCK_TIMEOUT_MSEC  1
+
+namespace test {
+class LinkProberTest;
+}
+
+namespace link_prober
+{
+class LinkProberBase;
+class LinkProberRxRing;
+
+using LinkProberRxRingPtr = std::shared_ptr<LinkProberRxRing>;
+
+/**
+ *@class LinkProberRxRing
+ *
+ *@brief receives ICMP ECHOREPLY packets of all mux ports through a single
+ *       TPACKET_V3 memory-mapped ring and demultiplexes them to the owning
+ *       link prober using the ingress interface index. Frames are handed to
+ *       link probers in place; a ring block is returned to the kernel once
+ *       every link prober is done with its frames.
+ */
+class LinkProberRxRing
+{
+public:
+    /**
+    *@method LinkProberRxRing
+    *
+    *@brief class copy constructor
+    *
+    *@param LinkProberRxRing (in)  reference to LinkProberRxRing object to be copied
+    */
+    LinkProberRxRing(const LinkProberRxRing &) = delete;
+
+    /**
+    *@method ~LinkProberRxRing
+    *
+    *@brief class destructor
+    */
+    virtual ~LinkProberRxRing() = default;
+
+    /**
+    *@method getInstance
+    *
+    *@brief constructs LinkProberRxRing singleton instance
+    *
+    *@return shared pointer to LinkProberRxRing singleton instance
+    */
+    static LinkProberRxRingPtr getInstance();
+
+    /**
+    *@method initialize
+    *
+    *@brief open packet socket, map its RX ring and start receiving
+    *
+    *@param ioService (in)  reference to boost io_service object
+    *
+    *@return none
+    */
+    void initialize(boost::asio::io_service &ioService);
+
+    /**
+    *@method deinitialize
+    *
+    *@brief stop receiving, unmap RX ring and close packet socket
+    *
+    *@return none
+    */
+    void deinitialize();
+
+    /**
+    *@method isEnabled
+    *
+    *@brief check if shared RX ring is up and link probers should use it
+    *
+    *@return true if RX ring is in use
+    */
+    inline bool isEnabled() const {return mEnabled;};
+
+    /**
+    *@method registerLinkProber
+    *
+    *@brief register link prober as owner of frames received on interface
+    *
+    *@param ifIndex (in)            interface index of mux port
+    *@param linkProberPtr (in)      pointer to owning link prober
+    *
+    *@return none
+    */
+    void registerLinkProber(int ifIndex, LinkProberBase *linkProberPtr);
+
+    /**
+    *@method unregisterLinkProber
+    *
+    *@brief remove link prober as owner of frames received on interface
+    *
+    *@param ifIndex (in)            interface index of mux port
+    *@param linkProberPtr (in)      pointer to owning link prober
+    *
+    *@return none
+    */
+    void unregisterLinkProber(int ifIndex, LinkProberBase *linkProberPtr);
+
+    /**
+    *@method getFrameCount
+    *
+    *@brief getter for number of frames handed to link probers
+    *
+    *@return frame count
+    */
+    inline uint64_t getFrameCount() const {return mFrameCount;};
+
+    /**
+    *@method getUnclaimedFrameCount
+    *
+    *@brief getter for number of frames received on interfaces without link prober
+    *
+    *@return unclaimed frame count
+    */
+    inline uint64_t getUnclaimedFrameCount() const {return mUnclaimedFrameCount;};
+
+    /**
+    *@method getBlockCount
+    *
+    *@brief getter for number of ring blocks processed
+    *
+    *@return block count
+    */
+    inline uint64_t getBlockCount() const {return mBlockCount;};
+
+private:
+    friend class test::LinkProberTest;
+
+    /**
+    *@method LinkProberRxRing
+    *
+    *@brief class default constructor
+    */
+    LinkProberRxRing() = default;
+
+    /**
+    *@method setupRing
+    *
+    *@brief create packet socket, attach filter and map TPACKET_V3 RX ring
+    *
+    *@return none
+    */
+    void setupRing();
+
+    /**
+    *@method startWait
+    *
+    *@brief wait for ring socket to become readable
+    *
+    *@return none
+    */
+    void startWait();
+
+    /**
+    *@method handleWait
+    *
+    *@brief handle ring socket readable notification
+    *
+    *@param errorCode (in)  socket error code
+    *
+    *@return none
+    */
+    void handleWait(const boost::system::error_code &errorCode);
+
+    /**
+    *@method processRing
+    *
+    *@brief walk user owned ring blocks in order and dispatch their frames
+    *
+    *@return none
+    */
+    void processRing();
+
+    /**
+    *@method dispatchBlock
+    *
+    *@brief hand every frame of a ring block to the link prober owning its interface
+    *
+    *@param blockDesc (in)  pointer to ring block descriptor
+    *@param blockRef (in)   reference held by link probers until their frames are processed
+    *
+    *@return none
+    */
+    void dispatchBlock(tpacket_block_desc *blockDesc, std::shared_ptr<void> blockRef);
+
+    /**
+    *@method releaseBlock
+    *
+    *@brief return ring block to the kernel
+    *
+    *@param blockIndex (in)     index of ring block
+    *
+    *@return none
+    */
+    void releaseBlock(size_t blockIndex);
+
+    /**
+    *@method getBlockDesc
+    *
+    *@brief getter for ring block descriptor
+    *
+    *@param blockIndex (in)     index of ring block
+    *
+    *@return pointer to ring block descriptor
+    */
+    inline tpacket_block_desc* getBlockDesc(size_t blockIndex) {
+        return reinterpret_cast<tpacket_block_desc *> (mRingPtr + blockIndex * MUX_RX_RING_BLOCK_SIZE);
+    };
+
+    LinkProberFilter mSockFilter;
+
+    std::shared_ptr<boost::asio::io_service::strand> mStrandPtr;
+    std::shared_ptr<boost::asio::posix::stream_descriptor> mStreamPtr;
+
+    int mSocket = -1;
+    uint8_t *mRingPtr = nullptr;
+    size_t mRingSize = 0;
+    size_t mBlockIndex = 0;
+    std::unique_ptr<std::atomic<bool>[]> mBlockInFlight;
+    std::atomic<bool> mStalled{false};
+    bool mEnabled = false;
+
+    std::mutex mLinkProberMapMutex;
+    std::unordered_map<int, LinkProberBase *> mLinkProberMap;
+
+    uint64_t mFrameCount = 0;
+    uint64_t mUnclaimedFrameCount = 0;
+    uint64_t mBlockCount = 0;
+};
+
+} /* namespace link_prober */
+
+#endif /* LINK_PROBER_LINKPROBERRXRING_H_ */
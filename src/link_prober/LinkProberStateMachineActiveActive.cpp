@@ -264,18 +264,21 @@ inline void LinkProberStateMachineActiveActive::postLinkManagerPeerEvent(LinkPro
 }
 
 // 
-// ---> handlePckLossRatioUpdate(const uint64_t unknownEventCount, const uint64_t expectedPacketCount);
+// ---> handlePckLossRatioUpdate(const uint64_t unknownEventCount, const uint64_t expectedPacketCount, const HeartbeatLossWindowStats &selfLossStats, const HeartbeatLossWindowStats &peerLossStats);
 //
 // post pck loss ratio update to link manager
 //
-void LinkProberStateMachineActiveActive::handlePckLossRatioUpdate(const uint64_t unknownEventCount, const uint64_t expectedPacketCount) 
+void LinkProberStateMachineActiveActive::handlePckLossRatioUpdate(const uint64_t unknownEventCount, const uint64_t expectedPacketCount,
+        const HeartbeatLossWindowStats &selfLossStats, const HeartbeatLossWindowStats &peerLossStats) 
 {
     boost::asio::io_service::strand &strand = mLinkManagerStateMachinePtr->getStrand();
     boost::asio::post(strand, boost::bind(
         &link_manager::LinkManagerStateMachineBase::handlePostPckLossRatioNotification,
         mLinkManagerStateMachinePtr,
         unknownEventCount,
-        expectedPacketCount
+        expectedPacketCount,
+        selfLossStats,
+        peerLossStats
     ));
 }
 
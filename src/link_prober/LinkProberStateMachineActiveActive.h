@@ -180,10 +180,13 @@ public:
      * 
      * @param unknownEventCount (in) count of missing icmp packets
      * @param expectedPacketCount (in) count of expected icmp packets
+     * @param selfLossStats (in) loss statistics of recent self heartbeats
+     * @param peerLossStats (in) loss statistics of recent peer heartbeats
      * 
      * @return none
     */
-    void handlePckLossRatioUpdate(const uint64_t unknownEventCount, const uint64_t expectedPacketCount) override;
+    void handlePckLossRatioUpdate(const uint64_t unknownEventCount, const uint64_t expectedPacketCount,
+        const HeartbeatLossWindowStats &selfLossStats, const HeartbeatLossWindowStats &peerLossStats) override;
 
 private:
     /**
@@ -139,11 +139,12 @@ void LinkProberStateMachineActiveStandby::handleMackAddressUpdate(const std::arr
 }
 
 // 
-// ---> handlePckLossRatioUpdate(const uint64_t unknownEventCount, const uint64_t expectedPacketCount);
+// ---> handlePckLossRatioUpdate(const uint64_t unknownEventCount, const uint64_t expectedPacketCount, const HeartbeatLossWindowStats &selfLossStats, const HeartbeatLossWindowStats &peerLossStats);
 //
 // post pck loss ratio update to link manager
 //
-void LinkProberStateMachineActiveStandby::handlePckLossRatioUpdate(const uint64_t unknownEventCount, const uint64_t expectedPacketCount) 
+void LinkProberStateMachineActiveStandby::handlePckLossRatioUpdate(const uint64_t unknownEventCount, const uint64_t expectedPacketCount,
+        const HeartbeatLossWindowStats &selfLossStats, const HeartbeatLossWindowStats &peerLossStats) 
 {
     boost::asio::io_service::strand &strand = mLinkManagerStateMachinePtr->getStrand();
     boost::asio::io_service &ioService = strand.context();
@@ -151,7 +152,9 @@ void LinkProberStateMachineActiveStandby::handlePckLossRatioUpdate(const uint64_
         &link_manager::LinkManagerStateMachineBase::handlePostPckLossRatioNotification,
         mLinkManagerStateMachinePtr,
         unknownEventCount,
-        expectedPacketCount
+        expectedPacketCount,
+        selfLossStats,
+        peerLossStats
     )));
 }
 
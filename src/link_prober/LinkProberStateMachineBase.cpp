@@ -359,15 +359,32 @@ void LinkProberStateMachineBase::handleMackAddressUpdate(const std::array<uint8_
 }
 
 //
-// ---> handlePckLossRatioUpdate(const uint64_t unknownEventCount, const uint64_t expectedPacketCount);
+// ---> handlePckLossRatioUpdate(const uint64_t unknownEventCount, const uint64_t expectedPacketCount, const HeartbeatLossWindowStats &selfLossStats, const HeartbeatLossWindowStats &peerLossStats);
 //
 // post pck loss ratio update to link manager
 //
-void LinkProberStateMachineBase::handlePckLossRatioUpdate(const uint64_t unknownEventCount, const uint64_t expectedPacketCount)
+void LinkProberStateMachineBase::handlePckLossRatioUpdate(const uint64_t unknownEventCount, const uint64_t expectedPacketCount,
+        const HeartbeatLossWindowStats &selfLossStats, const HeartbeatLossWindowStats &peerLossStats)
 {
     MUXLOGDEBUG(mMuxPortConfig.getPortName());
 }
 
+//
+// ---> handleProbeIntervalUpdate(const uint32_t probeInterval_msec);
+//
+// post current probing interval of adaptive link prober to link manager
+//
+void LinkProberStateMachineBase::handleProbeIntervalUpdate(const uint32_t probeInterval_msec)
+{
+    boost::asio::io_service::strand &strand = mLinkManagerStateMachinePtr->getStrand();
+    boost::asio::io_service &ioService = strand.context();
+    ioService.post(strand.wrap(boost::bind(
+        &link_manager::LinkManagerStateMachineBase::handlePostProbeIntervalNotification,
+        mLinkManagerStateMachinePtr,
+        probeInterval_msec
+    )));
+}
+
 //
 // ---> getCurrentPeerState();
 //
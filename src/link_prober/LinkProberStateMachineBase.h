@@ -18,6 +18,7 @@
 
 #include "common/StateMachine.h"
 #include "link_prober/ActiveState.h"
+#include "link_prober/HeartbeatLossWindow.h"
 #include "link_prober/PeerActiveState.h"
 #include "link_prober/PeerUnknownState.h"
 #include "link_prober/PeerWaitState.h"
@@ -440,10 +441,24 @@ public:
      *
      * @param unknownEventCount (in) count of missing icmp packets
      * @param expectedPacketCount (in) count of expected icmp packets
+     * @param selfLossStats (in) loss statistics of recent self heartbeats
+     * @param peerLossStats (in) loss statistics of recent peer heartbeats
      *
      * @return none
      */
-    virtual void handlePckLossRatioUpdate(const uint64_t unknownEventCount, const uint64_t expectedPacketCount);
+    virtual void handlePckLossRatioUpdate(const uint64_t unknownEventCount, const uint64_t expectedPacketCount,
+        const HeartbeatLossWindowStats &selfLossStats, const HeartbeatLossWindowStats &peerLossStats);
+
+    /**
+     * @method handleProbeIntervalUpdate
+     *
+     * @brief post current probing interval of adaptive link prober to link manager
+     *
+     * @param probeInterval_msec (in) current probing interval in msec
+     *
+     * @return none
+     */
+    void handleProbeIntervalUpdate(const uint32_t probeInterval_msec);
 
 public:
     /**
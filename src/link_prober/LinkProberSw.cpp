@@ -31,7 +31,18 @@
 
 namespace link_prober
 {
+//
+// ---> getMonotonicTime_msec();
+//
+// current CLOCK_MONOTONIC in milliseconds
+//
+static uint64_t getMonotonicTime_msec()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
 
+    return now.tv_sec * 1000ULL + now.tv_nsec / 1000000;
+}
 
 //
 // ---> LinkProberSw(
@@ -101,6 +112,9 @@ void LinkProberSw::startProbing()
 {
     mStream.cancel();
     sendHeartbeat();
+    if (isProbePipelined()) {
+        trackInFlightHeartbeat(getMonotonicTime_msec());
+    }
     startRecv();
     startTimer();
 }
@@ -178,8 +192,50 @@ void LinkProberSw::handleTimeout(boost::system::error_code errorCode)
     );
 
     mStream.cancel();
+    reportExpiredHeartbeats(getMonotonicTime_msec());
+
+    // start another cycle of send/recv
+    startProbing();
+}
+
+//
+// ---> reportExpiredHeartbeats(uint64_t now_msec);
+//
+// report heartbeats whose reply time is over at probe timer tick
+//
+void LinkProberSw::reportExpiredHeartbeats(uint64_t now_msec)
+{
+    if (isProbePipelined()) {
+        // heartbeats are retired on the first tick at or after their deadline
+        expireInFlightHeartbeats(now_msec);
+    } else if (mInFlightCount > 0) {
+        // pipelining was turned off by a longer probing interval, report heartbeats still in
+        // flight, last sent heartbeat included
+        while (mInFlightCount > 0) {
+            retireInFlightHeartbeat();
+        }
+    } else {
+        reportHeartbeatOutcome();
+    }
+}
+
+//
+// ---> reportHeartbeatOutcome();
+//
+// report heartbeat whose reply time is over
+//
+void LinkProberSw::reportHeartbeatOutcome()
+{
     mReportHeartbeatReplyNotReceivedFuncPtr(HeartbeatType::HEARTBEAT_SELF);
 
+    mLossWindows[static_cast<size_t> (HeartbeatType::HEARTBEAT_SELF)].record(mTxSeqNo != mRxSelfSeqNo);
+    mLossWindows[static_cast<size_t> (HeartbeatType::HEARTBEAT_PEER)].record(mTxSeqNo != mRxPeerSeqNo);
+
+    // standby ToR of active-standby port only sees heartbeats of its peer
+    bool heartbeatReceived = mTxSeqNo == mRxSelfSeqNo ||
+        (mMuxPortConfig.getPortCableType() == common::MuxPortConfig::PortCableType::ActiveStandby && mTxSeqNo == mRxPeerSeqNo);
+    updateAdaptiveProbeInterval(heartbeatReceived);
+
     mIcmpPacketCount++;
     if (mIcmpPacketCount % mMuxPortConfig.getLinkProberStatUpdateIntervalCount() == 0) {
         boost::asio::io_service::strand &strand = mLinkProberStateMachinePtr->getStrand();
@@ -188,11 +244,126 @@ void LinkProberSw::handleTimeout(boost::system::error_code errorCode)
             &LinkProberStateMachineBase::handlePckLossRatioUpdate,
             mLinkProberStateMachinePtr,
             mIcmpUnknownEventCount,
-            mIcmpPacketCount
+            mIcmpPacketCount,
+            mLossWindows[static_cast<size_t> (HeartbeatType::HEARTBEAT_SELF)].getStats(),
+            mLossWindows[static_cast<size_t> (HeartbeatType::HEARTBEAT_PEER)].getStats()
         )));
     }
-    // start another cycle of send/recv
-    startProbing();
+}
+
+//
+// ---> trackInFlightHeartbeat(uint64_t now_msec);
+//
+// add last sent heartbeat to in-flight window
+//
+void LinkProberSw::trackInFlightHeartbeat(uint64_t now_msec)
+{
+    if (mInFlightCount == mInFlightHeartbeats.size()) {
+        // only reachable on a tick shortened by probe phase alignment
+        MUXLOGDEBUG(boost::format("%s: in-flight heartbeat window is full, retiring heartbeat %d early") %
+            mMuxPortConfig.getPortName() %
+            mInFlightHeartbeats[mInFlightHead].seqNo
+        );
+        retireInFlightHeartbeat();
+    }
+
+    InFlightHeartbeat &heartbeat = mInFlightHeartbeats[(mInFlightHead + mInFlightCount) % mInFlightHeartbeats.size()];
+    heartbeat.seqNo = mTxSeqNo;
+    heartbeat.deadline_msec = now_msec + getInFlightTimeout_msec();
+    heartbeat.selfReceived = false;
+    heartbeat.peerReceived = false;
+    mInFlightCount++;
+}
+
+//
+// ---> getInFlightTimeout_msec();
+//
+// get detection timeout of in-flight heartbeats, clamped to what the in-flight window holds
+//
+uint32_t LinkProberSw::getInFlightTimeout_msec()
+{
+    uint32_t timeout_msec = mMuxPortConfig.getDetectionTimeoutIpv4_msec();
+    uint64_t maxTimeout_msec = static_cast<uint64_t> (getProbingInterval()) * (MUX_MAX_INFLIGHT_HEARTBEATS - 1);
+
+    bool clamped = timeout_msec > maxTimeout_msec;
+    if (clamped != mInFlightTimeoutClamped) {
+        mInFlightTimeoutClamped = clamped;
+        if (clamped) {
+            MUXLOGWARNING(boost::format("%s: detection timeout %d msec exceeds %d in-flight heartbeats at "
+                "probing interval %d msec, clamped to %d msec") %
+                mMuxPortConfig.getPortName() %
+                timeout_msec %
+                (MUX_MAX_INFLIGHT_HEARTBEATS - 1) %
+                getProbingInterval() %
+                maxTimeout_msec
+            );
+        } else {
+            MUXLOGWARNING(boost::format("%s: detection timeout %d msec is no longer clamped") %
+                mMuxPortConfig.getPortName() %
+                timeout_msec
+            );
+        }
+    }
+
+    return clamped ? static_cast<uint32_t> (maxTimeout_msec) : timeout_msec;
+}
+
+//
+// ---> expireInFlightHeartbeats(uint64_t now_msec);
+//
+// retire in-flight heartbeats whose deadline has passed
+//
+void LinkProberSw::expireInFlightHeartbeats(uint64_t now_msec)
+{
+    while (mInFlightCount > 0 && mInFlightHeartbeats[mInFlightHead].deadline_msec <= now_msec) {
+        retireInFlightHeartbeat();
+    }
+}
+
+//
+// ---> retireInFlightHeartbeat();
+//
+// report oldest in-flight heartbeat and remove it from the window
+//
+void LinkProberSw::retireInFlightHeartbeat()
+{
+    const InFlightHeartbeat &heartbeat = mInFlightHeartbeats[mInFlightHead];
+
+    // report functions look for replies to mTxSeqNo, present the retired heartbeat the same way
+    mRxSelfSeqNo = heartbeat.selfReceived ? mTxSeqNo : static_cast<uint16_t> (mTxSeqNo - 1);
+    mRxPeerSeqNo = heartbeat.peerReceived ? mTxSeqNo : static_cast<uint16_t> (mTxSeqNo - 1);
+    reportHeartbeatOutcome();
+
+    mInFlightHead = (mInFlightHead + 1) % mInFlightHeartbeats.size();
+    mInFlightCount--;
+}
+
+//
+// ---> creditInFlightHeartbeat(HeartbeatType heartbeatType, uint16_t seqNo);
+//
+// credit reply to the in-flight heartbeat it answers
+//
+bool LinkProberSw::creditInFlightHeartbeat(HeartbeatType heartbeatType, uint16_t seqNo)
+{
+    // heartbeats sent between probes, e.g. carrying switch commands, count for the preceding probe
+    for (size_t i = mInFlightCount; i > 0; i--) {
+        InFlightHeartbeat &heartbeat = mInFlightHeartbeats[(mInFlightHead + i - 1) % mInFlightHeartbeats.size()];
+        if (static_cast<uint16_t> (seqNo - heartbeat.seqNo) > static_cast<uint16_t> (mTxSeqNo - heartbeat.seqNo)) {
+            continue;
+        }
+
+        bool &received = heartbeatType == HeartbeatType::HEARTBEAT_SELF ? heartbeat.selfReceived : heartbeat.peerReceived;
+        if (received) {
+            return false;
+        }
+        received = true;
+        if (i < mInFlightCount) {
+            mLateReplyCount++;
+        }
+        return true;
+    }
+
+    return false;
 }
 
 //
@@ -225,9 +396,23 @@ void LinkProberSw::handleSuspendTimeout(boost::system::error_code errorCode)
 // reset Icmp packet counts, post a pck loss ratio update immediately 
 //
 void LinkProberSw::resetIcmpPacketCounts()
+{
+    // counters and loss windows are updated on the prober strand, called from link manager strand
+    boost::asio::post(mStrand, boost::bind(&LinkProberSw::handleResetIcmpPacketCounts, this));
+}
+
+//
+// ---> handleResetIcmpPacketCounts
+//
+// reset Icmp packet counts on prober strand, post a pck loss ratio update immediately
+//
+void LinkProberSw::handleResetIcmpPacketCounts()
 {
     mIcmpUnknownEventCount = 0;
     mIcmpPacketCount = 0;
+    for (HeartbeatLossWindow &lossWindow: mLossWindows) {
+        lossWindow.reset();
+    }
 
     boost::asio::io_service::strand &strand = mLinkProberStateMachinePtr->getStrand();
     boost::asio::io_service &ioService = strand.context();
@@ -235,7 +420,9 @@ void LinkProberSw::resetIcmpPacketCounts()
         &LinkProberStateMachineBase::handlePckLossRatioUpdate,
         mLinkProberStateMachinePtr,
         mIcmpUnknownEventCount,
-        mIcmpPacketCount
+        mIcmpPacketCount,
+        HeartbeatLossWindowStats(),
+        HeartbeatLossWindowStats()
     )));
 }
 
@@ -280,6 +467,7 @@ void LinkProberSw::decreaseProbeIntervalAfterSwitch(uint32_t switchTime_msec)
     )));
 
     mDecreaseProbingInterval = true;
+    resetProbeInterval();
 }
 
 // ---> revertProbeIntervalAfterSwitchComplete();
@@ -376,8 +564,12 @@ void LinkProberSw::reportHeartbeatReplyNotReceivedActiveActive(HeartbeatType hea
 void LinkProberSw::startTimer()
 {
     MUXLOGDEBUG(mMuxPortConfig.getPortName());
+    updateProbeBudget();
+    updateRxMode();
+
     // time out these heartbeats
-    mDeadlineTimer.expires_from_now(boost::posix_time::milliseconds(getProbingInterval()));
+    mTimerWaitCount++;
+    mDeadlineTimer.expires_from_now(boost::posix_time::milliseconds(getProbeTimerDelay_msec(getMonotonicTime_msec())));
     mDeadlineTimer.async_wait(mStrand.wrap(boost::bind(
         &LinkProberSw::handleTimeout,
         this,
@@ -402,17 +594,15 @@ void LinkProberSw::handleIcmpPayload(size_t bytesTransferred, icmphdr *icmpHeade
             mMuxPortConfig.getPortName() %
             mMuxPortConfig.getBladeIpv4Address().to_string()
         );
-        std::string guidDataStr;
-        getGuidStr(icmpPayload, guidDataStr);
+        uint32_t guid = getGuid(icmpPayload);
 
-        if (guidDataStr == "0x0") {
+        if (guid == 0) {
             MUXLOGWARNING(boost::format("%s: Received 0x0 GUID") %
                     mMuxPortConfig.getPortName());
-            startRecv();
             return;
         }
 
-        bool isSelfGuid = getSelfGuidData() == guidDataStr;
+        bool isSelfGuid = mSelfGuid == guid;
         HeartbeatType heartbeatType;
         if (isSelfGuid) {
             // echo reply for an echo request generated by this/active ToR
@@ -421,18 +611,31 @@ void LinkProberSw::handleIcmpPayload(size_t bytesTransferred, icmphdr *icmpHeade
         } else {
             mRxPeerSeqNo = mTxSeqNo;
             heartbeatType = HeartbeatType::HEARTBEAT_PEER;
-            MUXLOGDEBUG(boost::format("Peer Guid Detected %s") % guidDataStr);
-            setPeerGuidData(guidDataStr);
+            MUXLOGDEBUG(boost::format("Peer Guid Detected %s") % guidToString(guid));
+            setPeerGuidData(guid);
             if(isHwCookie){
                mPeerType = SessionType::HARDWARE;
             }
         }
-        mReportHeartbeatReplyReceivedFuncPtr(heartbeatType);
+        if (isSelfGuid && !isHwCookie) {
+            // hardware sessions do not carry TX timestamp in seq, peer TX timestamps come from the
+            // peer ToR clock so only self heartbeats give a round trip time
+            recordHeartbeatRtt(icmpPayload);
+        }
+        // only self replies echo our sequence number, hardware sessions and the peer ToR use their
+        // own sequence numbers, credit them to the last heartbeat. Heartbeats still in flight
+        // after pipelining is turned off are credited until the next tick reports them
+        if (mInFlightCount == 0 ||
+            creditInFlightHeartbeat(
+                heartbeatType,
+                isSelfGuid && !isHwCookie ? ntohs(icmpHeader->un.echo.sequence) : mTxSeqNo
+            )) {
+            mReportHeartbeatReplyReceivedFuncPtr(heartbeatType);
+        }
         handleTlvRecv(bytesTransferred, isSelfGuid);
     } else {
         MUXLOGWARNING(boost::format("Received invalid packet in software prober"));
     }
-    startRecv();
 }
 
 } /* namespace link_prober */
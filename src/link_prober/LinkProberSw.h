@@ -26,6 +26,8 @@
 
 #include "LinkProberBase.h"
 
+#define MUX_MAX_INFLIGHT_HEARTBEATS     8
+
 namespace test {
 class LinkProberTest;
 class LinkProberMockTest;
@@ -128,6 +130,15 @@ private:
      */
     void handleSwitchoverTimeout(boost::system::error_code errorCode);
 
+    /**
+     * @method handleResetIcmpPacketCounts()
+     * 
+     * @brief reset Icmp packet counts on prober strand, post a pck loss ratio update immediately 
+     * 
+     * @return none
+    */
+    void handleResetIcmpPacketCounts();
+
     friend class test::LinkProberTest;
     friend class test::LinkProberMockTest;
 
@@ -286,7 +297,118 @@ public:
     */
     virtual void handleIcmpPayload(size_t bytesTransferred, icmphdr *icmpHeader, IcmpPayload *icmpPayload) override;
 
+    /**
+    *@method getLateReplyCount
+    *
+    *@brief getter for number of replies credited after a newer heartbeat was sent
+    *
+    *@return late reply count
+    */
+    inline uint64_t getLateReplyCount() const {return mLateReplyCount;};
+
+private:
+    /**
+    *@method isProbePipelined
+    *
+    *@brief check if heartbeats stay in flight for longer than the probing interval
+    *
+    *@return true if detection timeout is longer than probing interval
+    */
+    inline bool isProbePipelined() {
+        return mMuxPortConfig.getDetectionTimeoutIpv4_msec() > getProbingInterval();
+    };
+
+    /**
+    *@method reportHeartbeatOutcome
+    *
+    *@brief report heartbeat whose reply time is over, received sequence numbers tell
+    *       whether self and peer replies arrived
+    *
+    *@return none
+    */
+    void reportHeartbeatOutcome();
+
+    /**
+    *@method reportExpiredHeartbeats
+    *
+    *@brief report heartbeats whose reply time is over at probe timer tick. In-flight
+    *       heartbeats are retired once their deadline has passed, or all at once when
+    *       pipelining is turned off
+    *
+    *@param now_msec (in)   current monotonic time in msec
+    *
+    *@return none
+    */
+    void reportExpiredHeartbeats(uint64_t now_msec);
+
+    /**
+    *@method getInFlightTimeout_msec
+    *
+    *@brief get detection timeout of in-flight heartbeats, clamped to
+    *       (MUX_MAX_INFLIGHT_HEARTBEATS - 1) probing intervals so the in-flight window
+    *       holds every heartbeat until its deadline
+    *
+    *@return detection timeout in msec
+    */
+    uint32_t getInFlightTimeout_msec();
+
+    /**
+    *@method trackInFlightHeartbeat
+    *
+    *@brief add last sent heartbeat to in-flight window, oldest heartbeat is retired
+    *       if the window is full
+    *
+    *@param now_msec (in)   current monotonic time in msec
+    *
+    *@return none
+    */
+    void trackInFlightHeartbeat(uint64_t now_msec);
+
+    /**
+    *@method expireInFlightHeartbeats
+    *
+    *@brief retire in-flight heartbeats whose deadline has passed
+    *
+    *@param now_msec (in)   current monotonic time in msec
+    *
+    *@return none
+    */
+    void expireInFlightHeartbeats(uint64_t now_msec);
+
+    /**
+    *@method retireInFlightHeartbeat
+    *
+    *@brief report oldest in-flight heartbeat and remove it from the window
+    *
+    *@return none
+    */
+    void retireInFlightHeartbeat();
+
+    /**
+    *@method creditInFlightHeartbeat
+    *
+    *@brief credit reply to the in-flight heartbeat it answers
+    *
+    *@param heartbeatType (in)  self or peer reply
+    *@param seqNo (in)          sequence number echoed by the reply
+    *
+    *@return false if the heartbeat already expired or was already credited
+    */
+    bool creditInFlightHeartbeat(HeartbeatType heartbeatType, uint16_t seqNo);
+
 private:
+    struct InFlightHeartbeat {
+        uint16_t seqNo;
+        uint64_t deadline_msec;
+        bool selfReceived;
+        bool peerReceived;
+    };
+
+    std::array<InFlightHeartbeat, MUX_MAX_INFLIGHT_HEARTBEATS> mInFlightHeartbeats;
+    size_t mInFlightHead = 0;
+    size_t mInFlightCount = 0;
+    uint64_t mLateReplyCount = 0;
+    bool mInFlightTimeoutClamped = false;
 };
 
 } /* namespace link_prober */
@@ -0,0 +1,289 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LinkProberTxBatcher.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <cstring>
+#include <sstream>
+
+#include <net/ethernet.h>
+#include <netinet/in.h>
+#include <netinet/ip.h>
+#include <netinet/ip_icmp.h>
+#include <unistd.h>
+
+#include <boost/bind/bind.hpp>
+
+#include "common/InternetChecksum.h"
+#include "common/MuxException.h"
+#include "common/MuxLogger.h"
+#include "LinkProberBase.h"
+#include "LinkProberTxBatcher.h"
+
+namespace link_prober
+{
+//
+// ---> getRealTime();
+//
+// current CLOCK_REALTIME in nanoseconds, the clock kernel RX timestamps are taken from
+//
+static uint64_t getRealTime()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    return now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+//
+// ---> getInstance();
+//
+// constructs LinkProberTxBatcher singleton instance
+//
+LinkProberTxBatcherPtr LinkProberTxBatcher::getInstance()
+{
+    static std::shared_ptr<LinkProberTxBatcher> LinkProberTxBatcherPtr = nullptr;
+
+    if (LinkProberTxBatcherPtr == nullptr) {
+        LinkProberTxBatcherPtr = std::shared_ptr<LinkProberTxBatcher> (new LinkProberTxBatcher);
+    }
+
+    return LinkProberTxBatcherPtr;
+}
+
+//
+// ---> initialize(boost::asio::io_service &ioService);
+//
+// open packet socket used to send batched heartbeats
+//
+void LinkProberTxBatcher::initialize(boost::asio::io_service &ioService)
+{
+    // socket with no protocol is never handed received packets, it is used for TX only
+    int sock = socket(AF_PACKET, SOCK_RAW | SOCK_NONBLOCK, 0);
+    if (sock < 0) {
+        std::ostringstream errMsg;
+        errMsg << "Failed to open TX batch socket with '" << strerror(errno) << "'" << std::endl;
+        throw MUX_ERROR(SocketError, errMsg.str());
+    }
+
+    setup(ioService, sock);
+
+    MUXLOGWARNING(boost::format("Link Prober TX batching initialized, up to %d frames every %d usec") %
+        MUX_TX_BATCH_MAX_FRAMES %
+        MUX_TX_BATCH_TICK_USEC
+    );
+}
+
+//
+// ---> deinitialize();
+//
+// close packet socket, pending frames are dropped
+//
+void LinkProberTxBatcher::deinitialize()
+{
+    if (mEnabled) {
+        mEnabled = false;
+
+        boost::system::error_code errorCode;
+        mFlushTimerPtr->cancel(errorCode);
+
+        {
+            std::lock_guard<std::mutex> lock(mPendingMutex);
+            mPendingCount = 0;
+            mFlushScheduled = false;
+        }
+
+        close(mSocket);
+        mSocket = -1;
+    }
+}
+
+//
+// ---> setup(boost::asio::io_service &ioService, int socket);
+//
+// set up strand, tick timer and batch buffers around an open socket
+//
+void LinkProberTxBatcher::setup(boost::asio::io_service &ioService, int socket)
+{
+    mStrandPtr = std::make_shared<boost::asio::io_service::strand> (ioService);
+    mFlushTimerPtr = std::make_shared<boost::asio::deadline_timer> (ioService);
+
+    mPendingFrames.resize(MUX_TX_BATCH_MAX_FRAMES);
+    mFlushFrames.resize(MUX_TX_BATCH_MAX_FRAMES);
+    mMsgHdrs.resize(MUX_TX_BATCH_MAX_FRAMES);
+    mIoVecs.resize(MUX_TX_BATCH_MAX_FRAMES);
+    mAddrs.resize(MUX_TX_BATCH_MAX_FRAMES);
+
+    mPendingCount = 0;
+    mFlushScheduled = false;
+
+    mSocket = socket;
+    mEnabled = true;
+}
+
+//
+// ---> enqueue(int ifIndex, const uint8_t *frame, size_t size, LinkProberBase *linkProberPtr);
+//
+// queue a frame to be sent on the next tick
+//
+bool LinkProberTxBatcher::enqueue(int ifIndex, const uint8_t *frame, size_t size, LinkProberBase *linkProberPtr)
+{
+    if (!mEnabled || size > MUX_TX_BATCH_FRAME_SIZE) {
+        return false;
+    }
+
+    bool startTimer = false;
+    {
+        std::lock_guard<std::mutex> lock(mPendingMutex);
+        if (mPendingCount >= mPendingFrames.size()) {
+            return false;
+        }
+
+        TxFrame &txFrame = mPendingFrames[mPendingCount++];
+        txFrame.ifIndex = ifIndex;
+        txFrame.linkProberPtr = linkProberPtr;
+        txFrame.size = size;
+        memcpy(txFrame.data.data(), frame, size);
+
+        if (!mFlushScheduled) {
+            mFlushScheduled = true;
+            startTimer = true;
+        }
+    }
+
+    if (startTimer) {
+        boost::asio::post(*mStrandPtr, boost::bind(&LinkProberTxBatcher::startFlushTimer, this));
+    }
+
+    return true;
+}
+
+//
+// ---> startFlushTimer();
+//
+// start tick timer that flushes queued frames
+//
+void LinkProberTxBatcher::startFlushTimer()
+{
+    mFlushTimerPtr->expires_from_now(boost::posix_time::microseconds(MUX_TX_BATCH_TICK_USEC));
+    mFlushTimerPtr->async_wait(mStrandPtr->wrap(boost::bind(
+        &LinkProberTxBatcher::handleFlushTimeout,
+        this,
+        boost::asio::placeholders::error
+    )));
+}
+
+//
+// ---> handleFlushTimeout(const boost::system::error_code &errorCode);
+//
+// handle tick timer expiry
+//
+void LinkProberTxBatcher::handleFlushTimeout(const boost::system::error_code &errorCode)
+{
+    if (errorCode != boost::asio::error::operation_aborted && mEnabled) {
+        flush();
+    }
+}
+
+//
+// ---> stampTxTimestamp(TxFrame &txFrame, uint64_t txTimestamp);
+//
+// stamp TX time into heartbeat payload seq field, ICMP checksum is updated incrementally
+//
+void LinkProberTxBatcher::stampTxTimestamp(TxFrame &txFrame, uint64_t txTimestamp)
+{
+    size_t icmpOffset = sizeof(ether_header) + sizeof(iphdr);
+    size_t seqOffset = icmpOffset + sizeof(icmphdr) + offsetof(IcmpPayload, seq);
+    if (txFrame.size < seqOffset + sizeof(txTimestamp)) {
+        return;
+    }
+
+    uint8_t *seqPtr = txFrame.data.data() + seqOffset;
+    uint32_t oldSum = common::InternetChecksum::sum(seqPtr, sizeof(txTimestamp));
+    txTimestamp = htobe64(txTimestamp);
+    memcpy(seqPtr, &txTimestamp, sizeof(txTimestamp));
+    uint32_t newSum = common::InternetChecksum::sum(seqPtr, sizeof(txTimestamp));
+
+    // RFC 1624: HC' = ~(~HC + ~m + m')
+    icmphdr *icmpHeader = reinterpret_cast<icmphdr *> (txFrame.data.data() + icmpOffset);
+    uint32_t sum = (~ntohs(icmpHeader->checksum) & 0xffff) +
+                   (~common::InternetChecksum::fold(oldSum) & 0xffff) +
+                   common::InternetChecksum::fold(newSum);
+    icmpHeader->checksum = common::InternetChecksum::finalize(sum);
+}
+
+//
+// ---> flush();
+//
+// send all queued frames
+//
+void LinkProberTxBatcher::flush()
+{
+    size_t frameCount;
+    {
+        std::lock_guard<std::mutex> lock(mPendingMutex);
+        mPendingFrames.swap(mFlushFrames);
+        frameCount = mPendingCount;
+        mPendingCount = 0;
+        mFlushScheduled = false;
+    }
+
+    // frames wait up to a tick in the queue, RTT is measured from the time the batch goes out
+    uint64_t txTimestamp = getRealTime();
+    for (size_t i = 0; i < frameCount; i++) {
+        TxFrame &txFrame = mFlushFrames[i];
+        stampTxTimestamp(txFrame, txTimestamp);
+
+        SockAddrLinkLayer &addr = mAddrs[i];
+        memset(&addr, 0, sizeof(addr));
+        addr.sll_family = AF_PACKET;
+        addr.sll_protocol = htons(ETH_P_IP);
+        addr.sll_ifindex = txFrame.ifIndex;
+        addr.sll_halen = ETHER_ADDR_LEN;
+        memcpy(addr.sll_addr, txFrame.data.data(), ETHER_ADDR_LEN);
+
+        mIoVecs[i].iov_base = txFrame.data.data();
+        mIoVecs[i].iov_len = txFrame.size;
+
+        memset(&mMsgHdrs[i], 0, sizeof(mMsgHdrs[i]));
+        mMsgHdrs[i].msg_hdr.msg_name = &addr;
+        mMsgHdrs[i].msg_hdr.msg_namelen = sizeof(addr);
+        mMsgHdrs[i].msg_hdr.msg_iov = &mIoVecs[i];
+        mMsgHdrs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    // sendmmsg stops at the first failing message, report it to its owner and carry on with the rest
+    size_t sent = 0;
+    while (sent < frameCount) {
+        mSyscallCount++;
+        int rc = sendmmsg(mSocket, &mMsgHdrs[sent], frameCount - sent, MSG_DONTWAIT);
+        if (rc > 0) {
+            sent += rc;
+            mFrameCount += rc;
+        } else {
+            boost::system::error_code errorCode(errno, boost::system::system_category());
+            mErrorCount++;
+            mFlushFrames[sent].linkProberPtr->handleTxBatchError(errorCode);
+            sent++;
+        }
+    }
+}
+
+} /* namespace link_prober */
@@ -0,0 +1,257 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LinkProberTxBatcher.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef LINK_PROBER_LINKPROBERTXBATCHER_H_
+#define LINK_PROBER_LINKPROBERTXBATCHER_H_
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <linux/if_packet.h>
+#include <sys/socket.h>
+
+#include <common/BoostAsioBehavior.h>
+#include <boost/asio.hpp>
+
+#define MUX_TX_BATCH_FRAME_SIZE     256
+#define MUX_TX_BATCH_MAX_FRAMES     256
+#define MUX_TX_BATCH_TICK_USEC      1000
+
+namespace test {
+class LinkProberTest;
+}
+
+namespace link_prober
+{
+class LinkProberBase;
+class LinkProberTxBatcher;
+
+using LinkProberTxBatcherPtr = std::shared_ptr<LinkProberTxBatcher>;
+
+/**
+ *@class LinkProberTxBatcher
+ *
+ *@brief collects heartbeat frames of all mux ports and sends them with a
+ *       single sendmmsg() call per tick through one packet socket. The TX
+ *       timestamp of each heartbeat is stamped when the batch is sent. Frames
+ *       that fail to send are reported back to the link prober that queued
+ *       them.
+ */
+class LinkProberTxBatcher
+{
+public:
+    /**
+    *@method LinkProberTxBatcher
+    *
+    *@brief class copy constructor
+    *
+    *@param LinkProberTxBatcher (in)  reference to LinkProberTxBatcher object to be copied
+    */
+    LinkProberTxBatcher(const LinkProberTxBatcher &) = delete;
+
+    /**
+    *@method ~LinkProberTxBatcher
+    *
+    *@brief class destructor
+    */
+    virtual ~LinkProberTxBatcher() = default;
+
+    /**
+    *@method getInstance
+    *
+    *@brief constructs LinkProberTxBatcher singleton instance
+    *
+    *@return shared pointer to LinkProberTxBatcher singleton instance
+    */
+    static LinkProberTxBatcherPtr getInstance();
+
+    /**
+    *@method initialize
+    *
+    *@brief open packet socket used to send batched heartbeats
+    *
+    *@param ioService (in)  reference to boost io_service object
+    *
+    *@return none
+    */
+    void initialize(boost::asio::io_service &ioService);
+
+    /**
+    *@method deinitialize
+    *
+    *@brief close packet socket, pending frames are dropped
+    *
+    *@return none
+    */
+    void deinitialize();
+
+    /**
+    *@method isEnabled
+    *
+    *@brief check if link probers should queue heartbeats to the batcher
+    *
+    *@return true if TX batching is in use
+    */
+    inline bool isEnabled() const {return mEnabled;};
+
+    /**
+    *@method enqueue
+    *
+    *@brief queue a heartbeat frame to be sent on the next tick, its TX timestamp is stamped at send time
+    *
+    *@param ifIndex (in)            interface index of mux port
+    *@param frame (in)              pointer to Ethernet frame
+    *@param size (in)               size of Ethernet frame
+    *@param linkProberPtr (in)      link prober to report send errors to
+    *
+    *@return true if frame is queued, false if caller has to send it
+    */
+    bool enqueue(int ifIndex, const uint8_t *frame, size_t size, LinkProberBase *linkProberPtr);
+
+    /**
+    *@method getFrameCount
+    *
+    *@brief getter for number of frames sent
+    *
+    *@return frame count
+    */
+    inline uint64_t getFrameCount() const {return mFrameCount;};
+
+    /**
+    *@method getSyscallCount
+    *
+    *@brief getter for number of sendmmsg() calls
+    *
+    *@return syscall count
+    */
+    inline uint64_t getSyscallCount() const {return mSyscallCount;};
+
+    /**
+    *@method getErrorCount
+    *
+    *@brief getter for number of frames that failed to send
+    *
+    *@return error count
+    */
+    inline uint64_t getErrorCount() const {return mErrorCount;};
+
+private:
+    friend class test::LinkProberTest;
+
+    /**
+    *@struct TxFrame
+    *
+    *@brief heartbeat frame queued for transmission
+    */
+    struct TxFrame {
+        int ifIndex;
+        LinkProberBase *linkProberPtr;
+        size_t size;
+        std::array<uint8_t, MUX_TX_BATCH_FRAME_SIZE> data;
+    };
+
+    /**
+    *@method LinkProberTxBatcher
+    *
+    *@brief class default constructor
+    */
+    LinkProberTxBatcher() = default;
+
+    /**
+    *@method setup
+    *
+    *@brief set up strand, tick timer and batch buffers around an open socket
+    *
+    *@param ioService (in)  reference to boost io_service object
+    *@param socket (in)     socket used to send frames
+    *
+    *@return none
+    */
+    void setup(boost::asio::io_service &ioService, int socket);
+
+    /**
+    *@method startFlushTimer
+    *
+    *@brief start tick timer that flushes queued frames
+    *
+    *@return none
+    */
+    void startFlushTimer();
+
+    /**
+    *@method handleFlushTimeout
+    *
+    *@brief handle tick timer expiry
+    *
+    *@param errorCode (in)  timer error code
+    *
+    *@return none
+    */
+    void handleFlushTimeout(const boost::system::error_code &errorCode);
+
+    /**
+    *@method stampTxTimestamp
+    *
+    *@brief stamp TX time into heartbeat payload seq field, ICMP checksum is updated incrementally
+    *
+    *@param txFrame (in)        queued heartbeat frame
+    *@param txTimestamp (in)    TX time in nanoseconds
+    *
+    *@return none
+    */
+    void stampTxTimestamp(TxFrame &txFrame, uint64_t txTimestamp);
+
+    /**
+    *@method flush
+    *
+    *@brief send all queued frames
+    *
+    *@return none
+    */
+    void flush();
+
+    std::shared_ptr<boost::asio::io_service::strand> mStrandPtr;
+    std::shared_ptr<boost::asio::deadline_timer> mFlushTimerPtr;
+
+    int mSocket = -1;
+    bool mEnabled = false;
+
+    std::mutex mPendingMutex;
+    std::vector<TxFrame> mPendingFrames;
+    size_t mPendingCount = 0;
+    bool mFlushScheduled = false;
+
+    std::vector<TxFrame> mFlushFrames;
+    std::vector<struct mmsghdr> mMsgHdrs;
+    std::vector<struct iovec> mIoVecs;
+    std::vector<struct sockaddr_ll> mAddrs;
+
+    uint64_t mFrameCount = 0;
+    uint64_t mSyscallCount = 0;
+    uint64_t mErrorCount = 0;
+};
+
+} /* namespace link_prober */
+
+#endif /* LINK_PROBER_LINKPROBERTXBATCHER_H_ */
@@ -0,0 +1,99 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * TlvCodec.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <string.h>
+
+#include "TlvCodec.h"
+
+namespace link_prober
+{
+
+//
+// ---> append(uint8_t type, uint16_t length);
+//
+// append TLV head and reserve room for its value
+//
+uint8_t* TlvWriter::append(uint8_t type, uint16_t length)
+{
+    size_t tlvSize = sizeof(TlvHead) + length;
+    if (mOffset > mCapacity || mCapacity - mOffset < tlvSize) {
+        return nullptr;
+    }
+
+    TlvHead *tlvHead = reinterpret_cast<TlvHead *> (mBuffer + mOffset);
+    tlvHead->type = type;
+    tlvHead->length = htons(length);
+    mOffset += tlvSize;
+
+    return reinterpret_cast<uint8_t *> (tlvHead) + sizeof(TlvHead);
+}
+
+//
+// ---> appendCommand(Command command);
+//
+// append command TLV
+//
+size_t TlvWriter::appendCommand(Command command)
+{
+    uint8_t *value = append(TlvType::TLV_COMMAND, sizeof(Command));
+    if (value == nullptr) {
+        return 0;
+    }
+    *value = static_cast<uint8_t> (command);
+
+    return sizeof(TlvHead) + sizeof(Command);
+}
+
+//
+// ---> appendSentinel();
+//
+// append sentinel TLV ending the TLV chain
+//
+size_t TlvWriter::appendSentinel()
+{
+    return append(TlvType::TLV_SENTINEL, 0) == nullptr ? 0 : sizeof(TlvHead);
+}
+
+//
+// ---> appendDummy(size_t paddingSize, uint32_t seqNo);
+//
+// append dummy TLV of zero padding followed by sequence number
+//
+size_t TlvWriter::appendDummy(size_t paddingSize, uint32_t seqNo)
+{
+    if (paddingSize > UINT16_MAX - sizeof(uint32_t)) {
+        return 0;
+    }
+
+    uint16_t length = paddingSize + sizeof(uint32_t);
+    uint8_t *value = append(TlvType::TLV_DUMMY, length);
+    if (value == nullptr) {
+        return 0;
+    }
+    memset(value, 0, paddingSize);
+    seqNo = htonl(seqNo);
+    memcpy(value + paddingSize, &seqNo, sizeof(seqNo));
+
+    return sizeof(TlvHead) + length;
+}
+
+} /* namespace link_prober */
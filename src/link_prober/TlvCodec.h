@@ -0,0 +1,394 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * TlvCodec.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef LINK_PROBER_TLVCODEC_H_
+#define LINK_PROBER_TLVCODEC_H_
+
+#include <array>
+#include <iterator>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <arpa/inet.h>
+
+#include "IcmpPayload.h"
+
+namespace link_prober
+{
+
+/**
+ *@class TlvView
+ *
+ *@brief non-owning view of a TLV inside a received frame, only constructed by
+ *       TlvReader once head and value are known to fit in the frame
+ */
+class TlvView
+{
+public:
+    /**
+    *@method TlvView
+    *
+    *@brief class default constructor, view of no TLV
+    */
+    TlvView() = default;
+
+    /**
+    *@method TlvView
+    *
+    *@brief class constructor
+    *
+    *@param tlvPtr (in)     pointer to TLV head
+    *@param offset (in)     offset of TLV head in frame
+    */
+    TlvView(const uint8_t *tlvPtr, size_t offset) : mTlvPtr(tlvPtr), mOffset(offset) {};
+
+    /**
+    *@method type
+    *
+    *@brief getter for TLV type
+    *
+    *@return TLV type
+    */
+    inline uint8_t type() const {return mTlvPtr[offsetof(TlvHead, type)];};
+
+    /**
+    *@method length
+    *
+    *@brief getter for TLV value length
+    *
+    *@return value length in bytes
+    */
+    inline uint16_t length() const {
+        return (mTlvPtr[offsetof(TlvHead, length)] << 8) | mTlvPtr[offsetof(TlvHead, length) + 1];
+    };
+
+    /**
+    *@method value
+    *
+    *@brief getter for TLV value
+    *
+    *@return pointer to first value byte
+    */
+    inline const uint8_t* value() const {return mTlvPtr + sizeof(TlvHead);};
+
+    /**
+    *@method size
+    *
+    *@brief getter for TLV size including head
+    *
+    *@return TLV size in bytes
+    */
+    inline size_t size() const {return sizeof(TlvHead) + length();};
+
+    /**
+    *@method offset
+    *
+    *@brief getter for offset of TLV in frame
+    *
+    *@return offset in bytes
+    */
+    inline size_t offset() const {return mOffset;};
+
+    /**
+    *@method data
+    *
+    *@brief getter for TLV head
+    *
+    *@return pointer to TLV head
+    */
+    inline const uint8_t* data() const {return mTlvPtr;};
+
+private:
+    const uint8_t *mTlvPtr = nullptr;
+    size_t mOffset = 0;
+};
+
+/**
+ *@class TlvReader
+ *
+ *@brief zero-copy, bounds-checked iteration over the TLV chain of a received frame.
+ *       Iteration ends at the first TLV whose head or value does not fit in the frame.
+ */
+class TlvReader
+{
+public:
+    /**
+    *@class const_iterator
+    *
+    *@brief forward iterator over TLVs that fit in frame
+    */
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TlvView;
+        using difference_type = ptrdiff_t;
+        using pointer = const TlvView*;
+        using reference = const TlvView&;
+
+        const_iterator() = default;
+        const_iterator(const uint8_t *frame, size_t size, size_t offset) :
+            mFrame(frame),
+            mSize(size) {
+            load(offset);
+        };
+
+        inline reference operator*() const {return mTlv;};
+        inline pointer operator->() const {return &mTlv;};
+        inline const_iterator& operator++() {load(mTlv.offset() + mTlv.size()); return *this;};
+        inline const_iterator operator++(int) {const_iterator iter = *this; ++(*this); return iter;};
+        inline bool operator==(const const_iterator &iter) const {return mTlv.data() == iter.mTlv.data();};
+        inline bool operator!=(const const_iterator &iter) const {return !(*this == iter);};
+
+    private:
+        inline void load(size_t offset) {
+            size_t tlvSize = TlvReader::getTlvSize(mFrame, mSize, offset);
+            mTlv = tlvSize ? TlvView(mFrame + offset, offset) : TlvView();
+        };
+
+        const uint8_t *mFrame = nullptr;
+        size_t mSize = 0;
+        TlvView mTlv;
+    };
+
+    /**
+    *@method TlvReader
+    *
+    *@brief class constructor
+    *
+    *@param frame (in)      pointer to received frame
+    *@param size (in)       frame size
+    *@param offset (in)     offset of first TLV in frame
+    */
+    TlvReader(const uint8_t *frame, size_t size, size_t offset) :
+        mFrame(frame),
+        mSize(size),
+        mOffset(offset) {};
+
+    /**
+    *@method begin
+    *
+    *@brief iterator to first TLV
+    *
+    *@return TLV iterator
+    */
+    inline const_iterator begin() const {return const_iterator(mFrame, mSize, mOffset);};
+
+    /**
+    *@method end
+    *
+    *@brief iterator past last TLV that fits in frame
+    *
+    *@return TLV iterator
+    */
+    inline const_iterator end() const {return const_iterator();};
+
+    /**
+    *@method getTlvSize
+    *
+    *@brief size of TLV at offset of frame
+    *
+    *@param frame (in)      pointer to received frame
+    *@param size (in)       frame size
+    *@param offset (in)     offset of TLV in frame
+    *
+    *@return TLV size including head, 0 if TLV does not fit in frame
+    */
+    static inline size_t getTlvSize(const uint8_t *frame, size_t size, size_t offset) {
+        if (offset > size || size - offset < sizeof(TlvHead)) {
+            return 0;
+        }
+        size_t tlvSize = TlvView(frame + offset, offset).size();
+
+        return tlvSize <= size - offset ? tlvSize : 0;
+    };
+
+private:
+    const uint8_t *mFrame;
+    size_t mSize;
+    size_t mOffset;
+};
+
+/**
+ *@enum TlvAction
+ *
+ *@brief returned by TLV handlers to continue or stop walking the TLV chain
+ */
+enum class TlvAction: uint8_t {
+    Continue,
+    Stop
+};
+
+template <typename Context>
+using TlvHandler = TlvAction (*) (Context &context, const TlvView &tlv);
+
+/**
+ *@struct TlvHandlerEntry
+ *
+ *@brief TLV type and its handler, used to build a dispatch table
+ */
+template <typename Context>
+struct TlvHandlerEntry {
+    uint8_t type;
+    TlvHandler<Context> handler;
+};
+
+template <typename Context>
+using TlvDispatchTable = std::array<TlvHandler<Context>, UINT8_MAX + 1>;
+
+/**
+ *@method makeTlvDispatchTable
+ *
+ *@brief build table mapping every TLV type to its handler at compile time
+ *
+ *@param entries (in)           handlers of known TLV types
+ *@param defaultHandler (in)    handler of unknown TLV types
+ *
+ *@return dispatch table indexed by TLV type
+ */
+template <typename Context, size_t N>
+constexpr TlvDispatchTable<Context> makeTlvDispatchTable(
+    const TlvHandlerEntry<Context> (&entries)[N],
+    TlvHandler<Context> defaultHandler
+)
+{
+    TlvDispatchTable<Context> dispatchTable {};
+    for (size_t i = 0; i < dispatchTable.size(); i++) {
+        dispatchTable[i] = defaultHandler;
+    }
+    for (size_t i = 0; i < N; i++) {
+        dispatchTable[entries[i].type] = entries[i].handler;
+    }
+
+    return dispatchTable;
+}
+
+/**
+ *@method dispatchTlvs
+ *
+ *@brief hand every TLV of the chain to the handler of its type until a handler stops
+ *
+ *@param dispatchTable (in)     handlers indexed by TLV type
+ *@param context (in)           context passed to handlers
+ *@param tlvReader (in)         TLV chain to walk
+ *
+ *@return offset past the last TLV processed
+ */
+template <typename Context>
+size_t dispatchTlvs(const TlvDispatchTable<Context> &dispatchTable, Context &context, const TlvReader &tlvReader)
+{
+    size_t offset = 0;
+    for (const TlvView &tlv: tlvReader) {
+        offset = tlv.offset() + tlv.size();
+        if (dispatchTable[tlv.type()](context, tlv) == TlvAction::Stop) {
+            break;
+        }
+    }
+
+    return offset;
+}
+
+/**
+ *@class TlvWriter
+ *
+ *@brief appends TLVs to a caller provided buffer, nothing is written if a TLV
+ *       does not fit in the buffer
+ */
+class TlvWriter
+{
+public:
+    /**
+    *@method TlvWriter
+    *
+    *@brief class constructor
+    *
+    *@param buffer (in)     buffer TLVs are written to
+    *@param capacity (in)   buffer size
+    *@param offset (in)     offset in buffer of first TLV to append
+    */
+    TlvWriter(uint8_t *buffer, size_t capacity, size_t offset) :
+        mBuffer(buffer),
+        mCapacity(capacity),
+        mOffset(offset) {};
+
+    /**
+    *@method append
+    *
+    *@brief append TLV head and reserve room for its value
+    *
+    *@param type (in)       TLV type
+    *@param length (in)     value length
+    *
+    *@return pointer to value to be filled by caller, nullptr if TLV does not fit
+    */
+    uint8_t* append(uint8_t type, uint16_t length);
+
+    /**
+    *@method appendCommand
+    *
+    *@brief append command TLV
+    *
+    *@param command (in)    command to send to peer
+    *
+    *@return TLV size, 0 if TLV does not fit
+    */
+    size_t appendCommand(Command command);
+
+    /**
+    *@method appendSentinel
+    *
+    *@brief append sentinel TLV ending the TLV chain
+    *
+    *@return TLV size, 0 if TLV does not fit
+    */
+    size_t appendSentinel();
+
+    /**
+    *@method appendDummy
+    *
+    *@brief append dummy TLV of zero padding followed by sequence number, test purpose only
+    *
+    *@param paddingSize (in)    bytes of zero padding
+    *@param seqNo (in)          sequence number
+    *
+    *@return TLV size, 0 if TLV does not fit
+    */
+    size_t appendDummy(size_t paddingSize, uint32_t seqNo);
+
+    /**
+    *@method getOffset
+    *
+    *@brief getter for offset past last TLV appended
+    *
+    *@return offset in bytes
+    */
+    inline size_t getOffset() const {return mOffset;};
+
+private:
+    uint8_t *mBuffer;
+    size_t mCapacity;
+    size_t mOffset;
+};
+
+} /* namespace link_prober */
+
+#endif /* LINK_PROBER_TLVCODEC_H_ */
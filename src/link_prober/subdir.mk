@@ -4,9 +4,18 @@ CPP_SRCS += \
     ./src/link_prober/PeerActiveState.cpp \
     ./src/link_prober/PeerUnknownState.cpp \
     ./src/link_prober/PeerWaitState.cpp \
+    ./src/link_prober/HeartbeatLossWindow.cpp \
     ./src/link_prober/IcmpPayload.cpp \
     ./src/link_prober/LinkProberBase.cpp \
+    ./src/link_prober/LinkProberBudget.cpp \
+    ./src/link_prober/LinkProberBufferPool.cpp \
+    ./src/link_prober/LinkProberBusyPoll.cpp \
+    ./src/link_prober/LinkProberFilter.cpp \
     ./src/link_prober/LinkProberHw.cpp \
+    ./src/link_prober/LinkProberRxFanout.cpp \
+    ./src/link_prober/LinkProberRxRing.cpp \
+    ./src/link_prober/LinkProberTxBatcher.cpp \
+    ./src/link_prober/TlvCodec.cpp \
     ./src/link_prober/LinkProberSw.cpp \
     ./src/link_prober/LinkProberState.cpp \
     ./src/link_prober/LinkProberStateMachineBase.cpp \
@@ -21,9 +30,18 @@ OBJS += \
     ./src/link_prober/PeerActiveState.o \
     ./src/link_prober/PeerUnknownState.o \
     ./src/link_prober/PeerWaitState.o \
+    ./src/link_prober/HeartbeatLossWindow.o \
     ./src/link_prober/IcmpPayload.o \
     ./src/link_prober/LinkProberBase.o \
+    ./src/link_prober/LinkProberBudget.o \
+    ./src/link_prober/LinkProberBufferPool.o \
+    ./src/link_prober/LinkProberBusyPoll.o \
+    ./src/link_prober/LinkProberFilter.o \
     ./src/link_prober/LinkProberHw.o \
+    ./src/link_prober/LinkProberRxFanout.o \
+    ./src/link_prober/LinkProberRxRing.o \
+    ./src/link_prober/LinkProberTxBatcher.o \
+    ./src/link_prober/TlvCodec.o \
     ./src/link_prober/LinkProberSw.o \
     ./src/link_prober/LinkProberState.o \
     ./src/link_prober/LinkProberStateMachineBase.o \
@@ -38,8 +56,17 @@ CPP_DEPS += \
     ./src/link_prober/PeerActiveState.d \
     ./src/link_prober/PeerUnknownState.d \
     ./src/link_prober/PeerWaitState.d \
+    ./src/link_prober/HeartbeatLossWindow.d \
     ./src/link_prober/IcmpPayload.d \
     ./src/link_prober/LinkProber.d \
+    ./src/link_prober/LinkProberBudget.d \
+    ./src/link_prober/LinkProberBufferPool.d \
+    ./src/link_prober/LinkProberBusyPoll.d \
+    ./src/link_prober/LinkProberFilter.d \
+    ./src/link_prober/LinkProberRxFanout.d \
+    ./src/link_prober/LinkProberRxRing.d \
+    ./src/link_prober/LinkProberTxBatcher.d \
+    ./src/link_prober/TlvCodec.d \
     ./src/link_prober/LinkProberState.d \
     ./src/link_prober/LinkProberStateMachineBase.d \
     ./src/link_prober/LinkProberStateMachineActiveStandby.d \
@@ -1,13 +1,19 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+    ./src/DbCommandQueue.cpp \
     ./src/DbInterface.cpp \
+    ./src/DbShadowCache.cpp \
     ./src/LinkMgrdMain.cpp \
+    ./src/MetricsSlotTable.cpp \
     ./src/MuxManager.cpp \
     ./src/MuxPort.cpp \
     ./src/NetMsgInterface.cpp
 
 OBJS += \
+    ./src/DbCommandQueue.o \
     ./src/DbInterface.o \
+    ./src/DbShadowCache.o \
+    ./src/MetricsSlotTable.o \
     ./src/MuxManager.o \
     ./src/MuxPort.o \
     ./src/NetMsgInterface.o
@@ -16,8 +22,11 @@ OBJS_LINKMGRD += \
     ./src/LinkMgrdMain.o \
 
 CPP_DEPS += \
+    ./src/DbCommandQueue.d \
     ./src/DbInterface.d \
+    ./src/DbShadowCache.d \
     ./src/LinkMgrdMain.d \
+    ./src/MetricsSlotTable.d \
     ./src/MuxManager.d \
     ./src/MuxPort.d \
     ./src/NetMsgInterface.d
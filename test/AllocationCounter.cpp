@@ -0,0 +1,88 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * AllocationCounter.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <new>
+#include <stdlib.h>
+
+#include "AllocationCounter.h"
+
+namespace
+{
+thread_local uint32_t allocationCounterDepth = 0;
+thread_local uint64_t allocationCount = 0;
+thread_local uint64_t allocationBytes = 0;
+}
+
+//
+// replaceable global allocation functions, count allocations while a counter is in scope
+//
+void* operator new(size_t size)
+{
+    if (allocationCounterDepth) {
+        allocationCount++;
+        allocationBytes += size;
+    }
+
+    void *ptr = malloc(size ? size : 1);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t size) noexcept
+{
+    free(ptr);
+}
+
+namespace test
+{
+
+AllocationCounter::AllocationCounter() :
+    mStartCount(allocationCount),
+    mStartBytes(allocationBytes)
+{
+    allocationCounterDepth++;
+}
+
+AllocationCounter::~AllocationCounter()
+{
+    allocationCounterDepth--;
+}
+
+uint64_t AllocationCounter::getCount() const
+{
+    return allocationCount - mStartCount;
+}
+
+uint64_t AllocationCounter::getBytes() const
+{
+    return allocationBytes - mStartBytes;
+}
+
+} /* namespace test */
@@ -0,0 +1,52 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * AllocationCounter.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef ALLOCATIONCOUNTER_H_
+#define ALLOCATIONCOUNTER_H_
+
+#include <stdint.h>
+
+namespace test
+{
+
+/**
+ *@class AllocationCounter
+ *
+ *@brief counts heap allocations and bytes allocated by the calling thread while in scope
+ */
+class AllocationCounter
+{
+public:
+    AllocationCounter();
+    virtual ~AllocationCounter();
+
+    uint64_t getCount() const;
+    uint64_t getBytes() const;
+
+private:
+    uint64_t mStartCount;
+    uint64_t mStartBytes;
+};
+
+} /* namespace test */
+
+#endif /* ALLOCATIONCOUNTER_H_ */
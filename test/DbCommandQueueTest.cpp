@@ -0,0 +1,100 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * DbCommandQueueTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "DbCommandQueueTest.h"
+
+namespace test
+{
+
+DbCommandQueueTest::DbCommandQueueTest() :
+    mStrand(mIoService),
+    mDbCommandQueue(mStrand)
+{
+}
+
+TEST_F(DbCommandQueueTest, QueueDepth)
+{
+    std::vector<int> commands;
+    for (int i = 0; i < 5; i++) {
+        mDbCommandQueue.post(mux::DbCommand::SetMuxState, [&commands, i] () {commands.push_back(i);});
+    }
+    mDbCommandQueue.post(mux::DbCommand::GetMuxState, [&commands] () {commands.push_back(5);});
+
+    EXPECT_EQ(mDbCommandQueue.getQueueDepth(), 6);
+    EXPECT_EQ(mDbCommandQueue.getMaxQueueDepth(), 6);
+    EXPECT_TRUE(commands.empty());
+
+    mIoService.poll();
+    EXPECT_EQ(commands, std::vector<int> ({0, 1, 2, 3, 4, 5}));
+    EXPECT_EQ(mDbCommandQueue.getQueueDepth(), 0);
+    EXPECT_EQ(mDbCommandQueue.getMaxQueueDepth(), 6);
+    EXPECT_EQ(mDbCommandQueue.getQueueLatency().getCount(), 6);
+}
+
+TEST_F(DbCommandQueueTest, CommandLatency)
+{
+    // stand-in for a slow Redis reply
+    mDbCommandQueue.post(mux::DbCommand::SetMuxLinkmgrState, [] () {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    });
+    mDbCommandQueue.post(mux::DbCommand::SetMuxLinkmgrState, [] () {});
+    mIoService.poll();
+
+    mDbCommandQueue.run(mux::DbCommand::FlushStateDb, [] () {});
+
+    const common::LatencyHistogram &latency = mDbCommandQueue.getCommandLatency(mux::DbCommand::SetMuxLinkmgrState);
+    EXPECT_EQ(latency.getCount(), 2);
+    EXPECT_GE(latency.getMax(), 2000);
+    EXPECT_EQ(mDbCommandQueue.getCommandLatency(mux::DbCommand::FlushStateDb).getCount(), 1);
+    EXPECT_EQ(mDbCommandQueue.getCommandLatency(mux::DbCommand::GetMuxState).getCount(), 0);
+    EXPECT_EQ(mDbCommandQueue.getQueueLatency().getCount(), 2);
+}
+
+TEST_F(DbCommandQueueTest, DedicatedThread)
+{
+    // commands run on their own thread while the posting thread keeps going
+    std::thread::id commandThreadId;
+    boost::asio::io_service::work work(mIoService);
+    std::thread dbThread([this] () {mIoService.run();});
+
+    std::atomic<bool> done {false};
+    mDbCommandQueue.post(mux::DbCommand::GetMuxState, [&commandThreadId, &done] () {
+        commandThreadId = std::this_thread::get_id();
+        done = true;
+    });
+    while (!done) {
+        std::this_thread::yield();
+    }
+
+    mIoService.stop();
+    dbThread.join();
+
+    EXPECT_NE(commandThreadId, std::this_thread::get_id());
+    EXPECT_EQ(mDbCommandQueue.getQueueDepth(), 0);
+}
+
+} /* namespace test */
@@ -0,0 +1,47 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * DbCommandQueueTest.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef DBCOMMANDQUEUETEST_H_
+#define DBCOMMANDQUEUETEST_H_
+
+#include <boost/asio.hpp>
+
+#include "gtest/gtest.h"
+#include "DbCommandQueue.h"
+
+namespace test
+{
+
+class DbCommandQueueTest: public ::testing::Test
+{
+public:
+    DbCommandQueueTest();
+    virtual ~DbCommandQueueTest() = default;
+
+    boost::asio::io_service mIoService;
+    boost::asio::io_service::strand mStrand;
+    mux::DbCommandQueue mDbCommandQueue;
+};
+
+} /* namespace test */
+
+#endif /* DBCOMMANDQUEUETEST_H_ */
@@ -0,0 +1,113 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * DbShadowCacheTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "DbShadowCacheTest.h"
+
+namespace test
+{
+
+size_t DbShadowCacheTest::getEntryCount(const std::string &table)
+{
+    auto iter = mDbShadowCache.mTables.find(table);
+    return iter == mDbShadowCache.mTables.end() ? 0 : iter->second.entries.size();
+}
+
+TEST_F(DbShadowCacheTest, SuppressUnchangedWrite)
+{
+    EXPECT_TRUE(mDbShadowCache.write("APPL_DB|MUX_CABLE_TABLE", "Ethernet0", "state", "active"));
+    EXPECT_FALSE(mDbShadowCache.write("APPL_DB|MUX_CABLE_TABLE", "Ethernet0", "state", "active"));
+    EXPECT_TRUE(mDbShadowCache.write("APPL_DB|MUX_CABLE_TABLE", "Ethernet0", "state", "standby"));
+    EXPECT_TRUE(mDbShadowCache.write("APPL_DB|MUX_CABLE_TABLE", "Ethernet4", "state", "standby"));
+    EXPECT_TRUE(mDbShadowCache.write("APPL_DB|MUX_CABLE_TABLE", "Ethernet0", "command", "standby"));
+
+    EXPECT_EQ(mDbShadowCache.getWriteCount("APPL_DB|MUX_CABLE_TABLE"), 4);
+    EXPECT_EQ(mDbShadowCache.getSuppressedWriteCount("APPL_DB|MUX_CABLE_TABLE"), 1);
+    EXPECT_EQ(getEntryCount("APPL_DB|MUX_CABLE_TABLE"), 2);
+}
+
+TEST_F(DbShadowCacheTest, EmptyValueWrite)
+{
+    EXPECT_TRUE(mDbShadowCache.write("STATE_DB|MUX_LINKMGR_TABLE", "Ethernet0", "state", ""));
+    EXPECT_FALSE(mDbShadowCache.write("STATE_DB|MUX_LINKMGR_TABLE", "Ethernet0", "state", ""));
+}
+
+TEST_F(DbShadowCacheTest, SeedAndNotificationUpdate)
+{
+    mDbShadowCache.seed("CONFIG_DB|MUX_CABLE", "Ethernet0", "state", "auto");
+    EXPECT_TRUE(mDbShadowCache.isStored("CONFIG_DB|MUX_CABLE", "Ethernet0", "state", "auto"));
+    EXPECT_FALSE(mDbShadowCache.write("CONFIG_DB|MUX_CABLE", "Ethernet0", "state", "auto"));
+
+    // value changed by another writer
+    mDbShadowCache.seed("CONFIG_DB|MUX_CABLE", "Ethernet0", "state", "manual");
+    EXPECT_FALSE(mDbShadowCache.isStored("CONFIG_DB|MUX_CABLE", "Ethernet0", "state", "auto"));
+    EXPECT_TRUE(mDbShadowCache.write("CONFIG_DB|MUX_CABLE", "Ethernet0", "state", "auto"));
+
+    EXPECT_EQ(mDbShadowCache.getWriteCount("CONFIG_DB|MUX_CABLE"), 1);
+    EXPECT_EQ(mDbShadowCache.getSuppressedWriteCount("CONFIG_DB|MUX_CABLE"), 1);
+}
+
+TEST_F(DbShadowCacheTest, EraseEntry)
+{
+    EXPECT_TRUE(mDbShadowCache.write("APPL_DB|MUX_CABLE_TABLE", "Ethernet0", "state", "active"));
+    mDbShadowCache.erase("APPL_DB|MUX_CABLE_TABLE", "Ethernet0");
+    mDbShadowCache.erase("APPL_DB|UNKNOWN_TABLE", "Ethernet0");
+
+    EXPECT_FALSE(mDbShadowCache.isStored("APPL_DB|MUX_CABLE_TABLE", "Ethernet0", "state", "active"));
+    EXPECT_TRUE(mDbShadowCache.write("APPL_DB|MUX_CABLE_TABLE", "Ethernet0", "state", "active"));
+    EXPECT_EQ(mDbShadowCache.getSuppressedWriteCount("APPL_DB|MUX_CABLE_TABLE"), 0);
+}
+
+TEST_F(DbShadowCacheTest, NonSuppressibleWrite)
+{
+    EXPECT_TRUE(mDbShadowCache.write("APPL_DB|MUX_CABLE_TABLE", "Ethernet0", "state", "active", false));
+    EXPECT_TRUE(mDbShadowCache.write("APPL_DB|MUX_CABLE_TABLE", "Ethernet0", "state", "active", false));
+    EXPECT_FALSE(mDbShadowCache.write("APPL_DB|MUX_CABLE_TABLE", "Ethernet0", "state", "active"));
+
+    EXPECT_EQ(mDbShadowCache.getWriteCount("APPL_DB|MUX_CABLE_TABLE"), 2);
+    EXPECT_EQ(mDbShadowCache.getSuppressedWriteCount("APPL_DB|MUX_CABLE_TABLE"), 1);
+    EXPECT_EQ(mDbShadowCache.getWriteCount("STATE_DB|MUX_CABLE_TABLE"), 0);
+    EXPECT_EQ(mDbShadowCache.getSuppressedWriteCount("STATE_DB|MUX_CABLE_TABLE"), 0);
+}
+
+TEST_F(DbShadowCacheTest, ReadHitMiss)
+{
+    std::string state;
+    EXPECT_FALSE(mDbShadowCache.read("STATE_DB|MUX_CABLE_TABLE", "Ethernet0", "state", state));
+
+    mDbShadowCache.seed("STATE_DB|MUX_CABLE_TABLE", "Ethernet0", "state", "standby");
+    EXPECT_TRUE(mDbShadowCache.read("STATE_DB|MUX_CABLE_TABLE", "Ethernet0", "state", state));
+    EXPECT_EQ(state, "standby");
+
+    mDbShadowCache.seed("STATE_DB|MUX_CABLE_TABLE", "Ethernet0", "state", "active");
+    EXPECT_TRUE(mDbShadowCache.read("STATE_DB|MUX_CABLE_TABLE", "Ethernet0", "state", state));
+    EXPECT_EQ(state, "active");
+    EXPECT_FALSE(mDbShadowCache.read("STATE_DB|MUX_CABLE_TABLE", "Ethernet0", "health", state));
+
+    mDbShadowCache.erase("STATE_DB|MUX_CABLE_TABLE", "Ethernet0");
+    EXPECT_FALSE(mDbShadowCache.read("STATE_DB|MUX_CABLE_TABLE", "Ethernet0", "state", state));
+
+    EXPECT_EQ(mDbShadowCache.getReadHitCount("STATE_DB|MUX_CABLE_TABLE"), 2);
+    EXPECT_EQ(mDbShadowCache.getReadMissCount("STATE_DB|MUX_CABLE_TABLE"), 3);
+    EXPECT_EQ(mDbShadowCache.getReadHitCount("APPL_DB|MUX_CABLE_TABLE"), 0);
+}
+
+} /* namespace test */
@@ -0,0 +1,45 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * DbShadowCacheTest.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef DBSHADOWCACHETEST_H_
+#define DBSHADOWCACHETEST_H_
+
+#include "gtest/gtest.h"
+#include "DbShadowCache.h"
+
+namespace test
+{
+
+class DbShadowCacheTest: public ::testing::Test
+{
+public:
+    DbShadowCacheTest() = default;
+    virtual ~DbShadowCacheTest() = default;
+
+    size_t getEntryCount(const std::string &table);
+
+    mux::DbShadowCache mDbShadowCache;
+};
+
+} /* namespace test */
+
+#endif /* DBSHADOWCACHETEST_H_ */
@@ -38,9 +38,10 @@ FakeDbInterface::FakeDbInterface(mux::MuxManager *muxManager, boost::asio::io_se
 {
 }
 
-void FakeDbInterface::handleSetMuxState(const std::string portName, mux_state::MuxState::Label label)
+void FakeDbInterface::handleSetMuxState(const std::string portName, mux_state::MuxState::Label label, bool forceSwitch)
 {
     mLastSetMuxState = label;
+    mLastSetMuxForceSwitch = forceSwitch;
     mSetMuxStateInvokeCount++;
 
     mDbInterfaceRaceConditionCheckFailure = false;
@@ -106,13 +107,23 @@ void FakeDbInterface::postLinkProberMetricsEvent(
 void FakeDbInterface::postPckLossRatio(
         const std::string &portName,
         const uint64_t unknownEventCount, 
-        const uint64_t expectedPacketCount
+        const uint64_t expectedPacketCount,
+        const link_prober::HeartbeatLossWindowStats &selfLossStats,
+        const link_prober::HeartbeatLossWindowStats &peerLossStats
 )
 {
     mUnknownEventCount = unknownEventCount;
     mExpectedPacketCount = expectedPacketCount;
+    mSelfLossStats = selfLossStats;
+    mPeerLossStats = peerLossStats;
 } 
 
+void FakeDbInterface::postProbeInterval(const std::string &portName, const uint32_t probeInterval_msec)
+{
+    mProbeInterval_msec = probeInterval_msec;
+    mPostProbeIntervalInvokeCount++;
+}
+
 void FakeDbInterface::handleSetMuxMode(const std::string &portName, const std::string state)
 {
     mSetMuxModeInvokeCount += 1;
@@ -157,6 +168,7 @@ void FakeDbInterface::handleSwssNotification(){
 
 void FakeDbInterface::createIcmpEchoSession(std::string key, IcmpHwOffloadEntriesPtr entries) {
     mIcmpSessionsCount++;
+    mLastIcmpSessionEntries = *entries;
 }
 
 void FakeDbInterface::deleteIcmpEchoSession(std::string key) {
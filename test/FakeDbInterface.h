@@ -39,7 +39,7 @@ public:
     FakeDbInterface(mux::MuxManager *muxManager, boost::asio::io_service *ioService);
     virtual ~FakeDbInterface() = default;
 
-    virtual void handleSetMuxState(const std::string portName, mux_state::MuxState::Label label) override;
+    virtual void handleSetMuxState(const std::string portName, mux_state::MuxState::Label label, bool forceSwitch) override;
     virtual void handleSetPeerMuxState(const std::string portName, mux_state::MuxState::Label label) override;
     virtual void getMuxState(const std::string &portName) override;
     virtual std::map<std::string, std::string> getMuxModeConfig() override;
@@ -67,8 +67,11 @@ public:
     virtual void postPckLossRatio(
         const std::string &portName,
         const uint64_t unknownEventCount, 
-        const uint64_t expectedPacketCount
+        const uint64_t expectedPacketCount,
+        const link_prober::HeartbeatLossWindowStats &selfLossStats,
+        const link_prober::HeartbeatLossWindowStats &peerLossStats
     ) override;
+    virtual void postProbeInterval(const std::string &portName, const uint32_t probeInterval_msec) override;
     virtual bool isWarmStart() override;
     virtual uint32_t getWarmStartTimer() override;
     virtual void setWarmStartStateReconciled() override; 
@@ -89,6 +92,7 @@ public:
 
     mux_state::MuxState::Label mLastSetMuxState;
     mux_state::MuxState::Label mLastSetPeerMuxState;
+    bool mLastSetMuxForceSwitch = false;
     link_manager::LinkManagerStateMachineBase::Label mLastSetMuxLinkmgrState;
 
     uint32_t mSetMuxStateInvokeCount = 0;
@@ -103,11 +107,16 @@ public:
     uint32_t mPostLinkProberMetricsInvokeCount = 0;
     uint64_t mUnknownEventCount = 0;
     uint64_t mExpectedPacketCount = 0;
+    link_prober::HeartbeatLossWindowStats mSelfLossStats;
+    link_prober::HeartbeatLossWindowStats mPeerLossStats;
+    uint32_t mProbeInterval_msec = 0;
+    uint32_t mPostProbeIntervalInvokeCount = 0;
     uint32_t mSetMuxModeInvokeCount = 0;
     uint32_t mSetWarmStartStateReconciledInvokeCount = 0;
     uint32_t mPostSwitchCauseInvokeCount = 0;
     uint32_t mGetMuxModeConfigInvokeCount = 0;
     uint32_t mIcmpSessionsCount = 0;
+    mux::IcmpHwOffloadEntries mLastIcmpSessionEntries;
 
     link_manager::ActiveStandbyStateMachine::SwitchCause mLastPostedSwitchCause;
     
@@ -197,7 +197,9 @@ void FakeLinkProber::resetIcmpPacketCounts()
         &link_prober::LinkProberStateMachineBase::handlePckLossRatioUpdate,
         mLinkProberStateMachine,
         mIcmpUnknownEventCount,
-        mIcmpPacketCount
+        mIcmpPacketCount,
+        link_prober::HeartbeatLossWindowStats(),
+        link_prober::HeartbeatLossWindowStats()
     )));
 }
 
@@ -229,4 +231,11 @@ void FakeLinkProber::revertProbeIntervalAfterSwitchComplete()
     mRevertIntervalCallCount++;
 }
 
+void FakeLinkProber::resetProbeInterval()
+{
+    MUXLOGINFO("");
+
+    mResetProbeIntervalCallCount++;
+}
+
 } /* namespace test */
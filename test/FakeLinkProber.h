@@ -53,6 +53,7 @@ public:
     void restartTxProbes();
     void decreaseProbeIntervalAfterSwitch(uint32_t switchTime_msec);
     void revertProbeIntervalAfterSwitchComplete();
+    void resetProbeInterval();
     void handleSendSwitchCommand();
     void handleSwitchCommandRecv();
     void handleMuxProbeCommandRecv();
@@ -76,6 +77,7 @@ public:
 
     uint32_t mDecreaseIntervalCallCount = 0;
     uint32_t mRevertIntervalCallCount = 0;
+    uint32_t mResetProbeIntervalCallCount = 0;
     uint32_t mIcmpEchoSessionStateUpdateCallCount = 0;
 
 private:
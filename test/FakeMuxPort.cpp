@@ -117,6 +117,9 @@ inline void FakeMuxPort::initLinkProberActiveActive()
     getActiveActiveStateMachinePtr()->setSendPeerProbeCommandFnPtr(
         boost::bind(&FakeLinkProber::sendPeerProbeCommand, mFakeLinkProber.get())
     );
+    getActiveActiveStateMachinePtr()->setResetProbeIntervalFnPtr(
+        boost::bind(&FakeLinkProber::resetProbeInterval, mFakeLinkProber.get())
+    );
 }
 
 inline void FakeMuxPort::initLinkProberActiveStandby()
@@ -157,6 +160,9 @@ inline void FakeMuxPort::initLinkProberActiveStandby()
     getActiveStandbyStateMachinePtr()->setRevertIntervalFnPtr(
         boost::bind(&FakeLinkProber::revertProbeIntervalAfterSwitchComplete, mFakeLinkProber.get())
     );
+    getActiveStandbyStateMachinePtr()->setResetProbeIntervalFnPtr(
+        boost::bind(&FakeLinkProber::resetProbeInterval, mFakeLinkProber.get())
+    );
 }
 
 void FakeMuxPort::activateStateMachine()
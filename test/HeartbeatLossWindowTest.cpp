@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * HeartbeatLossWindowTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "HeartbeatLossWindowTest.h"
+
+namespace test
+{
+
+void HeartbeatLossWindowTest::recordOutcomes(size_t count, size_t lossPeriod, size_t burstLength)
+{
+    for (size_t i = 0; i < count; i++) {
+        mLossWindow.record(i % lossPeriod < burstLength);
+    }
+}
+
+TEST_F(HeartbeatLossWindowTest, EmptyWindow)
+{
+    link_prober::HeartbeatLossWindowStats stats = mLossWindow.getStats();
+
+    EXPECT_EQ(stats.sampleCount, 0);
+    EXPECT_EQ(stats.lossCount, 0);
+    EXPECT_EQ(stats.burstCount, 0);
+    EXPECT_EQ(stats.longestBurst, 0);
+}
+
+TEST_F(HeartbeatLossWindowTest, UniformLossVersusBurst)
+{
+    // 1% uniform loss, single heartbeats lost
+    recordOutcomes(300, 100, 1);
+    link_prober::HeartbeatLossWindowStats uniform = mLossWindow.getStats();
+
+    EXPECT_EQ(uniform.sampleCount, 300);
+    EXPECT_EQ(uniform.lossCount, 3);
+    EXPECT_EQ(uniform.burstCount, 3);
+    EXPECT_EQ(uniform.longestBurst, 1);
+
+    // same loss count as one burst of 3 consecutive heartbeats
+    mLossWindow.reset();
+    recordOutcomes(300, 300, 3);
+    link_prober::HeartbeatLossWindowStats burst = mLossWindow.getStats();
+
+    EXPECT_EQ(burst.sampleCount, 300);
+    EXPECT_EQ(burst.lossCount, 3);
+    EXPECT_EQ(burst.burstCount, 1);
+    EXPECT_EQ(burst.longestBurst, 3);
+}
+
+TEST_F(HeartbeatLossWindowTest, OldOutcomesLeaveWindow)
+{
+    recordOutcomes(10, 10, 10);
+    mLossWindow.record(false);
+    recordOutcomes(MUX_HEARTBEAT_LOSS_WINDOW_SIZE - 6, 50, 2);
+
+    link_prober::HeartbeatLossWindowStats stats = mLossWindow.getStats();
+    EXPECT_EQ(stats.sampleCount, MUX_HEARTBEAT_LOSS_WINDOW_SIZE);
+    EXPECT_EQ(stats.longestBurst, 10);
+
+    // last lost heartbeat of the 10 heartbeat burst leaves the window
+    recordOutcomes(5, MUX_HEARTBEAT_LOSS_WINDOW_SIZE, 0);
+    stats = mLossWindow.getStats();
+    EXPECT_EQ(stats.sampleCount, MUX_HEARTBEAT_LOSS_WINDOW_SIZE);
+    EXPECT_EQ(stats.longestBurst, 2);
+}
+
+TEST_F(HeartbeatLossWindowTest, ResetClearsWindow)
+{
+    recordOutcomes(2 * MUX_HEARTBEAT_LOSS_WINDOW_SIZE, 7, 3);
+    EXPECT_EQ(mLossWindow.getStats().sampleCount, MUX_HEARTBEAT_LOSS_WINDOW_SIZE);
+
+    mLossWindow.reset();
+    link_prober::HeartbeatLossWindowStats stats = mLossWindow.getStats();
+    EXPECT_EQ(stats.sampleCount, 0);
+    EXPECT_EQ(stats.lossCount, 0);
+    EXPECT_EQ(stats.burstCount, 0);
+    EXPECT_EQ(stats.longestBurst, 0);
+}
+
+} /* namespace test */
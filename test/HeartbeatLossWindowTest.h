@@ -0,0 +1,45 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * HeartbeatLossWindowTest.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef HEARTBEATLOSSWINDOWTEST_H_
+#define HEARTBEATLOSSWINDOWTEST_H_
+
+#include "link_prober/HeartbeatLossWindow.h"
+#include "gtest/gtest.h"
+
+namespace test
+{
+
+class HeartbeatLossWindowTest: public ::testing::Test
+{
+public:
+    HeartbeatLossWindowTest() = default;
+    virtual ~HeartbeatLossWindowTest() = default;
+
+    void recordOutcomes(size_t count, size_t lossPeriod, size_t burstLength);
+
+    link_prober::HeartbeatLossWindow mLossWindow;
+};
+
+} /* namespace test */
+
+#endif /* HEARTBEATLOSSWINDOWTEST_H_ */
@@ -0,0 +1,139 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * InternetChecksumTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <random>
+
+#include "InternetChecksumTest.h"
+#include "link_prober/IcmpPayload.h"
+
+namespace test
+{
+
+InternetChecksumTest::InternetChecksumTest() :
+    mBuffer(MUX_MAX_ICMP_BUFFER_SIZE + 64)
+{
+    for (size_t i = 0; i < static_cast<size_t> (common::InternetChecksum::Kernel::Count); i++) {
+        common::InternetChecksum::Kernel kernel = static_cast<common::InternetChecksum::Kernel> (i);
+        if (common::InternetChecksum::isSupported(kernel)) {
+            mKernels.push_back(kernel);
+        }
+    }
+
+    std::mt19937 generator(0x6d7578);
+    for (uint8_t &byte: mBuffer) {
+        byte = generator();
+    }
+}
+
+//
+// scalar loop LinkProberBase::calculateChecksum used before kernels were introduced
+//
+uint32_t InternetChecksumTest::legacyChecksum(const uint8_t *data, size_t size)
+{
+    uint32_t sum = 0;
+
+    while (size > 1) {
+        uint16_t word;
+        memcpy(&word, data, sizeof(word));
+        sum += ntohs(word);
+        data += sizeof(word);
+        size -= sizeof(word);
+    }
+
+    if (size) {
+        sum += ntohs(static_cast<uint16_t> (*data));
+    }
+
+    return sum;
+}
+
+void InternetChecksumTest::expectKernelsMatch(const uint8_t *data, size_t size)
+{
+    uint32_t expected = common::InternetChecksum::fold(legacyChecksum(data, size));
+    for (common::InternetChecksum::Kernel kernel: mKernels) {
+        uint32_t sum = common::InternetChecksum::sum(kernel, data, size);
+        EXPECT_EQ(sum, expected) << common::InternetChecksum::getKernelName(kernel) << " size: " << size;
+        EXPECT_EQ(common::InternetChecksum::finalize(sum), common::InternetChecksum::finalize(legacyChecksum(data, size)));
+    }
+    EXPECT_EQ(common::InternetChecksum::sum(data, size), expected);
+}
+
+TEST_F(InternetChecksumTest, AllWords)
+{
+    // every 16-bit word and every odd trailing byte
+    for (uint32_t value = 0; value <= UINT16_MAX; value++) {
+        uint8_t word[2] = {static_cast<uint8_t> (value >> 8), static_cast<uint8_t> (value)};
+        expectKernelsMatch(word, sizeof(word));
+        if (value <= UINT8_MAX) {
+            expectKernelsMatch(word + 1, 1);
+        }
+    }
+}
+
+TEST_F(InternetChecksumTest, AllSizes)
+{
+    // every frame size up to the largest ICMP buffer, alignment varies with size
+    for (size_t size = 0; size <= MUX_MAX_ICMP_BUFFER_SIZE; size++) {
+        expectKernelsMatch(mBuffer.data() + size % 64, size);
+    }
+}
+
+TEST_F(InternetChecksumTest, AllAlignments)
+{
+    for (size_t offset = 0; offset < 64; offset++) {
+        for (size_t size = 0; size <= 256; size++) {
+            expectKernelsMatch(mBuffer.data() + offset, size);
+        }
+    }
+}
+
+TEST_F(InternetChecksumTest, Carries)
+{
+    // all ones words carry out of every lane
+    std::fill(mBuffer.begin(), mBuffer.end(), 0xff);
+    for (size_t size = MUX_MAX_ICMP_BUFFER_SIZE - 64; size <= MUX_MAX_ICMP_BUFFER_SIZE; size++) {
+        expectKernelsMatch(mBuffer.data(), size);
+    }
+
+    // buffers large enough to overflow 32-bit lanes
+    std::vector<uint8_t> buffer(4 << 20, 0xff);
+    buffer.back() = 0x01;
+    uint64_t expected = 0;
+    for (size_t i = 0; i < buffer.size(); i += 2) {
+        expected += (buffer[i] << 8) | buffer[i + 1];
+    }
+    while (expected >> 16) {
+        expected = (expected >> 16) + (expected & 0xffff);
+    }
+    for (common::InternetChecksum::Kernel kernel: mKernels) {
+        EXPECT_EQ(common::InternetChecksum::sum(kernel, buffer.data(), buffer.size()), expected)
+            << common::InternetChecksum::getKernelName(kernel);
+    }
+}
+
+TEST_F(InternetChecksumTest, SelectedKernel)
+{
+    EXPECT_TRUE(common::InternetChecksum::isSupported(common::InternetChecksum::getKernel()));
+    EXPECT_EQ(common::InternetChecksum::getKernel(), mKernels.back());
+}
+
+} /* namespace test */
@@ -0,0 +1,51 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * InternetChecksumTest.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INTERNETCHECKSUMTEST_H_
+#define INTERNETCHECKSUMTEST_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "common/InternetChecksum.h"
+
+namespace test
+{
+
+class InternetChecksumTest: public ::testing::Test
+{
+public:
+    InternetChecksumTest();
+    virtual ~InternetChecksumTest() = default;
+
+    static uint32_t legacyChecksum(const uint8_t *data, size_t size);
+    void expectKernelsMatch(const uint8_t *data, size_t size);
+
+    std::vector<common::InternetChecksum::Kernel> mKernels;
+    std::vector<uint8_t> mBuffer;
+};
+
+} /* namespace test */
+
+#endif /* INTERNETCHECKSUMTEST_H_ */
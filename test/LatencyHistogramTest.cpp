@@ -0,0 +1,88 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LatencyHistogramTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "LatencyHistogramTest.h"
+
+namespace test
+{
+
+TEST_F(LatencyHistogramTest, EmptyHistogram)
+{
+    EXPECT_EQ(mHistogram.getCount(), 0);
+    EXPECT_EQ(mHistogram.getPercentile(50), 0);
+    EXPECT_EQ(mHistogram.getPercentile(99.9), 0);
+}
+
+TEST_F(LatencyHistogramTest, SmallValuesAreExact)
+{
+    for (uint64_t value = 0; value < 16; value++) {
+        mHistogram.record(value);
+    }
+
+    EXPECT_EQ(mHistogram.getCount(), 16);
+    EXPECT_EQ(mHistogram.getPercentile(50), 7);
+    EXPECT_EQ(mHistogram.getPercentile(100), 15);
+    EXPECT_EQ(mHistogram.getMax(), 15);
+}
+
+TEST_F(LatencyHistogramTest, PercentilesWithinBucketError)
+{
+    for (uint64_t value = 1; value <= 100000; value++) {
+        mHistogram.record(value);
+    }
+
+    // reported value is the bucket upper bound, at most 1/16 above the exact percentile
+    for (double percentile: {50.0, 99.0, 99.9}) {
+        uint64_t exact = static_cast<uint64_t> (percentile * 1000);
+        uint64_t reported = mHistogram.getPercentile(percentile);
+        EXPECT_GE(reported, exact);
+        EXPECT_LE(reported, exact + exact / 16);
+    }
+    EXPECT_EQ(mHistogram.getPercentile(100), 100000);
+}
+
+TEST_F(LatencyHistogramTest, TailSamples)
+{
+    for (int i = 0; i < 999; i++) {
+        mHistogram.record(100);
+    }
+    mHistogram.record(50000);
+
+    EXPECT_EQ(mHistogram.getPercentile(50), 103);
+    EXPECT_EQ(mHistogram.getPercentile(99), 103);
+    EXPECT_EQ(mHistogram.getPercentile(99.99), 50000);
+    EXPECT_EQ(mHistogram.getMax(), 50000);
+}
+
+TEST_F(LatencyHistogramTest, OutOfRangeAndReset)
+{
+    mHistogram.record(UINT64_MAX);
+    EXPECT_EQ(mHistogram.getCount(), 1);
+    EXPECT_EQ(mHistogram.getPercentile(50), UINT32_MAX);
+
+    mHistogram.reset();
+    EXPECT_EQ(mHistogram.getCount(), 0);
+    EXPECT_EQ(mHistogram.getMax(), 0);
+    EXPECT_EQ(mHistogram.getPercentile(50), 0);
+}
+
+} /* namespace test */
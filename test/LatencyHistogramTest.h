@@ -0,0 +1,43 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LatencyHistogramTest.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef LATENCYHISTOGRAMTEST_H_
+#define LATENCYHISTOGRAMTEST_H_
+
+#include "common/LatencyHistogram.h"
+#include "gtest/gtest.h"
+
+namespace test
+{
+
+class LatencyHistogramTest: public ::testing::Test
+{
+public:
+    LatencyHistogramTest() = default;
+    virtual ~LatencyHistogramTest() = default;
+
+    common::LatencyHistogram mHistogram;
+};
+
+} /* namespace test */
+
+#endif /* LATENCYHISTOGRAMTEST_H_ */
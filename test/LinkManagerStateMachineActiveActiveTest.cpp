@@ -237,7 +237,7 @@ void LinkManagerStateMachineActiveActiveTest::activateStateMachine(bool enable_f
 
 void LinkManagerStateMachineActiveActiveTest::postPckLossRatioUpdateEvent(uint64_t unknownCount, uint64_t totalCount)
 {
-    mFakeMuxPort.postPckLossRatio(unknownCount, totalCount);
+    mFakeMuxPort.postPckLossRatio(unknownCount, totalCount, link_prober::HeartbeatLossWindowStats(), link_prober::HeartbeatLossWindowStats());
     mFakeMuxPort.mFakeLinkProber->mIcmpUnknownEventCount = unknownCount;
     mFakeMuxPort.mFakeLinkProber->mIcmpPacketCount = totalCount;
 
@@ -476,6 +476,31 @@ TEST_F(LinkManagerStateMachineActiveActiveTest, ConfigStandbySocAgentRestart)
     VALIDATE_STATE(Active, Active, Up);
 }
 
+TEST_F(LinkManagerStateMachineActiveActiveTest, ConfigStandbyCorrectsMuxDrift)
+{
+    setMuxActive();
+
+    handleMuxConfig("standby", 1);
+    EXPECT_EQ(mDbInterfacePtr->mSetMuxStateInvokeCount, 2);
+    EXPECT_TRUE(mDbInterfacePtr->mLastSetMuxForceSwitch);
+    handleMuxState("standby", 3);
+    VALIDATE_STATE(Active, Standby, Up);
+
+    // periodic probe finds hardware drifted to active while STATE DB still reports standby,
+    // the correcting write is forced so it is not skipped as redundant
+    handleProbeMuxState("active", 3);
+    EXPECT_EQ(mDbInterfacePtr->mSetMuxStateInvokeCount, 3);
+    EXPECT_EQ(mDbInterfacePtr->mLastSetMuxState, mux_state::MuxState::Label::Standby);
+    EXPECT_TRUE(mDbInterfacePtr->mLastSetMuxForceSwitch);
+    VALIDATE_STATE(Active, Standby, Up);
+
+    // regular switch in auto mode is not forced
+    handleMuxConfig("auto", 1);
+    EXPECT_EQ(mDbInterfacePtr->mSetMuxStateInvokeCount, 4);
+    EXPECT_EQ(mDbInterfacePtr->mLastSetMuxState, mux_state::MuxState::Label::Active);
+    EXPECT_FALSE(mDbInterfacePtr->mLastSetMuxForceSwitch);
+}
+
 TEST_F(LinkManagerStateMachineActiveActiveTest, MuxActiveLinkProberPeerActive)
 {
     setMuxActive();
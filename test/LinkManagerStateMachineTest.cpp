@@ -278,7 +278,7 @@ void LinkManagerStateMachineTest::postPeerLinkStateEvent(std::string linkState,
 
 void LinkManagerStateMachineTest::postPckLossRatioUpdateEvent(uint64_t unknownCount, uint64_t totalCount)
 {
-    mFakeMuxPort.postPckLossRatio(unknownCount, totalCount);
+    mFakeMuxPort.postPckLossRatio(unknownCount, totalCount, link_prober::HeartbeatLossWindowStats(), link_prober::HeartbeatLossWindowStats());
     mFakeMuxPort.mFakeLinkProber->mIcmpUnknownEventCount = unknownCount;
     mFakeMuxPort.mFakeLinkProber->mIcmpPacketCount = totalCount;
 
@@ -0,0 +1,156 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LinkProberBudgetTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "LinkProberBudgetTest.h"
+
+namespace test
+{
+
+void LinkProberBudgetTest::TearDown()
+{
+    for (size_t i = 0; i < mLinkProbers.size(); i++) {
+        mBudgetPtr->unregisterLinkProber(getLinkProberPtr(i));
+    }
+    mBudgetPtr->setMaxProbeRate(0);
+}
+
+link_prober::LinkProberBase *LinkProberBudgetTest::getLinkProberPtr(size_t index)
+{
+    return reinterpret_cast<link_prober::LinkProberBase *> (&mLinkProbers[index]);
+}
+
+link_prober::ProbeDemand LinkProberBudgetTest::makeDemand(uint32_t interval_msec, uint32_t maxInterval_msec, uint32_t priority)
+{
+    link_prober::ProbeDemand demand;
+    demand.interval_msec = interval_msec;
+    demand.maxInterval_msec = maxInterval_msec;
+    demand.priority = priority;
+
+    return demand;
+}
+
+TEST_F(LinkProberBudgetTest, Unlimited)
+{
+    for (size_t i = 0; i < 4; i++) {
+        EXPECT_EQ(mBudgetPtr->allocate(getLinkProberPtr(i), makeDemand(100, 1000)), 0);
+    }
+
+    EXPECT_DOUBLE_EQ(mBudgetPtr->getDemandRate(), 40);
+    EXPECT_DOUBLE_EQ(mBudgetPtr->getAllocatedRate(), 40);
+    EXPECT_FALSE(mBudgetPtr->isOverBudget());
+}
+
+TEST_F(LinkProberBudgetTest, WithinBudget)
+{
+    mBudgetPtr->setMaxProbeRate(40);
+    for (size_t i = 0; i < 4; i++) {
+        EXPECT_EQ(mBudgetPtr->allocate(getLinkProberPtr(i), makeDemand(100, 1000)), 100);
+    }
+
+    EXPECT_FALSE(mBudgetPtr->isOverBudget());
+}
+
+TEST_F(LinkProberBudgetTest, FairShare)
+{
+    mBudgetPtr->setMaxProbeRate(30);
+    for (size_t i = 0; i < 4; i++) {
+        mBudgetPtr->allocate(getLinkProberPtr(i), makeDemand(100, 1000));
+    }
+
+    // 1 pps floor of each prober plus equal share of the other 26 pps
+    for (size_t i = 0; i < 4; i++) {
+        EXPECT_EQ(mBudgetPtr->allocate(getLinkProberPtr(i), makeDemand(100, 1000)), 134);
+    }
+    EXPECT_TRUE(mBudgetPtr->isOverBudget());
+    EXPECT_DOUBLE_EQ(mBudgetPtr->getDemandRate(), 40);
+    EXPECT_LE(mBudgetPtr->getAllocatedRate(), 30);
+}
+
+TEST_F(LinkProberBudgetTest, PriorityWeightedShare)
+{
+    mBudgetPtr->setMaxProbeRate(42);
+    mBudgetPtr->allocate(getLinkProberPtr(0), makeDemand(10, 1000, 3));
+    mBudgetPtr->allocate(getLinkProberPtr(1), makeDemand(10, 1000, 1));
+
+    // 40 pps above floors is split 3:1
+    EXPECT_EQ(mBudgetPtr->allocate(getLinkProberPtr(0), makeDemand(10, 1000, 3)), 33);
+    EXPECT_EQ(mBudgetPtr->allocate(getLinkProberPtr(1), makeDemand(10, 1000, 1)), 91);
+
+    // zero priority prober only keeps its floor
+    mBudgetPtr->allocate(getLinkProberPtr(1), makeDemand(10, 1000, 0));
+    EXPECT_EQ(mBudgetPtr->allocate(getLinkProberPtr(0), makeDemand(10, 1000, 3)), 25);
+    EXPECT_EQ(mBudgetPtr->allocate(getLinkProberPtr(1), makeDemand(10, 1000, 0)), 1000);
+}
+
+TEST_F(LinkProberBudgetTest, UnusedShareIsRedistributed)
+{
+    mBudgetPtr->setMaxProbeRate(50);
+    mBudgetPtr->allocate(getLinkProberPtr(0), makeDemand(100, 1000));
+    mBudgetPtr->allocate(getLinkProberPtr(1), makeDemand(10, 1000));
+
+    // slow prober gets all it asks for, fast one the rest of the budget
+    EXPECT_EQ(mBudgetPtr->allocate(getLinkProberPtr(0), makeDemand(100, 1000)), 100);
+    EXPECT_EQ(mBudgetPtr->allocate(getLinkProberPtr(1), makeDemand(10, 1000)), 25);
+}
+
+TEST_F(LinkProberBudgetTest, RebalanceOnDemandChange)
+{
+    mBudgetPtr->setMaxProbeRate(100);
+    mBudgetPtr->allocate(getLinkProberPtr(0), makeDemand(10, 1000));
+    mBudgetPtr->allocate(getLinkProberPtr(1), makeDemand(10, 1000));
+    EXPECT_TRUE(mBudgetPtr->isOverBudget());
+    EXPECT_EQ(mBudgetPtr->allocate(getLinkProberPtr(0), makeDemand(10, 1000)), 20);
+
+    // inactive prober releases its share
+    link_prober::ProbeDemand inactive = makeDemand(10, 1000);
+    inactive.active = false;
+    mBudgetPtr->allocate(getLinkProberPtr(1), inactive);
+    EXPECT_FALSE(mBudgetPtr->isOverBudget());
+    EXPECT_EQ(mBudgetPtr->allocate(getLinkProberPtr(0), makeDemand(10, 1000)), 10);
+
+    mBudgetPtr->allocate(getLinkProberPtr(1), makeDemand(10, 1000));
+    EXPECT_TRUE(mBudgetPtr->isOverBudget());
+    mBudgetPtr->unregisterLinkProber(getLinkProberPtr(1));
+    EXPECT_FALSE(mBudgetPtr->isOverBudget());
+    EXPECT_EQ(mBudgetPtr->allocate(getLinkProberPtr(0), makeDemand(10, 1000)), 10);
+
+    // budget change is applied to registered probers
+    mBudgetPtr->setMaxProbeRate(50);
+    EXPECT_EQ(mBudgetPtr->allocate(getLinkProberPtr(0), makeDemand(10, 1000)), 20);
+}
+
+TEST_F(LinkProberBudgetTest, FloorExceedsBudget)
+{
+    mBudgetPtr->setMaxProbeRate(10);
+    for (size_t i = 0; i < 4; i++) {
+        mBudgetPtr->allocate(getLinkProberPtr(i), makeDemand(100, 200));
+    }
+
+    // probers are never throttled beyond their slowest interval
+    for (size_t i = 0; i < 4; i++) {
+        EXPECT_EQ(mBudgetPtr->allocate(getLinkProberPtr(i), makeDemand(100, 200)), 200);
+    }
+    EXPECT_TRUE(mBudgetPtr->isOverBudget());
+    EXPECT_DOUBLE_EQ(mBudgetPtr->getAllocatedRate(), 20);
+}
+
+} /* namespace test */
@@ -0,0 +1,52 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * LinkProberBudgetTest.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef LINKPROBERBUDGETTEST_H_
+#define LINKPROBERBUDGETTEST_H_
+
+#include <array>
+
+#include "link_prober/LinkProberBudget.h"
+#include "gtest/gtest.h"
+
+namespace test
+{
+
+class LinkProberBudgetTest: public ::testing::Test
+{
+public:
+    LinkProberBudgetTest() = default;
+    virtual ~LinkProberBudgetTest() = default;
+
+    virtual void TearDown() override;
+
+    link_prober::LinkProberBase *getLinkProberPtr(size_t index);
+    link_prober::ProbeDemand makeDemand(uint32_t interval_msec, uint32_t maxInterval_msec, uint32_t priority = 1);
+
+    // probers are only used as keys of the allocator
+    std::array<uint8_t, 8> mLinkProbers;
+    link_prober::LinkProberBudgetPtr mBudgetPtr = link_prober::LinkProberBudget::getInstance();
+};
+
+} /* namespace test */
+
+#endif /* LINKPROBERBUDGETTEST_H_ */
@@ -27,6 +27,7 @@
 
 #include "common/MuxException.h"
 #include "link_prober/IcmpPayload.h"
+#include "AllocationCounter.h"
 #include "LinkProberHardwareTest.h"
 
 #include "gmock/gmock.h"
@@ -88,7 +89,7 @@ void LinkProberHardwareTest::changePeerGuid()
 
 void LinkProberHardwareTest::buildIcmpReply()
 {
-    memcpy(mBuffer.data(), getTxBuffer().data(), mBuffer.size());
+    memcpy(mBuffer.data(), getTxBuffer().data(), getTxBuffer().size());
     ether_header *txEtherHeader = reinterpret_cast<ether_header *>(getTxBuffer().data());
     ether_header *rxEtherHeader = reinterpret_cast<ether_header *>(mBuffer.data());
     memcpy(rxEtherHeader->ether_shost, txEtherHeader->ether_dhost, sizeof(rxEtherHeader->ether_shost));
@@ -151,6 +152,36 @@ TEST_F(LinkProberHardwareTest, createIcmpSessionProbingTest)
     EXPECT_EQ(1, mDbInterfacePtr->mIcmpSessionsCount);
 }
 
+TEST_F(LinkProberHardwareTest, createIcmpSessionWriteSuppressedTest)
+{
+    mLinkProber.startProbing();
+    EXPECT_EQ(1, mDbInterfacePtr->mIcmpSessionsCount);
+    EXPECT_EQ(8, mDbInterfacePtr->mLastIcmpSessionEntries.size());
+
+    // unchanged session is not written again
+    mLinkProber.startProbing();
+    mLinkProber.startProbing();
+    EXPECT_EQ(1, mDbInterfacePtr->mIcmpSessionsCount);
+    EXPECT_EQ(1, mLinkProber.getIcmpSessionWriteCount());
+    EXPECT_EQ(2, mLinkProber.getIcmpSessionWriteSuppressedCount());
+
+    // only changed fields are written
+    mMuxConfig.setTimeoutIpv4_msec(2);
+    mLinkProber.startProbing();
+    EXPECT_EQ(2, mDbInterfacePtr->mIcmpSessionsCount);
+    ASSERT_EQ(2, mDbInterfacePtr->mLastIcmpSessionEntries.size());
+    EXPECT_EQ("tx_interval", mDbInterfacePtr->mLastIcmpSessionEntries[0].first);
+    EXPECT_EQ("2", mDbInterfacePtr->mLastIcmpSessionEntries[0].second);
+    EXPECT_EQ("rx_interval", mDbInterfacePtr->mLastIcmpSessionEntries[1].first);
+
+    // deleted session is written in full
+    mLinkProber.restartTxProbes();
+    EXPECT_EQ(2, mDbInterfacePtr->mIcmpSessionsCount);
+    EXPECT_EQ(8, mDbInterfacePtr->mLastIcmpSessionEntries.size());
+    EXPECT_EQ(3, mLinkProber.getIcmpSessionWriteCount());
+    EXPECT_EQ(2, mLinkProber.getIcmpSessionWriteSuppressedCount());
+}
+
 TEST_F(LinkProberHardwareTest, deleteIcmpSessionShutdownTest)
 {
     mLinkProber.startProbing();
@@ -278,4 +309,80 @@ TEST_F(LinkProberHardwareTest, LinkProberHardwareHandleIcmpPayload)
     TearDown();
 }
 
+TEST_F(LinkProberHardwareTest, TimerFreeSteadyState)
+{
+    mMuxConfig.enableDefaultRouteFeature(false);
+    mFakeMuxPort.activateStateMachine();
+
+    // software peer starts ICMP timeout timer
+    receivePeerSoftwareIcmpReply();
+    handleRecv();
+    runIoService(1);
+    EXPECT_GT(mLinkProber.getTimerWaitCount(), 0);
+
+    // peer moves to hardware and both sessions come up
+    receivePeerHardwareIcmpReply();
+    handleRecv();
+    mLinkProber.handleStateDbStateUpdate("Up", "NORMAL");
+    mLinkProber.handleStateDbStateUpdate("Up", "RX");
+    for (uint32_t i = 0; i < 100 && !isTimerFree(); i++) {
+        runIoService(1);
+    }
+    EXPECT_TRUE(isTimerFree());
+
+    // no timer or RX wait is armed while both sessions stay in hardware
+    uint64_t timerWaitCount = mLinkProber.getTimerWaitCount();
+    uint64_t rxWaitCount = mLinkProber.getRxWaitCount();
+    for (uint32_t i = 0; i < 10; i++) {
+        usleep(2000);
+        mIoService.poll();
+        mIoService.reset();
+    }
+    EXPECT_EQ(mLinkProber.getTimerWaitCount(), timerWaitCount);
+    EXPECT_EQ(mLinkProber.getRxWaitCount(), rxWaitCount);
+
+    // losing peer session falls back to software timing
+    mLinkProber.handleStateDbStateUpdate("Down", "RX");
+    EXPECT_FALSE(isTimerFree());
+    EXPECT_EQ(mLinkProber.getTimerWaitCount(), timerWaitCount + 1);
+
+    // and steady state is entered again once peer session is back up
+    mLinkProber.handleStateDbStateUpdate("Up", "RX");
+    for (uint32_t i = 0; i < 100 && !isTimerFree(); i++) {
+        runIoService(1);
+    }
+    EXPECT_TRUE(isTimerFree());
+}
+
+TEST_F(LinkProberHardwareTest, ReceivePeerHeartbeatAllocationFree)
+{
+    // learn software peer
+    receivePeerSoftwareIcmpReply();
+    handleRecv();
+    runIoService(1);
+
+    setRxRingEnabled(true);
+    uint32_t peerReplyCount = 0;
+    setReportHeartbeatReplyReceivedFuncPtr([&peerReplyCount] (link_prober::HeartbeatType heartbeatType) {
+        peerReplyCount++;
+    });
+
+    boost::log::trivial::severity_level level = common::MuxLogger::getInstance()->getLevel();
+    common::MuxLogger::getInstance()->setLevel(boost::log::trivial::info);
+
+    const uint32_t frameCount = 1000;
+    uint64_t allocationCount;
+    {
+        AllocationCounter allocationCounter;
+        for (uint32_t i = 0; i < frameCount; i++) {
+            handleRecv();
+        }
+        allocationCount = allocationCounter.getCount();
+    }
+    common::MuxLogger::getInstance()->setLevel(level);
+
+    EXPECT_EQ(allocationCount, 0);
+    EXPECT_EQ(peerReplyCount, frameCount);
+}
+
 } /* namespace test */
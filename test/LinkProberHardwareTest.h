@@ -56,12 +56,17 @@ public:
     bool getSuspendTx() {return mLinkProber.mSuspendTx;};
     std::size_t getTxPacketSize() { return mLinkProber.mTxPacketSize; }
     const std::size_t getPacketHeaderSize() { return mLinkProber.mPacketHeaderSize; }
-    void handleRecv() { mLinkProber.handleRecv(boost::system::error_code(), getTxPacketSize()); }
+    void handleRecv() { mLinkProber.processRxFrame(getTxPacketSize()); }
+    void setRxRingEnabled(bool enabled) { mLinkProber.mRxRingEnabled = enabled; }
+    bool isTimerFree() { return mLinkProber.mTimerFree; }
+    void setReportHeartbeatReplyReceivedFuncPtr(boost::function<void (link_prober::HeartbeatType heartbeatType)> funcPtr) {
+        mLinkProber.mReportHeartbeatReplyReceivedFuncPtr = funcPtr;
+    }
     void computeChecksum(icmphdr* icmpHeader, size_t size) { mLinkProber.computeChecksum(icmpHeader, size); }
     link_manager::ActiveActiveStateMachine::CompositeState mTestCompositeState;
 
-    std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE>& getTxBuffer() { return mLinkProber.mTxBuffer; }
-    std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE>& getRxBuffer() { return mLinkProber.mRxBuffer; }
+    link_prober::PacketBuffer& getTxBuffer() { return mLinkProber.mTxBuffer; }
+    link_prober::PacketBuffer& getRxBuffer() { return mLinkProber.mRxBuffer; }
     void receivePeerSoftwareIcmpReply();
     void receivePeerHardwareIcmpReply();
     void changePeerGuid();
@@ -21,11 +21,17 @@
  *      Author: taahme
  */
 
+#include <chrono>
+#include <iostream>
+#include <memory>
+
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_io.hpp>
 
+#include "common/InternetChecksum.h"
 #include "common/MuxException.h"
 #include "link_prober/IcmpPayload.h"
+#include "AllocationCounter.h"
 #include "LinkProberTest.h"
 
 namespace test
@@ -72,7 +78,7 @@ size_t LinkProberTest::findNextTlv(size_t readOffset, size_t bytesTransferred)
 TEST_F(LinkProberTest, InitializeSendBuffer)
 {
     initializeSendBuffer();
-    std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE> txBuffer = getTxBuffer();
+    link_prober::PacketBuffer &txBuffer = getTxBuffer();
 
     ether_header *ethHeader = reinterpret_cast<ether_header *> (txBuffer.data());
     EXPECT_TRUE(memcmp(
@@ -136,6 +142,7 @@ TEST_F(LinkProberTest, handleSendSwitchCommand)
     iphdr *ipHeader = reinterpret_cast<iphdr *>(getTxBufferData() + sizeof(ether_header));
     icmphdr *icmpHeader = reinterpret_cast<icmphdr *>(getTxBufferData() + sizeof(ether_header) + sizeof(iphdr));
     ipHeader->id = static_cast<uint16_t> (17767);
+    calculateTxPacketChecksum();
     initTxBufferSentinel();
     EXPECT_TRUE(ipHeader->check == 62919);
     EXPECT_EQ(icmpHeader->checksum, 22109);
@@ -158,6 +165,7 @@ TEST_F(LinkProberTest, handleSendProbeCommand)
     iphdr *ipHeader = reinterpret_cast<iphdr *>(getTxBufferData() + sizeof(ether_header));
     icmphdr *icmpHeader = reinterpret_cast<icmphdr *>(getTxBufferData() + sizeof(ether_header) + sizeof(iphdr));
     ipHeader->id = static_cast<uint16_t> (17767);
+    calculateTxPacketChecksum();
     initTxBufferSentinel();
     EXPECT_TRUE(ipHeader->check == 62919);
     EXPECT_EQ(icmpHeader->checksum, 22109);
@@ -184,6 +192,42 @@ TEST_F(LinkProberTest, UpdateEthernetFrame)
     EXPECT_EQ(icmpHeader->checksum, 22109);
 }
 
+TEST_F(LinkProberTest, UpdateTxFrameAddresses)
+{
+    initializeSendBuffer();
+    initTxBufferTlvSendSwitch();
+
+    common::MuxPortConfig &muxPortConfig = const_cast<common::MuxPortConfig &> (mFakeMuxPort.getMuxPortConfig());
+    muxPortConfig.setBladeIpv4Address(boost::asio::ip::address::from_string("192.168.1.42"));
+    muxPortConfig.setBladeMacAddress({0, 'b', 2, 'd', 4, 'f'});
+    handleUpdateEthernetFrame();
+
+    ether_header *ethHeader = reinterpret_cast<ether_header *> (getTxBufferData());
+    iphdr *ipHeader = reinterpret_cast<iphdr *> (getTxBufferData() + sizeof(ether_header));
+    icmphdr *icmpHeader = reinterpret_cast<icmphdr *> (getTxBufferData() + sizeof(ether_header) + sizeof(iphdr));
+    EXPECT_TRUE(memcmp(
+        ethHeader->ether_dhost,
+        mFakeMuxPort.getMuxPortConfig().getBladeMacAddress().data(),
+        sizeof(ethHeader->ether_dhost)
+    ) == 0);
+    EXPECT_EQ(ipHeader->daddr, htonl(mFakeMuxPort.getMuxPortConfig().getBladeIpv4Address().to_v4().to_uint()));
+
+    // incrementally patched frame carries the same checksums as a fully recomputed one
+    uint16_t ipChecksum = ipHeader->check;
+    uint16_t icmpChecksum = icmpHeader->checksum;
+    calculateTxPacketChecksum();
+    EXPECT_EQ(ipHeader->check, ipChecksum);
+    EXPECT_EQ(icmpHeader->checksum, icmpChecksum);
+
+    initTxBufferSentinel();
+    EXPECT_EQ(getTxPacketSize(), sizeof(ether_header) + sizeof(iphdr) + sizeof(icmphdr) + sizeof(link_prober::IcmpPayload) + sizeof(link_prober::TlvHead));
+    ipChecksum = ipHeader->check;
+    icmpChecksum = icmpHeader->checksum;
+    calculateTxPacketChecksum();
+    EXPECT_EQ(ipHeader->check, ipChecksum);
+    EXPECT_EQ(icmpHeader->checksum, icmpChecksum);
+}
+
 TEST_F(LinkProberTest, UpdateSequenceNo)
 {
     link_prober::IcmpPayload *icmpPayload = new (
@@ -220,7 +264,7 @@ TEST_F(LinkProberTest, GenerateGuid)
 {
     initializeSendBuffer();
 
-    std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE> txBuffer = getTxBuffer();
+    link_prober::PacketBuffer &txBuffer = getTxBuffer();
     link_prober::IcmpPayload *icmpPayload = new (
         txBuffer.data() + sizeof(ether_header) + sizeof(iphdr) + sizeof(icmphdr)
     ) link_prober::IcmpPayload();
@@ -243,7 +287,7 @@ TEST_F(LinkProberTest, UpdateToRMac)
 
     initializeSendBuffer();
 
-    std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE> txBuffer = getTxBuffer();
+    link_prober::PacketBuffer &txBuffer = getTxBuffer();
     ether_header *ethHeader = reinterpret_cast<ether_header *> (txBuffer.data());
 
     EXPECT_TRUE(ethHeader->ether_shost[0] == torMac[0]);
@@ -332,6 +376,986 @@ TEST_F(LinkProberTest, ReadWriteVariableSizedTlv)
     EXPECT_TRUE(findNextTlv(rxReadOffset, bytesTransferred) == 0);
 }
 
+TEST_F(LinkProberTest, RxRingDispatchFrame)
+{
+    initializeSendBuffer();
+
+    // build echo reply from this ToR's heartbeat
+    size_t frameSize = getTxPacketSize();
+    std::vector<uint8_t> frame(getTxBufferData(), getTxBufferData() + frameSize);
+    iphdr *ipHeader = reinterpret_cast<iphdr *> (frame.data() + sizeof(ether_header));
+    icmphdr *icmpHeader = reinterpret_cast<icmphdr *> (frame.data() + sizeof(ether_header) + sizeof(iphdr));
+    ipHeader->saddr = htonl(mFakeMuxPort.getMuxPortConfig().getBladeIpv4Address().to_v4().to_uint());
+    icmpHeader->type = ICMP_ECHOREPLY;
+
+    // lay out one ring block holding the reply on two interfaces, only the first one has a link prober
+    const int ifIndex = 1000;
+    alignas(8) std::array<uint8_t, 4096> block = {0};
+    tpacket_block_desc *blockDesc = reinterpret_cast<tpacket_block_desc *> (block.data());
+    size_t frameOffset = TPACKET_ALIGN(sizeof(tpacket_block_desc));
+    size_t macOffset = TPACKET_ALIGN(TPACKET_ALIGN(sizeof(tpacket3_hdr)) + sizeof(sockaddr_ll));
+    size_t frameStride = TPACKET_ALIGN(macOffset + frameSize);
+    blockDesc->hdr.bh1.num_pkts = 2;
+    blockDesc->hdr.bh1.offset_to_first_pkt = frameOffset;
+    for (int i = 0; i < 2; i++) {
+        tpacket3_hdr *frameHeader = reinterpret_cast<tpacket3_hdr *> (block.data() + frameOffset + i * frameStride);
+        sockaddr_ll *addr = reinterpret_cast<sockaddr_ll *> (
+            reinterpret_cast<uint8_t *> (frameHeader) + TPACKET_ALIGN(sizeof(tpacket3_hdr))
+        );
+        frameHeader->tp_next_offset = frameStride;
+        frameHeader->tp_mac = macOffset;
+        frameHeader->tp_snaplen = frameSize;
+        addr->sll_ifindex = ifIndex + i;
+        memcpy(reinterpret_cast<uint8_t *> (frameHeader) + macOffset, frame.data(), frameSize);
+    }
+
+    link_prober::LinkProberRxRingPtr rxRingPtr = link_prober::LinkProberRxRing::getInstance();
+    uint64_t frameCount = rxRingPtr->getFrameCount();
+    uint64_t unclaimedFrameCount = rxRingPtr->getUnclaimedFrameCount();
+    rxRingPtr->registerLinkProber(ifIndex, &mLinkProber);
+
+    bool blockReleased = false;
+    std::shared_ptr<void> blockRef(nullptr, [&blockReleased] (void *) {blockReleased = true;});
+    dispatchRxRingBlock(blockDesc, blockRef);
+    blockRef.reset();
+
+    EXPECT_EQ(rxRingPtr->getFrameCount(), frameCount + 1);
+    EXPECT_EQ(rxRingPtr->getUnclaimedFrameCount(), unclaimedFrameCount + 1);
+
+    // link prober holds the block until its frame is processed
+    EXPECT_FALSE(blockReleased);
+    EXPECT_EQ(getRxSelfSeqNo(), 0);
+    mIoService.poll();
+    EXPECT_TRUE(blockReleased);
+    EXPECT_EQ(getRxSelfSeqNo(), 0xffff);
+
+    rxRingPtr->unregisterLinkProber(ifIndex, &mLinkProber);
+}
+
+TEST_F(LinkProberTest, TxBatchSendError)
+{
+    initializeSendBuffer();
+
+    // unix socket rejects link layer addresses, every batched frame fails and is reported back
+    int sv[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_DGRAM, 0, sv), 0);
+    setupTxBatcher(sv[0]);
+
+    link_prober::LinkProberTxBatcherPtr txBatcherPtr = link_prober::LinkProberTxBatcher::getInstance();
+    uint64_t syscallCount = txBatcherPtr->getSyscallCount();
+    uint64_t errorCount = txBatcherPtr->getErrorCount();
+
+    handleSendHeartbeat();
+    handleSendHeartbeat();
+    EXPECT_EQ(txBatcherPtr->getSyscallCount(), syscallCount);
+
+    mIoService.run_for(std::chrono::milliseconds(100));
+
+    EXPECT_EQ(txBatcherPtr->getSyscallCount(), syscallCount + 2);
+    EXPECT_EQ(txBatcherPtr->getErrorCount(), errorCount + 2);
+    EXPECT_EQ(getTxErrorCount(), 2);
+
+    txBatcherPtr->deinitialize();
+    EXPECT_FALSE(txBatcherPtr->isEnabled());
+    close(sv[1]);
+}
+
+TEST_F(LinkProberTest, TxBatchTimestamp)
+{
+    initializeSendBuffer();
+
+    int sv[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_DGRAM, 0, sv), 0);
+    setupTxBatcher(sv[0]);
+
+    // heartbeat is stamped when the batch goes out, not when it is queued
+    handleSendHeartbeat();
+    struct timespec queued;
+    clock_gettime(CLOCK_REALTIME, &queued);
+    uint64_t queuedTimestamp = queued.tv_sec * 1000000000ULL + queued.tv_nsec;
+
+    mIoService.run_for(std::chrono::milliseconds(100));
+
+    const uint8_t *frame = getTxBatchFlushFrameData(0);
+    uint64_t txTimestamp;
+    memcpy(&txTimestamp, frame + sizeof(ether_header) + sizeof(iphdr) + sizeof(icmphdr) + offsetof(link_prober::IcmpPayload, seq),
+        sizeof(txTimestamp));
+    EXPECT_GE(be64toh(txTimestamp), queuedTimestamp);
+
+    // incrementally patched ICMP checksum stays valid
+    size_t icmpSize = getTxPacketSize() - sizeof(ether_header) - sizeof(iphdr);
+    EXPECT_EQ(common::InternetChecksum::fold(common::InternetChecksum::sum(frame + sizeof(ether_header) + sizeof(iphdr), icmpSize)), 0xffff);
+
+    link_prober::LinkProberTxBatcher::getInstance()->deinitialize();
+    close(sv[1]);
+}
+
+TEST_F(LinkProberTest, SocketFilterMatchesProberIdentity)
+{
+    common::MuxPortConfig &muxPortConfig = const_cast<common::MuxPortConfig &> (mFakeMuxPort.getMuxPortConfig());
+    muxPortConfig.setBladeIpv4Address(boost::asio::ip::address::from_string(mSmartNicIpAddress));
+    initializeSendBuffer();
+
+    // build echo reply from this ToR's heartbeat
+    std::vector<uint8_t> frame(getTxBufferData(), getTxBufferData() + getTxPacketSize());
+    iphdr *ipHeader = reinterpret_cast<iphdr *> (frame.data() + sizeof(ether_header));
+    icmphdr *icmpHeader = reinterpret_cast<icmphdr *> (frame.data() + sizeof(ether_header) + sizeof(iphdr));
+    link_prober::IcmpPayload *icmpPayload = reinterpret_cast<link_prober::IcmpPayload *> (
+        frame.data() + sizeof(ether_header) + sizeof(iphdr) + sizeof(icmphdr)
+    );
+    ipHeader->saddr = htonl(mFakeMuxPort.getMuxPortConfig().getBladeIpv4Address().to_v4().to_uint());
+    icmpHeader->type = ICMP_ECHOREPLY;
+
+    // unix datagram socket runs attached filter on the whole message
+    int sv[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_DGRAM, 0, sv), 0);
+    link_prober::LinkProberFilter filter;
+    filter.compile(getIcmpFilterIdentity());
+    struct sock_fprog sockFilterProg = filter.getSockFilterProg();
+    ASSERT_EQ(setsockopt(sv[1], SOL_SOCKET, SO_ATTACH_FILTER, &sockFilterProg, sizeof(sockFilterProg)), 0);
+
+    auto isFrameAccepted = [&sv] (const std::vector<uint8_t> &frame) -> bool {
+        std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE> buffer;
+        EXPECT_EQ(send(sv[0], frame.data(), frame.size(), 0), static_cast<ssize_t> (frame.size()));
+        return recv(sv[1], buffer.data(), buffer.size(), MSG_DONTWAIT) == static_cast<ssize_t> (frame.size());
+    };
+
+    EXPECT_TRUE(isFrameAccepted(frame));
+
+    // own echo request reflected back
+    icmpHeader->type = ICMP_ECHO;
+    EXPECT_FALSE(isFrameAccepted(frame));
+    icmpHeader->type = ICMP_ECHOREPLY;
+
+    // reply of another server
+    icmpHeader->un.echo.id = htons(mServerId + 1);
+    EXPECT_FALSE(isFrameAccepted(frame));
+
+    // software prober accepts hardware cookie regardless of echo id
+    icmpPayload->cookie = htonl(link_prober::IcmpPayload::getHardwareCookie());
+    EXPECT_TRUE(isFrameAccepted(frame));
+
+    icmpPayload->cookie = htonl(0xdeadbeef);
+    EXPECT_FALSE(isFrameAccepted(frame));
+    icmpPayload->cookie = htonl(link_prober::IcmpPayload::getSoftwareCookie());
+    icmpHeader->un.echo.id = htons(mServerId);
+
+    icmpPayload->version = htonl(link_prober::IcmpPayload::getVersion() + 1);
+    EXPECT_FALSE(isFrameAccepted(frame));
+    icmpPayload->version = htonl(link_prober::IcmpPayload::getVersion());
+
+    ipHeader->saddr = htonl(mFakeMuxPort.getMuxPortConfig().getBladeIpv4Address().to_v4().to_uint() + 1);
+    EXPECT_FALSE(isFrameAccepted(frame));
+    ipHeader->saddr = htonl(mFakeMuxPort.getMuxPortConfig().getBladeIpv4Address().to_v4().to_uint());
+
+    // truncated payload
+    std::vector<uint8_t> shortFrame(frame.begin(), frame.begin() + sizeof(ether_header) + sizeof(iphdr) + sizeof(icmphdr));
+    EXPECT_FALSE(isFrameAccepted(shortFrame));
+
+    EXPECT_TRUE(isFrameAccepted(frame));
+
+    close(sv[0]);
+    close(sv[1]);
+}
+
+TEST_F(LinkProberTest, ReceiveHeartbeatAllocationFree)
+{
+    common::MuxPortConfig &muxPortConfig = const_cast<common::MuxPortConfig &> (mFakeMuxPort.getMuxPortConfig());
+    muxPortConfig.setBladeIpv4Address(boost::asio::ip::address::from_string(mSmartNicIpAddress));
+    regenerateSelfGuid();
+    initializeSendBuffer();
+
+    // frames are pushed by RX ring, no re-arm of the socket read
+    setRxRingEnabled(true);
+    uint32_t selfReplyCount = 0;
+    uint32_t peerReplyCount = 0;
+    setReportHeartbeatReplyReceivedFuncPtr([&selfReplyCount, &peerReplyCount] (link_prober::HeartbeatType heartbeatType) {
+        heartbeatType == link_prober::HeartbeatType::HEARTBEAT_SELF ? selfReplyCount++ : peerReplyCount++;
+    });
+
+    size_t frameSize = getTxPacketSize();
+    memcpy(getRxBufferData(), getTxBufferData(), frameSize);
+    icmphdr *icmpHeader = reinterpret_cast<icmphdr *> (getRxBufferData() + sizeof(ether_header) + sizeof(iphdr));
+    link_prober::IcmpPayload *icmpPayload = reinterpret_cast<link_prober::IcmpPayload *> (
+        getRxBufferData() + sizeof(ether_header) + sizeof(iphdr) + sizeof(icmphdr)
+    );
+    icmpHeader->type = ICMP_ECHOREPLY;
+
+    std::array<uint8_t, sizeof(icmpPayload->uuid)> selfUuid;
+    std::array<uint8_t, sizeof(icmpPayload->uuid)> peerUuid = {0, 0, 0, 0, 0x12, 0x34, 0x56, 0x78};
+    memcpy(selfUuid.data(), icmpPayload->uuid, selfUuid.size());
+
+    boost::log::trivial::severity_level level = common::MuxLogger::getInstance()->getLevel();
+    common::MuxLogger::getInstance()->setLevel(boost::log::trivial::info);
+
+    const uint32_t frameCount = 1000;
+    uint64_t allocationCount;
+    {
+        AllocationCounter allocationCounter;
+        for (uint32_t i = 0; i < frameCount; i++) {
+            memcpy(icmpPayload->uuid, (i % 2) ? peerUuid.data() : selfUuid.data(), sizeof(icmpPayload->uuid));
+            processRxFrame(frameSize);
+        }
+        allocationCount = allocationCounter.getCount();
+    }
+    common::MuxLogger::getInstance()->setLevel(level);
+
+    EXPECT_EQ(allocationCount, 0);
+    EXPECT_EQ(selfReplyCount, frameCount / 2);
+    EXPECT_EQ(peerReplyCount, frameCount / 2);
+    EXPECT_EQ(mLinkProber.getPeerGuidData(), 0x12345678);
+    EXPECT_EQ(link_prober::LinkProberBase::guidToString(mLinkProber.getPeerGuidData()), "0x12345678");
+}
+
+TEST_F(LinkProberTest, DrainQueuedFramesInOneWakeup)
+{
+    common::MuxPortConfig &muxPortConfig = const_cast<common::MuxPortConfig &> (mFakeMuxPort.getMuxPortConfig());
+    muxPortConfig.setBladeIpv4Address(boost::asio::ip::address::from_string(mSmartNicIpAddress));
+    regenerateSelfGuid();
+    initializeSendBuffer();
+
+    uint32_t selfReplyCount = 0;
+    setReportHeartbeatReplyReceivedFuncPtr([&selfReplyCount] (link_prober::HeartbeatType heartbeatType) {
+        if (heartbeatType == link_prober::HeartbeatType::HEARTBEAT_SELF) {
+            selfReplyCount++;
+        }
+    });
+
+    size_t frameSize = getTxPacketSize();
+    icmphdr *icmpHeader = reinterpret_cast<icmphdr *> (getTxBufferData() + sizeof(ether_header) + sizeof(iphdr));
+    icmpHeader->type = ICMP_ECHOREPLY;
+
+    // queue more replies than a single recvmmsg batch
+    int sv[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_DGRAM, 0, sv), 0);
+    const size_t queuedFrameCount = 12;
+    for (size_t i = 0; i < queuedFrameCount; i++) {
+        ASSERT_EQ(send(sv[0], getTxBufferData(), frameSize, 0), static_cast<ssize_t> (frameSize));
+    }
+    assignRxSocket(sv[1]);
+
+    handleRecv();
+
+    EXPECT_EQ(selfReplyCount, queuedFrameCount);
+    EXPECT_EQ(mLinkProber.getRxWakeupCount(), 1);
+    EXPECT_EQ(mLinkProber.getRxFrameCount(), queuedFrameCount);
+    EXPECT_EQ(mLinkProber.getRxMaxFramesPerWakeup(), queuedFrameCount);
+
+    ASSERT_EQ(send(sv[0], getTxBufferData(), frameSize, 0), static_cast<ssize_t> (frameSize));
+    handleRecv();
+    EXPECT_EQ(selfReplyCount, queuedFrameCount + 1);
+    EXPECT_EQ(mLinkProber.getRxWakeupCount(), 2);
+    EXPECT_EQ(mLinkProber.getRxFrameCount(), queuedFrameCount + 1);
+    EXPECT_EQ(mLinkProber.getRxMaxFramesPerWakeup(), queuedFrameCount);
+
+    // spurious wakeup does not count
+    handleRecv();
+    EXPECT_EQ(mLinkProber.getRxWakeupCount(), 2);
+
+    close(sv[0]);
+}
+
+TEST_F(LinkProberTest, JumboTlvBuffers)
+{
+    common::MuxPortConfig &muxPortConfig = const_cast<common::MuxPortConfig &> (mFakeMuxPort.getMuxPortConfig());
+    muxPortConfig.setBladeIpv4Address(boost::asio::ip::address::from_string(mSmartNicIpAddress));
+    regenerateSelfGuid();
+    initializeSendBuffer();
+
+    uint32_t selfReplyCount = 0;
+    setReportHeartbeatReplyReceivedFuncPtr([&selfReplyCount] (link_prober::HeartbeatType heartbeatType) {
+        if (heartbeatType == link_prober::HeartbeatType::HEARTBEAT_SELF) {
+            selfReplyCount++;
+        }
+    });
+
+    std::vector<uint8_t> smallFrame(getTxBufferData(), getTxBufferData() + getTxPacketSize());
+    reinterpret_cast<icmphdr *> (smallFrame.data() + sizeof(ether_header) + sizeof(iphdr))->type = ICMP_ECHOREPLY;
+
+    // TX frame stays in a pool buffer until a TLV outgrows it
+    EXPECT_FALSE(getTxBuffer().isJumbo());
+    EXPECT_EQ(getTxBuffer().size(), MUX_POOL_BUFFER_SIZE);
+    resetTxBufferTlv();
+    appendTlvDummy(4000, 1);
+    appendTlvSentinel();
+    size_t frameSize = getTxPacketSize();
+    EXPECT_TRUE(getTxBuffer().isJumbo());
+    EXPECT_GE(getTxBuffer().size(), frameSize);
+    uint32_t *seqNoPtr = reinterpret_cast<uint32_t *> (getTxBufferData() + frameSize - sizeof(link_prober::TlvHead) - sizeof(uint32_t));
+    EXPECT_EQ(ntohl(*seqNoPtr), 1);
+
+    icmphdr *icmpHeader = reinterpret_cast<icmphdr *> (getTxBufferData() + sizeof(ether_header) + sizeof(iphdr));
+    icmpHeader->type = ICMP_ECHOREPLY;
+
+    int sv[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_DGRAM, 0, sv), 0);
+    assignRxSocket(sv[1]);
+
+    // jumbo frame at the head of the queue is sized before it is received and switches link prober to jumbo RX buffers
+    ASSERT_EQ(send(sv[0], getTxBufferData(), frameSize, 0), static_cast<ssize_t> (frameSize));
+    EXPECT_EQ(drainRecv(), 1);
+    EXPECT_EQ(selfReplyCount, 1);
+    EXPECT_TRUE(isRxJumboEnabled());
+    EXPECT_EQ(getRxTruncatedFrameCount(), 0);
+
+    ASSERT_EQ(send(sv[0], getTxBufferData(), frameSize, 0), static_cast<ssize_t> (frameSize));
+    handleRecv();
+    EXPECT_EQ(selfReplyCount, 2);
+
+    // jumbo frame behind a pool sized frame in the same batch is truncated and not counted as processed
+    setRxJumboEnabled(false);
+    ASSERT_EQ(send(sv[0], smallFrame.data(), smallFrame.size(), 0), static_cast<ssize_t> (smallFrame.size()));
+    ASSERT_EQ(send(sv[0], getTxBufferData(), frameSize, 0), static_cast<ssize_t> (frameSize));
+    EXPECT_EQ(drainRecv(), 1);
+    EXPECT_EQ(selfReplyCount, 3);
+    EXPECT_TRUE(isRxJumboEnabled());
+    EXPECT_EQ(getRxTruncatedFrameCount(), 1);
+
+    // following drains use jumbo buffers
+    ASSERT_EQ(send(sv[0], smallFrame.data(), smallFrame.size(), 0), static_cast<ssize_t> (smallFrame.size()));
+    ASSERT_EQ(send(sv[0], getTxBufferData(), frameSize, 0), static_cast<ssize_t> (frameSize));
+    EXPECT_EQ(drainRecv(), 2);
+    EXPECT_EQ(selfReplyCount, 5);
+
+    close(sv[0]);
+}
+
+TEST_F(LinkProberTest, MemoryPerMuxPort)
+{
+    link_prober::LinkProberBufferPoolPtr bufferPoolPtr = link_prober::LinkProberBufferPool::getInstance();
+    size_t poolBytes = bufferPoolPtr->getInUseBytes();
+
+    std::unique_ptr<link_prober::LinkProberSw> linkProberPtr;
+    uint64_t heapBytes;
+    {
+        AllocationCounter allocationCounter;
+        linkProberPtr.reset(new link_prober::LinkProberSw(
+            const_cast<common::MuxPortConfig&> (mFakeMuxPort.getMuxPortConfig()),
+            mIoService,
+            mFakeMuxPort.getLinkProberStateMachinePtr()
+        ));
+        heapBytes = allocationCounter.getBytes();
+    }
+    size_t poolBufferBytes = bufferPoolPtr->getInUseBytes() - poolBytes;
+
+    // link prober used to embed TX, RX and RX batch buffers sized for jumbo frames
+    size_t bytesAfter = heapBytes + poolBufferBytes;
+    size_t bytesBefore = heapBytes - (2 + 8) * sizeof(link_prober::PacketBuffer) + (2 + 8) * MUX_MAX_ICMP_BUFFER_SIZE;
+    RecordProperty("BytesPerMuxPortBefore", std::to_string(bytesBefore));
+    RecordProperty("BytesPerMuxPortAfter", std::to_string(bytesAfter));
+    std::cout << "link prober bytes per mux port, before: " << bytesBefore << ", after: " << bytesAfter << std::endl;
+
+    // only TX and RX buffers are held while idle, RX batch buffers return to pool after each drain
+    EXPECT_EQ(poolBufferBytes, 2 * MUX_POOL_BUFFER_SIZE);
+    EXPECT_LT(bytesAfter, bytesBefore / 2);
+
+    linkProberPtr.reset();
+    EXPECT_EQ(bufferPoolPtr->getInUseBytes(), poolBytes);
+}
+
+TEST_F(LinkProberTest, RecordHeartbeatRtt)
+{
+    common::MuxPortConfig &muxPortConfig = const_cast<common::MuxPortConfig &> (mFakeMuxPort.getMuxPortConfig());
+    muxPortConfig.setBladeIpv4Address(boost::asio::ip::address::from_string(mSmartNicIpAddress));
+    regenerateSelfGuid();
+    initializeSendBuffer();
+
+    // incrementally patched TX timestamp keeps ICMP checksum valid
+    icmphdr *icmpHeader = reinterpret_cast<icmphdr *> (getTxBufferData() + sizeof(ether_header) + sizeof(iphdr));
+    updateIcmpTxTimestamp();
+    uint16_t icmpChecksum = icmpHeader->checksum;
+    calculateTxPacketChecksum();
+    EXPECT_EQ(icmpHeader->checksum, icmpChecksum);
+
+    link_prober::IcmpPayload *icmpPayload = reinterpret_cast<link_prober::IcmpPayload *> (
+        getTxBufferData() + sizeof(ether_header) + sizeof(iphdr) + sizeof(icmphdr)
+    );
+    uint64_t txTimestamp;
+    memcpy(&txTimestamp, reinterpret_cast<uint8_t *> (icmpPayload) + offsetof(link_prober::IcmpPayload, seq), sizeof(txTimestamp));
+    EXPECT_NE(txTimestamp, 0);
+
+    int sv[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_DGRAM, 0, sv), 0);
+    icmpHeader->type = ICMP_ECHOREPLY;
+    ASSERT_EQ(send(sv[0], getTxBufferData(), getTxPacketSize(), 0), static_cast<ssize_t> (getTxPacketSize()));
+
+    // reply without TX timestamp, as sent by older ToRs, is not sampled
+    memset(reinterpret_cast<uint8_t *> (icmpPayload) + offsetof(link_prober::IcmpPayload, seq), 0, sizeof(txTimestamp));
+    ASSERT_EQ(send(sv[0], getTxBufferData(), getTxPacketSize(), 0), static_cast<ssize_t> (getTxPacketSize()));
+    assignRxSocket(sv[1]);
+
+    handleRecv();
+
+    const common::LatencyHistogram &selfRtt = mLinkProber.getRttHistogram();
+    EXPECT_EQ(selfRtt.getCount(), 1);
+    EXPECT_LT(selfRtt.getPercentile(99.9), 1000000);
+
+    // peer reply carries TX time of the peer ToR clock and is not sampled
+    updateIcmpTxTimestamp();
+    memcpy(getRxBufferData(), getTxBufferData(), getTxPacketSize());
+    link_prober::IcmpPayload *rxIcmpPayload = reinterpret_cast<link_prober::IcmpPayload *> (
+        getRxBufferData() + sizeof(ether_header) + sizeof(iphdr) + sizeof(icmphdr)
+    );
+    std::array<uint8_t, sizeof(rxIcmpPayload->uuid)> peerUuid = {0, 0, 0, 0, 0x12, 0x34, 0x56, 0x78};
+    memcpy(rxIcmpPayload->uuid, peerUuid.data(), peerUuid.size());
+    processRxFrame(getTxPacketSize());
+    EXPECT_EQ(mLinkProber.getPeerGuidData(), 0x12345678);
+    EXPECT_EQ(selfRtt.getCount(), 1);
+
+    close(sv[0]);
+}
+
+TEST_F(LinkProberTest, ProbePhaseSpread)
+{
+    mMuxConfig.setTimeoutIpv4_msec(100);
+    EXPECT_EQ(getProbeTimerDelay_msec(12345), 100);
+
+    mMuxConfig.enableProbePhaseSpread(true);
+    uint32_t phase_msec = mFakeMuxPort.getMuxPortConfig().getProbePhase_msec(100);
+    EXPECT_LT(phase_msec, 100);
+    for (uint64_t now_msec = 1000; now_msec < 1200; now_msec += 7) {
+        uint32_t delay_msec = getProbeTimerDelay_msec(now_msec);
+        EXPECT_GE(delay_msec, 50);
+        EXPECT_LT(delay_msec, 150);
+        EXPECT_EQ((now_msec + delay_msec) % 100, phase_msec);
+    }
+
+    // ports numbered with a stride are spread over every 10% of the interval
+    std::array<uint32_t, 10> binCount = {0};
+    for (uint16_t serverId = 0; serverId < 128; serverId += 4) {
+        common::MuxPortConfig muxPortConfig(mMuxConfig, "Ethernet" + std::to_string(serverId), serverId,
+            common::MuxPortConfig::PortCableType::ActiveStandby);
+        binCount[muxPortConfig.getProbePhase_msec(100) / 10]++;
+    }
+    for (uint32_t count: binCount) {
+        EXPECT_GE(count, 1);
+        EXPECT_LE(count, 4);
+    }
+
+    mMuxConfig.enableProbePhaseSpread(false);
+    mMuxConfig.setTimeoutIpv4_msec(1);
+}
+
+TEST_F(LinkProberTest, PipelinedHeartbeats)
+{
+    initializeSendBuffer();
+    mMuxConfig.setTimeoutIpv4_msec(50);
+    mMuxConfig.setDetectionTimeoutIpv4_msec(150);
+
+    // heartbeats sent at 0, 50, 100 and 150 msec
+    std::vector<uint16_t> seqNos;
+    for (uint64_t now_msec = 0; now_msec <= 150; now_msec += 50) {
+        reportExpiredHeartbeats(now_msec);
+        handleUpdateSequenceNumber();
+        trackInFlightHeartbeat(now_msec);
+        seqNos.push_back(getTxSeqNo());
+
+        if (now_msec == 50) {
+            // reply to first heartbeat arrives after the second one was sent
+            EXPECT_TRUE(creditInFlightHeartbeat(link_prober::HeartbeatType::HEARTBEAT_SELF, seqNos[0]));
+            EXPECT_FALSE(creditInFlightHeartbeat(link_prober::HeartbeatType::HEARTBEAT_SELF, seqNos[0]));
+        }
+    }
+    EXPECT_EQ(mLinkProber.getLateReplyCount(), 1);
+    EXPECT_TRUE(creditInFlightHeartbeat(link_prober::HeartbeatType::HEARTBEAT_SELF, seqNos[3]));
+
+    // first heartbeat retired at 150 msec was answered, second one at 200 msec was not
+    const link_prober::HeartbeatLossWindow &selfLossWindow = mLinkProber.getLossWindow(link_prober::HeartbeatType::HEARTBEAT_SELF);
+    EXPECT_EQ(selfLossWindow.getStats().sampleCount, 1);
+    EXPECT_EQ(selfLossWindow.getStats().lossCount, 0);
+    expireInFlightHeartbeats(225);
+    EXPECT_EQ(selfLossWindow.getStats().sampleCount, 2);
+    EXPECT_EQ(selfLossWindow.getStats().lossCount, 1);
+    EXPECT_EQ(getIcmpUnknownEventCount(), 1);
+
+    // expired heartbeat is no longer credited
+    EXPECT_FALSE(creditInFlightHeartbeat(link_prober::HeartbeatType::HEARTBEAT_SELF, seqNos[1]));
+
+    expireInFlightHeartbeats(1000);
+    EXPECT_EQ(selfLossWindow.getStats().sampleCount, 4);
+    EXPECT_EQ(selfLossWindow.getStats().lossCount, 2);
+
+    mMuxConfig.setDetectionTimeoutIpv4_msec(0);
+    mMuxConfig.setTimeoutIpv4_msec(1);
+}
+
+TEST_F(LinkProberTest, PipelinedHeartbeatDeadline)
+{
+    initializeSendBuffer();
+    mMuxConfig.setTimeoutIpv4_msec(50);
+    mMuxConfig.setDetectionTimeoutIpv4_msec(120);
+    const link_prober::HeartbeatLossWindow &selfLossWindow = mLinkProber.getLossWindow(link_prober::HeartbeatType::HEARTBEAT_SELF);
+
+    // heartbeats sent at 0, 50 and 100 msec
+    std::vector<uint16_t> seqNos;
+    for (uint64_t now_msec = 0; now_msec <= 100; now_msec += 50) {
+        reportExpiredHeartbeats(now_msec);
+        handleUpdateSequenceNumber();
+        trackInFlightHeartbeat(now_msec);
+        seqNos.push_back(getTxSeqNo());
+    }
+
+    // first heartbeat is not retired before its 120 msec deadline, reply at 110 msec counts
+    EXPECT_EQ(selfLossWindow.getStats().sampleCount, 0);
+    EXPECT_TRUE(creditInFlightHeartbeat(link_prober::HeartbeatType::HEARTBEAT_SELF, seqNos[0]));
+    reportExpiredHeartbeats(150);
+    EXPECT_EQ(selfLossWindow.getStats().sampleCount, 1);
+    EXPECT_EQ(selfLossWindow.getStats().lossCount, 0);
+
+    // longer probing interval turns pipelining off, heartbeats still in flight are reported
+    EXPECT_TRUE(creditInFlightHeartbeat(link_prober::HeartbeatType::HEARTBEAT_SELF, seqNos[2]));
+    mMuxConfig.setTimeoutIpv4_msec(200);
+    reportExpiredHeartbeats(200);
+    EXPECT_EQ(selfLossWindow.getStats().sampleCount, 3);
+    EXPECT_EQ(selfLossWindow.getStats().lossCount, 1);
+
+    // and later heartbeats are reported one per tick
+    handleUpdateSequenceNumber();
+    reportExpiredHeartbeats(400);
+    EXPECT_EQ(selfLossWindow.getStats().sampleCount, 4);
+
+    mMuxConfig.setDetectionTimeoutIpv4_msec(0);
+    mMuxConfig.setTimeoutIpv4_msec(1);
+}
+
+TEST_F(LinkProberTest, PipelinedHeartbeatTimeoutClamp)
+{
+    initializeSendBuffer();
+    mMuxConfig.setTimeoutIpv4_msec(10);
+    mMuxConfig.setDetectionTimeoutIpv4_msec(1000);
+    const link_prober::HeartbeatLossWindow &selfLossWindow = mLinkProber.getLossWindow(link_prober::HeartbeatType::HEARTBEAT_SELF);
+
+    // in-flight window holds heartbeats of 7 intervals
+    EXPECT_EQ(getInFlightTimeout_msec(), 70);
+
+    // heartbeats are retired at their clamped deadline, never early because the window is full
+    for (uint64_t now_msec = 0; now_msec <= 150; now_msec += 10) {
+        reportExpiredHeartbeats(now_msec);
+        EXPECT_EQ(selfLossWindow.getStats().sampleCount, now_msec < 70 ? 0 : (now_msec - 70) / 10 + 1);
+        handleUpdateSequenceNumber();
+        trackInFlightHeartbeat(now_msec);
+    }
+
+    mMuxConfig.setTimeoutIpv4_msec(200);
+    EXPECT_EQ(getInFlightTimeout_msec(), 1000);
+
+    mMuxConfig.setDetectionTimeoutIpv4_msec(0);
+    mMuxConfig.setTimeoutIpv4_msec(1);
+}
+
+TEST_F(LinkProberTest, PipelinedPeerHeartbeats)
+{
+    common::MuxPortConfig &muxPortConfig = const_cast<common::MuxPortConfig &> (mFakeMuxPort.getMuxPortConfig());
+    muxPortConfig.setBladeIpv4Address(boost::asio::ip::address::from_string(mSmartNicIpAddress));
+    regenerateSelfGuid();
+    initializeSendBuffer();
+    setRxRingEnabled(true);
+    mMuxConfig.setTimeoutIpv4_msec(50);
+    mMuxConfig.setDetectionTimeoutIpv4_msec(150);
+
+    uint32_t selfReplyCount = 0;
+    uint32_t peerReplyCount = 0;
+    setReportHeartbeatReplyReceivedFuncPtr([&selfReplyCount, &peerReplyCount] (link_prober::HeartbeatType heartbeatType) {
+        heartbeatType == link_prober::HeartbeatType::HEARTBEAT_SELF ? selfReplyCount++ : peerReplyCount++;
+    });
+
+    for (uint64_t now_msec = 0; now_msec <= 50; now_msec += 50) {
+        handleUpdateSequenceNumber();
+        trackInFlightHeartbeat(now_msec);
+    }
+
+    // peer ToR heartbeat carries the peer sequence number, unrelated to ours
+    size_t frameSize = getTxPacketSize();
+    memcpy(getRxBufferData(), getTxBufferData(), frameSize);
+    icmphdr *icmpHeader = reinterpret_cast<icmphdr *> (getRxBufferData() + sizeof(ether_header) + sizeof(iphdr));
+    link_prober::IcmpPayload *icmpPayload = reinterpret_cast<link_prober::IcmpPayload *> (
+        getRxBufferData() + sizeof(ether_header) + sizeof(iphdr) + sizeof(icmphdr)
+    );
+    icmpHeader->type = ICMP_ECHOREPLY;
+    icmpHeader->un.echo.sequence = htons(static_cast<uint16_t> (getTxSeqNo() + 0x4000));
+    std::array<uint8_t, sizeof(icmpPayload->uuid)> peerUuid = {0, 0, 0, 0, 0x12, 0x34, 0x56, 0x78};
+    memcpy(icmpPayload->uuid, peerUuid.data(), peerUuid.size());
+    processRxFrame(frameSize);
+    EXPECT_EQ(peerReplyCount, 1);
+    EXPECT_EQ(selfReplyCount, 0);
+
+    // duplicate peer heartbeat within the same interval is credited once
+    processRxFrame(frameSize);
+    EXPECT_EQ(peerReplyCount, 1);
+
+    // peer reply is credited to the newest heartbeat, the older one is lost
+    const link_prober::HeartbeatLossWindow &peerLossWindow = mLinkProber.getLossWindow(link_prober::HeartbeatType::HEARTBEAT_PEER);
+    expireInFlightHeartbeats(1000);
+    EXPECT_EQ(peerLossWindow.getStats().sampleCount, 2);
+    EXPECT_EQ(peerLossWindow.getStats().lossCount, 1);
+    EXPECT_EQ(mLinkProber.getLateReplyCount(), 0);
+
+    mMuxConfig.setDetectionTimeoutIpv4_msec(0);
+    mMuxConfig.setTimeoutIpv4_msec(1);
+}
+
+TEST_F(LinkProberTest, ResetIcmpPacketCountsOnProberStrand)
+{
+    initializeSendBuffer();
+    mMuxConfig.setTimeoutIpv4_msec(50);
+    mMuxConfig.setDetectionTimeoutIpv4_msec(150);
+
+    handleUpdateSequenceNumber();
+    trackInFlightHeartbeat(0);
+    expireInFlightHeartbeats(1000);
+    const link_prober::HeartbeatLossWindow &selfLossWindow = mLinkProber.getLossWindow(link_prober::HeartbeatType::HEARTBEAT_SELF);
+    EXPECT_EQ(selfLossWindow.getStats().lossCount, 1);
+    EXPECT_EQ(getIcmpUnknownEventCount(), 1);
+
+    // reset requested from link manager strand runs on the prober strand
+    mLinkProber.resetIcmpPacketCounts();
+    EXPECT_EQ(selfLossWindow.getStats().lossCount, 1);
+    EXPECT_EQ(getIcmpUnknownEventCount(), 1);
+
+    mIoService.poll();
+    EXPECT_EQ(selfLossWindow.getStats().sampleCount, 0);
+    EXPECT_EQ(selfLossWindow.getStats().lossCount, 0);
+    EXPECT_EQ(getIcmpUnknownEventCount(), 0);
+
+    mMuxConfig.setDetectionTimeoutIpv4_msec(0);
+    mMuxConfig.setTimeoutIpv4_msec(1);
+}
+
+TEST_F(LinkProberTest, AdaptiveProbeInterval)
+{
+    mMuxConfig.setTimeoutIpv4_msec(100);
+    mMuxConfig.setStableHeartbeatCount(10);
+    common::MuxPortConfig &muxPortConfig = const_cast<common::MuxPortConfig &> (mFakeMuxPort.getMuxPortConfig());
+    // active-active port whose peer ToR is not up
+    muxPortConfig.setPortCableType(common::MuxPortConfig::PortCableType::ActiveActive);
+
+    // interval is fixed without upper bound
+    for (int i = 0; i < 20; i++) {
+        updateAdaptiveProbeInterval(true);
+    }
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 100);
+
+    // interval doubles after each run of stable heartbeats, up to upper bound
+    mMuxConfig.setMaxTimeoutIpv4_msec(300);
+    for (int i = 0; i < 9; i++) {
+        updateAdaptiveProbeInterval(true);
+    }
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 100);
+    updateAdaptiveProbeInterval(true);
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 200);
+    for (int i = 0; i < 20; i++) {
+        updateAdaptiveProbeInterval(true);
+    }
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 300);
+
+    // first missed heartbeat snaps back to fast interval
+    updateAdaptiveProbeInterval(false);
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 100);
+    EXPECT_EQ(mLinkProber.getStableProbeCount(), 0);
+
+    // manual mode relaxes at once, even on missed heartbeats
+    muxPortConfig.setMode(common::MuxPortConfig::Mode::Manual);
+    updateAdaptiveProbeInterval(false);
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 300);
+
+    // mux config change snaps back
+    muxPortConfig.setMode(common::MuxPortConfig::Mode::Auto);
+    mLinkProber.resetProbeInterval();
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 100);
+
+    // switchover keeps decreased interval
+    for (int i = 0; i < 10; i++) {
+        updateAdaptiveProbeInterval(true);
+    }
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 200);
+    mLinkProber.decreaseProbeIntervalAfterSwitch(1000);
+    EXPECT_EQ(mLinkProber.getProbingInterval(), mMuxConfig.getDecreasedTimeoutIpv4_msec());
+    mLinkProber.revertProbeIntervalAfterSwitchComplete();
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 100);
+
+    // heartbeat from peer ToR snaps back, peer now watches our heartbeats
+    for (int i = 0; i < 10; i++) {
+        updateAdaptiveProbeInterval(true);
+    }
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 200);
+    mLinkProber.setPeerGuidData(0x12345678);
+    updateAdaptiveProbeInterval(true);
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 100);
+    for (int i = 0; i < 20; i++) {
+        updateAdaptiveProbeInterval(true);
+    }
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 100);
+
+    // detached mode keeps fast interval while peer ToR watches our heartbeats
+    muxPortConfig.setMode(common::MuxPortConfig::Mode::Detached);
+    updateAdaptiveProbeInterval(true);
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 100);
+
+    // and relaxes at once without peer
+    mLinkProber.setPeerGuidData(0);
+    updateAdaptiveProbeInterval(true);
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 300);
+    muxPortConfig.setMode(common::MuxPortConfig::Mode::Auto);
+    mLinkProber.resetProbeInterval();
+
+    // standby ToR of active-standby port watches our heartbeats
+    muxPortConfig.setPortCableType(common::MuxPortConfig::PortCableType::ActiveStandby);
+    for (int i = 0; i < 20; i++) {
+        updateAdaptiveProbeInterval(true);
+    }
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 100);
+
+    mMuxConfig.setMaxTimeoutIpv4_msec(0);
+    mMuxConfig.setStableHeartbeatCount(100);
+    mMuxConfig.setTimeoutIpv4_msec(1);
+}
+
+TEST_F(LinkProberTest, AdaptiveProbeIntervalManualActiveStandby)
+{
+    mMuxConfig.setTimeoutIpv4_msec(100);
+    mMuxConfig.setMaxTimeoutIpv4_msec(800);
+    mMuxConfig.setStableHeartbeatCount(3);
+    common::MuxPortConfig &muxPortConfig = const_cast<common::MuxPortConfig &> (mFakeMuxPort.getMuxPortConfig());
+    muxPortConfig.setMode(common::MuxPortConfig::Mode::Manual);
+
+    // auto mode standby ToR takes the mux once our heartbeats go missing, whatever our mode is
+    for (int i = 0; i < 20; i++) {
+        updateAdaptiveProbeInterval(true);
+        EXPECT_EQ(mLinkProber.getProbingInterval(), 100);
+    }
+    updateAdaptiveProbeInterval(false);
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 100);
+
+    muxPortConfig.setMode(common::MuxPortConfig::Mode::Auto);
+    mMuxConfig.setMaxTimeoutIpv4_msec(0);
+    mMuxConfig.setStableHeartbeatCount(100);
+    mMuxConfig.setTimeoutIpv4_msec(1);
+}
+
+TEST_F(LinkProberTest, AdaptiveProbeIntervalTwoTors)
+{
+    common::MuxPortConfig &muxPortConfig = const_cast<common::MuxPortConfig &> (mFakeMuxPort.getMuxPortConfig());
+    muxPortConfig.setBladeIpv4Address(boost::asio::ip::address::from_string(mSmartNicIpAddress));
+    regenerateSelfGuid();
+    initializeSendBuffer();
+    setRxRingEnabled(true);
+    mMuxConfig.setTimeoutIpv4_msec(100);
+    mMuxConfig.setMaxTimeoutIpv4_msec(800);
+    mMuxConfig.setStableHeartbeatCount(3);
+
+    // standby ToR probes at interval_v4 and judges our heartbeats at each of its own heartbeats
+    common::MuxConfig peerMuxConfig;
+    peerMuxConfig.setTimeoutIpv4_msec(100);
+    std::string peerPortName = mPortName;
+    FakeMuxPort peerMuxPort(mDbInterfacePtr, peerMuxConfig, peerPortName, mServerId, mIoService);
+    common::MuxPortConfig &peerMuxPortConfig = const_cast<common::MuxPortConfig &> (peerMuxPort.getMuxPortConfig());
+    peerMuxPortConfig.setBladeIpv4Address(boost::asio::ip::address::from_string(mSmartNicIpAddress));
+    link_prober::LinkProberSw peerLinkProber(peerMuxPortConfig, mIoService, peerMuxPort.getLinkProberStateMachinePtr());
+    peerLinkProber.setSelfGuidData(0x12345678);
+
+    // server echoes our heartbeats to both ToRs, mux drops heartbeats of standby ToR
+    size_t frameSize = getTxPacketSize();
+    std::vector<uint8_t> frame(getTxBufferData(), getTxBufferData() + frameSize);
+    icmphdr *icmpHeader = reinterpret_cast<icmphdr *> (frame.data() + sizeof(ether_header) + sizeof(iphdr));
+    icmpHeader->type = ICMP_ECHOREPLY;
+
+    uint64_t nextTx_msec = 0;
+    uint64_t nextPeerTx_msec = 0;
+    for (uint64_t now_msec = 0; now_msec < 10000; now_msec++) {
+        if (now_msec == nextTx_msec) {
+            reportHeartbeatOutcome(mLinkProber);
+            handleUpdateSequenceNumber();
+            processRxFrame(mLinkProber, frame.data(), frameSize);
+            processRxFrame(peerLinkProber, frame.data(), frameSize);
+            nextTx_msec += mLinkProber.getProbingInterval();
+        }
+        if (now_msec == nextPeerTx_msec) {
+            reportHeartbeatOutcome(peerLinkProber);
+            handleUpdateSequenceNumber(peerLinkProber);
+            nextPeerTx_msec += peerLinkProber.getProbingInterval();
+        }
+    }
+
+    // stable heartbeats are not relaxed, standby ToR never misses a heartbeat of active ToR
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 100);
+    const link_prober::HeartbeatLossWindow &peerLossWindow = peerLinkProber.getLossWindow(link_prober::HeartbeatType::HEARTBEAT_PEER);
+    EXPECT_EQ(peerLossWindow.getStats().sampleCount, 100);
+    EXPECT_EQ(peerLossWindow.getStats().lossCount, 0);
+    EXPECT_LT(peerLossWindow.getStats().longestBurst, mMuxConfig.getNegativeStateChangeRetryCount());
+
+    mMuxConfig.setMaxTimeoutIpv4_msec(0);
+    mMuxConfig.setStableHeartbeatCount(100);
+    mMuxConfig.setTimeoutIpv4_msec(1);
+}
+
+TEST_F(LinkProberTest, ProbeBudgetPeerTolerance)
+{
+    mMuxConfig.setTimeoutIpv4_msec(100);
+    common::MuxPortConfig &muxPortConfig = const_cast<common::MuxPortConfig &> (mFakeMuxPort.getMuxPortConfig());
+    muxPortConfig.setMaxProbeInterval_msec(1000);
+    link_prober::LinkProberBudgetPtr budgetPtr = link_prober::LinkProberBudget::getInstance();
+    budgetPtr->setMaxProbeRate(1);
+
+    // standby ToR acts after negative_signal_count missed heartbeats, keep one of margin
+    updateProbeBudget();
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 100 * (mMuxConfig.getNegativeStateChangeRetryCount() - 1));
+    EXPECT_TRUE(budgetPtr->isOverBudget());
+
+    // manual and detached mode ports ask for their slowest interval, still bound by peer ToR
+    muxPortConfig.setMode(common::MuxPortConfig::Mode::Manual);
+    updateProbeBudget();
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 100 * (mMuxConfig.getNegativeStateChangeRetryCount() - 1));
+    muxPortConfig.setMode(common::MuxPortConfig::Mode::Detached);
+    updateProbeBudget();
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 100 * (mMuxConfig.getNegativeStateChangeRetryCount() - 1));
+
+    // link down port is throttled to its slowest interval
+    muxPortConfig.setLinkUp(false);
+    updateProbeBudget();
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 1000);
+    muxPortConfig.setLinkUp(true);
+
+    // active-active port is only bound by peer ToR once peer heartbeats are received
+    muxPortConfig.setPortCableType(common::MuxPortConfig::PortCableType::ActiveActive);
+    updateProbeBudget();
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 1000);
+    muxPortConfig.setMode(common::MuxPortConfig::Mode::Auto);
+    updateProbeBudget();
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 1000);
+    mLinkProber.setPeerGuidData(0x12345678);
+    updateProbeBudget();
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 100 * (mMuxConfig.getNegativeStateChangeRetryCount() - 1));
+
+    // peer ToR acting on a single missed heartbeat leaves no room for throttling
+    uint32_t negativeCount = mMuxConfig.getNegativeStateChangeRetryCount();
+    mMuxConfig.setNegativeStateChangeRetryCount(1);
+    updateProbeBudget();
+    EXPECT_EQ(mLinkProber.getProbingInterval(), 100);
+
+    mMuxConfig.setNegativeStateChangeRetryCount(negativeCount);
+    budgetPtr->setMaxProbeRate(0);
+    mMuxConfig.setTimeoutIpv4_msec(1);
+}
+
+TEST_F(LinkProberTest, LowLatencyRx)
+{
+    common::MuxPortConfig &muxPortConfig = const_cast<common::MuxPortConfig &> (mFakeMuxPort.getMuxPortConfig());
+    muxPortConfig.setBladeIpv4Address(boost::asio::ip::address::from_string(mSmartNicIpAddress));
+    regenerateSelfGuid();
+    initializeSendBuffer();
+
+    uint32_t selfReplyCount = 0;
+    setReportHeartbeatReplyReceivedFuncPtr([&selfReplyCount] (link_prober::HeartbeatType heartbeatType) {
+        if (heartbeatType == link_prober::HeartbeatType::HEARTBEAT_SELF) {
+            selfReplyCount++;
+        }
+    });
+
+    size_t frameSize = getTxPacketSize();
+    icmphdr *icmpHeader = reinterpret_cast<icmphdr *> (getTxBufferData() + sizeof(ether_header) + sizeof(iphdr));
+    icmpHeader->type = ICMP_ECHOREPLY;
+
+    int sv[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_DGRAM, 0, sv), 0);
+    assignRxSocket(sv[1]);
+
+    // config change is picked up at next heartbeat
+    link_prober::LinkProberBusyPollPtr busyPollPtr = link_prober::LinkProberBusyPoll::getInstance();
+    muxPortConfig.setLowLatencyRx(true);
+    EXPECT_FALSE(mLinkProber.isLowLatencyRxEnabled());
+    updateRxMode();
+    EXPECT_TRUE(mLinkProber.isLowLatencyRxEnabled());
+    EXPECT_EQ(busyPollPtr->getLinkProberCount(), 1);
+
+    // reply is received on the busy poll thread and processed on the link prober strand
+    uint64_t frameCount = busyPollPtr->getFrameCount();
+    ASSERT_EQ(send(sv[0], getTxBufferData(), frameSize, 0), static_cast<ssize_t> (frameSize));
+    for (int i = 0; i < 1000 && busyPollPtr->getFrameCount() == frameCount; i++) {
+        usleep(1000);
+    }
+    EXPECT_EQ(busyPollPtr->getFrameCount(), frameCount + 1);
+    EXPECT_EQ(selfReplyCount, 0);
+    mIoService.poll();
+    mIoService.restart();
+    EXPECT_EQ(selfReplyCount, 1);
+    EXPECT_EQ(mLinkProber.getRxLatencyHistogram().getCount(), 1);
+
+    // reception moves back to io_service and latency samples restart
+    muxPortConfig.setLowLatencyRx(false);
+    updateRxMode();
+    EXPECT_FALSE(mLinkProber.isLowLatencyRxEnabled());
+    EXPECT_EQ(busyPollPtr->getLinkProberCount(), 0);
+    EXPECT_EQ(mLinkProber.getRxLatencyHistogram().getCount(), 0);
+
+    ASSERT_EQ(send(sv[0], getTxBufferData(), frameSize, 0), static_cast<ssize_t> (frameSize));
+    mIoService.run_one();
+    EXPECT_EQ(selfReplyCount, 2);
+    EXPECT_EQ(mLinkProber.getRxLatencyHistogram().getCount(), 1);
+
+    busyPollPtr->deinitialize();
+    close(sv[0]);
+}
+
+TEST_F(LinkProberTest, RxFanoutDispatchFrame)
+{
+    common::MuxPortConfig &muxPortConfig = const_cast<common::MuxPortConfig &> (mFakeMuxPort.getMuxPortConfig());
+    muxPortConfig.setBladeIpv4Address(boost::asio::ip::address::from_string(mSmartNicIpAddress));
+    regenerateSelfGuid();
+    initializeSendBuffer();
+
+    uint32_t selfReplyCount = 0;
+    setReportHeartbeatReplyReceivedFuncPtr([&selfReplyCount] (link_prober::HeartbeatType heartbeatType) {
+        if (heartbeatType == link_prober::HeartbeatType::HEARTBEAT_SELF) {
+            selfReplyCount++;
+        }
+    });
+
+    size_t frameSize = getTxPacketSize();
+    std::vector<uint8_t> frame(getTxBufferData(), getTxBufferData() + frameSize);
+    iphdr *ipHeader = reinterpret_cast<iphdr *> (frame.data() + sizeof(ether_header));
+    icmphdr *icmpHeader = reinterpret_cast<icmphdr *> (frame.data() + sizeof(ether_header) + sizeof(iphdr));
+    ipHeader->saddr = htonl(muxPortConfig.getBladeIpv4Address().to_v4().to_uint());
+    icmpHeader->type = ICMP_ECHOREPLY;
+    uint64_t rxTimestamp = std::chrono::duration_cast<std::chrono::nanoseconds> (
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+
+    // interface 1001 is owned by worker 1 of 2
+    const int ifIndex = 1001;
+    setupRxFanoutWorkers(2);
+    link_prober::LinkProberRxFanoutPtr rxFanoutPtr = link_prober::LinkProberRxFanout::getInstance();
+
+    // frames of unknown interfaces are dropped
+    dispatchRxFanoutFrame(1, ifIndex, frame.data(), frameSize, rxTimestamp);
+    EXPECT_EQ(selfReplyCount, 0);
+
+    // owning worker processes frames of link probers running on it inline
+    rxFanoutPtr->registerLinkProber(ifIndex, &mLinkProber, getRxFanoutWorkerIoService(1));
+    dispatchRxFanoutFrame(1, ifIndex, frame.data(), frameSize, rxTimestamp);
+    EXPECT_EQ(selfReplyCount, 1);
+    EXPECT_EQ(rxFanoutPtr->getWorkerForwardedFrameCount(1), 0);
+    EXPECT_EQ(rxFanoutPtr->getWorkerLatencyHistogram(1).getCount(), 1);
+
+    // hash and cpu modes may land frames on other workers, they are forwarded to the owner
+    dispatchRxFanoutFrame(0, ifIndex, frame.data(), frameSize, rxTimestamp);
+    EXPECT_EQ(selfReplyCount, 1);
+    EXPECT_EQ(rxFanoutPtr->getWorkerForwardedFrameCount(0), 1);
+    getRxFanoutWorkerIoService(1).poll();
+    EXPECT_EQ(selfReplyCount, 2);
+    EXPECT_EQ(rxFanoutPtr->getWorkerLatencyHistogram(1).getCount(), 2);
+
+    // link probers outside of workers get frames on their strand
+    rxFanoutPtr->registerLinkProber(ifIndex, &mLinkProber, mIoService);
+    dispatchRxFanoutFrame(1, ifIndex, frame.data(), frameSize, rxTimestamp);
+    EXPECT_EQ(selfReplyCount, 2);
+    EXPECT_EQ(rxFanoutPtr->getWorkerForwardedFrameCount(1), 1);
+    mIoService.poll();
+    EXPECT_EQ(selfReplyCount, 3);
+
+    rxFanoutPtr->unregisterLinkProber(ifIndex, &mLinkProber);
+    setupRxFanoutWorkers(0);
+}
+
 TEST_F(LinkProberTest, InitializeException)
 {
     EXPECT_THROW(initialize(), common::SocketErrorException);
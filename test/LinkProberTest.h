@@ -28,6 +28,11 @@
 
 #include "FakeMuxPort.h"
 #include "link_prober/LinkProberSw.h"
+#include "link_prober/LinkProberBudget.h"
+#include "link_prober/LinkProberBusyPoll.h"
+#include "link_prober/LinkProberRxFanout.h"
+#include "link_prober/LinkProberRxRing.h"
+#include "link_prober/LinkProberTxBatcher.h"
 
 namespace test
 {
@@ -42,6 +47,7 @@ public:
     void initializeSendBuffer() {mLinkProber.initializeSendBuffer();};
     void handleUpdateEthernetFrame() {mLinkProber.handleUpdateEthernetFrame();};
     void handleUpdateSequenceNumber() {mLinkProber.updateIcmpSequenceNo();};
+    void handleUpdateSequenceNumber(link_prober::LinkProberSw &linkProber) {linkProber.updateIcmpSequenceNo();};
     void handleSuspendTxProbes() {mLinkProber.suspendTxProbes(300);};
     void handleSendHeartbeat() {mLinkProber.sendHeartbeat();};
     void resetTxBufferTlv() {mLinkProber.resetTxBufferTlv();};
@@ -50,9 +56,13 @@ public:
     size_t appendTlvSentinel();
     size_t appendTlvDummy(size_t paddingSize, int seqNo);
     size_t findNextTlv(size_t readOffset, size_t bytesTransferred);
-    std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE>& getTxBuffer() {return mLinkProber.getTxBuffer();};
+    link_prober::PacketBuffer& getTxBuffer() {return mLinkProber.getTxBuffer();};
     uint8_t *getTxBufferData() {return mLinkProber.mTxBuffer.data();};
     uint8_t *getRxBufferData() {return mLinkProber.mRxBuffer.data();};
+    bool isRxJumboEnabled() {return mLinkProber.mRxJumboEnabled;};
+    void setRxJumboEnabled(bool enabled) {mLinkProber.mRxJumboEnabled = enabled;};
+    uint64_t getRxTruncatedFrameCount() {return mLinkProber.mRxTruncatedFrameCount;};
+    size_t drainRecv() {return mLinkProber.drainRecv();};
 
     uint16_t getRxSelfSeqNo() {return mLinkProber.mRxSelfSeqNo;};
     uint16_t getRxPeerSeqNo() {return mLinkProber.mRxPeerSeqNo;};
@@ -60,6 +70,61 @@ public:
     void initTxBufferTlvSendSwitch() {mLinkProber.initTxBufferTlvSendSwitch();}
     void initTxBufferTlvSendProbe() {mLinkProber.initTxBufferTlvSendProbe();}
     void initTxBufferSentinel() {mLinkProber.initTxBufferTlvSentinel();}
+    void calculateTxPacketChecksum() {mLinkProber.calculateTxPacketChecksum();}
+    void dispatchRxRingBlock(tpacket_block_desc *blockDesc, std::shared_ptr<void> blockRef) {
+        link_prober::LinkProberRxRing::getInstance()->dispatchBlock(blockDesc, blockRef);
+    };
+    void setupTxBatcher(int socket) {
+        link_prober::LinkProberTxBatcher::getInstance()->setup(mIoService, socket);
+        mLinkProber.mTxBatchEnabled = true;
+    };
+    const uint8_t *getTxBatchFlushFrameData(size_t index) {
+        return link_prober::LinkProberTxBatcher::getInstance()->mFlushFrames[index].data.data();
+    };
+    uint64_t getTxErrorCount() {return mLinkProber.mTxErrorCount;};
+    link_prober::IcmpFilterIdentity getIcmpFilterIdentity() {return mLinkProber.getIcmpFilterIdentity();};
+    void processRxFrame(size_t bytesTransferred) {mLinkProber.processRxFrame(bytesTransferred);};
+    void processRxFrame(link_prober::LinkProberSw &linkProber, const uint8_t *frame, size_t size) {
+        memcpy(linkProber.mRxBuffer.data(), frame, size);
+        linkProber.processRxFrame(size);
+    };
+    void reportHeartbeatOutcome(link_prober::LinkProberSw &linkProber) {linkProber.reportHeartbeatOutcome();};
+    void handleRecv() {mLinkProber.handleRecv(boost::system::error_code());};
+    void updateIcmpTxTimestamp() {mLinkProber.updateIcmpTxTimestamp();};
+    void assignRxSocket(int socket) {mLinkProber.mSocket = socket; mLinkProber.mStream.assign(socket);};
+    void setRxRingEnabled(bool enabled) {mLinkProber.mRxRingEnabled = enabled;};
+    void setReportHeartbeatReplyReceivedFuncPtr(boost::function<void (link_prober::HeartbeatType heartbeatType)> funcPtr) {
+        mLinkProber.mReportHeartbeatReplyReceivedFuncPtr = funcPtr;
+    };
+    uint32_t getProbeTimerDelay_msec(uint64_t now_msec) {return mLinkProber.getProbeTimerDelay_msec(now_msec);};
+    void trackInFlightHeartbeat(uint64_t now_msec) {mLinkProber.trackInFlightHeartbeat(now_msec);};
+    void expireInFlightHeartbeats(uint64_t now_msec) {mLinkProber.expireInFlightHeartbeats(now_msec);};
+    void reportExpiredHeartbeats(uint64_t now_msec) {mLinkProber.reportExpiredHeartbeats(now_msec);};
+    uint32_t getInFlightTimeout_msec() {return mLinkProber.getInFlightTimeout_msec();};
+    bool creditInFlightHeartbeat(link_prober::HeartbeatType heartbeatType, uint16_t seqNo) {
+        return mLinkProber.creditInFlightHeartbeat(heartbeatType, seqNo);
+    };
+    uint16_t getTxSeqNo() {return mLinkProber.mTxSeqNo;};
+    uint64_t getIcmpUnknownEventCount() {return mLinkProber.mIcmpUnknownEventCount;};
+    void updateAdaptiveProbeInterval(bool heartbeatReceived) {mLinkProber.updateAdaptiveProbeInterval(heartbeatReceived);};
+    void updateProbeBudget() {mLinkProber.updateProbeBudget();};
+    void regenerateSelfGuid() {mLinkProber.setSelfGuidData(mLinkProber.generateGuid());};
+    void updateRxMode() {mLinkProber.updateRxMode();};
+    void setupRxFanoutWorkers(size_t workerCount) {
+        link_prober::LinkProberRxFanoutPtr rxFanoutPtr = link_prober::LinkProberRxFanout::getInstance();
+        rxFanoutPtr->mWorkers.clear();
+        for (size_t i = 0; i < workerCount; i++) {
+            rxFanoutPtr->mWorkers.emplace_back(new link_prober::LinkProberRxFanout::Worker(i));
+        }
+    };
+    boost::asio::io_service& getRxFanoutWorkerIoService(size_t workerIndex) {
+        return link_prober::LinkProberRxFanout::getInstance()->mWorkers[workerIndex]->ioService;
+    };
+    void dispatchRxFanoutFrame(size_t workerIndex, int ifIndex, uint8_t *frame, size_t size, uint64_t rxTimestamp) {
+        link_prober::LinkProberRxFanoutPtr rxFanoutPtr = link_prober::LinkProberRxFanout::getInstance();
+        std::shared_lock<std::shared_mutex> lock(rxFanoutPtr->mLinkProberMapMutex);
+        rxFanoutPtr->dispatchFrame(*rxFanoutPtr->mWorkers[workerIndex], ifIndex, frame, size, rxTimestamp);
+    };
 
     void simulateBadFileDescriptor() {
         throw boost::system::system_error(make_error_code(boost::system::errc::bad_file_descriptor));
@@ -0,0 +1,125 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * MetricsSlotTableTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <atomic>
+#include <thread>
+
+#include "MetricsSlotTableTest.h"
+
+namespace test
+{
+
+size_t MetricsSlotTableTest::collect()
+{
+    mCollected.clear();
+    return mSlotTable.collect([this] (const std::string &portName, mux::MetricsSlot slot, const mux::MetricsSlotValues &values) {
+        EXPECT_EQ(mCollected.count({portName, slot}), 0);
+        mCollected[{portName, slot}] = values;
+    });
+}
+
+TEST_F(MetricsSlotTableTest, LatestValueWins)
+{
+    for (uint64_t i = 1; i <= 100; i++) {
+        EXPECT_TRUE(mSlotTable.store("Ethernet0", mux::MetricsSlot::PckLossRatio, {i, 10 * i}));
+    }
+    EXPECT_TRUE(mSlotTable.store("Ethernet0", mux::MetricsSlot::ProbeInterval, {100}));
+    EXPECT_TRUE(mSlotTable.store("Ethernet4", mux::MetricsSlot::MuxLinkmgrState, {1}));
+
+    EXPECT_EQ(collect(), 3);
+    EXPECT_EQ(mCollected[std::make_pair(std::string("Ethernet0"), mux::MetricsSlot::PckLossRatio)][0], 100);
+    EXPECT_EQ(mCollected[std::make_pair(std::string("Ethernet0"), mux::MetricsSlot::PckLossRatio)][1], 1000);
+    EXPECT_EQ(mCollected[std::make_pair(std::string("Ethernet0"), mux::MetricsSlot::ProbeInterval)][0], 100);
+    EXPECT_EQ(mCollected[std::make_pair(std::string("Ethernet4"), mux::MetricsSlot::MuxLinkmgrState)][0], 1);
+    EXPECT_EQ(mSlotTable.getStoreCount(), 102);
+    EXPECT_EQ(mSlotTable.getCollectCount(), 3);
+}
+
+TEST_F(MetricsSlotTableTest, OnlyDirtySlotsCollected)
+{
+    EXPECT_TRUE(mSlotTable.store("Ethernet0", mux::MetricsSlot::PckLossRatio, {1}));
+    EXPECT_TRUE(mSlotTable.store("Ethernet0", mux::MetricsSlot::ProbeInterval, {100}));
+    EXPECT_EQ(collect(), 2);
+    EXPECT_EQ(collect(), 0);
+
+    EXPECT_TRUE(mSlotTable.store("Ethernet0", mux::MetricsSlot::ProbeInterval, {200}));
+    EXPECT_EQ(collect(), 1);
+    EXPECT_EQ(mCollected.begin()->first.second, mux::MetricsSlot::ProbeInterval);
+    EXPECT_EQ(mCollected.begin()->second[0], 200);
+}
+
+TEST_F(MetricsSlotTableTest, TableFull)
+{
+    for (size_t i = 0; i < MUX_METRICS_SLOT_PORT_COUNT; i++) {
+        EXPECT_TRUE(mSlotTable.store("Ethernet" + std::to_string(i), mux::MetricsSlot::ProbeInterval, {i}));
+    }
+    EXPECT_FALSE(mSlotTable.store("Ethernet" + std::to_string(MUX_METRICS_SLOT_PORT_COUNT), mux::MetricsSlot::ProbeInterval, {0}));
+
+    // ports already in the table keep their entry
+    EXPECT_TRUE(mSlotTable.store("Ethernet7", mux::MetricsSlot::ProbeInterval, {70}));
+    EXPECT_EQ(collect(), MUX_METRICS_SLOT_PORT_COUNT);
+    EXPECT_EQ(mCollected[std::make_pair(std::string("Ethernet7"), mux::MetricsSlot::ProbeInterval)][0], 70);
+}
+
+TEST_F(MetricsSlotTableTest, ConcurrentProducers)
+{
+    // every store writes the same value to all fields, a torn copy would mix two stores
+    const uint64_t storeCount = 200000;
+    std::atomic<bool> done(false);
+    auto producer = [this] (const std::string &portName) {
+        for (uint64_t i = 1; i <= storeCount; i++) {
+            mux::MetricsSlotValues values;
+            values.fill(i);
+            mSlotTable.store(portName, mux::MetricsSlot::PckLossRatio, values);
+        }
+    };
+    std::thread producer0(producer, "Ethernet0");
+    std::thread producer1(producer, "Ethernet0");
+    std::thread producer2(producer, "Ethernet4");
+
+    std::map<std::string, uint64_t> latestValues;
+    auto flush = [&latestValues] (const std::string &portName, mux::MetricsSlot slot, const mux::MetricsSlotValues &values) {
+        for (uint64_t value: values) {
+            EXPECT_EQ(value, values[0]);
+        }
+        latestValues[portName] = values[0];
+    };
+    std::thread flusher([this, &done, &flush] () {
+        while (!done.load()) {
+            mSlotTable.collect(flush);
+        }
+    });
+
+    producer0.join();
+    producer1.join();
+    producer2.join();
+    done = true;
+    flusher.join();
+    mSlotTable.collect(flush);
+
+    EXPECT_EQ(mSlotTable.getStoreCount(), 3 * storeCount);
+    EXPECT_EQ(latestValues.size(), 2);
+    EXPECT_EQ(latestValues["Ethernet0"], storeCount);
+    EXPECT_EQ(latestValues["Ethernet4"], storeCount);
+}
+
+} /* namespace test */
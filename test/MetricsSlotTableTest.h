@@ -0,0 +1,50 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * MetricsSlotTableTest.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef METRICSSLOTTABLETEST_H_
+#define METRICSSLOTTABLETEST_H_
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "MetricsSlotTable.h"
+
+namespace test
+{
+
+class MetricsSlotTableTest: public ::testing::Test
+{
+public:
+    MetricsSlotTableTest() = default;
+    virtual ~MetricsSlotTableTest() = default;
+
+    size_t collect();
+
+    mux::MetricsSlotTable mSlotTable;
+    std::map<std::pair<std::string, mux::MetricsSlot>, mux::MetricsSlotValues> mCollected;
+};
+
+} /* namespace test */
+
+#endif /* METRICSSLOTTABLETEST_H_ */
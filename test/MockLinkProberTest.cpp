@@ -108,7 +108,7 @@ void LinkProberMockTest::runIoService(uint32_t count)
 
 void LinkProberMockTest::buildIcmpReply()
 {
-    memcpy(mBuffer.data(), getTxBuffer().data(), mBuffer.size());
+    memcpy(mBuffer.data(), getTxBuffer().data(), getTxBuffer().size());
     ether_header *txEtherHeader = reinterpret_cast<ether_header *>(getTxBuffer().data());
     ether_header *rxEtherHeader = reinterpret_cast<ether_header *>(mBuffer.data());
     memcpy(rxEtherHeader->ether_shost, txEtherHeader->ether_dhost, sizeof(rxEtherHeader->ether_shost));
@@ -138,9 +138,7 @@ void LinkProberMockTest::receivePeerIcmpReply()
         getRxBuffer().data() + getPacketHeaderSize()
     );
     memcpy(icmpPayload->uuid, PeerGuid.data, sizeof(icmpPayload->uuid));
-    std::string tempGuid;
-    mLinkProberPtr->getGuidStr(icmpPayload, tempGuid);
-    setPeerGuidData(tempGuid);
+    setPeerGuidData(mLinkProberPtr->getGuid(icmpPayload));
 }
 
 TEST_F(LinkProberMockTest, LinkProberActiveActive)
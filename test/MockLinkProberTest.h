@@ -40,20 +40,20 @@ public:
     void updateIcmpSequenceNo() { mLinkProberPtr->updateIcmpSequenceNo(); }
     void sendHeartbeat() { mLinkProberPtr->updateIcmpSequenceNo(); }
     boost::asio::posix::stream_descriptor& getStream() const { return mLinkProberPtr->mStream; }
-    std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE>& getTxBuffer() { return mLinkProberPtr->mTxBuffer; }
-    std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE>& getRxBuffer() { return mLinkProberPtr->mRxBuffer; }
+    link_prober::PacketBuffer& getTxBuffer() { return mLinkProberPtr->mTxBuffer; }
+    link_prober::PacketBuffer& getRxBuffer() { return mLinkProberPtr->mRxBuffer; }
     std::size_t getTxPacketSize() { return mLinkProberPtr->mTxPacketSize; }
     const std::size_t getPacketHeaderSize() { return mLinkProberPtr->mPacketHeaderSize; }
     std::shared_ptr<MockLinkManagerStateMachine> getLinkManagerStateMachinePtr() { return mLinkManagerStateMachinePtr; }
     std::shared_ptr<link_prober::LinkProberStateMachineBase> getLinkProberStateMachinePtr() { return mLinkProberStateMachinePtr; }
     std::shared_ptr<link_prober::LinkProberSw> getLinkProberPtr() { return mLinkProberPtr; }
     void computeChecksum(icmphdr* icmpHeader, size_t size) { mLinkProberPtr->computeChecksum(icmpHeader, size); }
-    void handleRecv() { mLinkProberPtr->handleRecv(boost::system::error_code(), getTxPacketSize()); 
+    void handleRecv() { mLinkProberPtr->processRxFrame(getTxPacketSize()); 
     }
     void handleTimeout() { mLinkProberPtr->mReportHeartbeatReplyNotReceivedFuncPtr(link_prober::HeartbeatType::HEARTBEAT_SELF); }
     void receiveSelfIcmpReply();
     void receivePeerIcmpReply();
-    void setPeerGuidData(std::string l_guid) { mLinkProberPtr->setPeerGuidData(l_guid); }
+    void setPeerGuidData(uint32_t guid) { mLinkProberPtr->setPeerGuidData(guid); }
     void postGenerateGuid(uint32_t count);
     boost::asio::io_service &getIoService() {  return mIoService; }
 
@@ -88,6 +88,11 @@ uint32_t MuxManagerTest::getLinkProberStatUpdateIntervalCount(std::string port)
     return muxPortPtr->mMuxPortConfig.getLinkProberStatUpdateIntervalCount();
 }
 
+uint32_t MuxManagerTest::getMetricsFlushInterval_msec()
+{
+    return mMuxManagerPtr->mMuxConfig.getMetricsFlushInterval_msec();
+}
+
 uint32_t MuxManagerTest::getTimeoutIpv4_msec(std::string port)
 {
     std::shared_ptr<mux::MuxPort> muxPortPtr = mMuxManagerPtr->mPortMap[port];
@@ -324,6 +329,16 @@ void MuxManagerTest::setMuxState(const std::string &portName, mux_state::MuxStat
     return muxPortPtr->setMuxState(label);
 }
 
+void MuxManagerTest::seedStateDbMuxState(const std::string &portName, const std::string &state)
+{
+    mDbInterfacePtr->mDbShadowCache.seed(std::string("STATE_DB|") + STATE_MUX_CABLE_TABLE_NAME, portName, "state", state);
+}
+
+bool MuxManagerTest::shadowMuxStateWrite(const std::string &portName, const std::string &state, bool forceSwitch)
+{
+    return mDbInterfacePtr->shadowMuxStateWrite(portName, state, forceSwitch);
+}
+
 void MuxManagerTest::initializeThread()
 {
     for (uint8_t i = 0; i < 3; i++) {
@@ -371,6 +386,9 @@ void MuxManagerTest::initLinkProberActiveActive(std::shared_ptr<link_manager::Ac
     linkManagerStateMachineActiveActive->setIcmpEchoSessionStateUpdate(
         boost::bind(&FakeLinkProber::handleStateDbStateUpdate, mFakeLinkProber.get())
     );
+    linkManagerStateMachineActiveActive->setResetProbeIntervalFnPtr(
+        boost::bind(&FakeLinkProber::resetProbeInterval, mFakeLinkProber.get())
+    );
 
     linkManagerStateMachineActiveActive->mComponentInitState.set(0);
 }
@@ -402,6 +420,9 @@ void MuxManagerTest::initLinkProberActiveStandby(std::shared_ptr<link_manager::A
     linkManagerStateMachineActiveStandby->setRevertIntervalFnPtr(
         boost::bind(&FakeLinkProber::revertProbeIntervalAfterSwitchComplete, mFakeLinkProber.get())
     );
+    linkManagerStateMachineActiveStandby->setResetProbeIntervalFnPtr(
+        boost::bind(&FakeLinkProber::resetProbeInterval, mFakeLinkProber.get())
+    );
     linkManagerStateMachineActiveStandby->setSendPeerSwitchCommandFnPtr(
         boost::bind(&FakeLinkProber::sendPeerSwitchCommand, mFakeLinkProber.get())
     );
@@ -981,6 +1002,7 @@ TEST_F(MuxManagerTest, LinkmgrdConfig)
         {"LINK_PROBER", "SET", {{"interval_v4", "abc"}}},
         {"LINK_PROBER", "SET", {{"src_mac", "ToRMac"}}},
         {"LINK_PROBER", "SET", {{"interval_pck_loss_count_update", "900"}}},
+        {"LINK_PROBER", "SET", {{"metrics_flush_interval", "200"}}},
         {"LINK_PROBER", "SET", {{"reset_suspend_timer", "Ethernet0"}}},
         {"MUXLOGGER", "SET", {{"log_verbosity", "warning"}}},
     };
@@ -996,6 +1018,7 @@ TEST_F(MuxManagerTest, LinkmgrdConfig)
     EXPECT_TRUE(getPositiveStateChangeRetryCount(port) == positiveSignalCount);
     EXPECT_TRUE(getNegativeStateChangeRetryCount(port) == negativeSignalCount);
     EXPECT_TRUE(getLinkProberStatUpdateIntervalCount(port) == pckLossStatUpdateInterval);
+    EXPECT_TRUE(getMetricsFlushInterval_msec() == 200);
     EXPECT_TRUE(getLinkWaitTimeout_msec(port) == (negativeSignalCount + 1) * v4PorbeInterval);
     EXPECT_TRUE(common::MuxLogger::getInstance()->getLevel() == boost::log::trivial::warning);
     EXPECT_TRUE(getIfUseWellKnownMac(port) == useWellKnownMac);
@@ -1147,6 +1170,21 @@ TEST_F(MuxManagerTest, TsaEnable)
     EXPECT_TRUE(getMode("Ethernet0") == common::MuxPortConfig::Mode::Auto);
 }
 
+TEST_F(MuxManagerTest, ShadowMuxStateWriteForceSwitch)
+{
+    // first write and retries while orchagent reports another state go to APP DB
+    EXPECT_TRUE(shadowMuxStateWrite("Ethernet0", "standby", false));
+    EXPECT_TRUE(shadowMuxStateWrite("Ethernet0", "standby", false));
+
+    // orchagent reports standby, rewriting standby is redundant
+    seedStateDbMuxState("Ethernet0", "standby");
+    EXPECT_FALSE(shadowMuxStateWrite("Ethernet0", "standby", false));
+
+    // hardware drifted from STATE DB, forced correction is always written
+    EXPECT_TRUE(shadowMuxStateWrite("Ethernet0", "standby", true));
+    EXPECT_TRUE(shadowMuxStateWrite("Ethernet0", "active", false));
+}
+
 TEST_F(MuxManagerTest, DbInterfaceRaceConditionCheck)
 {
     createPort("Ethernet0");
@@ -53,6 +53,7 @@ public:
     uint32_t getPositiveStateChangeRetryCount(std::string port);
     uint32_t getNegativeStateChangeRetryCount(std::string port);
     uint32_t getLinkProberStatUpdateIntervalCount(std::string port);
+    uint32_t getMetricsFlushInterval_msec();
     uint32_t getTimeoutIpv4_msec(std::string port);
     uint32_t getTimeoutIpv6_msec(std::string port);
     uint32_t getLinkWaitTimeout_msec(std::string port);
@@ -95,6 +96,8 @@ public:
     void resetUpdateEthernetFrameFn(const std::string &portName);
     void postMetricsEvent(const std::string &portName, mux_state::MuxState::Label label);
     void setMuxState(const std::string &portName, mux_state::MuxState::Label label);
+    void seedStateDbMuxState(const std::string &portName, const std::string &state);
+    bool shadowMuxStateWrite(const std::string &portName, const std::string &state, bool forceSwitch);
     void initializeThread();
     void terminate();
     void updateLinkFailureDetectionState(const std::string &portName, const std::string
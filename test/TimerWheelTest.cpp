@@ -0,0 +1,136 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <boost/bind/bind.hpp>
+
+#include "TimerWheelTest.h"
+
+namespace test
+{
+
+TimerWheelTest::TimerWheelTest() :
+    mTimerWheelPtr(common::TimerWheel::getInstance())
+{
+    mTimerWheelPtr->initialize(mIoService);
+}
+
+TimerWheelTest::~TimerWheelTest()
+{
+    mTimerWheelPtr->deinitialize();
+}
+
+void TimerWheelTest::handleTimeout(const std::string &name, const boost::system::error_code &errorCode)
+{
+    if (errorCode == boost::asio::error::operation_aborted) {
+        mCanceled.push_back(name);
+    } else {
+        mExpired.push_back(name);
+    }
+}
+
+TEST_F(TimerWheelTest, ExpiryOrder)
+{
+    boost::asio::io_service::strand strand(mIoService);
+    common::WheelTimer shortTimer(mIoService);
+    common::WheelTimer longTimer(mIoService);
+    common::WheelTimer canceledTimer(mIoService);
+
+    // long timer sits on an upper level and is cascaded down before it expires
+    longTimer.expires_from_now(boost::posix_time::milliseconds(300));
+    longTimer.async_wait(strand.wrap(boost::bind(
+        &TimerWheelTest::handleTimeout, this, "long", boost::asio::placeholders::error
+    )));
+    shortTimer.expires_from_now(boost::posix_time::milliseconds(5));
+    shortTimer.async_wait(strand.wrap(boost::bind(
+        &TimerWheelTest::handleTimeout, this, "short", boost::asio::placeholders::error
+    )));
+    canceledTimer.expires_from_now(boost::posix_time::milliseconds(20));
+    canceledTimer.async_wait(boost::asio::bind_executor(strand, boost::bind(
+        &TimerWheelTest::handleTimeout, this, "canceled", boost::asio::placeholders::error
+    )));
+
+    EXPECT_EQ(mTimerWheelPtr->getTimerCount(), 3);
+    EXPECT_EQ(canceledTimer.cancel(), 1);
+    EXPECT_EQ(mTimerWheelPtr->getTimerCount(), 2);
+    EXPECT_FALSE(longTimer.expires_at().is_not_a_date_time());
+
+    mIoService.run_for(std::chrono::milliseconds(500));
+
+    EXPECT_EQ(mCanceled, std::vector<std::string>({"canceled"}));
+    EXPECT_EQ(mExpired, std::vector<std::string>({"short", "long"}));
+    EXPECT_EQ(mTimerWheelPtr->getTimerCount(), 0);
+}
+
+TEST_F(TimerWheelTest, BatchedExpiry)
+{
+    std::vector<std::shared_ptr<common::WheelTimer>> timers;
+    for (int i = 0; i < 100; i++) {
+        timers.push_back(std::make_shared<common::WheelTimer> (mIoService));
+        timers.back()->expires_from_now(boost::posix_time::milliseconds(10));
+        timers.back()->async_wait(boost::bind(
+            &TimerWheelTest::handleTimeout, this, std::to_string(i), boost::asio::placeholders::error
+        ));
+    }
+
+    uint64_t wakeupCount = mTimerWheelPtr->getWakeupCount();
+    uint64_t expiredCount = mTimerWheelPtr->getExpiredCount();
+    mIoService.run_for(std::chrono::milliseconds(100));
+
+    EXPECT_EQ(mExpired.size(), 100);
+    EXPECT_EQ(mTimerWheelPtr->getExpiredCount(), expiredCount + 100);
+    EXPECT_LE(mTimerWheelPtr->getWakeupCount(), wakeupCount + 3);
+    EXPECT_EQ(mTimerWheelPtr->getBurstHistogram().getMax(), 100);
+}
+
+TEST_F(TimerWheelTest, SpreadExpiryBurstSize)
+{
+    std::vector<std::shared_ptr<common::WheelTimer>> timers;
+    for (int i = 0; i < 20; i++) {
+        timers.push_back(std::make_shared<common::WheelTimer> (mIoService));
+        timers.back()->expires_from_now(boost::posix_time::milliseconds(10 + 5 * (i % 10)));
+        timers.back()->async_wait(boost::bind(
+            &TimerWheelTest::handleTimeout, this, std::to_string(i), boost::asio::placeholders::error
+        ));
+    }
+
+    mIoService.run_for(std::chrono::milliseconds(100));
+
+    EXPECT_EQ(mExpired.size(), 20);
+    // timers armed across a tick boundary may split a slot, never merge two
+    EXPECT_GE(mTimerWheelPtr->getBurstHistogram().getCount(), 10);
+    EXPECT_LE(mTimerWheelPtr->getBurstHistogram().getMax(), 2);
+}
+
+TEST_F(TimerWheelTest, RearmCancelsPendingWait)
+{
+    common::WheelTimer timer(mIoService);
+
+    timer.expires_from_now(boost::posix_time::milliseconds(50));
+    timer.async_wait(boost::bind(
+        &TimerWheelTest::handleTimeout, this, "first", boost::asio::placeholders::error
+    ));
+    EXPECT_EQ(timer.expires_from_now(boost::posix_time::milliseconds(5)), 1);
+    timer.async_wait(boost::bind(
+        &TimerWheelTest::handleTimeout, this, "second", boost::asio::placeholders::error
+    ));
+
+    mIoService.run_for(std::chrono::milliseconds(100));
+
+    EXPECT_EQ(mCanceled, std::vector<std::string>({"first"}));
+    EXPECT_EQ(mExpired, std::vector<std::string>({"second"}));
+}
+
+} /* namespace test */
@@ -0,0 +1,46 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef TIMERWHEELTEST_H_
+#define TIMERWHEELTEST_H_
+
+#include <string>
+#include <vector>
+
+#include "common/TimerWheel.h"
+#include "gtest/gtest.h"
+
+namespace test
+{
+
+class TimerWheelTest: public ::testing::Test
+{
+public:
+    TimerWheelTest();
+    virtual ~TimerWheelTest();
+
+    void handleTimeout(const std::string &name, const boost::system::error_code &errorCode);
+
+    boost::asio::io_service mIoService;
+    common::TimerWheelPtr mTimerWheelPtr;
+
+    std::vector<std::string> mExpired;
+    std::vector<std::string> mCanceled;
+};
+
+} /* namespace test */
+
+#endif /* TIMERWHEELTEST_H_ */
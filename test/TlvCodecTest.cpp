@@ -0,0 +1,111 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * TlvCodecTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "TlvCodecTest.h"
+
+namespace test
+{
+
+link_prober::TlvAction TlvCodecTest::handleCommand(TlvCodecTest &context, const link_prober::TlvView &tlv)
+{
+    context.mCommands.push_back(*tlv.value());
+    return link_prober::TlvAction::Continue;
+}
+
+link_prober::TlvAction TlvCodecTest::handleSentinel(TlvCodecTest &context, const link_prober::TlvView &tlv)
+{
+    context.mSentinelCount++;
+    return link_prober::TlvAction::Stop;
+}
+
+link_prober::TlvAction TlvCodecTest::handleUnknown(TlvCodecTest &context, const link_prober::TlvView &tlv)
+{
+    context.mUnknownTypes.push_back(tlv.type());
+    return link_prober::TlvAction::Continue;
+}
+
+const link_prober::TlvDispatchTable<TlvCodecTest> TlvCodecTest::mDispatchTable =
+    link_prober::makeTlvDispatchTable<TlvCodecTest> ({
+        {link_prober::TlvType::TLV_COMMAND, &TlvCodecTest::handleCommand},
+        {link_prober::TlvType::TLV_SENTINEL, &TlvCodecTest::handleSentinel},
+    }, &TlvCodecTest::handleUnknown);
+
+TEST_F(TlvCodecTest, WriteAndDispatch)
+{
+    const size_t startOffset = 4;
+    link_prober::TlvWriter tlvWriter(mBuffer.data(), mBuffer.size(), startOffset);
+    EXPECT_EQ(tlvWriter.appendCommand(link_prober::Command::COMMAND_MUX_PROBE), sizeof(link_prober::TlvHead) + 1);
+    EXPECT_EQ(tlvWriter.appendDummy(2, 7), sizeof(link_prober::TlvHead) + 2 + sizeof(uint32_t));
+    EXPECT_EQ(tlvWriter.appendCommand(link_prober::Command::COMMAND_SWITCH_ACTIVE), sizeof(link_prober::TlvHead) + 1);
+    EXPECT_EQ(tlvWriter.appendSentinel(), sizeof(link_prober::TlvHead));
+    size_t frameSize = tlvWriter.getOffset();
+
+    // TLVs after sentinel are not dispatched
+    tlvWriter.appendCommand(link_prober::Command::COMMAND_MUX_PROBE);
+
+    link_prober::TlvReader tlvReader(mBuffer.data(), tlvWriter.getOffset(), startOffset);
+    EXPECT_EQ(link_prober::dispatchTlvs(mDispatchTable, static_cast<TlvCodecTest &> (*this), tlvReader), frameSize);
+    EXPECT_EQ(mCommands, std::vector<uint8_t> ({
+        static_cast<uint8_t> (link_prober::Command::COMMAND_MUX_PROBE),
+        static_cast<uint8_t> (link_prober::Command::COMMAND_SWITCH_ACTIVE)
+    }));
+    EXPECT_EQ(mUnknownTypes, std::vector<uint8_t> ({link_prober::TlvType::TLV_DUMMY}));
+    EXPECT_EQ(mSentinelCount, 1);
+
+    // views point into the frame
+    link_prober::TlvReader::const_iterator tlvIter = tlvReader.begin();
+    EXPECT_EQ(tlvIter->data(), mBuffer.data() + startOffset);
+    ++tlvIter;
+    EXPECT_EQ(tlvIter->type(), link_prober::TlvType::TLV_DUMMY);
+    EXPECT_EQ(tlvIter->length(), 2 + sizeof(uint32_t));
+    EXPECT_EQ(tlvIter->value()[5], 7);
+}
+
+TEST_F(TlvCodecTest, BoundsCheck)
+{
+    // writer appends nothing that does not fit
+    link_prober::TlvWriter tlvWriter(mBuffer.data(), 8, 0);
+    EXPECT_EQ(tlvWriter.appendCommand(link_prober::Command::COMMAND_MUX_PROBE), 4);
+    EXPECT_EQ(tlvWriter.appendDummy(2, 1), 0);
+    EXPECT_EQ(tlvWriter.appendSentinel(), 3);
+    EXPECT_EQ(tlvWriter.appendSentinel(), 0);
+    EXPECT_EQ(tlvWriter.getOffset(), 7);
+
+    // reader stops at truncated head and at value running past frame end
+    link_prober::TlvReader truncatedHead(mBuffer.data(), 6, 0);
+    EXPECT_EQ(std::distance(truncatedHead.begin(), truncatedHead.end()), 1);
+
+    mBuffer[4] = link_prober::TlvType::TLV_DUMMY;
+    mBuffer[5] = 0;
+    mBuffer[6] = 1;
+    link_prober::TlvReader truncatedValue(mBuffer.data(), 7, 0);
+    EXPECT_EQ(std::distance(truncatedValue.begin(), truncatedValue.end()), 1);
+    EXPECT_EQ(link_prober::TlvReader::getTlvSize(mBuffer.data(), 8, 4), 4);
+    EXPECT_EQ(link_prober::TlvReader::getTlvSize(mBuffer.data(), 8, 9), 0);
+
+    // offset past frame end yields no TLV
+    link_prober::TlvReader emptyReader(mBuffer.data(), 4, 6);
+    EXPECT_TRUE(emptyReader.begin() == emptyReader.end());
+    EXPECT_EQ(link_prober::dispatchTlvs(mDispatchTable, static_cast<TlvCodecTest &> (*this), emptyReader), 0);
+}
+
+} /* namespace test */
@@ -0,0 +1,56 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * TlvCodecTest.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef TLVCODECTEST_H_
+#define TLVCODECTEST_H_
+
+#include <array>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "link_prober/TlvCodec.h"
+
+namespace test
+{
+
+class TlvCodecTest: public ::testing::Test
+{
+public:
+    TlvCodecTest() = default;
+    virtual ~TlvCodecTest() = default;
+
+    static link_prober::TlvAction handleCommand(TlvCodecTest &context, const link_prober::TlvView &tlv);
+    static link_prober::TlvAction handleSentinel(TlvCodecTest &context, const link_prober::TlvView &tlv);
+    static link_prober::TlvAction handleUnknown(TlvCodecTest &context, const link_prober::TlvView &tlv);
+
+    static const link_prober::TlvDispatchTable<TlvCodecTest> mDispatchTable;
+
+    std::array<uint8_t, 64> mBuffer = {};
+    std::vector<uint8_t> mCommands;
+    std::vector<uint8_t> mUnknownTypes;
+    uint32_t mSentinelCount = 0;
+};
+
+} /* namespace test */
+
+#endif /* TLVCODECTEST_H_ */
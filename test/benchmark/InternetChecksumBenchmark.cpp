@@ -0,0 +1,86 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * InternetChecksumBenchmark.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "common/InternetChecksum.h"
+
+namespace
+{
+
+//
+// scalar loop LinkProberBase::calculateChecksum used before kernels were introduced
+//
+uint32_t legacyChecksum(const uint16_t *data, size_t size)
+{
+    uint32_t sum = 0;
+
+    while (size > 1) {
+        sum += ntohs(*data++);
+        size -= sizeof(uint16_t);
+    }
+
+    if (size) {
+        sum += ntohs(static_cast<uint16_t> ((*reinterpret_cast<const uint8_t *> (data))));
+    }
+
+    return sum;
+}
+
+void BM_ChecksumLegacy(benchmark::State &state)
+{
+    std::vector<uint16_t> buffer(state.range(0) / sizeof(uint16_t) + 1, 0xa5c3);
+
+    for (auto _: state) {
+        benchmark::DoNotOptimize(legacyChecksum(buffer.data(), state.range(0)));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ChecksumLegacy)->RangeMultiplier(2)->Range(64, 8192)->Arg(9100);
+
+void BM_ChecksumKernel(benchmark::State &state)
+{
+    common::InternetChecksum::Kernel kernel = static_cast<common::InternetChecksum::Kernel> (state.range(1));
+    if (!common::InternetChecksum::isSupported(kernel)) {
+        state.SkipWithError("kernel not supported by CPU");
+        return;
+    }
+    state.SetLabel(common::InternetChecksum::getKernelName(kernel));
+
+    std::vector<uint16_t> buffer(state.range(0) / sizeof(uint16_t) + 1, 0xa5c3);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(common::InternetChecksum::sum(kernel, buffer.data(), state.range(0)));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ChecksumKernel)->ArgsProduct({
+    {64, 128, 256, 512, 1024, 2048, 4096, 8192, 9100},
+    {
+        static_cast<int64_t> (common::InternetChecksum::Kernel::Scalar),
+        static_cast<int64_t> (common::InternetChecksum::Kernel::Sse2),
+        static_cast<int64_t> (common::InternetChecksum::Kernel::Avx2)
+    }
+});
+
+} /* namespace */
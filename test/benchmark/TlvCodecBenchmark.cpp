@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * TlvCodecBenchmark.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <array>
+
+#include <benchmark/benchmark.h>
+
+#include "link_prober/TlvCodec.h"
+
+namespace
+{
+
+struct BenchmarkContext {
+    uint32_t commandCount = 0;
+    uint32_t unknownCount = 0;
+};
+
+link_prober::TlvAction handleCommand(BenchmarkContext &context, const link_prober::TlvView &tlv)
+{
+    context.commandCount += *tlv.value();
+    return link_prober::TlvAction::Continue;
+}
+
+link_prober::TlvAction handleSentinel(BenchmarkContext &context, const link_prober::TlvView &tlv)
+{
+    return link_prober::TlvAction::Stop;
+}
+
+link_prober::TlvAction handleUnknown(BenchmarkContext &context, const link_prober::TlvView &tlv)
+{
+    context.unknownCount++;
+    return link_prober::TlvAction::Continue;
+}
+
+const link_prober::TlvDispatchTable<BenchmarkContext> DispatchTable =
+    link_prober::makeTlvDispatchTable<BenchmarkContext> ({
+        {link_prober::TlvType::TLV_COMMAND, &handleCommand},
+        {link_prober::TlvType::TLV_SENTINEL, &handleSentinel},
+    }, &handleUnknown);
+
+//
+// frame of state.range(0) command TLVs and state.range(1) dummy TLVs ended by sentinel
+//
+size_t buildFrame(benchmark::State &state, std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE> &frame)
+{
+    link_prober::TlvWriter tlvWriter(frame.data(), frame.size(), 0);
+    for (int64_t i = 0; i < state.range(0); i++) {
+        tlvWriter.appendCommand(link_prober::Command::COMMAND_MUX_PROBE);
+    }
+    for (int64_t i = 0; i < state.range(1); i++) {
+        tlvWriter.appendDummy(i % 8, i);
+    }
+    tlvWriter.appendSentinel();
+
+    return tlvWriter.getOffset();
+}
+
+void BM_TlvDispatch(benchmark::State &state)
+{
+    std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE> frame;
+    size_t frameSize = buildFrame(state, frame);
+
+    BenchmarkContext context;
+    for (auto _: state) {
+        link_prober::TlvReader tlvReader(frame.data(), frameSize, 0);
+        benchmark::DoNotOptimize(link_prober::dispatchTlvs(DispatchTable, context, tlvReader));
+    }
+    benchmark::DoNotOptimize(context);
+    state.SetBytesProcessed(state.iterations() * frameSize);
+    state.SetItemsProcessed(state.iterations() * (state.range(0) + state.range(1) + 1));
+}
+BENCHMARK(BM_TlvDispatch)->Args({0, 0})->Args({1, 0})->Args({1, 16})->Args({4, 256});
+
+void BM_TlvWrite(benchmark::State &state)
+{
+    std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE> frame;
+
+    for (auto _: state) {
+        benchmark::DoNotOptimize(buildFrame(state, frame));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * (state.range(0) + state.range(1) + 1));
+}
+BENCHMARK(BM_TlvWrite)->Args({0, 0})->Args({1, 0})->Args({1, 16})->Args({4, 256});
+
+} /* namespace */
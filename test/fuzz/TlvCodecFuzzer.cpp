@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2021 (c) Microsoft Corporation.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * TlvCodecFuzzer.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <array>
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "link_prober/TlvCodec.h"
+
+namespace
+{
+
+struct FuzzContext {
+    const uint8_t *frame;
+    size_t size;
+    size_t tlvCount;
+};
+
+//
+// every TLV handed to a handler must lie within the frame
+//
+link_prober::TlvAction handleTlv(FuzzContext &context, const link_prober::TlvView &tlv)
+{
+    assert(tlv.data() == context.frame + tlv.offset());
+    assert(tlv.offset() + tlv.size() <= context.size);
+    context.tlvCount++;
+
+    // touch the whole value so sanitizers catch reads past the frame
+    volatile uint8_t sum = 0;
+    for (size_t i = 0; i < tlv.length(); i++) {
+        sum += tlv.value()[i];
+    }
+
+    return tlv.type() == link_prober::TlvType::TLV_SENTINEL ? link_prober::TlvAction::Stop : link_prober::TlvAction::Continue;
+}
+
+const link_prober::TlvDispatchTable<FuzzContext> DispatchTable =
+    link_prober::makeTlvDispatchTable<FuzzContext> ({
+        {link_prober::TlvType::TLV_SENTINEL, &handleTlv},
+    }, &handleTlv);
+
+} /* namespace */
+
+//
+// first input byte selects the offset of the TLV chain, the rest is the frame
+//
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    if (size == 0) {
+        return 0;
+    }
+
+    size_t offset = data[0];
+    FuzzContext context {data + 1, size - 1, 0};
+    link_prober::TlvReader tlvReader(context.frame, context.size, offset);
+    size_t endOffset = link_prober::dispatchTlvs(DispatchTable, context, tlvReader);
+    assert(endOffset <= context.size);
+    assert(context.tlvCount <= context.size);
+
+    // re-encoding the TLVs read must reproduce the frame bytes
+    std::array<uint8_t, MUX_MAX_ICMP_BUFFER_SIZE> buffer;
+    link_prober::TlvWriter tlvWriter(buffer.data(), buffer.size(), 0);
+    for (const link_prober::TlvView &tlv: tlvReader) {
+        uint8_t *value = tlvWriter.append(tlv.type(), tlv.length());
+        if (value == nullptr) {
+            break;
+        }
+        memcpy(value, tlv.value(), tlv.length());
+        assert(memcmp(value - sizeof(link_prober::TlvHead), tlv.data(), tlv.size()) == 0);
+    }
+
+    return 0;
+}
@@ -1,51 +1,81 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+    ./test/AllocationCounter.cpp \
+    ./test/DbCommandQueueTest.cpp \
+    ./test/DbShadowCacheTest.cpp \
     ./test/FakeDbInterface.cpp \
     ./test/FakeLinkProber.cpp \
     ./test/FakeMuxPort.cpp \
+    ./test/HeartbeatLossWindowTest.cpp \
+    ./test/InternetChecksumTest.cpp \
+    ./test/LatencyHistogramTest.cpp \
+    ./test/LinkProberBudgetTest.cpp \
     ./test/LinkManagerStateMachineTest.cpp \
     ./test/LinkManagerStateMachineActiveActiveTest.cpp \
     ./test/LinkProberTest.cpp \
     ./test/LinkProberHardwareTest.cpp \
+    ./test/MetricsSlotTableTest.cpp \
     ./test/MuxManagerTest.cpp \
     ./test/MockLinkManagerStateMachine.cpp \
     ./test/MockLinkProberTest.cpp \
     ./test/LinkMgrdTestMain.cpp \
     ./test/MuxLoggerTest.cpp \
     ./test/FakeLinkManagerStateMachine.cpp \
-    ./test/MuxPortTest.cpp
+    ./test/MuxPortTest.cpp \
+    ./test/TimerWheelTest.cpp \
+    ./test/TlvCodecTest.cpp
 
 OBJS_LINKMGRD_TEST += \
+    ./test/AllocationCounter.o \
+    ./test/DbCommandQueueTest.o \
+    ./test/DbShadowCacheTest.o \
     ./test/FakeDbInterface.o \
     ./test/FakeLinkProber.o \
     ./test/FakeMuxPort.o \
+    ./test/HeartbeatLossWindowTest.o \
+    ./test/InternetChecksumTest.o \
+    ./test/LatencyHistogramTest.o \
+    ./test/LinkProberBudgetTest.o \
     ./test/LinkManagerStateMachineTest.o \
     ./test/LinkManagerStateMachineActiveActiveTest.o \
     ./test/LinkProberTest.o \
     ./test/LinkProberHardwareTest.o \
+    ./test/MetricsSlotTableTest.o \
     ./test/MuxManagerTest.o \
     ./test/MockLinkManagerStateMachine.o \
     ./test/MockLinkProberTest.o \
     ./test/LinkMgrdTestMain.o \
     ./test/MuxLoggerTest.o \
     ./test/FakeLinkManagerStateMachine.o \
-    ./test/MuxPortTest.o
+    ./test/MuxPortTest.o \
+    ./test/TimerWheelTest.o \
+    ./test/TlvCodecTest.o
 
 CPP_DEPS += \
+    ./test/AllocationCounter.d \
+    ./test/DbCommandQueueTest.d \
+    ./test/DbShadowCacheTest.d \
     ./test/FakeDbInterface.d \
     ./test/FakeLinkProber.d \
     ./test/FakeMuxPort.d \
+    ./test/HeartbeatLossWindowTest.d \
+    ./test/InternetChecksumTest.d \
+    ./test/LatencyHistogramTest.d \
+    ./test/LinkProberBudgetTest.d \
     ./test/LinkManagerStateMachineTest.d \
     ./test/LinkManagerStateMachineActiveActiveTest.d \
     ./test/LinkProberTest.d \
     ./test/LinkProberHardwareTest.d \
+    ./test/MetricsSlotTableTest.d \
     ./test/MuxManagerTest.d \
     ./test/MockLinkManagerStateMachine.d \
     ./test/MockLinkProberTest.d \
     ./test/LinkMgrdTestMain.d \
     ./test/MuxLoggerTest.d \
     ./test/FakeLinkManagerStateMachine.d \
-    ./test/MuxPortTest.d
+    ./test/MuxPortTest.d \
+    ./test/TimerWheelTest.d \
+    ./test/TlvCodecTest.d
 
 # Each subdirectory must supply rules for building sources it contributes
 test/%.o: test/%.cpp